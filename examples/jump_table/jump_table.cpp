@@ -89,14 +89,11 @@ void setup(int argc, char **argv) {
 bool should_analyze(Program* p, Function* f) {
    /* found 1 unexplored jump --> analyze */
    if (!skipped.contains(f->offset())) {
-      for (auto scc: f->scc_list())
-      for (auto b: scc->block_list())
-      for (auto i: b->insn_list())
-         if (i->indirect()) {
-            auto it = p->icfs().find(i->offset());
-            if (it == p->icfs().end() || it->second.empty())
-               return true;
-         }
+      for (auto i: f->icf_sites()) {
+         auto it = p->icfs().find(i->offset());
+         if (it == p->icfs().end() || it->second.empty())
+            return true;
+      }
    }
    /* explored all jumps --> not analyze, mark skip */
    skipped.insert(f->offset());
@@ -177,27 +174,7 @@ int main(int argc, char **argv) {
       /* reduce gaps by resolving targets of indirect jumps */
       while (true) {
          auto prev_cnt = p->icfs().size();
-         for (auto fptr: p->fptrs()) {
-            // 创建字符串流
-            std::stringstream stream;
-            // 将十进制变量转换为十六进制并存储到字符串流中
-            stream << std::hex << fptr;
-            // 获取十六进制字符串
-            std::string hexString = stream.str();
-            if (fptr == 5242){
-               hexString = stream.str();
-            }
-            if (p->updated(fptr)) {
-               auto f = p->func(fptr);
-               if (f != nullptr) {
-                  if (should_analyze(p, f)) {
-                     f->analyze(config,p);
-                     f->resolve_icf();
-                  }
-                  delete f;
-               }
-            }
-         }
+         p->analyze(config, [p](Function* f) {return should_analyze(p, f);});
          p->resolve_unbounded_icf();
          if (prev_cnt == p->icfs().size())
             break;
@@ -210,11 +187,13 @@ int main(int argc, char **argv) {
    LOG_STOP();
 
    // 获取f_obj文件中的.text段的范围   
-   pair<uint64_t, uint64_t> text_range = p->get_text_section_range(f_obj);
+   pair<uint64_t, uint64_t> text_range = p->get_text_section_range();
    for (auto fptr: p->fptrs()) {
       if(fptr < text_range.first || fptr >= text_range.second)
          continue;
       auto f = p->func(fptr);
+      if (f == nullptr)
+         continue;
       
       std::stringstream stream;
       // 将十进制变量转换为十六进制并存储到字符串流中
@@ -223,8 +202,9 @@ int main(int argc, char **argv) {
       std::string hexString = stream.str();
       
       f->analyze(config,p);
+      f->clear();
    }
-   p->resolve_vfunc( f_obj);
+   p->resolve_vfunc();
 
    /* results */
    fstream f1(f_out, fstream::out);
@@ -0,0 +1,51 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef ADDR_INDEX_H
+#define ADDR_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "config.h"
+
+namespace SBA {
+   /* ------------------------------ AddrIndex ------------------------------ */
+   /* Address -> position in a vector of instructions. Code addresses are    */
+   /* dense, so each run of nearby addresses gets a flat array of positions; */
+   /* a lookup is a binary search among few runs and one array access, with */
+   /* 4 bytes per code byte instead of a hash node per instruction.         */
+   class AddrIndex {
+    private:
+      struct Run {
+         IMM base;
+         std::vector<uint32_t> slot;      /* position + 1, 0 if none */
+      };
+      std::vector<Run> runs_;
+      size_t size_ = 0;
+
+    public:
+      /* addrs[k] is the address at position k, a repeated one keeps the last */
+      void build(const std::vector<IMM>& addrs);
+      bool empty() const {return size_ == 0;};
+      size_t size() const {return size_;};
+      bool contains(IMM addr) const {return find(addr) >= 0;};
+
+      /* position of addr, or -1 */
+      int64_t find(IMM addr) const {
+         auto it = std::upper_bound(runs_.begin(), runs_.end(), addr,
+                   [](IMM a, const Run& r) {return a < r.base;});
+         if (it == runs_.begin())
+            return -1;
+         --it;
+         auto k = (uint64_t)(addr - it->base);
+         return k < it->slot.size()? (int64_t)it->slot[k] - 1: -1;
+      };
+   };
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace SBA {
+   /* -------------------------------- Arena -------------------------------- */
+   /* Bump allocator for objects that die together, e.g. the insns and RTL   */
+   /* of a Program, laid out in the order they are created. Chunks are cut   */
+   /* from one reserved address range, so a pointer is told apart from heap  */
+   /* memory in O(1): deleting an object of an arena only runs its           */
+   /* destructor, the memory is given back in bulk by reset() or ~Arena().   */
+   /* Classes opt in through operator new/delete, which use the arena of the */
+   /* calling thread's Scope, or the heap if there is none. Each thread cuts */
+   /* objects from a chunk of its own, the lock is only taken for a chunk.   */
+   class Arena {
+    public:
+      class Scope {
+       private:
+         Arena* prev_;
+
+       public:
+         Scope(Arena* arena);
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+         ~Scope();
+      };
+
+    private:
+      std::mutex lock_;
+      std::vector<uint8_t*> chunks_;
+      std::atomic<uint64_t> id_;     /* renewed by reset(), tags thread chunks */
+
+    public:
+      Arena();
+      Arena(const Arena&) = delete;
+      Arena& operator=(const Arena&) = delete;
+      ~Arena();
+
+      /* nullptr if no chunk is left, objects must be destroyed before reset */
+      void* allocate(size_t size);
+      void reset();
+
+      static Arena* current();
+      static void* alloc(size_t size, Arena* arena = current());
+      static void free(void* p);
+      static bool owns(const void* p);
+   };
+}
+
+#endif
@@ -9,6 +9,8 @@
 #define BLOCK_H
 
 #include "state.h"
+#include "arena.h"
+#include "cfg.h"
 #include "common.h"
 
 namespace SBA {
@@ -26,7 +28,6 @@ namespace SBA {
       bool faulty;
       #if ENABLE_DETECT_UPDATED_FUNCTION == true
          IMM update_num;
-         vector<Block*> superset_preds;
       #endif
       #if ENABLE_SUPPORT_CONSTRAINT == true
          AbsFlags flags;
@@ -40,9 +41,9 @@ namespace SBA {
       uint64_t preset_regs;
 
     private:
-      vector<Insn*> i_list_;
-      vector<pair<Block*,COMPARE>> succ_;
-      vector<Block*> pred_;
+      /* insns and edges are kept in cfg_ under id_ */
+      CFG* cfg_;
+      uint32_t id_;
 
     private:
       BlockVal val_;
@@ -53,8 +54,14 @@ namespace SBA {
       unordered_set<UnitVal*> b_commit_;
 
     public:
-      Block(const vector<Insn*>& i_list);
-      ~Block() {};
+      Block(CFG& cfg, const vector<Insn*>& i_list);
+      ~Block() {cfg_->remove(id_);};
+      static void* operator new(size_t size) {return Arena::alloc(size);};
+      static void* operator new(size_t size, Arena& arena) {
+         return Arena::alloc(size, &arena);
+      };
+      static void operator delete(void* p) {Arena::free(p);};
+      static void operator delete(void* p, Arena&) {Arena::free(p);};
 
       /* state */
       UnitVal& value(IMM sym);
@@ -80,20 +87,24 @@ namespace SBA {
 
       /* accessor */
       IMM offset() const;
-      const vector<Insn*>& insn_list() const {return i_list_;};
-      Insn* first() const {return i_list_.front();};
-      Insn* last() const {return i_list_.back();};
+      uint32_t id() const {return id_;};
+      CFG::Insns insn_list() const {return cfg_->insns(id_);};
+      Insn* first() const {return insn_list().front();};
+      Insn* last() const {return insn_list().back();};
       Expr* indirect_target() const;
       Expr* cond_expr() const;
-      const vector<pair<Block*,COMPARE>>& succ() const {return succ_;};
-      const vector<Block*>& pred() const {return pred_;};
+      CFG::Succs succ() const {return cfg_->succ(id_);};
+      CFG::Blocks pred() const {return cfg_->pred(id_);};
       void succ(Block* u, COMPARE c, bool back_edge = true);
-      void pred(Block* u) {pred_.push_back(u);};
+      void pred(Block* u) {cfg_->pred(id_, u->id_);};
+      #if ENABLE_DETECT_UPDATED_FUNCTION == true
+         CFG::Blocks superset_preds() const {return cfg_->superset_pred(id_);};
+         void clear_superset_preds() {cfg_->clear_superset_pred(id_);};
+      #endif
       void attach(SCC* scc) {parent = scc;};
       void detach();
-      void shrink_succ() {succ_.clear();};
-      void shrink_insn_list(vector<Insn*>::const_iterator it)
-                           {i_list_.erase(it, i_list_.end());};
+      void shrink_succ() {cfg_->clear_succ(id_);};
+      void shrink_insn_list(uint32_t n) {cfg_->shrink_insns(id_, n);};
    };
 }
 
@@ -0,0 +1,54 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "state.h"
+#include "common.h"
+
+namespace SBA {
+   class Expr;
+   /* ------------------------------ Bytecode ------------------------------- */
+   /* Expressions of one insn lowered to a flat post-order code, evaluated by */
+   /* a switch loop instead of a virtual call per node. Instruction i writes  */
+   /* slot i, its operands are slots of earlier instructions, so the values   */
+   /* are computed in the same order as the recursive Expr::eval(). An        */
+   /* expression is lowered the first time it is evaluated, the nodes keep    */
+   /* their EVAL_* semantics since only the operand walk is replaced. The     */
+   /* simplified form of a statement operand is likewise found once.          */
+   class Bytecode {
+    private:
+      enum class OP: uint8_t {CONST, REG, NOTYPE, OTHER, MEM, SUBREG,
+                              IFELSE, CONVERSION, UNARY, BINARY};
+      struct Instr {
+         OP op;
+         uint16_t a;             /* slot of first operand  */
+         uint16_t b;             /* slot of second operand */
+         Expr* node;
+      };
+      struct Entry {
+         const Expr* expr;
+         uint32_t first;
+         uint32_t last;          /* first == last: not lowered, too large */
+      };
+      vector<Instr> code_;
+      vector<Entry> entries_;
+      vector<pair<const Expr*,Expr*>> simple_;   /* expr, its simplify() */
+
+    public:
+      AbsVal eval(State& s, Expr* e);
+      Expr* simplify(Expr* e);
+      void clear() {code_.clear(); entries_.clear(); simple_.clear();};
+
+    private:
+      const Entry& lower(Expr* e);
+      bool emit(Expr* e, uint32_t first);
+   };
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef CFG_H
+#define CFG_H
+
+#include "common.h"
+
+namespace SBA {
+   /* Forward declaration */
+   class Block;
+   class Insn;
+   /* --------------------------------- CFG --------------------------------- */
+   /* Topology of all blocks of a Program, kept apart from the blocks. Each  */
+   /* block is known by a 32-bit id, its insns, successors and predecessors  */
+   /* are windows of a few flat arrays, in the manner of a compressed sparse */
+   /* row graph. A window that is full moves to the end of its array with    */
+   /* twice the room, so edges are still added one at a time while the CFG   */
+   /* grows; compact() packs the windows again once half is unused. Ids of   */
+   /* deleted blocks are reused together with their windows.                 */
+   class CFG {
+    public:
+      struct Edge {
+         uint32_t to;
+         COMPARE cond;
+      };
+
+      /* list of one block, read by position: it stays valid while the */
+      /* windows of other blocks grow and move the array               */
+      template<class T, class V> class View {
+       public:
+         class iterator {
+          private:
+            const CFG* cfg_;
+            const vector<T>* data_;
+            uint32_t k_;
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = V;
+            using pointer = void;
+            using reference = V;
+            iterator(): cfg_(nullptr), data_(nullptr), k_(0) {};
+            iterator(const CFG* cfg, const vector<T>* data, uint32_t k):
+                     cfg_(cfg), data_(data), k_(k) {};
+            V operator*() const {return cfg_->value((*data_)[k_]);};
+            iterator& operator++() {++k_; return *this;};
+            iterator operator++(int) {auto x = *this; ++k_; return x;};
+            bool operator==(const iterator& x) const {return k_ == x.k_;};
+            bool operator!=(const iterator& x) const {return k_ != x.k_;};
+         };
+
+       private:
+         const CFG* cfg_;
+         const vector<T>* data_;
+         uint32_t first_;
+         uint32_t last_;
+
+       public:
+         View(const CFG* cfg, const vector<T>* data, uint32_t first,
+              uint32_t last): cfg_(cfg), data_(data), first_(first),
+              last_(last) {};
+         iterator begin() const {return iterator(cfg_, data_, first_);};
+         iterator end() const {return iterator(cfg_, data_, last_);};
+         bool empty() const {return first_ == last_;};
+         uint32_t size() const {return last_ - first_;};
+         V operator[](uint32_t k) const {
+            return cfg_->value((*data_)[first_+k]);
+         };
+         V front() const {return (*this)[0];};
+         V back() const {return (*this)[size()-1];};
+      };
+      using Succs = View<Edge,pair<Block*,COMPARE>>;
+      using Blocks = View<uint32_t,Block*>;
+      using Insns = View<Insn*,Insn*>;
+
+    private:
+      struct Range {
+         uint32_t first = 0;
+         uint32_t size = 0;
+         uint32_t cap = 0;
+      };
+      template<class T> struct Pool {
+         vector<T> data;
+         vector<Range> range;
+         size_t unused = 0;
+         void push(uint32_t id, const T& x);
+         void assign(uint32_t id, const vector<T>& x);
+         void compact();
+      };
+
+      vector<Block*> blocks_;
+      vector<uint32_t> free_;
+      Pool<Insn*> insns_;
+      Pool<Edge> succ_;
+      Pool<uint32_t> pred_;
+      Pool<uint32_t> sup_;
+
+    public:
+      /* block */
+      uint32_t add(Block* b, const vector<Insn*>& i_list);
+      void remove(uint32_t id);
+      Block* block(uint32_t id) const {return blocks_[id];};
+      uint32_t size() const {return blocks_.size();};
+      void compact();
+
+      /* insns */
+      Insns insns(uint32_t id) const {return view<Insn*>(insns_, id);};
+      void shrink_insns(uint32_t id, uint32_t n) {insns_.range[id].size = n;};
+
+      /* edges */
+      Succs succ(uint32_t id) const {
+         return view<pair<Block*,COMPARE>>(succ_, id);
+      };
+      Blocks pred(uint32_t id) const {return view<Block*>(pred_, id);};
+      Blocks superset_pred(uint32_t id) const {return view<Block*>(sup_, id);};
+      void succ(uint32_t u, uint32_t v, COMPARE c) {succ_.push(u, {v,c});};
+      void pred(uint32_t u, uint32_t v) {pred_.push(u, v);};
+      void superset_pred(uint32_t u, uint32_t v) {sup_.push(u, v);};
+      void clear_succ(uint32_t id) {succ_.range[id].size = 0;};
+      void clear_pred(uint32_t id) {pred_.range[id].size = 0;};
+      void clear_superset_pred(uint32_t id) {sup_.range[id].size = 0;};
+
+    private:
+      template<class V, class T> View<T,V> view(const Pool<T>& pool,
+      uint32_t id) const {
+         auto const& r = pool.range[id];
+         return View<T,V>(this, &pool.data, r.first, r.first + r.size);
+      };
+      Insn* value(Insn* i) const {return i;};
+      Block* value(uint32_t id) const {return blocks_[id];};
+      pair<Block*,COMPARE> value(const Edge& e) const {
+         return {blocks_[e.to], e.cond};
+      };
+   };
+}
+
+#endif
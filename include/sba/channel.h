@@ -0,0 +1,64 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace SBA {
+   /* ------------------------------- Channel ------------------------------- */
+   /* bounded FIFO between two pipeline stages: push() blocks while full,    */
+   /* pop() blocks while empty and returns false once closed and drained    */
+   template<class T> class Channel {
+    private:
+      std::deque<T> items_;
+      size_t capacity_;
+      bool closed_ = false;
+      std::mutex lock_;
+      std::condition_variable not_full_;
+      std::condition_variable not_empty_;
+
+    public:
+      explicit Channel(size_t capacity): capacity_(capacity > 0? capacity: 1) {};
+      Channel(const Channel&) = delete;
+      Channel& operator=(const Channel&) = delete;
+
+      void push(T&& item) {
+         std::unique_lock<std::mutex> guard(lock_);
+         not_full_.wait(guard, [&]() {return items_.size() < capacity_ ||
+                                              closed_;});
+         if (closed_)
+            return;
+         items_.push_back(std::move(item));
+         not_empty_.notify_one();
+      };
+
+      bool pop(T& item) {
+         std::unique_lock<std::mutex> guard(lock_);
+         not_empty_.wait(guard, [&]() {return !items_.empty() || closed_;});
+         if (items_.empty())
+            return false;
+         item = std::move(items_.front());
+         items_.pop_front();
+         not_full_.notify_one();
+         return true;
+      };
+
+      void close() {
+         std::lock_guard<std::mutex> guard(lock_);
+         closed_ = true;
+         not_full_.notify_all();
+         not_empty_.notify_all();
+      };
+   };
+}
+
+#endif
@@ -48,6 +48,9 @@ using std::unordered_set;
 /* -------------------------------------------------------------------------- */
 extern fstream LOG_FILE;
 extern bool GLOBAL_DEBUG;
+/* per-thread buffer that its owner merges into LOG_FILE, or nullptr */
+extern thread_local std::ostream* LOG_STREAM;
+#define LOG_OUT (LOG_STREAM != nullptr? *LOG_STREAM: (std::ostream&)LOG_FILE)
 
 
 #define LOG_START(fpath) {      \
@@ -61,35 +64,35 @@ extern bool GLOBAL_DEBUG;
 
 
 #if DLEVEL >= 1
-   #define LOG1(s) {if (GLOBAL_DEBUG) LOG_FILE << s << "\n";}
+   #define LOG1(s) {if (GLOBAL_DEBUG) LOG_OUT << s << "\n";}
 #else
    #define LOG1(s) {}
 #endif
 
 
 #if DLEVEL >= 2
-   #define LOG2(s) {if (GLOBAL_DEBUG) LOG_FILE << s << "\n";}
+   #define LOG2(s) {if (GLOBAL_DEBUG) LOG_OUT << s << "\n";}
 #else
    #define LOG2(s) {}
 #endif
 
 
 #if DLEVEL >= 3
-   #define LOG3(s) {if (GLOBAL_DEBUG) LOG_FILE << s << "\n";}
+   #define LOG3(s) {if (GLOBAL_DEBUG) LOG_OUT << s << "\n";}
 #else
    #define LOG3(s) {}
 #endif
 
 
 #if DLEVEL >= 4
-   #define LOG4(s) {if (GLOBAL_DEBUG) LOG_FILE << s << "\n";}
+   #define LOG4(s) {if (GLOBAL_DEBUG) LOG_OUT << s << "\n";}
 #else
    #define LOG4(s) {}
 #endif
 
 
 #if DLEVEL >= 5
-   #define LOG5(s) {if (GLOBAL_DEBUG) LOG_FILE << s << "\n";}
+   #define LOG5(s) {if (GLOBAL_DEBUG) LOG_OUT << s << "\n";}
 #else
    #define LOG5(s) {}
 #endif
@@ -153,7 +156,6 @@ namespace SBA {
    extern UnitId get_id(REGION r, IMM i);
    extern UnitId get_id(SYSTEM::Reg r);
    extern UnitId get_id(IMM sym);
-   template class Array<IMM,Block*,LIMIT_VISITED>;
    template class Array<uint8_t,IMM,LIMIT_REFRESH>;
    template class Array<uint8_t,pair<IMM,COMPARE>,2>;
 
@@ -163,7 +165,11 @@ namespace SBA {
       static double to_double(const string& s);
       static COMPARE opposite(COMPARE cmp);
       static int64_t cast_int(uint64_t val, uint8_t bytes, bool signedness = true);
-      static Array<IMM,Block*,LIMIT_VISITED> Visited;
+      static int workers(int n);
+      static void parallel_for(size_t n, int workers, const
+                               function<void(size_t,size_t)>& f,
+                               size_t grain = 0);
+      static thread_local vector<Block*> Visited;
    };
 }
 
@@ -46,8 +46,19 @@
 #define ENABLE_DETECT_UNINIT              true
 #define ENABLE_SUPPORT_CONSTRAINT         true
 #define ENABLE_DETECT_UPDATED_FUNCTION    true
+#define ENABLE_FAST_AUTOMATON             true  /* d_base/<auto>.fast   */
+#define ENABLE_STREAMING_LIFT             true  /* no asm/rtl/raw files */
+#define STREAM_BATCH_SIZE                 1024  /* insns per queue item */
+#define STREAM_QUEUE_SIZE                 16    /* batches per queue    */
+#define ENABLE_LIFT_CACHE                 true  /* needs streaming lift */
+#define ENABLE_LIFT_TEMPLATE              true  /* needs streaming lift */
+#define LIFT_WORKERS                      0     /* 0: one per core      */
+#define LOAD_WORKERS                      0     /* 0: one per core      */
+#define ANALYSIS_WORKERS                  0     /* 0: one per core      */
+#define ENABLE_SHARED_EXPR                true  /* hash-consed Expr     */
+#define ENABLE_RTL_IMAGE                  true  /* d_base/rtl-<key>.img */
+#define ENABLE_BYTECODE_EVAL              true  /* flat Expr evaluation */
 #define LIMIT_JTABLE                      5000
-#define LIMIT_VISITED                     100000
 #define LIMIT_REFRESH                     100
 #define ABORT_UNLIFTED_INSN               false
 #define ABORT_MISSING_FUNCTION_ENTRY      false
@@ -78,14 +89,14 @@
          if (bin != nullptr) {                                          \
             cstr.assign(dest_id, src_id);                               \
             if (bin->op() == Binary::OP::AND) {                         \
-               auto c0 = bin->operand_const(0);                         \
-               auto c1 = bin->operand_const(1);                         \
+               auto c0 = bin->operand_const(state, 0);                  \
+               auto c1 = bin->operand_const(state, 1);                  \
                cstr.intersect(DOMAIN_BOUNDS(dest_id,                    \
                         Range(0, c1 != _oo && c1 > 0? c1:               \
                                 (c0 != _oo && c0 > 0? c0: oo))));       \
             }                                                           \
             else if (bin->op() == Binary::OP::LSHIFTRT) {               \
-               auto c1 = bin->operand_const(1);                         \
+               auto c1 = bin->operand_const(state, 1);                  \
                if (c1 != _oo) {                                         \
                   IMM x = (8*(IMM)(source->mode_size()) - c1);          \
                   x = ((IMM)1 << x) - 1;                                \
@@ -0,0 +1,39 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef DECODER_H
+#define DECODER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace SBA {
+   /* ------------------------------- Decoder ------------------------------- */
+   /* In-process x86-64 decoder. The text is what the lifter used to receive  */
+   /* from "objdump -M intel" after the clean-up that followed it:            */
+   /*   - branch targets are decimal, "*1" and "+0x0" are dropped            */
+   /*   - bnd/lock/data16/addr32/rep* prefixes are dropped (except for       */
+   /*     "rep stos" and "repz cmps")                                         */
+   /*   - int1/int3 become "hlt"                                              */
+   /*   - unused REX/segment prefixes, riz, far pointers and invalid          */
+   /*     encodings become "nop"                                              */
+   /* AVX-512, opmask, FMA4 and XOP instructions are not lifted but keep the  */
+   /* text objdump prints for them. The text is checked against objdump 2.40  */
+   /* on the sample binaries, ld.so, every one-byte, 0f and VEX opcode with   */
+   /* a few ModRMs and prefixes, and a set of EVEX/XOP encodings; other       */
+   /* encodings of the 0f38/0f3a, EVEX and XOP maps may still print apart.    */
+   class Decoder {
+    public:
+      /* decode one instruction of at most size bytes located at addr */
+      /* returns its length (>= 1 if size > 0) and fills in itc        */
+      static uint8_t decode(const uint8_t* code, size_t size, uint64_t addr,
+                            std::string& itc);
+   };
+}
+
+#endif
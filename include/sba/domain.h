@@ -237,6 +237,10 @@ namespace SBA {
       };
       ~BaseStride();
 
+      /* values escape the analysis, recycled through a per-thread list */
+      static void* operator new(size_t size);
+      static void operator delete(void* p);
+
       /* accessor */
       IMM base() const {return b;};
       int8_t stride() const {return s;};
@@ -134,6 +134,9 @@ namespace SBA {
               (error == 0x4? "uninit critical data": ""))));                   \
       }
    /* ---------------------------- EXECUTE & EVAL --------------------------- */
+   /* EVAL_MEMORY, EVAL_BINARY, EVAL_UNARY, EVAL_SUBREG, EVAL_IFELSE and     */
+   /* EVAL_CONVERSION receive their operands already evaluated: aval_addr, */
+   /* res (first operand) and op2 (second operand), see Bytecode            */
    #define EXECUTE_CALL(state)                                                 \
            if (state.config.enable_callee_effect) {                            \
                for (auto r: SYSTEM::return_value){                             \
@@ -177,7 +180,7 @@ namespace SBA {
            }                                                                   \
            /* handle indirect calls */                                         \
            if (state.loc.insn->indirect_target() != nullptr) {                 \
-              auto aval_t = target()->addr()->eval(state);                     \
+              auto aval_t = state.loc.insn->eval(state, target()->addr());     \
               state.loc.func->target_expr[state.loc.insn->offset()]            \
                               = ABSVAL(BaseStride,aval_t).clone();             \
            }                                                                   \
@@ -312,7 +315,6 @@ namespace SBA {
            return res;
    #define EVAL_MEMORY(state)                                                  \
            AbsVal res(AbsVal::T::TOP);                                         \
-           auto aval_addr = addr()->eval(state);                               \
            auto size = mode_size();                                            \
            CHECK_UNINIT(state, aval_addr, size, 0x1);                          \
            IF_MEMORY_ADDR(aval_addr, r, range, {                               \
@@ -349,16 +351,16 @@ namespace SBA {
            }                                                                   \
            return res;
    #define EVAL_BINARY(state)                                                  \
-           auto res = operand(0)->eval(state);                                 \
-           auto op2 = operand(1)->eval(state);                                 \
            LOG4("op1 = " << res.to_string());                                  \
            LOG4("op2 = " << op2.to_string());                                  \
-           UPDATE_CONST_EXPR(operand_const_[0],                                \
+           UPDATE_CONST_EXPR(                                                  \
+                        state.loc.insn->expr_cache(this).operand_const[0],     \
                         (ABSVAL(BaseLH,res).concrete()                         \
                       && ABSVAL(BaseLH,res).base() == 0                        \
                       && ABSVAL(BaseLH,res).range().cst())?                    \
                          ABSVAL(BaseLH,res).range().lo(): _oo);                \
-           UPDATE_CONST_EXPR(operand_const_[1],                                \
+           UPDATE_CONST_EXPR(                                                  \
+                        state.loc.insn->expr_cache(this).operand_const[1],     \
                         (ABSVAL(BaseLH,op2).concrete()                         \
                       && ABSVAL(BaseLH,op2).base() == 0                        \
                       && ABSVAL(BaseLH,op2).range().cst())?                    \
@@ -423,7 +425,6 @@ namespace SBA {
            res.mode(mode_size());                                              \
            return res;
    #define EVAL_UNARY(state)                                                   \
-           auto res = operand_->eval(state);                                   \
            switch (op_) {                                                      \
               case OP::NEG: {                                                  \
                  res.neg();                                                    \
@@ -431,7 +432,6 @@ namespace SBA {
                  break;                                                        \
               }                                                                \
               case OP::ABS: {                                                  \
-                 res = operand_->eval(state);                                  \
                  res.abs();                                                    \
                  res.mode(mode_size());                                        \
                  break;                                                        \
@@ -62,7 +62,7 @@ namespace SBA {
                                   8, 16, 16, 16,  8,  8,
                                  32, 16, 16, 16,  8, 32, 32,
                                  32, 16, 32, 0};
-      static inline const string MODE_STR[43] = {
+      static constexpr std::array<std::string_view,43> MODE_STR = {
             ":QI", ":HI", ":SI", ":DI", ":TI", ":SF", ":DF", ":XF", ":TF",
             ":FSQI", ":FSHI", ":FSSI", ":FSDI",
             ":BLK", ":BLKQI", ":BLKHI", ":BLKSI", ":BLKDI",
@@ -74,12 +74,7 @@ namespace SBA {
     private:
       EXPR_TYPE typeExpr_;
       EXPR_MODE modeExpr_;
-
-    protected:
-      #if ENABLE_SUPPORT_CONSTRAINT == true
-         AbsId expr_id_;
-         bool run_expr_id_ = true;
-      #endif
+      bool shared_ = false;
 
     public:
       Expr(EXPR_TYPE type, EXPR_MODE mode): RTL(RTL_TYPE::EXPR),
@@ -97,23 +92,32 @@ namespace SBA {
       EXPR_TYPE expr_type() const {return typeExpr_;};
       EXPR_MODE expr_mode() const {return modeExpr_;};
       uint8_t mode_size() const {return Expr::MODE_SZ[(int)modeExpr_];};
-      string mode_string() const {return Expr::MODE_STR[(int)modeExpr_];}
+      string mode_string() const {return string(Expr::MODE_STR[(int)modeExpr_]);}
       virtual Expr* simplify() const {return (Expr*)this;};
 
       /* analysis */
       virtual AbsVal eval(State& s) = 0;
       void execute(State& s) override {};
       #if ENABLE_SUPPORT_CONSTRAINT == true
-         virtual const AbsId& expr_id(const State& s) {return expr_id_;};
+         virtual const AbsId& expr_id(const State& s);
       #endif
 
       /* helper */
       virtual Expr* clone() = 0;
+
+      /* hash-consing: an interned node may be shared by many instructions, */
+      /* it is owned by the pool, so children are dropped with release()    */
+      bool shared() const {return shared_;};
+      static Expr* intern(Expr* e);
+      static void release(Expr* e) {if (e != nullptr && !e->shared_) delete e;};
       RTL* find_container(RTL* subExpr, const function<bool(const RTL*)>&
                           select) const override {
                              return select(this) && contains(subExpr)?
                                     (RTL*)this: nullptr;
                           };
+
+    protected:
+      bool identical(RTL_EQUAL eq, RTL* v, bool& res) const;
    };
    /* ------------------------------- Const --------------------------------- */
    class Const: public Expr {
@@ -128,6 +132,9 @@ namespace SBA {
       Const(IMM i): Expr(EXPR_TYPE::CONSTANT, EXPR_MODE::NONE),
                     typeConst_(CONST_TYPE::INTEGER), i_(i) {};
       Const(CONST_TYPE typeConst, Expr* expr);
+      Const(CONST_TYPE typeConst, IMM i): Expr(EXPR_TYPE::CONSTANT,
+                                      EXPR_MODE::NONE),
+                                      typeConst_(typeConst), i_(i) {};
 
       /* accessor */
       IMM to_int() const {return i_;};
@@ -175,6 +182,7 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal aval_addr);
       #if ENABLE_SUPPORT_CONSTRAINT == true
          const AbsId& expr_id(const State& s);
       #endif
@@ -233,6 +241,7 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal res);
 
       /* helper */
       bool equal(RTL_EQUAL eq, RTL* v) const override;
@@ -261,6 +270,7 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal res, AbsVal op2);
 
       /* helper */
       bool equal(RTL_EQUAL eq, RTL* v) const override;
@@ -306,6 +316,7 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal res);
       #if ENABLE_SUPPORT_CONSTRAINT == true
          const AbsId& expr_id(const State& s);
       #endif
@@ -380,6 +391,7 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal res);
 
       /* helper */
       Expr* clone() override;
@@ -399,11 +411,6 @@ namespace SBA {
     private:
       OP op_;
       array<Expr*,2> operands_;
-      #if ENABLE_SUPPORT_CONSTRAINT == true
-         AbsPair expr_pair_;
-         bool run_expr_pair_ = true;
-         array<IMM,2> operand_const_ = {_oo,_oo};
-      #endif
 
     public:
       Binary(OP type, EXPR_MODE mode, Expr* a, Expr* b):
@@ -420,10 +427,11 @@ namespace SBA {
 
       /* analysis */
       AbsVal eval(State& s) override;
+      AbsVal eval(State& s, AbsVal res, AbsVal op2);
       #if ENABLE_SUPPORT_CONSTRAINT == true
          const AbsId& expr_id(const State& s);
          const AbsPair& expr_pair(const State& s);
-         IMM operand_const(uint8_t idx) const {return operand_const_[idx];};
+         IMM operand_const(const State& s, uint8_t idx) const;
       #endif
 
       /* helper */
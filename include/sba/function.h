@@ -45,11 +45,13 @@ namespace SBA {
       Block* pseudo_entry_;
       Block* pseudo_exit_;
       vector<SCC*> s_list_;
+      vector<Insn*> icf_sites_;
       State s_;
 
     public:
       Function(Program* p, Block* e): container(p), faulty(false), entry_(e),
-                                      pseudo_entry_(nullptr) {build_cfg();};
+                                      pseudo_entry_(nullptr),
+                                      pseudo_exit_(nullptr) {build_cfg();};
       ~Function();
 
       /* accessor */
@@ -58,9 +60,11 @@ namespace SBA {
       Block* pseudo_entry() const {return pseudo_entry_;};
       Block* pseudo_exit() const {return pseudo_exit_;};
       const vector<SCC*>& scc_list() const {return s_list_;};
+      const vector<Insn*>& icf_sites() const {return icf_sites_;};
 
       /* analysis */
       void analyze(const State::StateConfig& conf,Program* p);
+      void clear();
       vector<AbsVal> track(TRACK trackType, const UnitId& id, const Loc& loc,
                            const vector<Insn*>& insns);
       void resolve_icf();
@@ -81,7 +85,7 @@ namespace SBA {
  
     private:
       /* cfg */
-      void tarjan(Block* u, IMM& cnt, stack<Block*>& st);
+      void tarjan(Block* root);
       void rev_postorder(Block* header);
       void build_cfg();
    };
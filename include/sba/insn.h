@@ -9,6 +9,8 @@
 #define INSN_H
 
 #include "state.h"
+#include "arena.h"
+#include "bytecode.h"
 #include "common.h"
 
 namespace SBA {
@@ -37,12 +39,39 @@ namespace SBA {
          pair<IMM,IMM> directTargets_;
          pair<COMPARE,COMPARE> cond_op_;
          Expr* cond_expr_;
+         static void* operator new(size_t size) {return Arena::alloc(size);};
+         static void operator delete(void* p) {Arena::free(p);};
       };
       TransferInfo* transfer_;
+      /* (plus (reg ip) X): X of the first pc-relative sum, or nullptr */
+      Expr* pc_rel_;
+
+    #if ENABLE_SUPPORT_CONSTRAINT == true
+    public:
+      /* per-insn results of Expr::expr_id(), kept out of the expressions */
+      /* since interned subtrees are shared by many instructions          */
+      struct ExprCache {
+         const Expr* expr = nullptr;
+         bool run_expr_id = true;
+         bool run_expr_pair = true;
+         AbsId expr_id;
+         AbsPair expr_pair;
+         array<IMM,2> operand_const = {_oo,_oo};
+      };
+
+    private:
+      std::deque<ExprCache> expr_cache_;
+    #endif
+
+    #if ENABLE_BYTECODE_EVAL == true
+      Bytecode bytecode_;
+    #endif
 
     public:
       Insn(IMM offset, RTL* rtl, const vector<uint8_t>& raw_bytes);
       ~Insn();
+      static void* operator new(size_t size) {return Arena::alloc(size);};
+      static void operator delete(void* p) {Arena::free(p);};
 
       /* accessors */
       void replace(RTL* rtl, const vector<uint8_t>& raw_bytes);
@@ -50,6 +79,7 @@ namespace SBA {
       IMM offset() const {return offset_;};
       IMM next_offset() const {return offset_ + raw_bytes_.size();};
       Statement* stmt() const {return stmt_;};
+      Expr* pc_rel() const {return pc_rel_;};
       const vector<uint8_t>& raw_bytes() const {return raw_bytes_;};
       Expr* indirect_target() const {return transfer_->indirectTarget_;};
       pair<IMM,IMM> direct_target() const {return transfer_->directTargets_;};
@@ -87,6 +117,11 @@ namespace SBA {
 
       /* analysis */
       void execute(State& s) const;
+      AbsVal eval(State& s, Expr* e);
+      Expr* simplify(Expr* e);
+      #if ENABLE_SUPPORT_CONSTRAINT == true
+         ExprCache& expr_cache(const Expr* e);
+      #endif
 
     private:
       void refresh();
@@ -0,0 +1,58 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef LIFT_CACHE_H
+#define LIFT_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SBA {
+   /* ------------------------------ LiftCache ------------------------------ */
+   /* Persistent asm -> RTL cache, one file per automaton version. The file   */
+   /* is an append-only log of checksummed (itc, rtl) records: lookups go     */
+   /* through a read-only mapping of the records present at open(), new      */
+   /* translations are appended by flush() under an exclusive flock, so the  */
+   /* file can be shared by concurrent analysis processes. A torn record left */
+   /* by a crashed writer ends the scan and is cut off by the next flush().   */
+   class LiftCache {
+    private:
+      int fd_ = -1;
+      const uint8_t* data_ = nullptr;
+      size_t size_ = 0;
+      size_t valid_end_ = 0;
+      std::unordered_map<std::string_view,std::string_view> index_;
+      std::deque<std::string> owned_;
+      std::vector<std::pair<std::string_view,std::string_view>> pending_;
+      std::string key_;
+
+    public:
+      LiftCache() = default;
+      LiftCache(const LiftCache&) = delete;
+      LiftCache& operator=(const LiftCache&) = delete;
+      ~LiftCache();
+
+      bool open(const std::string& file, uint64_t version);
+      void close();
+      bool find(const std::string& itc, std::string& rtl);
+      void insert(const std::string& itc, const std::string& rtl);
+      void flush();
+
+      /* automaton version: hash of the automaton file, 0 if unreadable */
+      static uint64_t version(const std::string& f_auto);
+
+    private:
+      const std::string& normalize(const std::string& itc);
+   };
+}
+
+#endif
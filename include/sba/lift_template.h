@@ -0,0 +1,70 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef LIFT_TEMPLATE_H
+#define LIFT_TEMPLATE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SBA {
+   /* ---------------------------- TemplateLifter --------------------------- */
+   /* Lifts instructions that only differ in immediates/displacements once.  */
+   /* Every numeric literal of the asm text becomes a hole, keyed by its     */
+   /* width and sign so that the automaton sees the same kind of value. The  */
+   /* RTL of a concrete instance is turned into a template by mapping its    */
+   /* integers back to the holes (as is, negated or sign-extended); the      */
+   /* template is trusted only after it reproduces the concrete RTL of the   */
+   /* next VALIDATIONS instances, otherwise all instances are lifted as is.  */
+   /* An instance only counts as a validation if each of its holes has a     */
+   /* value that no earlier instance of the template had in that hole, so a  */
+   /* literal of the RTL that just equals an operand cannot pass as a hole.  */
+   /* find() instantiates a trusted template, the concrete RTL of any other  */
+   /* instruction is handed back through learn().                            */
+   class TemplateLifter {
+    private:
+      static constexpr uint8_t VALIDATIONS = 2;
+      static constexpr uint8_t ATTEMPTS = 3;
+
+      enum class STATE: uint8_t {BUILD, VALIDATE, READY, BAD};
+      struct Piece {
+         std::string text;       /* emitted before the hole                */
+         int16_t hole = -1;      /* index into the operand values, or -1   */
+         uint8_t fn = 0;         /* 0: as is, 1: negated, 2: sign-extended */
+      };
+      struct Template {
+         STATE state = STATE::BUILD;
+         uint8_t count = 0;
+         std::vector<Piece> pieces;
+         std::vector<uint64_t> seen;   /* hole values of counted instances */
+      };
+
+      std::unordered_map<std::string,Template> templates_;
+      std::string key_;
+      std::vector<uint64_t> vals_;
+      std::vector<uint8_t> widths_;
+      uint64_t hits_ = 0;
+      uint64_t misses_ = 0;
+
+    public:
+      bool find(const std::string& itc, std::string& rtl);
+      void learn(const std::string& itc, const std::string& rtl);
+      uint64_t hits() const {return hits_;};
+      uint64_t misses() const {return misses_;};
+
+    private:
+      bool abstract(const std::string& itc);
+      bool build(Template& t, const std::string& rtl) const;
+      bool fresh(const Template& t) const;
+      std::string instantiate(const Template& t) const;
+   };
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef LIFTER_POOL_H
+#define LIFTER_POOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace SBA {
+   /* ------------------------------ LifterPool ----------------------------- */
+   /* Worker processes forked once the automaton is loaded, so each of them  */
+   /* owns a copy of the single-threaded OCaml runtime. A shard of asm lines */
+   /* is sent to a worker with send() and its RTL lines are collected with   */
+   /* receive(); both sides speak over a socketpair, one shard at a time.    */
+   class LifterPool {
+    public:
+      using Lift = std::function<std::string(const std::string&)>;
+
+    private:
+      struct Worker {
+         pid_t pid;
+         int fd;
+      };
+      std::vector<Worker> workers_;
+
+    public:
+      LifterPool() = default;
+      LifterPool(const LifterPool&) = delete;
+      LifterPool& operator=(const LifterPool&) = delete;
+      ~LifterPool();
+
+      /* fork up to n workers running lift, returns how many are running */
+      size_t start(size_t n, const Lift& lift);
+      void stop();
+      size_t size() const {return workers_.size();};
+
+      bool send(size_t w, const std::vector<const std::string*>& itcs);
+      bool receive(size_t w, std::vector<std::string>& rtls);
+   };
+}
+
+#endif
@@ -23,7 +23,6 @@
 
 
 #define DEFAULT_EVAL_SUBREG(state)                                             \
-   AbsVal res = expr_->eval(state);                                            \
    if (bytenum() == 0)                                                         \
       res.mode(mode_size());                                                   \
    else                                                                        \
@@ -32,73 +31,58 @@
 
 
 #define DEFAULT_EVAL_IFELSE(state)                                             \
-   AbsVal res = if_expr()->eval(state);                                        \
-   AbsVal else_val = else_expr()->eval(state);                                 \
-   res.abs_union(else_val);                                                    \
+   res.abs_union(op2);                                                         \
    return res;
 
 
 #define DEFAULT_EVAL_CONVERSION(state)                                         \
-   auto expr = simplify();                                                     \
-   AbsVal res = expr->eval(state);                                             \
    res.mode(mode_size());                                                      \
    return res;
 
 
 #define DEFAULT_EVAL_UNARY(state)                                              \
-   AbsVal res(AbsVal::T::TOP);                                                 \
    switch (op_) {                                                              \
       case OP::NEG: {                                                          \
-         res = operand_->eval(state);                                          \
          res.neg();                                                            \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       case OP::ABS: {                                                          \
-         res = operand_->eval(state);                                          \
          res.abs();                                                            \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       default:                                                                 \
+         res = AbsVal(AbsVal::T::TOP);                                         \
          break;                                                                \
    }                                                                           \
    return res;
 
 
 #define DEFAULT_EVAL_BINARY(state)                                             \
-   AbsVal res(AbsVal::T::TOP);                                                 \
    switch (op_) {                                                              \
       case OP::PLUS: {                                                         \
-         res = operand(0)->eval(state);                                        \
-         auto op2 = operand(1)->eval(state);                                   \
          res.add(op2);                                                         \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       case OP::MINUS: {                                                        \
-         res = operand(0)->eval(state);                                        \
-         auto op2 = operand(1)->eval(state);                                   \
          res.sub(op2);                                                         \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       case OP::MULT: {                                                         \
-         res = operand(0)->eval(state);                                        \
-         auto op2 = operand(1)->eval(state);                                   \
          res.mul(op2);                                                         \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       case OP::ASHIFT: {                                                       \
-         res = operand(0)->eval(state);                                        \
-         auto op2 = operand(1)->eval(state);                                   \
          res.lshift(op2);                                                      \
          res.mode(mode_size());                                                \
          break;                                                                \
       }                                                                        \
       default: {                                                               \
-         res.fill(AbsVal::T::TOP);                                             \
+         res = AbsVal(AbsVal::T::TOP);                                         \
          break;                                                                \
       }                                                                        \
    }                                                                           \
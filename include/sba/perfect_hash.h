@@ -0,0 +1,75 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+namespace SBA {
+   /* ----------------------------- PerfectHash ----------------------------- */
+   /* Collision-free table over a fixed set of names, built at compile time: */
+   /* the seed is searched until every key lands in a slot of its own, so a  */
+   /* lookup is one hash of the token and one compare, without building a   */
+   /* string. find() gives the index of the key in the array, or -1.         */
+   template<size_t N, size_t M = 8 * std::bit_ceil(N)>
+   class PerfectHash {
+      static_assert(N < 255 && std::has_single_bit(M));
+
+    private:
+      std::array<std::string_view,N> keys_;
+      std::array<uint8_t,M> slot_{};         /* index + 1, 0 if empty */
+      uint32_t seed_ = 0;
+
+      static constexpr uint32_t hash(std::string_view s, uint32_t seed) {
+         uint32_t h = 2166136261u ^ seed;
+         for (auto c: s) {
+            h ^= (uint8_t)c;
+            h *= 16777619u;
+         }
+         h ^= h >> 15;
+         h *= 0x2c1b3c6du;
+         h ^= h >> 12;
+         return h & (M - 1);
+      };
+
+      /* a repeated name resolves to its first index, as a linear scan */
+      constexpr bool duplicate(size_t i) const {
+         for (size_t j = 0; j < i; ++j)
+            if (keys_[j] == keys_[i])
+               return true;
+         return false;
+      };
+
+    public:
+      constexpr PerfectHash(const std::array<std::string_view,N>& keys):
+      keys_(keys) {
+         for (auto done = false; !done; ) {
+            ++seed_;
+            slot_ = {};
+            done = true;
+            for (size_t i = 0; i < N && done; ++i) {
+               if (duplicate(i))
+                  continue;
+               auto& x = slot_[hash(keys_[i], seed_)];
+               done = (x == 0);
+               x = i + 1;
+            }
+         }
+      };
+
+      constexpr int find(std::string_view s) const {
+         int i = slot_[hash(s, seed_)] - 1;
+         return (i >= 0 && keys_[i] == s)? i: -1;
+      };
+   };
+}
+
+#endif
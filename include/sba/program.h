@@ -9,7 +9,10 @@
 #define PROGRAM_H
 
 #include "system.h"
+#include "state.h"
 #include "common.h"
+#include "arena.h"
+#include "cfg.h"
 #include <utility>  // 引入 pair
 #include <elf.h>
 #include <gelf.h>
@@ -22,6 +25,7 @@
 #include <vector>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 
 namespace SBA {
    /* Forward declaration */
@@ -45,17 +49,22 @@ namespace SBA {
       unordered_map<IMM,IMM> vfunc;
 
 
+    private:
+      /* declared first to outlive the insns and blocks built on them */
+      Arena* arena_;
+      Arena blocks_;
+      CFG cfg_;
+
     private:
       unordered_set<IMM> fptrs_;
-      unordered_map<IMM,Insn*> i_map_;
-      unordered_map<IMM,Block*> b_map_;
-      unordered_map<IMM,Function*> f_map_;
       unordered_map<IMM,unordered_set<IMM>> icfs_;
 
     private:
       vector<IMM> recent_fptrs_;
       vector<IMM> recent_icfs_;
       unordered_set<IMM> recent_norets_;
+      /* fptrs whose CFG changed since the last analyze() */
+      unordered_set<IMM> worklist_;
       vector<tuple<Insn*,Insn*,COMPARE>> split_;
 
     private:
@@ -63,15 +72,25 @@ namespace SBA {
       SYSTEM::Object info_;
 
     private:
+      /* insns in load order, found by address through i_index_; b_head_ */
+      /* holds the block starting at each of them                        */
       vector<Insn*> sorted_insns_;
+      AddrIndex i_index_;
+      vector<Block*> b_head_;
       unordered_set<IMM> checked_fptrs_;
-      
+      /* functions built by func(), kept until a block of theirs changes */
+      /* or another function needs one: blocks hold the analysis state  */
+      /* of a single function at a time                                 */
+      unordered_map<IMM,Function*> f_cache_;
+      std::mutex vtables_lock_;
+
 
     public:
-      Program(const string& f_obj,
+      Program(const string& f_obj, SYSTEM::Object&& info,
               const vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw,
               const vector<IMM>& fptrs,
-              const unordered_map<IMM,unordered_set<IMM>>& indirect_targets);
+              const unordered_map<IMM,unordered_set<IMM>>& indirect_targets,
+              Arena* arena = nullptr);
       ~Program();
       void build_func(IMM entry, const unordered_map<IMM,unordered_set<IMM>>& icfs,
                       const vector<IMM>& norets);
@@ -81,11 +100,18 @@ namespace SBA {
       // Indirect Jump Location --> List of Targets
       const unordered_map<IMM,unordered_set<IMM>>& icfs() const {return icfs_;};
       void fptrs(const vector<IMM>& fptr_list);
+      CFG& cfg() {return cfg_;};
 
       /* cfg */
       Function* func(IMM fptr);
       bool updated(IMM fptr);
       void update();
+      const unordered_set<IMM>& worklist() const {return worklist_;};
+
+      /* analysis */
+      void analyze(const State::StateConfig& conf,
+                   const function<bool(Function*)>& select);
+      void vtable(IMM table);
 
       /* icf */
       #if ENABLE_RESOLVE_ICF
@@ -93,7 +119,7 @@ namespace SBA {
          unordered_map<IMM,unordered_set<IMM>> unbounded_icf_targets;
          unordered_map<IMM,unordered_set<IMM>> jtable_targets;
          void icf(IMM jump_loc, const unordered_set<IMM>& targets);
-         bool valid_icf(IMM target) const {return i_map_.contains(target);};
+         bool valid_icf(IMM target) const {return i_index_.contains(target);};
          void resolve_icf(unordered_map<IMM,unordered_set<IMM>>& bounded_targets,
                           unordered_map<IMM,unordered_set<IMM>>& unbounded_targets,
                           Function* func, BaseStride* expr,
@@ -117,15 +143,34 @@ namespace SBA {
       // vtable
       unordered_map<IMM,IMM> find_vtable_constructors() const ;
       std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> scan_vfunc(unordered_set<IMM> constructors, 
-         unordered_map<IMM, unordered_set<IMM>> v_tables,const string& file, IMM file_offset);
-      void resolve_vfunc(const string& f_obj);
-      std::pair<uint64_t, uint64_t> get_text_section_range(const std::string& filename) ;
+         unordered_map<IMM, unordered_set<IMM>> v_tables);
+      void resolve_vfunc();
+      std::pair<uint64_t, uint64_t> get_text_section_range() const;
 
     private:
+      /* lookup */
+      Insn* insn(IMM offset) const {
+         auto k = i_index_.find(offset);
+         return k < 0? nullptr: sorted_insns_[k];
+      };
+      Block* block(IMM offset) const {
+         auto k = i_index_.find(offset);
+         return k < 0? nullptr: b_head_[k];
+      };
+      void block(Block* b);
+
       /* cfg */
       void block_split(Insn* insn);
       void block_connect(Block* b, IMM target, COMPARE cond, bool fix_prefix=false);
+      Insn* block_target(Block* b, IMM target, COMPARE cond, bool fix_prefix=false);
       void block_dfs(Insn* insn);
+      void evict(Block* b);
+      vector<Block*> reach(IMM fptr);
+      vector<size_t> call_order(const vector<IMM>& fptr_list,
+                                const vector<vector<Block*>>& blocks);
+      bool claim(const vector<Block*>& blocks, uint32_t wave,
+                 vector<uint32_t>& owner);
+      void release(const vector<Block*>& blocks, vector<uint32_t>& owner);
       #if ENABLE_DETECT_UPDATED_FUNCTION
          void propagate_update(Block *b);
       #endif
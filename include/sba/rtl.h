@@ -9,6 +9,7 @@
 #define RTL_H
 
 #include "state.h"
+#include "arena.h"
 #include "common.h"
 
 namespace SBA {
@@ -107,6 +108,8 @@ namespace SBA {
     public:
       Statement(STATEMENT_TYPE type): RTL(RTL_TYPE::STATEMENT),typeStmt_(type){};
       virtual ~Statement() {};
+      static void* operator new(size_t size) {return Arena::alloc(size);};
+      static void operator delete(void* p) {Arena::free(p);};
       STATEMENT_TYPE stmt_type() const {return typeStmt_;};
       #if ENABLE_SUPPORT_CONSTRAINT == true
          virtual void assign_flags(const State& s) {};
@@ -0,0 +1,37 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef RTL_IMAGE_H
+#define RTL_IMAGE_H
+
+#include "common.h"
+
+namespace SBA {
+   class RTL;
+   class Arena;
+   /* ------------------------------ RTLImage ------------------------------- */
+   /* Parsed instruction stream of one binary saved as a compact image, so a */
+   /* later run on the same binary and automaton skips disassembly, lifting  */
+   /* and parsing: load() maps the file and rebuilds every RTL tree from its */
+   /* prefix encoding in the given arena. The key covers the content of the  */
+   /* binary, the automaton version, VERSION and the build options that      */
+   /* change what is lifted; a file with another key is ignored.             */
+   class RTLImage {
+    public:
+      /* bump on any change to the decoder, the parser or the image format */
+      static constexpr uint64_t VERSION = 1;
+
+      static uint64_t key(const string& f_obj, uint64_t version);
+      static bool save(const string& file, uint64_t key, const
+                       vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw);
+      static bool load(const string& file, uint64_t key,
+                       vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw,
+                       Arena* arena);
+   };
+}
+
+#endif
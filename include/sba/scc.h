@@ -15,6 +15,7 @@ namespace SBA {
    /* Forward declaration */
    class Block;
    class State;
+   class Function;
    /* ---------------------------------- SCC -------------------------------- */
   //  可以用来处理循环
    class SCC {
@@ -23,13 +24,15 @@ namespace SBA {
       vector<Block*> ext_target;
 
     private:
+      Function* f_;
       vector<Block*> b_list_;
 
     public:
-      SCC(): ext_target({}), b_list_({}) {};
+      SCC(Function* f): ext_target({}), f_(f), b_list_({}) {};
       ~SCC();
 
       /* accessor */
+      Function* func() const {return f_;};
       const vector<Block*>& block_list() const {return b_list_;};
 
       /* cfg */
@@ -40,7 +43,7 @@ namespace SBA {
       void execute(State& s) const;
 
     private:
-      void dfs(Block* u);
+      void dfs(Block* header);
    };
 
 }
@@ -0,0 +1,27 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "common.h"
+
+namespace SBA {
+   /* ------------------------------ Scheduler ------------------------------ */
+   /* Work stealing over a fixed list of tasks. Tasks are dealt in the given */
+   /* order to one deque per worker; a worker takes from the front of its   */
+   /* own deque, so earlier tasks start first, and once it is empty steals  */
+   /* from the back of the others. A long task then no longer holds up the  */
+   /* short ones dealt to the same worker.                                  */
+   class Scheduler {
+    public:
+      static void run(const vector<size_t>& tasks, int workers,
+                      const function<void(size_t)>& f);
+   };
+}
+
+#endif
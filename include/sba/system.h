@@ -15,33 +15,97 @@
 #include <unordered_map>
 #include <utility>
 #include <tuple>
+#include <string_view>
 #include <fstream>
 #include "config.h"
+#include "perfect_hash.h"
+#include "addr_index.h"
 #include <cstdint> 
 #include <map>
+#include <functional>
 namespace SBA {
 
    class Insn;
 
    struct ELF_x86 {
       /* -------------------------- Binary Content -------------------------- */
+      /* section, symbol and relocation tables of the ELF64 file, parsed */
+      /* once by load() and shared by every query below                  */
+      struct Section {
+         std::string name;
+         uint32_t type;
+         uint64_t flags;
+         uint64_t addr;
+         uint64_t offset;
+         uint64_t size;
+         uint64_t entsize;
+         uint32_t link;
+      };
+      struct Symbol {
+         std::string name;
+         uint64_t value;
+         uint64_t size;
+         uint8_t type;
+         uint8_t bind;
+         uint16_t shndx;
+      };
+      struct Relocation {
+         uint64_t offset;
+         uint32_t type;
+         uint32_t sym;
+         int64_t addend;
+      };
+      /* read-only mmap of the binary; pages are faulted in on demand and */
+      /* shared by every reader instead of being copied into a vector     */
+      class Image {
+       public:
+         Image() = default;
+         Image(const Image&) = delete;
+         Image& operator=(const Image&) = delete;
+         Image(Image&& other) noexcept;
+         Image& operator=(Image&& other) noexcept;
+         ~Image();
+
+         bool map(const std::string& file);
+         const uint8_t* data() const {return data_;};
+         size_t size() const {return size_;};
+         bool empty() const {return size_ == 0;};
+         const uint8_t& operator[](size_t i) const {return data_[i];};
+         const uint8_t* begin() const {return data_;};
+         const uint8_t* end() const {return data_ + size_;};
+
+       private:
+         const uint8_t* data_ = nullptr;
+         size_t size_ = 0;
+         void release();
+      };
       struct Object {
-         std::vector<uint8_t> raw_bytes;
+         Image raw_bytes;
          std::vector<std::pair<IMM,IMM>> code_segment;
          std::vector<std::tuple<uint64_t,uint64_t,uint64_t,uint64_t>> phdr;
-         std::unordered_map<IMM,Insn*>* insns;
+         /* page -> index of the last phdr starting at or before the page */
+         uint64_t page_base = 0;
+         std::vector<uint16_t> page_phdr;
+         std::vector<Section> sections;
+         std::vector<Symbol> dynsym;
+         std::vector<Symbol> symtab;
+         std::vector<Relocation> rela_dyn;
+         std::vector<Relocation> rela_plt;
+         const AddrIndex* insns = nullptr;
       };
-      static void load(Object& info, const std::string& f_obj);
+      static bool load(Object& info, const std::string& f_obj);
+      static const Section* section(const Object& info, const std::string& name);
       static uint64_t read(const Object& info, int64_t offset, uint8_t width);
       static bool code_ptr(const Object& info, IMM val);
       static std::unordered_set<IMM> stored_cptrs(const Object& info, uint8_t ptr_size);
-      static std::unordered_set<IMM> definite_fptrs(const Object& info, const std::string& f_obj);
-      static std::unordered_set<IMM> noreturn_fptrs(const std::string& f_obj);
-      static std::unordered_set<IMM> noreturn_calls(const std::string& f_obj);
-      static std::tuple<bool,IMM,std::unordered_map<IMM, std::unordered_set<IMM>>> vtables_by_rel(const std::string& file);
-      static void disassemble(const std::string& f_obj, const std::string& f_asm, const std::string& f_raw);
-      static std::vector<std::pair<IMM,IMM>> import_symbols(const std::string& file);
-      static std::vector<std::pair<IMM,IMM>> call_insns(const std::string& file);
+      static std::unordered_set<IMM> definite_fptrs(const Object& info);
+      static std::unordered_set<IMM> noreturn_fptrs(const Object& info);
+      static std::unordered_set<IMM> noreturn_calls(const Object& info);
+      static std::tuple<bool,IMM,std::unordered_map<IMM, std::unordered_set<IMM>>> vtables_by_rel(const Object& info);
+      static void disassemble(const Object& info, const std::string& f_asm, const std::string& f_raw);
+      static void disassemble(const Object& info, const std::function<void(uint64_t,const std::string&,const uint8_t*,uint8_t)>& emit);
+      static std::vector<std::pair<IMM,IMM>> import_symbols(const Object& info);
+      static std::vector<std::pair<IMM,IMM>> call_insns(const Object& info);
       static uint8_t prolog(const std::vector<uint8_t>& raw_insn);
       /*不会返回调用点的指令声明
       1. 标准 C/C++ 库中的终止函数
@@ -118,7 +182,7 @@ namespace SBA {
          XMM24, XMM25, XMM26, XMM27, XMM28, XMM29, XMM30, XMM31,
          ST, ST1, ST2, ST3, ST4, ST5, ST6, ST7
       };
-      static inline const std::string REG_STR[NUM_REG] = {
+      static constexpr std::array<std::string_view,NUM_REG> REG_STR = {
          "",
          "ax", "bx", "cx", "dx", "sp", "bp", "si", "di",
          "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
@@ -149,19 +213,15 @@ namespace SBA {
          Reg::AX //, Reg::DX, Reg::XMM0, Reg::XMM1, Reg::ST, Reg::ST1
       };
 
-      static Reg to_reg(const std::string& reg) {
-         for (int i = 0; i < NUM_REG; ++i)
-            if (!reg.compare(ELF_x86::REG_STR[i]))
-               return (Reg)i;
-         return Reg::UNKNOWN;
+      static Reg to_reg(std::string_view reg) {
+         static constexpr PerfectHash table(REG_STR);
+         auto i = table.find(reg);
+         return i < 0? Reg::UNKNOWN: (Reg)i;
       };
-      static std::string to_string(Reg reg) {return ELF_x86::REG_STR[(int)reg];};
-      static Reg from_string(const std::string& reg) {
-         for (int i = 0; i < NUM_REG; ++i)
-            if (!reg.compare(ELF_x86::REG_STR[i]))
-               return (Reg)i;
-         return Reg::UNKNOWN;
+      static std::string to_string(Reg reg) {
+         return std::string(ELF_x86::REG_STR[(int)reg]);
       };
+      static Reg from_string(std::string_view reg) {return to_reg(reg);};
       /* -------------------------------------------------------------------- */
    };
 }
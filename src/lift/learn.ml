@@ -1913,6 +1913,54 @@ let load_automata (inf: in_channel): unit =
     close_in inf
   end
         
+(* The compact format starts with fastAutoMagic and the OCaml version (the
+   Marshal format is only guaranteed within one version), followed by a single
+   marshalled pair holding the used slots of s and e with their indices.
+   Unused slots are the ones save_automata does not count. *)
+let fastAutoMagic = "SBAAUTO1"
+
+let save_automata_fast (outf: out_channel): unit =
+  let used_states = ref [] in
+  let used_edges = ref [] in
+  let _ = Array.iteri (fun i x -> match x with
+                         | NWAYST(0, [], []) -> ()
+                         | _ -> used_states := (i, x) :: !used_states) s in
+  let _ = Array.iteri (fun i x -> match x with
+                         | TERM(0, []) -> ()
+                         | _ -> used_edges := (i, x) :: !used_edges) e in
+  let states = Array.of_list (List.rev !used_states) in
+  let edges = Array.of_list (List.rev !used_edges) in
+  begin
+    output_string outf fastAutoMagic;
+    output_string outf (Sys.ocaml_version ^ "\n");
+    Marshal.to_channel outf (states, edges) [];
+    (errmsg ("Number of states in automata:"^string_of_int (Array.length states)));
+    (errmsg ("Number of edges in automata:"^string_of_int (Array.length edges)));
+    close_out outf
+  end
+
+let load_automata_fast (inf: in_channel): unit =
+  let (states, edges) : (int * state) array * (int * edge) array =
+    Marshal.from_channel inf in
+  begin
+    Array.fill s 0 maxAutoSize (NWAYST(0, [], []));
+    Array.fill e 0 maxAutoSize (TERM(0, []));
+    Array.iter (fun (i, x) -> Array.set s i x) states;
+    Array.iter (fun (i, x) -> Array.set e i x) edges;
+    close_in inf
+  end
+
+let load_automata_file (file: string): unit =
+  let inf = open_in_bin file in
+  let magic = try really_input_string inf (String.length fastAutoMagic)
+              with End_of_file -> "" in
+  if magic <> fastAutoMagic then
+    (seek_in inf 0; load_automata inf)
+  else if input_line inf <> Sys.ocaml_version then
+    (close_in inf; failwith ("Automaton " ^ file ^ " needs OCaml " ^ 
+                             "version " ^ Sys.ocaml_version))
+  else load_automata_fast inf
+
 (*****************************************************************************
            Print automata as dot file so that it can be viewed as a graph
  *****************************************************************************)
@@ -96,6 +96,11 @@ val dot_of_auto: out_channel -> stateId  -> unit
 val save_automata: out_channel -> unit
 val load_automata: in_channel -> unit
 
+(* Compact format: only the used slots, in a single marshalled value behind a
+   versioned header. load_automata_file accepts either format. *)
+val save_automata_fast: out_channel -> unit
+val load_automata_file: string -> unit
+
 (* Use automaton to translate a term. Returns a success result and errcode *)
 val translate: term -> term 
 
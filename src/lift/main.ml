@@ -445,10 +445,10 @@ let rec liftAsm (asml:(string*string*term) list) partSize oc lblerr: unit =
  transducer in a file, or output a picture of it in a dot file. (The dot file is
  typically readable when the transducer isn't larger than a few hundred nodes.)
  ******************************************************************************)
-let procXducer inXducerFile outXducerFile asmRtlPairs dotFile =
+let procXducer inXducerFile outXducerFile outFastFile asmRtlPairs dotFile =
   let transducer = 
     if inXducerFile <> "" then
-      begin (Learn.load_automata (open_in_bin inXducerFile)); 1 end
+      begin (Learn.load_automata_file inXducerFile); 1 end
     else if asmRtlPairs <> [] 
        then Learn.mkducer (procRules asmRtlPairs)
     else begin (errmsg "Invalid options"); raise Exit end
@@ -458,6 +458,8 @@ let procXducer inXducerFile outXducerFile asmRtlPairs dotFile =
   else ();
   if outXducerFile <> "" 
      then (Learn.save_automata (open_out_bin outXducerFile)) else ();
+  if outFastFile <> "" 
+     then (Learn.save_automata_fast (open_out_bin outFastFile)) else ();
 ;;
 
 (*******************************************************************************
@@ -512,12 +514,13 @@ let doSelfTest asmRtlPairs checkTx: unit =
  ******************************************************************************)
 
 let testXducer trainFile trainFile2 inXducerFile dotFile outXducerFile 
-    asmFiles outFile =
+    outFastFile asmFiles outFile =
   let asmRtlPairs = 
     if trainFile <> "" 
       then readallpairs trainFile trainFile2 
     else [] in
-  let _ = procXducer inXducerFile outXducerFile asmRtlPairs dotFile in
+  let _ = procXducer inXducerFile outXducerFile outFastFile asmRtlPairs 
+            dotFile in
   let checkTx (intr, outtr) : unit = 
     (* utility function to test transducer *)
     try
@@ -558,17 +561,33 @@ let testXducer trainFile trainFile2 inXducerFile dotFile outXducerFile
 (******************************************************************************
                                   C Interface
 ******************************************************************************)
-let c_load_automaton (file_auto:string) =
-  Learn.load_automata (open_in_bin file_auto)
+let c_load_automaton (file_auto:string) : bool =
+  try (Learn.load_automata_file file_auto; true) with _ -> false
+;;
+
+let c_save_automaton_fast (file_auto:string) : bool =
+  try (Learn.save_automata_fast (open_out_bin file_auto); true) with _ -> false
 ;;
 
 let c_lift_asm (file_asm:string) (file_rtl:string) =
   doLiftAsm [file_asm] file_rtl
 ;;
 
+(* Lifts one instruction (archMaxPartSize is 1, so this is what liftAsm does
+   for every line of an asm file). Returns "" if it cannot be lifted. *)
+let c_lift_one (ins:string) : string =
+  try
+    let rtl = Learn.translate (parseasm ins I64.zero) in
+    rpass := !rpass + 1;
+    string_of_term rtl
+  with _ -> (rfail := !rfail + 1; "")
+;;
+
 let () =
   Callback.register "Load callback" c_load_automaton;
+  Callback.register "Save fast callback" c_save_automaton_fast;
   Callback.register "Lift callback" c_lift_asm;
+  Callback.register "Lift one callback" c_lift_one;
 ;;
 
 (****************************************************************************** 
@@ -580,7 +599,7 @@ let parseargs argv =
     let usage = 
       "Usage: " ^ argv.(0) ^ " [-d [<level>]] " ^
         "[-tr <train_file> [-m <train_file2>] | -al <automata_file>] " ^
-        "[-dotf <dot_file>] [-as <automata_file>] " ^ 
+        "[-dotf <dot_file>] [-as <automata_file>] [-asf <automata_file>] " ^ 
         "[-e <asm_file>] [-l <asm_file> | -r <rtl_file> -o <out_file>]\n" ^
         "\t-d: set logging level\n" ^
         "\t-p: permit branches based on parameter values\n" ^
@@ -589,6 +608,7 @@ let parseargs argv =
         "\t-al: load automaton from file\n" ^
         "\t-dotf: print in-memory automaton in graphviz-compatible format\n" ^ 
         "\t-as: store in-memory automata to file\n" ^
+        "\t-asf: store in-memory automata to file in the compact format\n" ^
         "\t-e: run exact recall on asm_file\n" ^
         "\t-l: lift instructions in asm_file to rtl, print to out_file\n" ^
         "\t-r: parse rtl_file and print resulting terms to out_file\n" ^
@@ -629,6 +649,7 @@ let parseargs argv =
       let inXducerFile = getVal (getIdx "-al") in
       let dotFile   = getVal (getIdx "-dotf") in
       let outXducerFile    = getVal (getIdx "-as") in
+      let outFastFile      = getVal (getIdx "-asf") in
       let itfMode = getVal (getIdx "-c") in
       let exactRecall = getIdx "-e"  in
       let lift = getIdx "-l" in
@@ -642,7 +663,7 @@ let parseargs argv =
                  ^ usage);
          raise Exit)
       else (trainFile, trainFile2, inXducerFile, dotFile, outXducerFile, 
-            exactRecall, lift, asmFiles, rtlFile, outFile, itfMode)
+            outFastFile, exactRecall, lift, asmFiles, rtlFile, outFile, itfMode)
   in parseargs1 argv
 ;;
 
@@ -651,14 +672,15 @@ let parseargs argv =
  *******************************************************************************)
 let main argv = 
   let (trainFile, trainFile2, inXducerFile, dotFile, outXducerFile, 
-       exactRecall, lift, asmFiles, rtlFile, outFile, itfMode) = parseargs argv in
+       outFastFile, exactRecall, lift, asmFiles, rtlFile, outFile, itfMode) =
+    parseargs argv in
   if itfMode = "off" || itfMode = "" then
     if rtlFile <> ""
       then readAndPrintRtl rtlFile outFile
     else if exactRecall > 0 then 
       testExactRecall trainFile trainFile2 (List.hd asmFiles)
     else (testXducer trainFile trainFile2 inXducerFile dotFile outXducerFile 
-              asmFiles outFile)
+              outFastFile asmFiles outFile)
 ;;
 
 let _ = main Sys.argv
@@ -0,0 +1,36 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/addr_index.h"
+
+using std::vector;
+using namespace SBA;
+
+/* a gap wider than this starts a new run instead of empty slots */
+static constexpr IMM RUN_GAP = 4096;
+// -------------------------------- AddrIndex ----------------------------------
+void AddrIndex::build(const vector<IMM>& addrs) {
+   runs_.clear();
+   vector<IMM> sorted(addrs);
+   std::sort(sorted.begin(), sorted.end());
+   sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+   size_ = sorted.size();
+
+   for (size_t i = 0; i < sorted.size(); ) {
+      auto j = i + 1;
+      while (j < sorted.size() && sorted[j] - sorted[j-1] <= RUN_GAP)
+         ++j;
+      runs_.push_back({sorted[i], vector<uint32_t>(sorted[j-1]-sorted[i]+1)});
+      i = j;
+   }
+
+   for (size_t k = 0; k < addrs.size(); ++k) {
+      auto it = std::upper_bound(runs_.begin(), runs_.end(), addrs[k],
+                [](IMM a, const Run& r) {return a < r.base;}) - 1;
+      it->slot[addrs[k] - it->base] = k + 1;
+   }
+}
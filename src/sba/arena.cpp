@@ -0,0 +1,167 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/arena.h"
+#include <new>
+#include <array>
+#include <sys/mman.h>
+
+using std::vector;
+using std::array;
+using namespace SBA;
+
+static constexpr size_t CHUNK_SIZE = (size_t)1 << 20;
+static constexpr size_t REGION_SIZE = (size_t)1 << 38;  /* address space only */
+static constexpr size_t MAX_OBJECT = CHUNK_SIZE / 16;
+static constexpr size_t ALIGN = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+/* chunks of all arenas, pages are only backed once they are touched */
+struct Region {
+   uint8_t* base = nullptr;
+   size_t size = 0;
+   size_t next = 0;
+   vector<uint8_t*> free;
+   std::mutex lock;
+
+   Region() {
+      auto p = mmap(nullptr, REGION_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (p != MAP_FAILED) {
+         base = (uint8_t*)p;
+         size = REGION_SIZE;
+      }
+   }
+};
+
+
+static Region& region() {
+   static Region r;
+   return r;
+}
+
+
+static uint8_t* get_chunk() {
+   auto& r = region();
+   std::lock_guard<std::mutex> guard(r.lock);
+   if (!r.free.empty()) {
+      auto chunk = r.free.back();
+      r.free.pop_back();
+      return chunk;
+   }
+   if (r.size - r.next < CHUNK_SIZE)
+      return nullptr;
+   auto chunk = r.base + r.next;
+   r.next += CHUNK_SIZE;
+   return chunk;
+}
+
+
+static void put_chunk(uint8_t* chunk) {
+   auto& r = region();
+   madvise(chunk, CHUNK_SIZE, MADV_DONTNEED);
+   std::lock_guard<std::mutex> guard(r.lock);
+   r.free.push_back(chunk);
+}
+
+
+static thread_local Arena* current_arena = nullptr;
+static std::atomic<uint64_t> next_id{1};
+
+
+/* chunks a thread is cutting from, one per arena it allocated in lately */
+struct LocalChunk {
+   uint64_t id = 0;
+   uint8_t* top = nullptr;
+   uint8_t* end = nullptr;
+};
+static constexpr int LOCAL_CHUNKS = 4;
+static thread_local array<LocalChunk,LOCAL_CHUNKS> local_chunks;
+/* -------------------------------------------------------------------------- */
+
+
+Arena::Scope::Scope(Arena* arena): prev_(current_arena) {
+   current_arena = arena;
+}
+
+
+Arena::Scope::~Scope() {
+   current_arena = prev_;
+}
+
+
+Arena::Arena(): id_(next_id++) {}
+
+
+Arena::~Arena() {
+   reset();
+}
+
+
+void* Arena::allocate(size_t size) {
+   size = (size + ALIGN - 1) & ~(ALIGN - 1);
+   auto id = id_.load(std::memory_order_relaxed);
+   auto l = &local_chunks[0];
+   for (auto& x: local_chunks) {
+      if (x.id == id) {
+         l = &x;
+         break;
+      }
+      /* otherwise replace the chunk with least room */
+      if (x.end - x.top < l->end - l->top)
+         l = &x;
+   }
+   if (l->id != id || (size_t)(l->end - l->top) < size) {
+      auto chunk = get_chunk();
+      if (chunk == nullptr)
+         return nullptr;
+      {
+         std::lock_guard<std::mutex> guard(lock_);
+         chunks_.push_back(chunk);
+      }
+      *l = LocalChunk{id, chunk, chunk + CHUNK_SIZE};
+   }
+   auto p = l->top;
+   l->top += size;
+   return p;
+}
+
+
+/* chunks left in the caches of threads are stale once the id changes */
+void Arena::reset() {
+   std::lock_guard<std::mutex> guard(lock_);
+   for (auto chunk: chunks_)
+      put_chunk(chunk);
+   chunks_.clear();
+   id_ = next_id++;
+}
+
+
+Arena* Arena::current() {
+   return current_arena;
+}
+
+
+void* Arena::alloc(size_t size, Arena* arena) {
+   if (arena != nullptr && size <= MAX_OBJECT) {
+      auto p = arena->allocate(size);
+      if (p != nullptr)
+         return p;
+   }
+   return ::operator new(size);
+}
+
+
+void Arena::free(void* p) {
+   if (!owns(p))
+      ::operator delete(p);
+}
+
+
+bool Arena::owns(const void* p) {
+   auto& r = region();
+   return (uintptr_t)p - (uintptr_t)r.base < r.size;
+}
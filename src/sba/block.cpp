@@ -14,13 +14,14 @@
 using namespace SBA;
 UnitVal uval_empty = {{AbsVal(),AbsVal(),AbsVal()},nullptr};
 // --------------------------------- Block -------------------------------------
-Block::Block(const vector<Insn*>& i_list): parent(nullptr), faulty(false),
+Block::Block(CFG& cfg, const vector<Insn*>& i_list): parent(nullptr),
+faulty(false),
 #if ENABLE_DETECT_UPDATED_FUNCTION == true
-   update_num(0), superset_preds({}), 
+   update_num(0),
 #endif
-visited(false), num(0), low(0), preset_regs(0), i_list_(i_list),
-succ_({}), pred_({}), clobber_({nullptr,nullptr,nullptr}) {
-   for (auto i: insn_list()) {
+visited(false), num(0), low(0), preset_regs(0), cfg_(&cfg),
+id_(cfg.add(this, i_list)), clobber_({nullptr,nullptr,nullptr}) {
+   for (auto i: i_list) {
       i->parent = this;
       i->gap = false;
       if (!i->empty())
@@ -46,10 +47,10 @@ Expr* Block::cond_expr() const {
 
 
 void Block::succ(Block* u, COMPARE c, bool back_edge) {
-   succ_.push_back({u,c});
+   cfg_->succ(id_, u->id_, c);
    #if ENABLE_DETECT_UPDATED_FUNCTION == true
       if (back_edge)
-         u->superset_preds.push_back(this);
+         cfg_->superset_pred(u->id_, id_);
    #endif
 }
 
@@ -57,7 +58,7 @@ void Block::succ(Block* u, COMPARE c, bool back_edge) {
 void Block::detach() {
    parent = nullptr;
    num = 0;
-   pred_.clear();
+   cfg_->clear_pred(id_);
    #if ENABLE_SUPPORT_CONSTRAINT == true
       flags = AbsFlags();
       cstr = DOMAIN_BOUNDS();
@@ -88,14 +89,14 @@ void Block:: execute(State& s) {
 
    #if ENABLE_SUPPORT_CONSTRAINT == true
       /* update flags */
-      for (auto [u, c]: succ_)
+      for (auto [u, c]: succ())
          u->flags.merge(flags);
       /* update constraints */
       if (last()->cond_jump()) {
 
          IF_RTL_TYPE(Reg, last()->cond_expr(), reg, {
             /* cond_expr: flags */
-            for (auto [u, c]: succ_) {
+            for (auto [u, c]: succ()) {
                auto branch_cstr = cstr;
                branch_cstr.intersect(DOMAIN_BOUNDS(flags, c));
                LOG3("branch_" << u->offset() << " = "
@@ -107,7 +108,7 @@ void Block:: execute(State& s) {
          /* cond_expr: embedded comparison */
          IF_RTL_TYPE(Binary, last()->cond_expr(), bin, {
             auto cflags = AbsFlags(bin->expr_pair(s));
-            for (auto [u, c]: succ_) {
+            for (auto [u, c]: succ()) {
                auto branch_cstr = cstr;
                branch_cstr.intersect(DOMAIN_BOUNDS(cflags, c));
                LOG3("branch_" << u->offset() << " = "
@@ -120,7 +121,7 @@ void Block:: execute(State& s) {
          });
       }
       else {
-         for (auto [u, c]: succ_) {
+         for (auto [u, c]: succ()) {
             u->cstr.merge(cstr);
             LOG3("cstr_" << u->offset() << " = " << u->cstr.to_string());
          }
@@ -205,6 +206,10 @@ void Block::clear() {
    val_.first.fill(uval_empty);
    val_.second.clear();
    refresh_.clear();
+   #if ENABLE_SUPPORT_CONSTRAINT == true
+      flags = AbsFlags();
+      cstr = DOMAIN_BOUNDS();
+   #endif
 }
 
 
@@ -0,0 +1,163 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/bytecode.h"
+#include "../../include/sba/expr.h"
+
+using namespace SBA;
+/* slots of the running code, nested runs take the slots above top and */
+/* may move them                                                       */
+static thread_local vector<AbsVal> slots;
+static thread_local size_t top = 0;
+// -------------------------------- Bytecode -----------------------------------
+AbsVal Bytecode::eval(State& s, Expr* e) {
+   auto const& entry = lower(e);
+   auto first = entry.first;
+   auto n = entry.last - entry.first;
+   if (n == 0)
+      return e->eval(s);
+
+   auto base = top;
+   top += n;
+   if (slots.size() < top)
+      slots.resize(top);
+
+   /* a step may run nested code that moves the slots or code_: both */
+   /* are taken anew before each step, its value is stored after it  */
+   auto step = [&](const Instr& in, AbsVal* v) -> AbsVal {
+      switch (in.op) {
+         case OP::CONST:
+            return ((Const*)in.node)->Const::eval(s);
+         case OP::REG:
+            return ((Reg*)in.node)->Reg::eval(s);
+         case OP::NOTYPE:
+            return ((NoType*)in.node)->NoType::eval(s);
+         case OP::MEM:
+            return ((Mem*)in.node)->eval(s, std::move(v[in.a]));
+         case OP::SUBREG:
+            return ((SubReg*)in.node)->eval(s, std::move(v[in.a]));
+         case OP::IFELSE:
+            return ((IfElse*)in.node)->eval(s, std::move(v[in.a]),
+                                               std::move(v[in.b]));
+         case OP::CONVERSION:
+            return ((Conversion*)in.node)->eval(s, std::move(v[in.a]));
+         case OP::UNARY:
+            return ((Unary*)in.node)->eval(s, std::move(v[in.a]));
+         case OP::BINARY:
+            return ((Binary*)in.node)->eval(s, std::move(v[in.a]),
+                                               std::move(v[in.b]));
+         default:
+            return in.node->eval(s);
+      }
+   };
+   for (uint32_t i = 0; i < n; ++i) {
+      auto res = step(code_[first + i], slots.data() + base);
+      slots[base + i] = std::move(res);
+   }
+
+   top = base;
+   return std::move(slots[base + n - 1]);
+}
+
+
+Expr* Bytecode::simplify(Expr* e) {
+   for (auto const& [x, y]: simple_)
+      if (x == e)
+         return y;
+   return simple_.emplace_back(e, e->simplify()).second;
+}
+
+
+const Bytecode::Entry& Bytecode::lower(Expr* e) {
+   for (auto const& entry: entries_)
+      if (entry.expr == e)
+         return entry;
+   uint32_t first = code_.size();
+   if (!emit(e, first)) {
+      code_.resize(first);
+      return entries_.emplace_back(Entry{e, first, first});
+   }
+   return entries_.emplace_back(Entry{e, first, (uint32_t)code_.size()});
+}
+
+
+bool Bytecode::emit(Expr* e, uint32_t first) {
+   if (e == nullptr || code_.size() - first >= 0xffff)
+      return false;
+
+   /* operands first, in the order Expr::eval() evaluates them */
+   auto operand = [&](Expr* x, uint16_t& slot) {
+      if (!emit(x, first))
+         return false;
+      slot = code_.size() - 1 - first;
+      return true;
+   };
+
+   Instr in{OP::OTHER, 0, 0, e};
+   switch (e->expr_type()) {
+      case Expr::EXPR_TYPE::CONSTANT:
+         in.op = OP::CONST;
+         break;
+      case Expr::EXPR_TYPE::NOTYPE:
+         in.op = OP::NOTYPE;
+         break;
+      case Expr::EXPR_TYPE::VAR:
+         if (((Var*)e)->var_type() == Var::VAR_TYPE::REG)
+            in.op = OP::REG;
+         else {
+            if (!operand(((Mem*)e)->addr(), in.a))
+               return false;
+            in.op = OP::MEM;
+         }
+         break;
+      case Expr::EXPR_TYPE::SUBREG:
+         if (!operand(((SubReg*)e)->expr(), in.a))
+            return false;
+         in.op = OP::SUBREG;
+         break;
+      case Expr::EXPR_TYPE::IFELSE: {
+         auto x = (IfElse*)e;
+         if (!operand(x->if_expr(), in.a) || !operand(x->else_expr(), in.b))
+            return false;
+         in.op = OP::IFELSE;
+         break;
+      }
+      case Expr::EXPR_TYPE::CONVERSION: {
+         auto x = e->simplify();
+         if (x == e)
+            break;
+         if (!operand(x, in.a))
+            return false;
+         in.op = OP::CONVERSION;
+         break;
+      }
+      case Expr::EXPR_TYPE::ARITHMETIC:
+         switch (((Arithmetic*)e)->arith_type()) {
+            case Arithmetic::ARITH_TYPE::UNARY:
+               if (!operand(((Unary*)e)->operand(), in.a))
+                  return false;
+               in.op = OP::UNARY;
+               break;
+            case Arithmetic::ARITH_TYPE::BINARY: {
+               auto x = (Binary*)e;
+               if (!operand(x->operand(0), in.a)
+               || !operand(x->operand(1), in.b))
+                  return false;
+               in.op = OP::BINARY;
+               break;
+            }
+            default:
+               break;
+         }
+         break;
+      default:
+         break;
+   }
+
+   code_.push_back(in);
+   return true;
+}
@@ -0,0 +1,102 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/cfg.h"
+
+using namespace SBA;
+// ----------------------------------- CFG -------------------------------------
+uint32_t CFG::add(Block* b, const vector<Insn*>& i_list) {
+   uint32_t id;
+   if (!free_.empty()) {
+      id = free_.back();
+      free_.pop_back();
+      blocks_[id] = b;
+   }
+   else {
+      id = blocks_.size();
+      blocks_.push_back(b);
+      insns_.range.emplace_back();
+      succ_.range.emplace_back();
+      pred_.range.emplace_back();
+      sup_.range.emplace_back();
+   }
+   insns_.assign(id, i_list);
+   return id;
+}
+
+
+void CFG::remove(uint32_t id) {
+   /* windows are kept for the next block with this id */
+   blocks_[id] = nullptr;
+   insns_.range[id].size = 0;
+   succ_.range[id].size = 0;
+   pred_.range[id].size = 0;
+   sup_.range[id].size = 0;
+   free_.push_back(id);
+}
+
+
+void CFG::compact() {
+   insns_.compact();
+   succ_.compact();
+   pred_.compact();
+   sup_.compact();
+}
+/* -------------------------------------------------------------------------- */
+template<class T> void CFG::Pool<T>::push(uint32_t id, const T& x) {
+   auto& r = range[id];
+   if (r.size == r.cap) {
+      uint32_t cap = std::max<uint32_t>(2, 2 * r.cap);
+      /* last window grows in place */
+      if (r.first + r.cap == data.size())
+         data.resize(r.first + cap);
+      else {
+         uint32_t first = data.size();
+         data.resize(first + cap);
+         std::copy_n(data.begin() + r.first, r.size, data.begin() + first);
+         unused += r.cap;
+         r.first = first;
+      }
+      r.cap = cap;
+   }
+   data[r.first + r.size++] = x;
+}
+
+
+template<class T> void CFG::Pool<T>::assign(uint32_t id, const vector<T>& x) {
+   auto& r = range[id];
+   if (r.cap < x.size()) {
+      unused += r.cap;
+      r.first = data.size();
+      r.cap = x.size();
+      data.resize(r.first + r.cap);
+   }
+   std::copy(x.begin(), x.end(), data.begin() + r.first);
+   r.size = x.size();
+}
+
+
+template<class T> void CFG::Pool<T>::compact() {
+   if (2 * unused <= data.size())
+      return;
+   vector<T> packed;
+   packed.reserve(data.size() - unused);
+   for (auto& r: range) {
+      auto first = packed.size();
+      packed.insert(packed.end(), data.begin() + r.first,
+                                  data.begin() + r.first + r.size);
+      r.first = first;
+      r.cap = r.size;
+   }
+   data = std::move(packed);
+   unused = 0;
+}
+
+
+template struct CFG::Pool<Insn*>;
+template struct CFG::Pool<CFG::Edge>;
+template struct CFG::Pool<uint32_t>;
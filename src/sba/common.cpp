@@ -7,12 +7,15 @@
 
 #include "../../include/sba/expr.h"
 #include "../../include/sba/common.h"
+#include <atomic>
+#include <thread>
 
 using namespace SBA;
 /* -------------------------------------------------------------------------- */
 fstream LOG_FILE;
 bool GLOBAL_DEBUG = false;
-Array<IMM,Block*,LIMIT_VISITED> Util::Visited;
+thread_local std::ostream* LOG_STREAM = nullptr;
+thread_local vector<Block*> Util::Visited;
 IMM SBA::stackSym = SBA::get_sym(SYSTEM::STACK_PTR);
 IMM SBA::staticSym = SBA::get_sym(SYSTEM::INSN_PTR);
 /* -------------------------------------------------------------------------- */
@@ -135,3 +138,36 @@ int64_t Util::cast_int(uint64_t val, uint8_t bytes, bool signedness) {
          return 0;
    }
 }
+
+
+/* n threads, or one per core if n <= 0 */
+int Util::workers(int n) {
+   return n > 0? n: std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+
+/* f(lo,hi) over [0,n) in ranges taken by up to `workers` threads on demand, */
+/* small inputs run on the calling thread; grain 0 picks the range size     */
+void Util::parallel_for(size_t n, int workers, const function<void(size_t,
+size_t)>& f, size_t grain) {
+   auto w = (size_t)Util::workers(workers);
+   if (grain == 0)
+      grain = std::max((size_t)256, n / (w * 8));
+   w = std::min(w, (n + grain - 1) / grain);
+   if (w <= 1) {
+      if (n > 0)
+         f(0, n);
+      return;
+   }
+   std::atomic<size_t> next{0};
+   auto run = [&]() {
+      for (auto lo = next.fetch_add(grain); lo < n; lo = next.fetch_add(grain))
+         f(lo, std::min(n, lo + grain));
+   };
+   vector<std::thread> threads;
+   for (size_t i = 1; i < w; ++i)
+      threads.emplace_back(run);
+   run();
+   for (auto& t: threads)
+      t.join();
+}
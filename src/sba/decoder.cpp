@@ -0,0 +1,3709 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/decoder.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using std::string;
+using namespace SBA;
+
+/* --------------------------------- Tables --------------------------------- */
+/* operand codes follow the Intel opcode map:                                 */
+/*   E/G  r/m and reg of ModRM       M  memory only      R  register only     */
+/*   I    immediate (s: imm8 sign-extended to the operand size)                */
+/*   J    relative target             Z  register in opcode bits              */
+/*   O    moffs                       S  segment register                     */
+/*   R    r32 or sized memory         K  r/m register, ModRM.mod ignored      */
+/*   X/Y  string source/destination   C/D control/debug register              */
+/*   V/W  xmm reg and xmm r/m         U  xmm r/m register only                */
+/*   H    VEX.vvvv                    L  register in imm8[7:4]                */
+/*   P/Q  mmx reg and mmx r/m         N  mmx r/m register only                */
+/*   B    VEX.vvvv general register                                           */
+/*   t    tile register: tG reg, tE r/m, tH vvvv; tM memory with a SIB byte   */
+/* size codes: b w d q v(16/32/64) y(32/64) z(16/32) o(xmm) x(xmm/ymm) t(80)  */
+/*             h/u/e(half/quarter/eighth of x)  f(d or q by VEX.W)            */
+/*             m(q for 128 bits, x otherwise)   _ (memory without size)       */
+/*             4 (imm8[3:0] of the L operand before)                          */
+/* "a/b" mnemonics and operands are selected by VEX.W, "r|m" operands by the  */
+/* register or memory form of ModRM, an empty one being (bad)                 */
+enum: uint8_t {
+   NONE = 0,
+   D64 = 1,       /* default operand size is 64 */
+   F64 = 2,       /* operand size is always 64  */
+   GRP = 4,       /* entry is a group indexed by ModRM.reg */
+   SPEC = 8,      /* decoded by hand */
+   BAD = 16,
+   CMP = 32,      /* imm8 selects a cmp pseudo-op */
+   MODT = 64,     /* register/memory forms differ: a mismatch is (bad) */
+   PLAIN = 128,   /* VEX form without the "v" prefix */
+};
+
+/* VEX forms objdump accepts: with any of VL0-VW1, an L or W outside them is */
+/* (bad), as is a VEX.pp without an entry or a VEX.vvvv no operand reads     */
+enum: uint8_t {
+   VL0 = 1,       /* VEX.L = 0 only */
+   VL1 = 2,       /* VEX.L = 1 only */
+   VW0 = 4,       /* VEX.W = 0 only */
+   VW1 = 8,       /* VEX.W = 1 only */
+   VRM = 16,      /* a register for memory, or the reverse, is an invalid */
+                  /* operand rather than an invalid opcode                */
+};
+
+struct Op {
+   const char* mnem = nullptr;
+   const char* args = nullptr;
+   uint8_t flags = NONE;
+   const char* vargs = nullptr;   /* operands of the VEX form, if any */
+   uint8_t vex = 0;               /* VL0.. of the VEX form */
+};
+
+/* entries selected by mandatory prefix: none, 66, F3, F2 */
+struct Op4 {
+   Op op[4];
+};
+
+static const char* const R8[16] = {"al","cl","dl","bl","ah","ch","dh","bh",
+   "r8b","r9b","r10b","r11b","r12b","r13b","r14b","r15b"};
+static const char* const R8_REX[8] = {"al","cl","dl","bl","spl","bpl","sil",
+   "dil"};
+static const char* const R16[16] = {"ax","cx","dx","bx","sp","bp","si","di",
+   "r8w","r9w","r10w","r11w","r12w","r13w","r14w","r15w"};
+static const char* const R32[16] = {"eax","ecx","edx","ebx","esp","ebp","esi",
+   "edi","r8d","r9d","r10d","r11d","r12d","r13d","r14d","r15d"};
+static const char* const R64[16] = {"rax","rcx","rdx","rbx","rsp","rbp","rsi",
+   "rdi","r8","r9","r10","r11","r12","r13","r14","r15"};
+static const char* const SREG[8] = {"es","cs","ss","ds","fs","gs","?","?"};
+static const char* const SSE_CMP[8] = {"eq","lt","le","unord","neq","nlt",
+   "nle","ord"};
+static const char* const AVX_CMP[32] = {"eq","lt","le","unord","neq","nlt",
+   "nle","ord","eq_uq","nge","ngt","false","neq_oq","ge","gt","true","eq_os",
+   "lt_oq","le_oq","unord_s","neq_us","nlt_uq","nle_uq","ord_s","eq_us",
+   "nge_uq","ngt_uq","false_os","neq_os","ge_oq","gt_oq","true_us"};
+
+static const Op ONE[256] = {
+   /* 00 */ {"add","Eb,Gb"}, {"add","Ev,Gv"}, {"add","Gb,Eb"}, {"add","Gv,Ev"},
+            {"add","AL,Ib"}, {"add","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 08 */ {"or","Eb,Gb"}, {"or","Ev,Gv"}, {"or","Gb,Eb"}, {"or","Gv,Ev"},
+            {"or","AL,Ib"}, {"or","rAX,Iz"}, {0,0,BAD}, {0,0,SPEC},
+   /* 10 */ {"adc","Eb,Gb"}, {"adc","Ev,Gv"}, {"adc","Gb,Eb"}, {"adc","Gv,Ev"},
+            {"adc","AL,Ib"}, {"adc","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 18 */ {"sbb","Eb,Gb"}, {"sbb","Ev,Gv"}, {"sbb","Gb,Eb"}, {"sbb","Gv,Ev"},
+            {"sbb","AL,Ib"}, {"sbb","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 20 */ {"and","Eb,Gb"}, {"and","Ev,Gv"}, {"and","Gb,Eb"}, {"and","Gv,Ev"},
+            {"and","AL,Ib"}, {"and","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 28 */ {"sub","Eb,Gb"}, {"sub","Ev,Gv"}, {"sub","Gb,Eb"}, {"sub","Gv,Ev"},
+            {"sub","AL,Ib"}, {"sub","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 30 */ {"xor","Eb,Gb"}, {"xor","Ev,Gv"}, {"xor","Gb,Eb"}, {"xor","Gv,Ev"},
+            {"xor","AL,Ib"}, {"xor","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 38 */ {"cmp","Eb,Gb"}, {"cmp","Ev,Gv"}, {"cmp","Gb,Eb"}, {"cmp","Gv,Ev"},
+            {"cmp","AL,Ib"}, {"cmp","rAX,Iz"}, {0,0,BAD}, {0,0,BAD},
+   /* 40 */ {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+            {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+   /* 48 */ {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+            {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+   /* 50 */ {"push","Zv",D64}, {"push","Zv",D64}, {"push","Zv",D64},
+            {"push","Zv",D64}, {"push","Zv",D64}, {"push","Zv",D64},
+            {"push","Zv",D64}, {"push","Zv",D64},
+   /* 58 */ {"pop","Zv",D64}, {"pop","Zv",D64}, {"pop","Zv",D64},
+            {"pop","Zv",D64}, {"pop","Zv",D64}, {"pop","Zv",D64},
+            {"pop","Zv",D64}, {"pop","Zv",D64},
+   /* 60 */ {0,0,BAD}, {0,0,BAD}, {0,0,SPEC}, {"movsxd","Gv,Ed"},
+            {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+   /* 68 */ {"push","Iz",D64}, {"imul","Gv,Ev,Iz"}, {"push","Is",D64},
+            {"imul","Gv,Ev,Is"}, {"ins","Yb,DX"}, {"ins","Yz,DX"},
+            {"outs","DX,Xb"}, {"outs","DX,Xz"},
+   /* 70 */ {"jo","Jb",F64}, {"jno","Jb",F64}, {"jb","Jb",F64},
+            {"jae","Jb",F64}, {"je","Jb",F64}, {"jne","Jb",F64},
+            {"jbe","Jb",F64}, {"ja","Jb",F64},
+   /* 78 */ {"js","Jb",F64}, {"jns","Jb",F64}, {"jp","Jb",F64},
+            {"jnp","Jb",F64}, {"jl","Jb",F64}, {"jge","Jb",F64},
+            {"jle","Jb",F64}, {"jg","Jb",F64},
+   /* 80 */ {"0","Eb,Ib",GRP}, {"0","Ev,Iz",GRP}, {0,0,BAD},
+            {"0","Ev,Is",GRP}, {"test","Eb,Gb"}, {"test","Ev,Gv"},
+            {"xchg","Eb,Gb"}, {"xchg","Ev,Gv"},
+   /* 88 */ {"mov","Eb,Gb"}, {"mov","Ev,Gv"}, {"mov","Gb,Eb"},
+            {"mov","Gv,Ev"}, {"mov","Sv,Sw"}, {"lea","Gv,M_"},
+            {"mov","Sw,Ev|Sw,Mw"}, {"10","Ev",GRP|D64},
+   /* 90 */ {0,0,SPEC}, {"xchg","Zv,rAX"}, {"xchg","Zv,rAX"},
+            {"xchg","Zv,rAX"}, {"xchg","Zv,rAX"}, {"xchg","Zv,rAX"},
+            {"xchg","Zv,rAX"}, {"xchg","Zv,rAX"},
+   /* 98 */ {0,0,SPEC}, {0,0,SPEC}, {0,0,BAD}, {"fwait",""},
+            {"pushf","",D64}, {"popf","",D64}, {"sahf",""}, {"lahf",""},
+   /* a0 */ {"movabs","AL,Ob"}, {"movabs","rAX,Ov"}, {"movabs","Ob,AL"},
+            {"movabs","Ov,rAX"}, {"movs","Yb,Xb"}, {"movs","Yv,Xv"},
+            {"cmps","Xb,Yb"}, {"cmps","Xv,Yv"},
+   /* a8 */ {"test","AL,Ib"}, {"test","rAX,Iz"}, {"stos","Yb,AL"},
+            {"stos","Yv,rAX"}, {"lods","AL,Xb"}, {"lods","rAX,Xv"},
+            {"scas","AL,Yb"}, {"scas","rAX,Yv"},
+   /* b0 */ {"mov","Zb,Ib"}, {"mov","Zb,Ib"}, {"mov","Zb,Ib"},
+            {"mov","Zb,Ib"}, {"mov","Zb,Ib"}, {"mov","Zb,Ib"},
+            {"mov","Zb,Ib"}, {"mov","Zb,Ib"},
+   /* b8 */ {"mov","Zv,Iv"}, {"mov","Zv,Iv"}, {"mov","Zv,Iv"},
+            {"mov","Zv,Iv"}, {"mov","Zv,Iv"}, {"mov","Zv,Iv"},
+            {"mov","Zv,Iv"}, {"mov","Zv,Iv"},
+   /* c0 */ {"1","Eb,Ib",GRP}, {"1","Ev,Ib",GRP}, {"ret","Iw",F64},
+            {"ret","",F64}, {0,0,SPEC}, {0,0,SPEC}, {"11","Eb,Ib",GRP},
+            {"12","Ev,Iz",GRP},
+   /* c8 */ {"enter","Iw,Ib",D64}, {"leave","",D64}, {"retf","Iw"},
+            {"retf",""}, {"int3",""}, {"int","Ib"}, {0,0,BAD}, {0,0,SPEC},
+   /* d0 */ {"1","Eb,1",GRP}, {"1","Ev,1",GRP}, {"1","Eb,CL",GRP},
+            {"1","Ev,CL",GRP}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+            {"xlat","Xl"},
+   /* d8 */ {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC},
+            {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC},
+   /* e0 */ {"loopne","Jb",F64}, {"loope","Jb",F64}, {"loop","Jb",F64},
+            {"jrcxz","Jb",F64}, {"in","AL,Ib"}, {"in","eAX,Ib"},
+            {"out","Ib,AL"}, {"out","Ib,eAX"},
+   /* e8 */ {"call","Jz",F64}, {"jmp","Jz",F64}, {0,0,BAD},
+            {"jmp","Jb",F64}, {"in","AL,DX"}, {"in","eAX,DX"},
+            {"out","DX,AL"}, {"out","DX,eAX"},
+   /* f0 */ {0,0,BAD}, {"int1",""}, {0,0,BAD}, {0,0,BAD},
+            {"hlt",""}, {"cmc",""}, {"3","Eb",GRP}, {"4","Ev",GRP},
+   /* f8 */ {"clc",""}, {"stc",""}, {"cli",""}, {"sti",""},
+            {"cld",""}, {"std",""}, {"5","",GRP}, {"6","",GRP},
+};
+
+/* groups of the one-byte and two-byte maps, indexed by ModRM.reg */
+static const Op GROUP[][8] = {
+   /* 0: 80-83 */
+   {{"add"}, {"or"}, {"adc"}, {"sbb"}, {"and"}, {"sub"}, {"xor"}, {"cmp"}},
+   /* 1: c0-c1, d0-d3 */
+   {{"rol"}, {"ror"}, {"rcl"}, {"rcr"}, {"shl"}, {"shr"}, {"shl"}, {"sar"}},
+   /* 2: unused */
+   {},
+   /* 3: f6 */
+   {{"test","Eb,Ib"}, {"test","Eb,Ib"}, {"not","Eb"}, {"neg","Eb"},
+    {"mul","Eb"}, {"imul","Eb"}, {"div","Eb"}, {"idiv","Eb"}},
+   /* 4: f7 */
+   {{"test","Ev,Iz"}, {"test","Ev,Iz"}, {"not","Ev"}, {"neg","Ev"},
+    {"mul","Ev"}, {"imul","Ev"}, {"div","Ev"}, {"idiv","Ev"}},
+   /* 5: fe */
+   {{"inc","Eb"}, {"dec","Eb"}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+    {0,0,BAD}, {0,0,BAD}},
+   /* 6: ff */
+   {{"inc","Ev"}, {"dec","Ev"}, {"call","Ev",D64}, {"call","Mp"},
+    {"jmp","Ev",D64}, {"jmp","Mp"}, {"push","Ev",D64}, {0,0,BAD}},
+   /* 7: 0f 00 */
+   {{"sldt","Sv"}, {"str","Sv"}, {"lldt","Ew"}, {"ltr","Ew"}, {"verr","Ew"},
+    {"verw","Ew"}, {0,0,BAD}, {0,0,BAD}},
+   /* 8: 0f ba */
+   {{0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {"bt","Ev,Ib"},
+    {"bts","Ev,Ib"}, {"btr","Ev,Ib"}, {"btc","Ev,Ib"}},
+   /* 9: 0f 18 */
+   {{"prefetchnta","Mb"}, {"prefetcht0","Mb"}, {"prefetcht1","Mb"},
+    {"prefetcht2","Mb"}, {"nop","Ev"}, {"nop","Ev"}, {"nop","Ev"},
+    {"nop","Ev"}},
+   /* 10: 8f */
+   {{"pop","Ev",D64}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+    {0,0,BAD}, {0,0,BAD}, {0,0,BAD}},
+   /* 11: c6 */
+   {{"mov","Eb,Ib"}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+    {0,0,BAD}, {0,0,BAD}, {0,0,SPEC}},
+   /* 12: c7 */
+   {{"mov","Ev,Iz"}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+    {0,0,BAD}, {0,0,BAD}, {0,0,SPEC}},
+   /* 13: 0f 0d */
+   {{"prefetch","Mb"}, {"prefetchw","Mb"}, {"prefetchwt1","Mb"},
+    {"prefetch","Mb"}, {"prefetch","Mb"}, {"prefetch","Mb"},
+    {"prefetch","Mb"}, {"prefetch","Mb"}},
+};
+
+/* two-byte map */
+#define O1(m,a)            {{{m,a}}}
+#define O1F(m,a,f)         {{{m,a,f}}}
+#define SSE(m0,a0,v0,m1,a1,v1,m2,a2,v2,m3,a3,v3) \
+   {{{m0,a0,0,v0}, {m1,a1,0,v1}, {m2,a2,0,v2}, {m3,a3,0,v3}}}
+#define PS_PD_SS_SD(m,ps,pd,ss,sd) \
+   SSE(m "ps","Vx,Wx",ps, m "pd","Vx,Wx",pd, m "ss","Vo,Wd",ss, \
+       m "sd","Vo,Wq",sd)
+#define PS_PD(m,ps,pd) \
+   SSE(m "ps","Vx,Wx",ps, m "pd","Vx,Wx",pd, 0,0,0, 0,0,0)
+#define MMX(m,q) \
+   SSE(m,"Pq," q,0, m,"Vx,Wx","Vx,Hx,Wx", 0,0,0, 0,0,0)
+/* shift by the count in an xmm, whatever the vector length */
+#define MMX_SHIFT(m) \
+   SSE(m,"Pq,Qq",0, m,"Vx,Wx","Vx,Hx,Wo", 0,0,0, 0,0,0)
+#define SSE66(m,a,v) \
+   SSE(0,0,0, m,a,v, 0,0,0, 0,0,0)
+#define BADOP              {{{0,0,BAD}}}
+
+static const Op4 TWO[256] = {
+   /* 00 */ O1F("7","",GRP), O1F(0,0,SPEC), O1("lar","Gv,Ev|Gv,Mw"),
+            O1("lsl","Gv,Ev|Gv,Mw"), BADOP, O1("syscall",""), O1("clts",""),
+            O1F(0,0,SPEC),
+   /* 08 */ O1("invd",""), SSE("wbinvd","",0, 0,0,0, "wbnoinvd","",0, 0,0,0),
+            BADOP, O1("ud2",""), BADOP,
+            O1F("13","",GRP), O1("femms",""), O1F(0,0,SPEC),
+   /* 10 */ SSE("movups","Vx,Wx","Vx,Wx", "movupd","Vx,Wx","Vx,Wx",
+                "movss","Vo,Wd","Vo,Ho,Wo|Vo,Wd",
+                "movsd","Vo,Wq","Vo,Ho,Wo|Vo,Wq"),
+            SSE("movups","Wx,Vx","Wx,Vx", "movupd","Wx,Vx","Wx,Vx",
+                "movss","Wd,Vo","Wx,Ho,Vo|Wd,Vo",
+                "movsd","Wq,Vo","Wx,Ho,Vo|Wq,Vo"),
+            {{{"movlps","Vo,Wq",0,"Vo,Ho,Wq",VL0},
+              {"movlpd","Vo,Mq",0,"Vo,Ho,Mq",VL0},
+              {"movsldup","Vx,Wx",0,"Vx,Wx"},
+              {"movddup","Vo,Wq",0,"Vx,Wm"}}},
+            {{{"movlps","Mq,Vo",0,"Mq,Vo",VL0},
+              {"movlpd","Mq,Vo",0,"Mq,Vo",VL0}}},
+            PS_PD("unpckl","Vx,Hx,Wx","Vx,Hx,Wx"),
+            PS_PD("unpckh","Vx,Hx,Wx","Vx,Hx,Wx"),
+            {{{"movhps","Vo,Wq",0,"Vo,Ho,Wq",VL0},
+              {"movhpd","Vo,Mq",0,"Vo,Ho,Mq",VL0},
+              {"movshdup","Vx,Wx",0,"Vx,Wx"}}},
+            {{{"movhps","Mq,Vo",0,"Mq,Vo",VL0},
+              {"movhpd","Mq,Vo",0,"Mq,Vo",VL0}}},
+   /* 18 */ O1F("9","",GRP), O1("nop","Ev"), O1F(0,0,SPEC), O1F(0,0,SPEC),
+            O1F(0,0,SPEC), O1("nop","Ev"), O1F(0,0,SPEC), O1("nop","Ev"),
+   /* 20 */ O1F("mov","Kq,Cq",F64), O1F("mov","Kq,Dq",F64),
+            O1F("mov","Cq,Kq",F64), O1F("mov","Dq,Kq",F64), BADOP, BADOP,
+            BADOP, BADOP,
+   /* 28 */ SSE("movaps","Vx,Wx","Vx,Wx", "movapd","Vx,Wx","Vx,Wx",
+                0,0,0, 0,0,0),
+            SSE("movaps","Wx,Vx","Wx,Vx", "movapd","Wx,Vx","Wx,Vx",
+                0,0,0, 0,0,0),
+            SSE("cvtpi2ps","Vo,Qq",0, "cvtpi2pd","Vo,Qq",0,
+                "cvtsi2ss","Vo,Ey","Vo,Ho,Ey", "cvtsi2sd","Vo,Ey","Vo,Ho,Ey"),
+            SSE("movntps","Mx,Vx","Mx,Vx", "movntpd","Mx,Vx","Mx,Vx",
+                "movntss","Md,Vo",0, "movntsd","Mq,Vo",0),
+            SSE("cvttps2pi","Pq,Wq",0, "cvttpd2pi","Pq,Wo",0,
+                "cvttss2si","Gy,Wd","Gy,Wd", "cvttsd2si","Gy,Wq","Gy,Wq"),
+            SSE("cvtps2pi","Pq,Wq",0, "cvtpd2pi","Pq,Wo",0,
+                "cvtss2si","Gy,Wd","Gy,Wd", "cvtsd2si","Gy,Wq","Gy,Wq"),
+            SSE("ucomiss","Vo,Wd","Vo,Wd", "ucomisd","Vo,Wq","Vo,Wq",
+                0,0,0, 0,0,0),
+            SSE("comiss","Vo,Wd","Vo,Wd", "comisd","Vo,Wq","Vo,Wq",
+                0,0,0, 0,0,0),
+   /* 30 */ O1("wrmsr",""), O1("rdtsc",""), O1("rdmsr",""), O1("rdpmc",""),
+            O1("sysenter",""), O1F(0,0,SPEC), BADOP, O1("getsec",""),
+   /* 38 */ O1F(0,0,SPEC), BADOP, O1F(0,0,SPEC), BADOP, BADOP, BADOP, BADOP,
+            BADOP,
+   /* 40 */ O1("cmovo","Gv,Ev"), O1("cmovno","Gv,Ev"), O1("cmovb","Gv,Ev"),
+            O1("cmovae","Gv,Ev"), O1("cmove","Gv,Ev"), O1("cmovne","Gv,Ev"),
+            O1("cmovbe","Gv,Ev"), O1("cmova","Gv,Ev"),
+   /* 48 */ O1("cmovs","Gv,Ev"), O1("cmovns","Gv,Ev"), O1("cmovp","Gv,Ev"),
+            O1("cmovnp","Gv,Ev"), O1("cmovl","Gv,Ev"), O1("cmovge","Gv,Ev"),
+            O1("cmovle","Gv,Ev"), O1("cmovg","Gv,Ev"),
+   /* 50 */ SSE("movmskps","Gy,Ux","Gy,Ux", "movmskpd","Gy,Ux","Gy,Ux",
+                0,0,0, 0,0,0),
+            SSE("sqrtps","Vx,Wx","Vx,Wx", "sqrtpd","Vx,Wx","Vx,Wx",
+                "sqrtss","Vo,Wd","Vo,Ho,Wd", "sqrtsd","Vo,Wq","Vo,Ho,Wq"),
+            SSE("rsqrtps","Vx,Wx","Vx,Wx", 0,0,0,
+                "rsqrtss","Vo,Wd","Vo,Ho,Wd", 0,0,0),
+            SSE("rcpps","Vx,Wx","Vx,Wx", 0,0,0,
+                "rcpss","Vo,Wd","Vo,Ho,Wd", 0,0,0),
+            PS_PD("and","Vx,Hx,Wx","Vx,Hx,Wx"),
+            PS_PD("andn","Vx,Hx,Wx","Vx,Hx,Wx"),
+            PS_PD("or","Vx,Hx,Wx","Vx,Hx,Wx"),
+            PS_PD("xor","Vx,Hx,Wx","Vx,Hx,Wx"),
+   /* 58 */ PS_PD_SS_SD("add","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+            PS_PD_SS_SD("mul","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+            SSE("cvtps2pd","Vo,Wq","Vx,Wh", "cvtpd2ps","Vo,Wx","Vo,Wx",
+                "cvtss2sd","Vo,Wd","Vo,Ho,Wd", "cvtsd2ss","Vo,Wq","Vo,Ho,Wq"),
+            SSE("cvtdq2ps","Vx,Wx","Vx,Wx", "cvtps2dq","Vx,Wx","Vx,Wx",
+                "cvttps2dq","Vx,Wx","Vx,Wx", 0,0,0),
+            PS_PD_SS_SD("sub","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+            PS_PD_SS_SD("min","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+            PS_PD_SS_SD("div","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+            PS_PD_SS_SD("max","Vx,Hx,Wx","Vx,Hx,Wx","Vo,Ho,Wd","Vo,Ho,Wq"),
+   /* 60 */ MMX("punpcklbw","Qd"), MMX("punpcklwd","Qd"),
+            MMX("punpckldq","Qd"), MMX("packsswb","Qq"), MMX("pcmpgtb","Qq"),
+            MMX("pcmpgtw","Qq"), MMX("pcmpgtd","Qq"), MMX("packuswb","Qq"),
+   /* 68 */ MMX("punpckhbw","Qq"), MMX("punpckhwd","Qq"),
+            MMX("punpckhdq","Qq"), MMX("packssdw","Qq"),
+            SSE66("punpcklqdq","Vx,Wx","Vx,Hx,Wx"),
+            SSE66("punpckhqdq","Vx,Wx","Vx,Hx,Wx"),
+            {{{"movd","Pq,Ey"}, {"movd","Vo,Ey",0,"Vo,Ey",VL0}}},
+            SSE("movq","Pq,Qq",0, "movdqa","Vx,Wx","Vx,Wx",
+                "movdqu","Vx,Wx","Vx,Wx", 0,0,0),
+   /* 70 */ SSE("pshufw","Pq,Qq,Ib",0, "pshufd","Vx,Wx,Ib","Vx,Wx,Ib",
+                "pshufhw","Vx,Wx,Ib","Vx,Wx,Ib",
+                "pshuflw","Vx,Wx,Ib","Vx,Wx,Ib"),
+            O1F(0,0,SPEC), O1F(0,0,SPEC), O1F(0,0,SPEC),
+            MMX("pcmpeqb","Qq"), MMX("pcmpeqw","Qq"), MMX("pcmpeqd","Qq"),
+            O1F(0,0,SPEC),
+   /* 78 */ {{{"vmread","Eq,Gq",F64}, {"extrq","Uo,Ib,Ib"}, {0,0,BAD},
+              {"insertq","Vo,Uo,Ib,Ib"}}},
+            {{{"vmwrite","Gq,Eq",F64}, {"extrq","Vo,Uo"}, {0,0,BAD},
+              {"insertq","Vo,Uo"}}}, BADOP,
+            BADOP,
+            SSE(0,0,0, "haddpd","Vx,Wx","Vx,Hx,Wx", 0,0,0,
+                "haddps","Vx,Wx","Vx,Hx,Wx"),
+            SSE(0,0,0, "hsubpd","Vx,Wx","Vx,Hx,Wx", 0,0,0,
+                "hsubps","Vx,Wx","Vx,Hx,Wx"),
+            {{{"movd","Ey,Pq"}, {"movd","Ey,Vo",0,"Ey,Vo",VL0},
+              {"movq","Vo,Wq",0,"Vo,Wq",VL0}}},
+            SSE("movq","Qq,Pq",0, "movdqa","Wx,Vx","Wx,Vx",
+                "movdqu","Wx,Vx","Wx,Vx", 0,0,0),
+   /* 80 */ O1F("jo","Jz",F64), O1F("jno","Jz",F64), O1F("jb","Jz",F64),
+            O1F("jae","Jz",F64), O1F("je","Jz",F64), O1F("jne","Jz",F64),
+            O1F("jbe","Jz",F64), O1F("ja","Jz",F64),
+   /* 88 */ O1F("js","Jz",F64), O1F("jns","Jz",F64), O1F("jp","Jz",F64),
+            O1F("jnp","Jz",F64), O1F("jl","Jz",F64), O1F("jge","Jz",F64),
+            O1F("jle","Jz",F64), O1F("jg","Jz",F64),
+   /* 90 */ O1("seto","Eb"), O1("setno","Eb"), O1("setb","Eb"),
+            O1("setae","Eb"), O1("sete","Eb"), O1("setne","Eb"),
+            O1("setbe","Eb"), O1("seta","Eb"),
+   /* 98 */ O1("sets","Eb"), O1("setns","Eb"), O1("setp","Eb"),
+            O1("setnp","Eb"), O1("setl","Eb"), O1("setge","Eb"),
+            O1("setle","Eb"), O1("setg","Eb"),
+   /* a0 */ O1F("push","FS",D64), O1F("pop","FS",D64), O1("cpuid",""),
+            O1("bt","Ev,Gv"), O1("shld","Ev,Gv,Ib"), O1("shld","Ev,Gv,CL"),
+            O1F(0,0,SPEC), O1F(0,0,SPEC),
+   /* a8 */ O1F("push","GS",D64), O1F("pop","GS",D64), O1("rsm",""),
+            O1("bts","Ev,Gv"), O1("shrd","Ev,Gv,Ib"), O1("shrd","Ev,Gv,CL"),
+            O1F(0,0,SPEC), O1("imul","Gv,Ev"),
+   /* b0 */ O1("cmpxchg","Eb,Gb"), O1("cmpxchg","Ev,Gv"), O1F("lss","Gv,Mp",MODT),
+            O1("btr","Ev,Gv"), O1F("lfs","Gv,Mp",MODT), O1F("lgs","Gv,Mp",MODT),
+            O1("movzx","Gv,Eb"), O1("movzx","Gv,Ew"),
+   /* b8 */ SSE(0,0,0, 0,0,0, "popcnt","Gv,Ev",0, 0,0,0),
+            O1("ud1","Gv,Ev"), O1F("8","",GRP), O1("btc","Ev,Gv"),
+            SSE("bsf","Gv,Ev",0, "bsf","Gv,Ev",0, "tzcnt","Gv,Ev",0, 0,0,0),
+            SSE("bsr","Gv,Ev",0, "bsr","Gv,Ev",0, "lzcnt","Gv,Ev",0, 0,0,0),
+            O1("movsx","Gv,Eb"), O1("movsx","Gv,Ew"),
+   /* c0 */ O1("xadd","Eb,Gb"), O1("xadd","Ev,Gv"),
+            {{{"cmpps","Vx,Wx,Ib",CMP,"Vx,Hx,Wx,Ib"},
+              {"cmppd","Vx,Wx,Ib",CMP,"Vx,Hx,Wx,Ib"},
+              {"cmpss","Vo,Wd,Ib",CMP,"Vo,Ho,Wd,Ib"},
+              {"cmpsd","Vo,Wq,Ib",CMP,"Vo,Ho,Wq,Ib"}}},
+            {{{"movnti","My,Gy"}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD}}},
+            {{{"pinsrw","Pq,Rw,Ib"},
+              {"pinsrw","Vo,Rw,Ib",0,"Vo,Ho,Rw,Ib",VL0}}},
+            {{{"pextrw","Gd,Nq,Ib"},
+              {"pextrw","Gd,Uo,Ib",0,"Gd,Uo,Ib",VL0|VRM}}},
+            SSE("shufps","Vx,Wx,Ib","Vx,Hx,Wx,Ib",
+                "shufpd","Vx,Wx,Ib","Vx,Hx,Wx,Ib", 0,0,0, 0,0,0),
+            O1F(0,0,SPEC),
+   /* c8 */ O1("bswap","Zv"), O1("bswap","Zv"), O1("bswap","Zv"),
+            O1("bswap","Zv"), O1("bswap","Zv"), O1("bswap","Zv"),
+            O1("bswap","Zv"), O1("bswap","Zv"),
+   /* d0 */ SSE(0,0,0, "addsubpd","Vx,Wx","Vx,Hx,Wx", 0,0,0,
+                "addsubps","Vx,Wx","Vx,Hx,Wx"),
+            MMX_SHIFT("psrlw"), MMX_SHIFT("psrld"), MMX_SHIFT("psrlq"),
+            MMX("paddq","Qq"), MMX("pmullw","Qq"),
+            {{{0,0,0,0}, {"movq","Wq,Vo",0,"Wq,Vo",VL0},
+              {"movq2dq","Vo,Nq"}, {"movdq2q","Pq,Uo"}}},
+            SSE("pmovmskb","Gy,Nq",0, "pmovmskb","Gy,Ux","Gy,Ux",
+                "pmovmskb","Gy,Nq",0, "pmovmskb","Gy,Nq",0),
+   /* d8 */ MMX("psubusb","Qq"), MMX("psubusw","Qq"), MMX("pminub","Qq"),
+            MMX("pand","Qq"), MMX("paddusb","Qq"), MMX("paddusw","Qq"),
+            MMX("pmaxub","Qq"), MMX("pandn","Qq"),
+   /* e0 */ MMX("pavgb","Qq"), MMX_SHIFT("psraw"), MMX_SHIFT("psrad"),
+            MMX("pavgw","Qq"), MMX("pmulhuw","Qq"), MMX("pmulhw","Qq"),
+            SSE(0,0,0, "cvttpd2dq","Vo,Wx","Vo,Wx", "cvtdq2pd","Vo,Wq","Vx,Wh",
+                "cvtpd2dq","Vo,Wx","Vo,Wx"),
+            SSE("movntq","Mq,Pq",0, "movntdq","Mx,Vx","Mx,Vx", 0,0,0, 0,0,0),
+   /* e8 */ MMX("psubsb","Qq"), MMX("psubsw","Qq"), MMX("pminsw","Qq"),
+            MMX("por","Qq"), MMX("paddsb","Qq"), MMX("paddsw","Qq"),
+            MMX("pmaxsw","Qq"), MMX("pxor","Qq"),
+   /* f0 */ SSE(0,0,0, 0,0,0, 0,0,0, "lddqu","Vx,M_","Vx,M_"),
+            MMX_SHIFT("psllw"), MMX_SHIFT("pslld"), MMX_SHIFT("psllq"),
+            MMX("pmuludq","Qq"), MMX("pmaddwd","Qq"), MMX("psadbw","Qq"),
+            {{{"maskmovq","Pq,Nq"}, {"maskmovdqu","Vo,Uo",0,"Vo,Uo",VL0|VRM}}},
+   /* f8 */ MMX("psubb","Qq"), MMX("psubw","Qq"), MMX("psubd","Qq"),
+            MMX("psubq","Qq"), MMX("paddb","Qq"), MMX("paddw","Qq"),
+            MMX("paddd","Qq"), O1("ud0","Gv,Ev"),
+};
+
+/* three-byte map 0f 38: only the forms compilers emit */
+struct Op38 {
+   uint8_t opcode;
+   Op4 op;
+};
+
+/* no mandatory prefix: any is (bad) */
+#define NP(m,a) {{{m,a}, {0,0,BAD}}}
+#define SSSE3(m) SSE(m,"Pq,Qq",0, m,"Vx,Wx","Vx,Hx,Wx", 0,0,0, 0,0,0)
+#define PABS(m) SSE(m,"Pq,Qq",0, m,"Vx,Wx","Vx,Wx", 0,0,0, 0,0,0)
+#define SSE4(m,a,v) SSE(0,0,0, m,a,v, 0,0,0, 0,0,0)
+#define AVX(m,v) SSE4(m,nullptr,v)
+#define SSE4V(m,a,v,f) {{{0,0,0,0}, {m,a,0,v,f}}}
+#define AVXV(m,v,f) SSE4V(m,nullptr,v,f)
+#define FMA4(n,m) \
+   {n, AVX(m "ps","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")}, \
+   {n + 1, AVX(m "pd","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")}, \
+   {n + 2, AVX(m "ss","Vo,Ho,Wd,Lo/Vo,Ho,Lo,Wd")}, \
+   {n + 3, AVX(m "sd","Vo,Ho,Wq,Lo/Vo,Ho,Lo,Wq")}
+#define FMA(m,n) \
+   {0x96 + n, AVX("fmaddsub" m "ps/fmaddsub" m "pd","Vx,Hx,Wx")}, \
+   {0x97 + n, AVX("fmsubadd" m "ps/fmsubadd" m "pd","Vx,Hx,Wx")}, \
+   {0x98 + n, AVX("fmadd" m "ps/fmadd" m "pd","Vx,Hx,Wx")}, \
+   {0x99 + n, AVX("fmadd" m "ss/fmadd" m "sd","Vo,Ho,Wf")}, \
+   {0x9a + n, AVX("fmsub" m "ps/fmsub" m "pd","Vx,Hx,Wx")}, \
+   {0x9b + n, AVX("fmsub" m "ss/fmsub" m "sd","Vo,Ho,Wf")}, \
+   {0x9c + n, AVX("fnmadd" m "ps/fnmadd" m "pd","Vx,Hx,Wx")}, \
+   {0x9d + n, AVX("fnmadd" m "ss/fnmadd" m "sd","Vo,Ho,Wf")}, \
+   {0x9e + n, AVX("fnmsub" m "ps/fnmsub" m "pd","Vx,Hx,Wx")}, \
+   {0x9f + n, AVX("fnmsub" m "ss/fnmsub" m "sd","Vo,Ho,Wf")}
+/* BMI: general registers, no "v" prefix */
+#define BMI(m0,v0,m1,v1,m2,v2,m3,v3) \
+   {{{m0,0,PLAIN,v0,VL0}, {m1,0,PLAIN,v1,VL0}, {m2,0,PLAIN,v2,VL0}, \
+     {m3,0,PLAIN,v3,VL0}}}
+/* AMX: tile registers, no "v" prefix */
+#define AMX(m0,v0,m1,v1,m2,v2,m3,v3) \
+   {{{m0,0,PLAIN,v0,VL0|VW0}, {m1,0,PLAIN,v1,VL0|VW0}, \
+     {m2,0,PLAIN,v2,VL0|VW0}, {m3,0,PLAIN,v3,VL0|VW0}}}
+/* CMPccXADD: memory only */
+#define CMPXADD(n,cc) \
+   {n, {{{0,0,0,0}, {"cmp" cc "xadd",0,PLAIN,"My,Gy,By",VRM}}}}
+
+static const Op38 THREE_38[] = {
+   {0x00, SSSE3("pshufb")}, {0x01, SSSE3("phaddw")}, {0x02, SSSE3("phaddd")},
+   {0x03, SSSE3("phaddsw")}, {0x04, SSSE3("pmaddubsw")},
+   {0x05, SSSE3("phsubw")}, {0x06, SSSE3("phsubd")}, {0x07, SSSE3("phsubsw")},
+   {0x08, SSSE3("psignb")}, {0x09, SSSE3("psignw")}, {0x0a, SSSE3("psignd")},
+   {0x0b, SSSE3("pmulhrsw")},
+   {0x0c, AVXV("permilps","Vx,Hx,Wx",VW0)},
+   {0x0d, AVXV("permilpd","Vx,Hx,Wx",VW0)},
+   {0x0e, AVXV("testps","Vx,Wx",VW0)}, {0x0f, AVXV("testpd","Vx,Wx",VW0)},
+   {0x10, SSE4("pblendvb","Vx,Wx,XMM0",nullptr)},
+   {0x14, SSE4("blendvps","Vx,Wx,XMM0",nullptr)},
+   {0x15, SSE4("blendvpd","Vx,Wx,XMM0",nullptr)},
+   {0x13, AVXV("cvtph2ps","Vx,Wh",VW0)},
+   {0x16, AVXV("permps","Vx,Hx,Wx",VL1|VW0)},
+   {0x17, SSE4("ptest","Vx,Wx","Vx,Wx")},
+   {0x18, AVXV("broadcastss","Vx,Wd",VW0)},
+   {0x19, AVXV("broadcastsd","Vx,Wq",VL1|VW0)},
+   {0x1a, AVXV("broadcastf128","Vx,Mo",VL1|VW0)},
+   {0x1c, PABS("pabsb")}, {0x1d, PABS("pabsw")}, {0x1e, PABS("pabsd")},
+   {0x20, SSE4("pmovsxbw","Vo,Wq","Vx,Wh")},
+   {0x21, SSE4("pmovsxbd","Vo,Wd","Vx,Wu")},
+   {0x22, SSE4("pmovsxbq","Vo,Ww","Vx,We")},
+   {0x23, SSE4("pmovsxwd","Vo,Wq","Vx,Wh")},
+   {0x24, SSE4("pmovsxwq","Vo,Wd","Vx,Wu")},
+   {0x25, SSE4("pmovsxdq","Vo,Wq","Vx,Wh")},
+   {0x28, SSE4("pmuldq","Vx,Wx","Vx,Hx,Wx")},
+   {0x29, SSE4("pcmpeqq","Vx,Wx","Vx,Hx,Wx")},
+   {0x2a, SSE4("movntdqa","Vx,Mx","Vx,Mx")},
+   {0x2b, SSE4("packusdw","Vx,Wx","Vx,Hx,Wx")},
+   {0x2c, AVXV("maskmovps","Vx,Hx,Mx",VW0)},
+   {0x2d, AVXV("maskmovpd","Vx,Hx,Mx",VW0)},
+   {0x2e, AVXV("maskmovps","Mx,Hx,Vx",VW0)},
+   {0x2f, AVXV("maskmovpd","Mx,Hx,Vx",VW0)},
+   {0x30, SSE4("pmovzxbw","Vo,Wq","Vx,Wh")},
+   {0x31, SSE4("pmovzxbd","Vo,Wd","Vx,Wu")},
+   {0x32, SSE4("pmovzxbq","Vo,Ww","Vx,We")},
+   {0x33, SSE4("pmovzxwd","Vo,Wq","Vx,Wh")},
+   {0x34, SSE4("pmovzxwq","Vo,Wd","Vx,Wu")},
+   {0x35, SSE4("pmovzxdq","Vo,Wq","Vx,Wh")},
+   {0x36, AVXV("permd","Vx,Hx,Wx",VL1|VW0)},
+   {0x37, SSE4("pcmpgtq","Vx,Wx","Vx,Hx,Wx")},
+   {0x38, SSE4("pminsb","Vx,Wx","Vx,Hx,Wx")},
+   {0x39, SSE4("pminsd","Vx,Wx","Vx,Hx,Wx")},
+   {0x3a, SSE4("pminuw","Vx,Wx","Vx,Hx,Wx")},
+   {0x3b, SSE4("pminud","Vx,Wx","Vx,Hx,Wx")},
+   {0x3c, SSE4("pmaxsb","Vx,Wx","Vx,Hx,Wx")},
+   {0x3d, SSE4("pmaxsd","Vx,Wx","Vx,Hx,Wx")},
+   {0x3e, SSE4("pmaxuw","Vx,Wx","Vx,Hx,Wx")},
+   {0x3f, SSE4("pmaxud","Vx,Wx","Vx,Hx,Wx")},
+   {0x40, SSE4("pmulld","Vx,Wx","Vx,Hx,Wx")},
+   {0x41, SSE4V("phminposuw","Vo,Wo","Vo,Wo",VL0)},
+   {0x45, AVX("psrlvd/psrlvq","Vx,Hx,Wx")},
+   {0x46, AVXV("psravd","Vx,Hx,Wx",VW0)},
+   {0x47, AVX("psllvd/psllvq","Vx,Hx,Wx")},
+   {0x49, AMX("ldtilecfg","|M_", "sttilecfg","|M_", 0,0, "tilezero","tG|")},
+   {0x4b, AMX(0,0, "tileloaddt1","|tG,tM", "tilestored","|tM,tG",
+              "tileloadd","|tG,tM")},
+   {0x50, {{{"pdpbuud",0,0,"Vx,Hx,Wx",VW0},
+            {"{vex} vpdpbusd",0,PLAIN,"Vx,Hx,Wx",VW0},
+            {"pdpbsud",0,0,"Vx,Hx,Wx",VW0},
+            {"pdpbssd",0,0,"Vx,Hx,Wx",VW0}}}},
+   {0x51, {{{"pdpbuuds",0,0,"Vx,Hx,Wx",VW0},
+            {"{vex} vpdpbusds",0,PLAIN,"Vx,Hx,Wx",VW0},
+            {"pdpbsuds",0,0,"Vx,Hx,Wx",VW0},
+            {"pdpbssds",0,0,"Vx,Hx,Wx",VW0}}}},
+   {0x52, {{{0,0,0,0}, {"{vex} vpdpwssd",0,PLAIN,"Vx,Hx,Wx",VW0}}}},
+   {0x53, {{{0,0,0,0}, {"{vex} vpdpwssds",0,PLAIN,"Vx,Hx,Wx",VW0}}}},
+   {0x58, AVXV("pbroadcastd","Vx,Wd",VW0)},
+   {0x59, AVXV("pbroadcastq","Vx,Wq",VW0)},
+   {0x5a, AVXV("broadcasti128","Vx,Mo",VL1|VW0)},
+   {0x5c, AMX(0,0, 0,0, "tdpbf16ps","tG,tE,tH|", "tdpfp16ps","tG,tE,tH|")},
+   {0x5e, AMX("tdpbuud","tG,tE,tH|", "tdpbusd","tG,tE,tH|",
+              "tdpbsud","tG,tE,tH|", "tdpbssd","tG,tE,tH|")},
+   {0x72, {{{0,0,0,0}, {0,0,0,0},
+            {"{vex} vcvtneps2bf16",0,PLAIN,"Vo,Wx",VW0}}}},
+   {0x78, AVXV("pbroadcastb","Vx,Wb",VW0)},
+   {0x79, AVXV("pbroadcastw","Vx,Ww",VW0)},
+   {0x8c, AVX("pmaskmovd/pmaskmovq","Vx,Hx,Mx")},
+   {0x8e, AVX("pmaskmovd/pmaskmovq","Mx,Hx,Vx")},
+   {0x90, AVX("pgatherdd/pgatherdq","Vx,vdx,Hx/Vx,vqh,Hx")},
+   {0x91, AVX("pgatherqd/pgatherqq","Vh,vdx,Hh/Vx,vqx,Hx")},
+   {0x92, AVX("gatherdps/gatherdpd","Vx,vdx,Hx/Vx,vqh,Hx")},
+   {0x93, AVX("gatherqps/gatherqpd","Vh,vdx,Hh/Vx,vqx,Hx")},
+   FMA("132",0x00), FMA("213",0x10), FMA("231",0x20),
+   {0xb0, {{{"cvtneoph2ps",0,0,"Vx,Mx",VW0|VRM},
+            {"cvtneeph2ps",0,0,"Vx,Mx",VW0|VRM},
+            {"cvtneebf162ps",0,0,"Vx,Mx",VW0|VRM},
+            {"cvtneobf162ps",0,0,"Vx,Mx",VW0|VRM}}}},
+   {0xb1, {{{0,0,0,0}, {"bcstnesh2ps",0,0,"Vx,Mw",VW0|VRM},
+            {"bcstnebf162ps",0,0,"Vx,Mw",VW0|VRM}}}},
+   {0xb4, {{{0,0,0,0}, {"{vex} vpmadd52luq",0,PLAIN,"Vx,Hx,Wx",VW1}}}},
+   {0xb5, {{{0,0,0,0}, {"{vex} vpmadd52huq",0,PLAIN,"Vx,Hx,Wx",VW1}}}},
+   {0xc8, NP("sha1nexte","Vo,Wo")}, {0xc9, NP("sha1msg1","Vo,Wo")},
+   {0xca, NP("sha1msg2","Vo,Wo")}, {0xcb, NP("sha256rnds2","Vo,Wo,XMM0")},
+   {0xcc, NP("sha256msg1","Vo,Wo")}, {0xcd, NP("sha256msg2","Vo,Wo")},
+   {0xcf, SSE4V("gf2p8mulb","Vx,Wx","Vx,Hx,Wx",VW0)},
+   {0xdb, SSE4V("aesimc","Vo,Wo","Vo,Wo",VL0)},
+   {0xdc, SSE4("aesenc","Vo,Wo","Vx,Hx,Wx")},
+   {0xdd, SSE4("aesenclast","Vo,Wo","Vx,Hx,Wx")},
+   {0xde, SSE4("aesdec","Vo,Wo","Vx,Hx,Wx")},
+   {0xdf, SSE4("aesdeclast","Vo,Wo","Vx,Hx,Wx")},
+   CMPXADD(0xe0,"o"), CMPXADD(0xe1,"no"), CMPXADD(0xe2,"b"),
+   CMPXADD(0xe3,"nb"), CMPXADD(0xe4,"z"), CMPXADD(0xe5,"nz"),
+   CMPXADD(0xe6,"be"), CMPXADD(0xe7,"nbe"), CMPXADD(0xe8,"s"),
+   CMPXADD(0xe9,"ns"), CMPXADD(0xea,"p"), CMPXADD(0xeb,"np"),
+   CMPXADD(0xec,"l"), CMPXADD(0xed,"nl"), CMPXADD(0xee,"le"),
+   CMPXADD(0xef,"nle"),
+   {0xf0, SSE("movbe","Gv,Mv",0, "movbe","Gv,Mv",0, 0,0,0,
+              "crc32","Gy,Eb",0)},
+   {0xf1, SSE("movbe","Mv,Gv",0, "movbe","Mv,Gv",0, 0,0,0,
+              "crc32","Gy,Ev",0)},
+   {0xf2, BMI("andn","Gy,By,Ey", 0,0, 0,0, 0,0)},
+   {0xf5, {{{"bzhi",0,PLAIN,"Gy,Ey,By",VL0}, {"wruss","M_,Gy"},
+            {"pext",0,PLAIN,"Gy,By,Ey",VL0}, {"pdep",0,PLAIN,"Gy,By,Ey",VL0}}}},
+   {0xf6, {{{"wrss","M_,Gy"}, {"adcx","Gy,Ey",0,0}, {"adox","Gy,Ey",0,0},
+            {"mulx",0,PLAIN,"Gy,By,Ey",VL0}}}},
+   {0xf7, BMI("bextr","Gy,Ey,By", "shlx","Gy,Ey,By", "sarx","Gy,Ey,By",
+              "shrx","Gy,Ey,By")},
+   {0xf8, {{{0,0,0,0}, {"movdir64b","Ga,M_"}, {"enqcmds","Ga,M_"},
+            {"enqcmd","Ga,M_"}}}},
+   {0xf9, NP("movdiri","My,Gy")},
+   {0xfc, {{{"aadd","My,Gy"}, {"aand","My,Gy"}, {"axor","My,Gy"},
+            {"aor","My,Gy"}}}},
+};
+
+static const Op38 THREE_3A[] = {
+   {0x00, AVXV("permq","Vx,Wx,Ib",VL1|VW1)},
+   {0x01, AVXV("permpd","Vx,Wx,Ib",VL1|VW1)},
+   {0x02, AVXV("pblendd","Vx,Hx,Wx,Ib",VW0)},
+   {0x04, AVXV("permilps","Vx,Wx,Ib",VW0)},
+   {0x05, AVXV("permilpd","Vx,Wx,Ib",VW0)},
+   {0x06, AVXV("perm2f128","Vx,Hx,Wx,Ib",VL1|VW0)},
+   {0x08, SSE4("roundps","Vx,Wx,Ib","Vx,Wx,Ib")},
+   {0x09, SSE4("roundpd","Vx,Wx,Ib","Vx,Wx,Ib")},
+   {0x0a, SSE4("roundss","Vo,Wd,Ib","Vo,Ho,Wd,Ib")},
+   {0x0b, SSE4("roundsd","Vo,Wq,Ib","Vo,Ho,Wq,Ib")},
+   {0x0c, SSE4("blendps","Vx,Wx,Ib","Vx,Hx,Wx,Ib")},
+   {0x0d, SSE4("blendpd","Vx,Wx,Ib","Vx,Hx,Wx,Ib")},
+   {0x0e, SSE4("pblendw","Vx,Wx,Ib","Vx,Hx,Wx,Ib")},
+   {0x0f, SSE("palignr","Pq,Qq,Ib",0, "palignr","Vx,Wx,Ib","Vx,Hx,Wx,Ib",
+              0,0,0, 0,0,0)},
+   {0x14, SSE4V("pextrb","Rb,Vo,Ib","Rb,Vo,Ib",VL0)},
+   {0x15, SSE4V("pextrw","Rw,Vo,Ib","Rw,Vo,Ib",VL0)},
+   {0x16, SSE4V("pextr","Ey,Vo,Ib","Ey,Vo,Ib",VL0)},
+   {0x17, SSE4V("extractps","Ed,Vo,Ib","Ed,Vo,Ib",VL0)},
+   {0x18, AVXV("insertf128","Vx,Hx,Wo,Ib",VL1|VW0)},
+   {0x19, AVXV("extractf128","Wo,Vx,Ib",VL1|VW0)},
+   {0x1d, AVXV("cvtps2ph","Wh,Vx,Ib",VW0)},
+   {0x20, SSE4V("pinsrb","Vo,Rb,Ib","Vo,Ho,Rb,Ib",VL0)},
+   {0x21, SSE4V("insertps","Vo,Wd,Ib","Vo,Ho,Wd,Ib",VL0)},
+   {0x22, SSE4V("pinsr","Vo,Ey,Ib","Vo,Ho,Ey,Ib",VL0)},
+   {0x38, AVXV("inserti128","Vx,Hx,Wo,Ib",VL1|VW0)},
+   {0x39, AVXV("extracti128","Wo,Vx,Ib",VL1|VW0)},
+   {0x40, SSE4("dpps","Vx,Wx,Ib","Vx,Hx,Wx,Ib")},
+   {0x41, SSE4V("dppd","Vo,Wo,Ib","Vo,Ho,Wo,Ib",VL0)},
+   {0x42, SSE4("mpsadbw","Vx,Wx,Ib","Vx,Hx,Wx,Ib")},
+   {0x44, SSE4("pclmulqdq","Vo,Wo,Ib","Vx,Hx,Wx,Ib")},
+   {0x46, AVXV("perm2i128","Vx,Hx,Wx,Ib",VL1|VW0)},
+   /* AMD XOP-era permute: imm8[3:0] after the is4 register is m2z */
+   {0x48, AVX("permil2ps","Vx,Hx,Wx,Lx,I4/Vx,Hx,Lx,Wx,I4")},
+   {0x49, AVX("permil2pd","Vx,Hx,Wx,Lx,I4/Vx,Hx,Lx,Wx,I4")},
+   {0x4a, AVXV("blendvps","Vx,Hx,Wx,Lx",VW0)},
+   {0x4b, AVXV("blendvpd","Vx,Hx,Wx,Lx",VW0)},
+   {0x4c, AVXV("pblendvb","Vx,Hx,Wx,Lx",VW0)},
+   /* AMD FMA4: VEX.W swaps the r/m and is4 sources */
+   {0x5c, AVX("fmaddsubps","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")},
+   {0x5d, AVX("fmaddsubpd","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")},
+   {0x5e, AVX("fmsubaddps","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")},
+   {0x5f, AVX("fmsubaddpd","Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx")},
+   {0x60, SSE4V("pcmpestrm/pcmpestrmq","Vo,Wo,Ib","Vo,Wo,Ib",VL0)},
+   {0x61, SSE4V("pcmpestri/pcmpestriq","Vo,Wo,Ib","Vo,Wo,Ib",VL0)},
+   {0x62, SSE4V("pcmpistrm","Vo,Wo,Ib","Vo,Wo,Ib",VL0)},
+   {0x63, SSE4V("pcmpistri","Vo,Wo,Ib","Vo,Wo,Ib",VL0)},
+   FMA4(0x68, "fmadd"), FMA4(0x6c, "fmsub"),
+   FMA4(0x78, "fnmadd"), FMA4(0x7c, "fnmsub"),
+   {0xcc, NP("sha1rnds4","Vo,Wo,Ib")},
+   {0xce, SSE4V("gf2p8affineqb","Vx,Wx,Ib","Vx,Hx,Wx,Ib",VW1)},
+   {0xcf, SSE4V("gf2p8affineinvqb","Vx,Wx,Ib","Vx,Hx,Wx,Ib",VW1)},
+   {0xdf, SSE4V("aeskeygenassist","Vo,Wo,Ib","Vo,Wo,Ib",VL0)},
+   {0xf0, BMI(0,0, 0,0, 0,0, "rorx","Gy,Ey,Ib")},
+};
+
+/* x87 memory forms: mnemonic and operand size, indexed by [opcode-d8][reg] */
+static const Op X87_MEM[8][8] = {
+   {{"fadd","Md"}, {"fmul","Md"}, {"fcom","Md"}, {"fcomp","Md"},
+    {"fsub","Md"}, {"fsubr","Md"}, {"fdiv","Md"}, {"fdivr","Md"}},
+   {{"fld","Md"}, {0,0,BAD}, {"fst","Md"}, {"fstp","Md"},
+    {"fldenv","M_"}, {"fldcw","Mw"}, {"fnstenv","M_"}, {"fnstcw","Mw"}},
+   {{"fiadd","Md"}, {"fimul","Md"}, {"ficom","Md"}, {"ficomp","Md"},
+    {"fisub","Md"}, {"fisubr","Md"}, {"fidiv","Md"}, {"fidivr","Md"}},
+   {{"fild","Md"}, {"fisttp","Md"}, {"fist","Md"}, {"fistp","Md"},
+    {0,0,BAD}, {"fld","Mt"}, {0,0,BAD}, {"fstp","Mt"}},
+   {{"fadd","Mq"}, {"fmul","Mq"}, {"fcom","Mq"}, {"fcomp","Mq"},
+    {"fsub","Mq"}, {"fsubr","Mq"}, {"fdiv","Mq"}, {"fdivr","Mq"}},
+   {{"fld","Mq"}, {"fisttp","Mq"}, {"fst","Mq"}, {"fstp","Mq"},
+    {"frstor","M_"}, {0,0,BAD}, {"fnsave","M_"}, {"fnstsw","Mw"}},
+   {{"fiadd","Mw"}, {"fimul","Mw"}, {"ficom","Mw"}, {"ficomp","Mw"},
+    {"fisub","Mw"}, {"fisubr","Mw"}, {"fidiv","Mw"}, {"fidivr","Mw"}},
+   {{"fild","Mw"}, {"fisttp","Mw"}, {"fist","Mw"}, {"fistp","Mw"},
+    {"fbld","Mt"}, {"fild","Mq"}, {"fbstp","Mt"}, {"fistp","Mq"}},
+};
+
+/* x87 register forms: "T" is st(i), indexed by [opcode-d8][reg] */
+static const Op X87_REG[8][8] = {
+   {{"fadd","ST,T"}, {"fmul","ST,T"}, {"fcom","T"}, {"fcomp","T"},
+    {"fsub","ST,T"}, {"fsubr","ST,T"}, {"fdiv","ST,T"}, {"fdivr","ST,T"}},
+   {{"fld","T"}, {"fxch","T"}, {0,0,SPEC}, {0,0,BAD},
+    {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC}, {0,0,SPEC}},
+   {{"fcmovb","ST,T"}, {"fcmove","ST,T"}, {"fcmovbe","ST,T"},
+    {"fcmovu","ST,T"}, {0,0,BAD}, {0,0,SPEC}, {0,0,BAD}, {0,0,BAD}},
+   {{"fcmovnb","ST,T"}, {"fcmovne","ST,T"}, {"fcmovnbe","ST,T"},
+    {"fcmovnu","ST,T"}, {0,0,SPEC}, {"fucomi","ST,T"}, {"fcomi","ST,T"},
+    {0,0,BAD}},
+   {{"fadd","T,ST"}, {"fmul","T,ST"}, {0,0,BAD}, {0,0,BAD},
+    {"fsubr","T,ST"}, {"fsub","T,ST"}, {"fdivr","T,ST"}, {"fdiv","T,ST"}},
+   {{"ffree","T"}, {0,0,BAD}, {"fst","T"}, {"fstp","T"},
+    {"fucom","T"}, {"fucomp","T"}, {0,0,BAD}, {0,0,BAD}},
+   {{"faddp","T,ST"}, {"fmulp","T,ST"}, {0,0,BAD}, {0,0,SPEC},
+    {"fsubrp","T,ST"}, {"fsubp","T,ST"}, {"fdivrp","T,ST"}, {"fdivp","T,ST"}},
+   {{"ffreep","T"}, {0,0,BAD}, {0,0,BAD}, {0,0,BAD},
+    {0,0,SPEC}, {"fucomip","ST,T"}, {"fcomip","ST,T"}, {0,0,BAD}},
+};
+
+static const char* const X87_D9[4][8] = {
+   {"fchs","fabs",0,0,"ftst","fxam",0,0},
+   {"fld1","fldl2t","fldl2e","fldpi","fldlg2","fldln2","fldz",0},
+   {"f2xm1","fyl2x","fptan","fpatan","fxtract","fprem1","fdecstp","fincstp"},
+   {"fprem","fyl2xp1","fsqrt","fsincos","frndint","fscale","fsin","fcos"},
+};
+
+/* EVEX (AVX-512) entries, sorted by map, opcode and mandatory prefix. Names  */
+/* and operands are those objdump prints, "{bad}" included for an EVEX.W it  */
+/* rejects; "r|m" gives register and memory forms that differ.               */
+/*   k    opmask register: kG reg, kE r/m, kH vvvv                           */
+/*   v    VSIB memory: element size, then index size (vdx, vqh)              */
+/*   m    size code: q for 128 bits, x otherwise (vmovddup)                  */
+enum: uint16_t {
+   EV_NONE = 0,
+   EV_VEX = 1,          /* also VEX-encodable: objdump tells with {evex} */
+   EV_ER = 2,           /* EVEX.b on registers is rounding control */
+   EV_SAE = 4,          /* EVEX.b on registers suppresses exceptions */
+   EV_BC = 8,           /* EVEX.b on memory broadcasts a d or q (EVEX.W) */
+   EV_BCW = 16,         /* EVEX.b on memory broadcasts a word */
+   EV_L128 = 32,        /* vector lengths other than these are (bad) */
+   EV_L512 = 64,
+   EV_NO128 = 128,
+   EV_T1 = 256,         /* disp8 scales by a d or q element (EVEX.W) */
+   EV_T1BW = 512,       /* disp8 scales by a b or w element (EVEX.W) */
+   EV_CMP = 1024,       /* imm8 selects a vcmp pseudo-op */
+   EV_PCMP = 2048,      /* imm8 selects a vpcmp pseudo-op */
+   EV_NOREG = 4096,     /* memory form only */
+   EV_NOMEM = 8192,     /* register form only */
+   EV_DEST = 16384,     /* the destination must differ from the sources */
+   EV_RCBAD = 32768,    /* EVEX.b on registers: "{rX-bad}" on the last one */
+};
+
+struct OpEvex {
+   uint8_t map;
+   uint8_t opcode;
+   uint8_t pp;          /* mandatory prefix: none, 66, F3, F2 */
+   uint8_t w;           /* EVEX.W, 2 if either */
+   int8_t reg;          /* ModRM.reg of group entries, -1 otherwise */
+   const char* mnem;
+   const char* args;
+   uint16_t flags;
+};
+
+static const OpEvex EVEX[] = {
+   {1, 0x10, 0, 2, -1, "vmovups", "Vx,Wx", EV_VEX},
+   {1, 0x10, 1, 2, -1, "vmovupd", "Vx,Wx", EV_VEX},
+   {1, 0x10, 2, 0, -1, "vmovss", "Vo,Ho,Wo|Vo,Wd", EV_VEX},
+   {1, 0x10, 2, 1, -1, "vmovs{bad}", "Vo,Ho,Wo|Vo,Wd", EV_VEX},
+   {1, 0x10, 3, 0, -1, "vmovs{bad}", "Vo,Ho,Wo|Vo,Wq", EV_VEX},
+   {1, 0x10, 3, 1, -1, "vmovsd", "Vo,Ho,Wo|Vo,Wq", EV_VEX},
+   {1, 0x11, 0, 2, -1, "vmovups", "Wx,Vx", EV_VEX},
+   {1, 0x11, 1, 2, -1, "vmovupd", "Wx,Vx", EV_VEX},
+   {1, 0x11, 2, 0, -1, "vmovss", "Wx,Ho,Vo|Wd,Vo", EV_VEX},
+   {1, 0x11, 2, 1, -1, "vmovs{bad}", "Wx,Ho,Vo|Wd,Vo", EV_VEX},
+   {1, 0x11, 3, 0, -1, "vmovs{bad}", "Wx,Ho,Vo|Wq,Vo", EV_VEX},
+   {1, 0x11, 3, 1, -1, "vmovsd", "Wx,Ho,Vo|Wq,Vo", EV_VEX},
+   {1, 0x12, 0, 0, -1, "vmovhlps|vmovlps", "Vo,Ho,Wq", EV_VEX|EV_L128},
+   {1, 0x12, 0, 1, -1, "vmovhlp{bad}|vmovlps", "Vo,Ho,Wq", EV_VEX|EV_L128},
+   {1, 0x12, 1, 2, -1, "vmovlpd", "Vo,Ho,Wq", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x12, 2, 0, -1, "vmovsldup", "Vx,Wx", EV_VEX},
+   {1, 0x12, 2, 1, -1, "vmov{bad}ldup", "Vx,Wx", EV_VEX},
+   {1, 0x12, 3, 0, -1, "vmov{bad}dup", "Vx,Wm", EV_VEX},
+   {1, 0x12, 3, 1, -1, "vmovddup", "Vx,Wm", EV_VEX},
+   {1, 0x13, 0, 0, -1, "vmovlps", "Wq,Vo", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x13, 1, 1, -1, "vmovlpd", "Wq,Vo", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x14, 0, 0, -1, "vunpcklps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x14, 1, 1, -1, "vunpcklpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x15, 0, 0, -1, "vunpckhps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x15, 1, 1, -1, "vunpckhpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x16, 0, 0, -1, "vmovlhps|vmovhps", "Vo,Ho,Wq", EV_VEX|EV_L128},
+   {1, 0x16, 0, 1, -1, "vmovlhp{bad}|vmovhps", "Vo,Ho,Wq", EV_VEX|EV_L128},
+   {1, 0x16, 1, 2, -1, "vmovhpd", "Vo,Ho,Wq", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x16, 2, 0, -1, "vmovshdup", "Vx,Wx", EV_VEX},
+   {1, 0x16, 2, 1, -1, "vmov{bad}hdup", "Vx,Wx", EV_VEX},
+   {1, 0x17, 0, 0, -1, "vmovhps", "Wq,Vo", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x17, 1, 1, -1, "vmovhpd", "Wq,Vo", EV_VEX|EV_L128|EV_NOREG},
+   {1, 0x28, 0, 0, -1, "vmovaps", "Vx,Wx", EV_VEX|EV_BC},
+   {1, 0x28, 1, 1, -1, "vmovapd", "Vx,Wx", EV_VEX|EV_BC},
+   {1, 0x29, 0, 0, -1, "vmovaps", "Wx,Vx", EV_VEX},
+   {1, 0x29, 1, 1, -1, "vmovapd", "Wx,Vx", EV_VEX},
+   {1, 0x2a, 2, 0, -1, "vcvtsi2ss", "Vo,Ho,Ed", EV_VEX|EV_ER},
+   {1, 0x2a, 2, 1, -1, "vcvtsi2ss", "Vo,Ho,Eq", EV_VEX|EV_ER},
+   {1, 0x2a, 3, 0, -1, "vcvtsi2sd", "Vo,Ho,Ed", EV_VEX|EV_RCBAD},
+   {1, 0x2a, 3, 1, -1, "vcvtsi2sd", "Vo,Ho,Eq", EV_VEX|EV_ER},
+   {1, 0x2b, 0, 0, -1, "vmovntps", "Wx,Vx", EV_VEX|EV_BC|EV_NOREG},
+   {1, 0x2b, 1, 1, -1, "vmovntpd", "Wx,Vx", EV_VEX|EV_BC|EV_NOREG},
+   {1, 0x2c, 2, 0, -1, "vcvttss2si", "Gd,Wd", EV_VEX|EV_SAE},
+   {1, 0x2c, 2, 1, -1, "vcvttss2si", "Gq,Wd", EV_VEX|EV_SAE},
+   {1, 0x2c, 3, 0, -1, "vcvttsd2si", "Gd,Wq", EV_VEX|EV_SAE},
+   {1, 0x2c, 3, 1, -1, "vcvttsd2si", "Gq,Wq", EV_VEX|EV_SAE},
+   {1, 0x2d, 2, 0, -1, "vcvtss2si", "Gd,Wd", EV_VEX|EV_ER},
+   {1, 0x2d, 2, 1, -1, "vcvtss2si", "Gq,Wd", EV_VEX|EV_ER},
+   {1, 0x2d, 3, 0, -1, "vcvtsd2si", "Gd,Wq", EV_VEX|EV_ER},
+   {1, 0x2d, 3, 1, -1, "vcvtsd2si", "Gq,Wq", EV_VEX|EV_ER},
+   {1, 0x2e, 0, 2, -1, "vucomiss", "Vo,Wd", EV_VEX|EV_SAE},
+   {1, 0x2e, 1, 2, -1, "vucomisd", "Vo,Wq", EV_VEX|EV_SAE},
+   {1, 0x2f, 0, 2, -1, "vcomiss", "Vo,Wd", EV_VEX|EV_SAE},
+   {1, 0x2f, 1, 2, -1, "vcomisd", "Vo,Wq", EV_VEX|EV_SAE},
+   {1, 0x51, 0, 2, -1, "vsqrtps", "Vx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x51, 1, 2, -1, "vsqrtpd", "Vx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x51, 2, 0, -1, "vsqrtss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x51, 2, 1, -1, "vsqrts{bad}", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x51, 3, 0, -1, "vsqrts{bad}", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x51, 3, 1, -1, "vsqrtsd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x54, 0, 0, -1, "vandps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x54, 1, 1, -1, "vandpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x55, 0, 0, -1, "vandnps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x55, 1, 1, -1, "vandnpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x56, 0, 0, -1, "vorps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x56, 1, 1, -1, "vorpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x57, 0, 0, -1, "vxorps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x57, 1, 1, -1, "vxorpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x58, 0, 2, -1, "vaddps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x58, 1, 2, -1, "vaddpd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x58, 2, 0, -1, "vaddss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x58, 2, 1, -1, "vadds{bad}", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x58, 3, 0, -1, "vadds{bad}", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x58, 3, 1, -1, "vaddsd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x59, 0, 2, -1, "vmulps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x59, 1, 2, -1, "vmulpd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x59, 2, 0, -1, "vmulss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x59, 2, 1, -1, "vmuls{bad}", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x59, 3, 0, -1, "vmuls{bad}", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x59, 3, 1, -1, "vmulsd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5a, 0, 0, -1, "vcvtps2pd", "Vx,Wh", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5a, 0, 1, -1, "vcvtp{bad}2pd", "Vx,Wh", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5a, 1, 0, -1, "vcvtp{bad}2ps", "Vh,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5a, 1, 1, -1, "vcvtpd2ps", "Vh,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5a, 2, 0, -1, "vcvtss2sd", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5a, 2, 1, -1, "vcvts{bad}2sd", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5a, 3, 0, -1, "vcvts{bad}2ss", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5a, 3, 1, -1, "vcvtsd2ss", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5b, 0, 0, -1, "vcvtdq2ps", "Vx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5b, 0, 1, -1, "vcvtqq2ps", "Vh,Wx", EV_ER|EV_BC},
+   {1, 0x5b, 1, 0, -1, "vcvtps2dq", "Vx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5b, 1, 1, -1, "vcvtp{bad}2dq", "Vx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5b, 2, 0, -1, "vcvttps2dq", "Vx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5b, 2, 1, -1, "vcvttp{bad}2dq", "Vx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5c, 0, 2, -1, "vsubps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5c, 1, 2, -1, "vsubpd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5c, 2, 0, -1, "vsubss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x5c, 2, 1, -1, "vsubs{bad}", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x5c, 3, 0, -1, "vsubs{bad}", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5c, 3, 1, -1, "vsubsd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5d, 0, 2, -1, "vminps", "Vx,Hx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5d, 1, 2, -1, "vminpd", "Vx,Hx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5d, 2, 0, -1, "vminss", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5d, 2, 1, -1, "vmins{bad}", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5d, 3, 0, -1, "vmins{bad}", "Vo,Ho,Wq", EV_VEX|EV_SAE},
+   {1, 0x5d, 3, 1, -1, "vminsd", "Vo,Ho,Wq", EV_VEX|EV_SAE},
+   {1, 0x5e, 0, 2, -1, "vdivps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5e, 1, 2, -1, "vdivpd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0x5e, 2, 0, -1, "vdivss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x5e, 2, 1, -1, "vdivs{bad}", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {1, 0x5e, 3, 0, -1, "vdivs{bad}", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5e, 3, 1, -1, "vdivsd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {1, 0x5f, 0, 2, -1, "vmaxps", "Vx,Hx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5f, 1, 2, -1, "vmaxpd", "Vx,Hx,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0x5f, 2, 0, -1, "vmaxss", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5f, 2, 1, -1, "vmaxs{bad}", "Vo,Ho,Wd", EV_VEX|EV_SAE},
+   {1, 0x5f, 3, 0, -1, "vmaxs{bad}", "Vo,Ho,Wq", EV_VEX|EV_SAE},
+   {1, 0x5f, 3, 1, -1, "vmaxsd", "Vo,Ho,Wq", EV_VEX|EV_SAE},
+   {1, 0x60, 1, 2, -1, "vpunpcklbw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x61, 1, 2, -1, "vpunpcklwd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x62, 1, 0, -1, "vpunpckldq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x63, 1, 2, -1, "vpacksswb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x64, 1, 2, -1, "vpcmpgtb", "kG,Hx,Wx", EV_BC},
+   {1, 0x65, 1, 2, -1, "vpcmpgtw", "kG,Hx,Wx", EV_BC},
+   {1, 0x66, 1, 0, -1, "vpcmpgtd", "kG,Hx,Wx", EV_BC},
+   {1, 0x67, 1, 2, -1, "vpackuswb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x68, 1, 2, -1, "vpunpckhbw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x69, 1, 2, -1, "vpunpckhwd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x6a, 1, 0, -1, "vpunpckhdq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x6b, 1, 0, -1, "vpackssdw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x6c, 1, 1, -1, "vpunpcklqdq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x6d, 1, 1, -1, "vpunpckhqdq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0x6e, 1, 0, -1, "vmovd", "Vo,Ed", EV_VEX|EV_L128},
+   {1, 0x6e, 1, 1, -1, "vmovq", "Vo,Eq", EV_VEX|EV_L128},
+   {1, 0x6f, 1, 0, -1, "vmovdqa32", "Vx,Wx", EV_NONE},
+   {1, 0x6f, 1, 1, -1, "vmovdqa64", "Vx,Wx", EV_NONE},
+   {1, 0x6f, 2, 0, -1, "vmovdqu32", "Vx,Wx", EV_NONE},
+   {1, 0x6f, 2, 1, -1, "vmovdqu64", "Vx,Wx", EV_NONE},
+   {1, 0x6f, 3, 0, -1, "vmovdqu8", "Vx,Wx", EV_BC},
+   {1, 0x6f, 3, 1, -1, "vmovdqu16", "Vx,Wx", EV_BC},
+   {1, 0x70, 1, 0, -1, "vpshufd", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x70, 2, 2, -1, "vpshufhw", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x70, 3, 2, -1, "vpshuflw", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x71, 1, 2,  2, "vpsrlw", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x71, 1, 2,  4, "vpsraw", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x71, 1, 2,  6, "vpsllw", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x72, 1, 0,  0, "vprord", "Hx,Wx,Ib", EV_BC},
+   {1, 0x72, 1, 0,  1, "vprold", "Hx,Wx,Ib", EV_BC},
+   {1, 0x72, 1, 0,  2, "vpsrld", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x72, 1, 0,  4, "vpsrad", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x72, 1, 0,  6, "vpslld", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x72, 1, 1,  0, "vprorq", "Hx,Wx,Ib", EV_BC},
+   {1, 0x72, 1, 1,  1, "vprolq", "Hx,Wx,Ib", EV_BC},
+   {1, 0x72, 1, 1,  4, "vpsraq", "Hx,Wx,Ib", EV_BC},
+   {1, 0x73, 1, 2,  3, "vpsrldq", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x73, 1, 2,  7, "vpslldq", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x73, 1, 1,  2, "vpsrlq", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x73, 1, 1,  6, "vpsllq", "Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0x74, 1, 2, -1, "vpcmpeqb", "kG,Hx,Wx", EV_BC},
+   {1, 0x75, 1, 2, -1, "vpcmpeqw", "kG,Hx,Wx", EV_BC},
+   {1, 0x76, 1, 0, -1, "vpcmpeqd", "kG,Hx,Wx", EV_BC},
+   {1, 0x78, 0, 0, -1, "vcvttps2udq", "Vx,Wx", EV_SAE|EV_BC},
+   {1, 0x78, 0, 1, -1, "vcvttpd2udq", "Vh,Wx", EV_SAE|EV_BC},
+   {1, 0x78, 1, 0, -1, "vcvttps2uqq", "Vx,Wh", EV_SAE|EV_BC},
+   {1, 0x78, 1, 1, -1, "vcvttpd2uqq", "Vx,Wx", EV_SAE|EV_BC},
+   {1, 0x78, 2, 0, -1, "vcvttss2usi", "Gd,Wd", EV_SAE},
+   {1, 0x78, 2, 1, -1, "vcvttss2usi", "Gq,Wd", EV_SAE},
+   {1, 0x78, 3, 0, -1, "vcvttsd2usi", "Gd,Wq", EV_SAE},
+   {1, 0x78, 3, 1, -1, "vcvttsd2usi", "Gq,Wq", EV_SAE},
+   {1, 0x79, 0, 0, -1, "vcvtps2udq", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0x79, 0, 1, -1, "vcvtpd2udq", "Vh,Wx", EV_ER|EV_BC},
+   {1, 0x79, 1, 0, -1, "vcvtps2uqq", "Vx,Wh", EV_ER|EV_BC},
+   {1, 0x79, 1, 1, -1, "vcvtpd2uqq", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0x79, 2, 0, -1, "vcvtss2usi", "Gd,Wd", EV_ER},
+   {1, 0x79, 2, 1, -1, "vcvtss2usi", "Gq,Wd", EV_ER},
+   {1, 0x79, 3, 0, -1, "vcvtsd2usi", "Gd,Wq", EV_ER},
+   {1, 0x79, 3, 1, -1, "vcvtsd2usi", "Gq,Wq", EV_ER},
+   {1, 0x7a, 1, 0, -1, "vcvttps2qq", "Vx,Wh", EV_SAE|EV_BC},
+   {1, 0x7a, 1, 1, -1, "vcvttpd2qq", "Vx,Wx", EV_SAE|EV_BC},
+   {1, 0x7a, 2, 0, -1, "vcvtudq2pd", "Vx,Wh", EV_BC},
+   {1, 0x7a, 2, 1, -1, "vcvtuqq2pd", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0x7a, 3, 0, -1, "vcvtudq2ps", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0x7a, 3, 1, -1, "vcvtuqq2ps", "Vh,Wx", EV_ER|EV_BC},
+   {1, 0x7b, 1, 0, -1, "vcvtps2qq", "Vx,Wh", EV_ER|EV_BC},
+   {1, 0x7b, 1, 1, -1, "vcvtpd2qq", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0x7b, 2, 0, -1, "vcvtusi2ss", "Vo,Ho,Ed", EV_ER},
+   {1, 0x7b, 2, 1, -1, "vcvtusi2ss", "Vo,Ho,Eq", EV_ER},
+   {1, 0x7b, 3, 0, -1, "vcvtusi2sd", "Vo,Ho,Ed", EV_RCBAD},
+   {1, 0x7b, 3, 1, -1, "vcvtusi2sd", "Vo,Ho,Eq", EV_ER},
+   {1, 0x7e, 1, 0, -1, "vmovd", "Ed,Vo", EV_VEX|EV_L128},
+   {1, 0x7e, 1, 1, -1, "vmovq", "Eq,Vo", EV_VEX|EV_L128},
+   {1, 0x7e, 2, 1, -1, "vmovq", "Vo,Wq", EV_VEX|EV_L128},
+   {1, 0x7f, 1, 0, -1, "vmovdqa32", "Wx,Vx", EV_NONE},
+   {1, 0x7f, 1, 1, -1, "vmovdqa64", "Wx,Vx", EV_NONE},
+   {1, 0x7f, 2, 0, -1, "vmovdqu32", "Wx,Vx", EV_NONE},
+   {1, 0x7f, 2, 1, -1, "vmovdqu64", "Wx,Vx", EV_NONE},
+   {1, 0x7f, 3, 0, -1, "vmovdqu8", "Wx,Vx", EV_NONE},
+   {1, 0x7f, 3, 1, -1, "vmovdqu16", "Wx,Vx", EV_NONE},
+   {1, 0xc2, 0, 0, -1, "vcmpps", "kG,Hx,Wx,Ib", EV_SAE|EV_BC|EV_CMP},
+   {1, 0xc2, 1, 1, -1, "vcmppd", "kG,Hx,Wx,Ib", EV_SAE|EV_BC|EV_CMP},
+   {1, 0xc2, 2, 0, -1, "vcmpss", "kG,Ho,Wd,Ib", EV_SAE|EV_CMP},
+   {1, 0xc2, 2, 1, -1, "vcmps{bad}", "kG,Ho,Wd,Ib", EV_SAE|EV_CMP},
+   {1, 0xc2, 3, 0, -1, "vcmps{bad}", "kG,Ho,Wq,Ib", EV_SAE|EV_CMP},
+   {1, 0xc2, 3, 1, -1, "vcmpsd", "kG,Ho,Wq,Ib", EV_SAE|EV_CMP},
+   {1, 0xc4, 1, 2, -1, "vpinsrw", "Vo,Ho,Rw,Ib", EV_VEX|EV_L128},
+   {1, 0xc5, 1, 2, -1, "vpextrw", "Gd,Uo,Ib", EV_VEX|EV_L128},
+   {1, 0xc6, 0, 0, -1, "vshufps", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0xc6, 1, 1, -1, "vshufpd", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {1, 0xd1, 1, 2, -1, "vpsrlw", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xd2, 1, 0, -1, "vpsrld", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xd3, 1, 1, -1, "vpsrlq", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xd4, 1, 1, -1, "vpaddq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xd5, 1, 2, -1, "vpmullw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xd6, 1, 1, -1, "vmovq", "Wq,Vo", EV_VEX|EV_L128},
+   {1, 0xd8, 1, 2, -1, "vpsubusb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xd9, 1, 2, -1, "vpsubusw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xda, 1, 2, -1, "vpminub", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xdb, 1, 0, -1, "vpandd", "Vx,Hx,Wx", EV_BC},
+   {1, 0xdb, 1, 1, -1, "vpandq", "Vx,Hx,Wx", EV_BC},
+   {1, 0xdc, 1, 2, -1, "vpaddusb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xdd, 1, 2, -1, "vpaddusw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xde, 1, 2, -1, "vpmaxub", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xdf, 1, 0, -1, "vpandnd", "Vx,Hx,Wx", EV_BC},
+   {1, 0xdf, 1, 1, -1, "vpandnq", "Vx,Hx,Wx", EV_BC},
+   {1, 0xe0, 1, 2, -1, "vpavgb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xe1, 1, 2, -1, "vpsraw", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xe2, 1, 0, -1, "vpsrad", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xe2, 1, 1, -1, "vpsraq", "Vx,Hx,Wo", EV_NONE},
+   {1, 0xe3, 1, 2, -1, "vpavgw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xe4, 1, 2, -1, "vpmulhuw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xe5, 1, 2, -1, "vpmulhw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xe6, 1, 0, -1, "vcvttp{bad}2dq", "Vh,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0xe6, 1, 1, -1, "vcvttpd2dq", "Vh,Wx", EV_VEX|EV_SAE|EV_BC},
+   {1, 0xe6, 2, 0, -1, "vcvtdq2pd", "Vx,Wh", EV_VEX|EV_BC},
+   {1, 0xe6, 2, 1, -1, "vcvtqq2pd", "Vx,Wx", EV_ER|EV_BC},
+   {1, 0xe6, 3, 0, -1, "vcvtp{bad}2dq", "Vh,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0xe6, 3, 1, -1, "vcvtpd2dq", "Vh,Wx", EV_VEX|EV_ER|EV_BC},
+   {1, 0xe7, 1, 0, -1, "vmovntdq", "Wx,Vx", EV_VEX},
+   {1, 0xe8, 1, 2, -1, "vpsubsb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xe9, 1, 2, -1, "vpsubsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xea, 1, 2, -1, "vpminsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xeb, 1, 0, -1, "vpord", "Vx,Hx,Wx", EV_BC},
+   {1, 0xeb, 1, 1, -1, "vporq", "Vx,Hx,Wx", EV_BC},
+   {1, 0xec, 1, 2, -1, "vpaddsb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xed, 1, 2, -1, "vpaddsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xee, 1, 2, -1, "vpmaxsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xef, 1, 0, -1, "vpxord", "Vx,Hx,Wx", EV_BC},
+   {1, 0xef, 1, 1, -1, "vpxorq", "Vx,Hx,Wx", EV_BC},
+   {1, 0xf1, 1, 2, -1, "vpsllw", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xf2, 1, 0, -1, "vpslld", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xf3, 1, 1, -1, "vpsllq", "Vx,Hx,Wo", EV_VEX},
+   {1, 0xf4, 1, 1, -1, "vpmuludq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xf5, 1, 2, -1, "vpmaddwd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xf6, 1, 2, -1, "vpsadbw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xf8, 1, 2, -1, "vpsubb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xf9, 1, 2, -1, "vpsubw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xfa, 1, 0, -1, "vpsubd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xfb, 1, 1, -1, "vpsubq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xfc, 1, 2, -1, "vpaddb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xfd, 1, 2, -1, "vpaddw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {1, 0xfe, 1, 0, -1, "vpaddd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x00, 1, 2, -1, "vpshufb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x04, 1, 2, -1, "vpmaddubsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x0b, 1, 2, -1, "vpmulhrsw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x0c, 1, 0, -1, "vpermilps", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x0d, 1, 0, -1, "vpermilp{bad}", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x0d, 1, 1, -1, "vpermilpd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x10, 1, 1, -1, "vpsrlvw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x10, 2, 0, -1, "vpmovuswb", "Wh,Vx", EV_NONE},
+   {2, 0x11, 1, 1, -1, "vpsravw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x11, 2, 0, -1, "vpmovusdb", "Wu,Vx", EV_NONE},
+   {2, 0x12, 1, 1, -1, "vpsllvw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x12, 2, 0, -1, "vpmovusqb", "We,Vx", EV_NONE},
+   {2, 0x13, 1, 0, -1, "vcvtph2ps", "Vx,Wh", EV_VEX|EV_SAE},
+   {2, 0x13, 1, 1, -1, "vcvtph2p{bad}", "Vx,Wh", EV_VEX|EV_SAE},
+   {2, 0x13, 2, 0, -1, "vpmovusdw", "Wh,Vx", EV_NONE},
+   {2, 0x14, 1, 0, -1, "vprorvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x14, 1, 1, -1, "vprorvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x14, 2, 0, -1, "vpmovusqw", "Wu,Vx", EV_NONE},
+   {2, 0x15, 1, 0, -1, "vprolvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x15, 1, 1, -1, "vprolvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x15, 2, 0, -1, "vpmovusqd", "Wh,Vx", EV_NONE},
+   {2, 0x16, 1, 0, -1, "vpermps", "Vx,Hx,Wx", EV_VEX|EV_BC|EV_NO128},
+   {2, 0x16, 1, 1, -1, "vpermpd", "Vx,Hx,Wx", EV_VEX|EV_BC|EV_NO128},
+   {2, 0x18, 1, 0, -1, "vbroadcastss", "Vx,Wd", EV_VEX},
+   {2, 0x19, 1, 0, -1, "vbroadcastf32x2", "Vx,Wq", EV_NO128},
+   {2, 0x19, 1, 1, -1, "vbroadcastsd", "Vx,Wq", EV_VEX|EV_NO128},
+   {2, 0x1a, 1, 0, -1, "vbroadcastf32x4", "Vx,Wo", EV_NO128|EV_NOREG},
+   {2, 0x1a, 1, 1, -1, "vbroadcastf64x2", "Vx,Wo", EV_NO128|EV_NOREG},
+   {2, 0x1b, 1, 0, -1, "vbroadcastf32x8", "Vx,Wh", EV_L512|EV_NOREG},
+   {2, 0x1b, 1, 1, -1, "vbroadcastf64x4", "Vx,Wh", EV_L512|EV_NOREG},
+   {2, 0x1c, 1, 2, -1, "vpabsb", "Vx,Wx", EV_VEX|EV_BC},
+   {2, 0x1d, 1, 2, -1, "vpabsw", "Vx,Wx", EV_VEX|EV_BC},
+   {2, 0x1e, 1, 0, -1, "vpabsd", "Vx,Wx", EV_VEX|EV_BC},
+   {2, 0x1f, 1, 1, -1, "vpabsq", "Vx,Wx", EV_BC},
+   {2, 0x20, 1, 2, -1, "vpmovsxbw", "Vx,Wh", EV_VEX},
+   {2, 0x20, 2, 0, -1, "vpmovswb", "Wh,Vx", EV_NONE},
+   {2, 0x21, 1, 2, -1, "vpmovsxbd", "Vx,Wu", EV_VEX},
+   {2, 0x21, 2, 0, -1, "vpmovsdb", "Wu,Vx", EV_NONE},
+   {2, 0x22, 1, 2, -1, "vpmovsxbq", "Vx,We", EV_VEX},
+   {2, 0x22, 2, 0, -1, "vpmovsqb", "We,Vx", EV_NONE},
+   {2, 0x23, 1, 2, -1, "vpmovsxwd", "Vx,Wh", EV_VEX},
+   {2, 0x23, 2, 0, -1, "vpmovsdw", "Wh,Vx", EV_NONE},
+   {2, 0x24, 1, 2, -1, "vpmovsxwq", "Vx,Wu", EV_VEX},
+   {2, 0x24, 2, 0, -1, "vpmovsqw", "Wu,Vx", EV_NONE},
+   {2, 0x25, 1, 0, -1, "vpmovsxdq", "Vx,Wh", EV_VEX},
+   {2, 0x25, 2, 0, -1, "vpmovsqd", "Wh,Vx", EV_NONE},
+   {2, 0x26, 1, 0, -1, "vptestmb", "kG,Hx,Wx", EV_BC},
+   {2, 0x26, 1, 1, -1, "vptestmw", "kG,Hx,Wx", EV_BC},
+   {2, 0x26, 2, 0, -1, "vptestnmb", "kG,Hx,Wx", EV_BC},
+   {2, 0x26, 2, 1, -1, "vptestnmw", "kG,Hx,Wx", EV_BC},
+   {2, 0x27, 1, 0, -1, "vptestmd", "kG,Hx,Wx", EV_BC},
+   {2, 0x27, 1, 1, -1, "vptestmq", "kG,Hx,Wx", EV_BC},
+   {2, 0x27, 2, 0, -1, "vptestnmd", "kG,Hx,Wx", EV_BC},
+   {2, 0x27, 2, 1, -1, "vptestnmq", "kG,Hx,Wx", EV_BC},
+   {2, 0x28, 1, 1, -1, "vpmuldq", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x28, 2, 0, -1, "vpmovm2b", "Vx,kE", EV_NOMEM},
+   {2, 0x28, 2, 1, -1, "vpmovm2w", "Vx,kE", EV_NOMEM},
+   {2, 0x29, 1, 1, -1, "vpcmpeqq", "kG,Hx,Wx", EV_BC},
+   {2, 0x29, 2, 0, -1, "vpmovb2m", "kG,Wx", EV_BC},
+   {2, 0x29, 2, 1, -1, "vpmovw2m", "kG,Wx", EV_BC},
+   {2, 0x2a, 1, 0, -1, "vmovntdqa", "Vx,Wx", EV_VEX},
+   {2, 0x2a, 2, 1, -1, "vpbroadcastmb2q", "Vx,kE", EV_NOMEM},
+   {2, 0x2b, 1, 0, -1, "vpackusdw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x2c, 1, 0, -1, "vscalefps", "Vx,Hx,Wx", EV_ER|EV_BC},
+   {2, 0x2c, 1, 1, -1, "vscalefpd", "Vx,Hx,Wx", EV_ER|EV_BC},
+   {2, 0x2d, 1, 0, -1, "vscalefss", "Vo,Ho,Wd", EV_ER},
+   {2, 0x2d, 1, 1, -1, "vscalefsd", "Vo,Ho,Wq", EV_ER},
+   {2, 0x30, 1, 2, -1, "vpmovzxbw", "Vx,Wh", EV_VEX},
+   {2, 0x30, 2, 0, -1, "vpmovwb", "Wh,Vx", EV_NONE},
+   {2, 0x31, 1, 2, -1, "vpmovzxbd", "Vx,Wu", EV_VEX},
+   {2, 0x31, 2, 0, -1, "vpmovdb", "Wu,Vx", EV_NONE},
+   {2, 0x32, 1, 2, -1, "vpmovzxbq", "Vx,We", EV_VEX},
+   {2, 0x32, 2, 0, -1, "vpmovqb", "We,Vx", EV_NONE},
+   {2, 0x33, 1, 2, -1, "vpmovzxwd", "Vx,Wh", EV_VEX},
+   {2, 0x33, 2, 0, -1, "vpmovdw", "Wh,Vx", EV_NONE},
+   {2, 0x34, 1, 2, -1, "vpmovzxwq", "Vx,Wu", EV_VEX},
+   {2, 0x34, 2, 0, -1, "vpmovqw", "Wu,Vx", EV_NONE},
+   {2, 0x35, 1, 0, -1, "vpmovzxdq", "Vx,Wh", EV_VEX},
+   {2, 0x35, 2, 0, -1, "vpmovqd", "Wh,Vx", EV_NONE},
+   {2, 0x36, 1, 0, -1, "vpermd", "Vx,Hx,Wx", EV_VEX|EV_BC|EV_NO128},
+   {2, 0x36, 1, 1, -1, "vpermq", "Vx,Hx,Wx", EV_BC|EV_NO128},
+   {2, 0x37, 1, 1, -1, "vpcmpgtq", "kG,Hx,Wx", EV_BC},
+   {2, 0x38, 1, 2, -1, "vpminsb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x38, 2, 0, -1, "vpmovm2d", "Vx,kE", EV_NOMEM},
+   {2, 0x38, 2, 1, -1, "vpmovm2q", "Vx,kE", EV_NOMEM},
+   {2, 0x39, 1, 0, -1, "vpminsd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x39, 1, 1, -1, "vpminsq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x39, 2, 0, -1, "vpmovd2m", "kG,Wx", EV_BC},
+   {2, 0x39, 2, 1, -1, "vpmovq2m", "kG,Wx", EV_BC},
+   {2, 0x3a, 1, 2, -1, "vpminuw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3a, 2, 0, -1, "vpbroadcastmw2d", "Vx,kE", EV_NOMEM},
+   {2, 0x3b, 1, 0, -1, "vpminud", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3b, 1, 1, -1, "vpminuq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x3c, 1, 2, -1, "vpmaxsb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3d, 1, 0, -1, "vpmaxsd", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3d, 1, 1, -1, "vpmaxsq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x3e, 1, 2, -1, "vpmaxuw", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3f, 1, 0, -1, "vpmaxud", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x3f, 1, 1, -1, "vpmaxuq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x40, 1, 0, -1, "vpmulld", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0x40, 1, 1, -1, "vpmullq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x42, 1, 0, -1, "vgetexpps", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0x42, 1, 1, -1, "vgetexppd", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0x43, 1, 0, -1, "vgetexpss", "Vo,Ho,Wd", EV_SAE},
+   {2, 0x43, 1, 1, -1, "vgetexpsd", "Vo,Ho,Wq", EV_SAE},
+   {2, 0x44, 1, 0, -1, "vplzcntd", "Vx,Wx", EV_BC},
+   {2, 0x44, 1, 1, -1, "vplzcntq", "Vx,Wx", EV_BC},
+   {2, 0x45, 1, 0, -1, "vpsrlvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x45, 1, 1, -1, "vpsrlvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x46, 1, 0, -1, "vpsravd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x46, 1, 1, -1, "vpsravq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x47, 1, 0, -1, "vpsllvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x47, 1, 1, -1, "vpsllvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x4c, 1, 0, -1, "vrcp14ps", "Vx,Wx", EV_BC},
+   {2, 0x4c, 1, 1, -1, "vrcp14pd", "Vx,Wx", EV_BC},
+   {2, 0x4d, 1, 0, -1, "vrcp14ss", "Vo,Ho,Wd", EV_NONE},
+   {2, 0x4d, 1, 1, -1, "vrcp14sd", "Vo,Ho,Wq", EV_NONE},
+   {2, 0x4e, 0, 0, -1, "vrsqrt14ps", "Vx,Wx", EV_BC},
+   {2, 0x4e, 0, 1, -1, "vrsqrt14pd", "Vx,Wx", EV_BC},
+   {2, 0x4e, 1, 0, -1, "vrsqrt14ps", "Vx,Wx", EV_BC},
+   {2, 0x4e, 1, 1, -1, "vrsqrt14pd", "Vx,Wx", EV_BC},
+   {2, 0x4e, 2, 0, -1, "vrsqrt14ps", "Vx,Wx", EV_BC},
+   {2, 0x4e, 2, 1, -1, "vrsqrt14pd", "Vx,Wx", EV_BC},
+   {2, 0x4e, 3, 0, -1, "vrsqrt14ps", "Vx,Wx", EV_BC},
+   {2, 0x4e, 3, 1, -1, "vrsqrt14pd", "Vx,Wx", EV_BC},
+   {2, 0x4f, 1, 0, -1, "vrsqrt14ss", "Vo,Ho,Wd", EV_NONE},
+   {2, 0x4f, 1, 1, -1, "vrsqrt14sd", "Vo,Ho,Wq", EV_NONE},
+   {2, 0x50, 0, 0, -1, "vpdpbuud", "Vx,Hx,Wx", EV_BC},
+   {2, 0x50, 1, 0, -1, "vpdpbusd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x50, 2, 0, -1, "vpdpbsud", "Vx,Hx,Wx", EV_BC},
+   {2, 0x50, 3, 0, -1, "vpdpbssd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x51, 0, 0, -1, "vpdpbuuds", "Vx,Hx,Wx", EV_BC},
+   {2, 0x51, 1, 0, -1, "vpdpbusds", "Vx,Hx,Wx", EV_BC},
+   {2, 0x51, 2, 0, -1, "vpdpbsuds", "Vx,Hx,Wx", EV_BC},
+   {2, 0x51, 3, 0, -1, "vpdpbssds", "Vx,Hx,Wx", EV_BC},
+   {2, 0x52, 1, 0, -1, "vpdpwssd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x52, 2, 0, -1, "vdpbf16ps", "Vx,Hx,Wx", EV_BC},
+   {2, 0x52, 2, 1, -1, "vdpbf16p{bad}", "Vx,Hx,Wx", EV_BC},
+   {2, 0x52, 3, 0, -1, "vp4dpwssd", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x52, 3, 1, -1, "vp4dpws{bad}d", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x53, 1, 0, -1, "vpdpwssds", "Vx,Hx,Wx", EV_BC},
+   {2, 0x53, 3, 0, -1, "vp4dpwssds", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x53, 3, 1, -1, "vp4dpws{bad}ds", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x54, 1, 0, -1, "vpopcntb", "Vx,Wx", EV_BC},
+   {2, 0x54, 1, 1, -1, "vpopcntw", "Vx,Wx", EV_BC},
+   {2, 0x55, 1, 0, -1, "vpopcntd", "Vx,Wx", EV_BC},
+   {2, 0x55, 1, 1, -1, "vpopcntq", "Vx,Wx", EV_BC},
+   {2, 0x58, 1, 0, -1, "vpbroadcastd", "Vx,Wd", EV_VEX},
+   {2, 0x59, 1, 0, -1, "vbroadcasti32x2", "Vx,Wq", EV_NONE},
+   {2, 0x59, 1, 1, -1, "vpbroadcastq", "Vx,Wq", EV_VEX},
+   {2, 0x5a, 1, 0, -1, "vbroadcasti32x4", "Vx,Wo", EV_NO128|EV_NOREG},
+   {2, 0x5a, 1, 1, -1, "vbroadcasti64x2", "Vx,Wo", EV_NO128|EV_NOREG},
+   {2, 0x5b, 1, 0, -1, "vbroadcasti32x8", "Vx,Wh", EV_L512|EV_NOREG},
+   {2, 0x5b, 1, 1, -1, "vbroadcasti64x4", "Vx,Wh", EV_L512|EV_NOREG},
+   {2, 0x62, 1, 0, -1, "vpexpandb", "Vx,Wx", EV_T1BW},
+   {2, 0x62, 1, 1, -1, "vpexpandw", "Vx,Wx", EV_T1BW},
+   {2, 0x63, 1, 0, -1, "vpcompressb", "Wx,Vx", EV_T1BW},
+   {2, 0x63, 1, 1, -1, "vpcompressw", "Wx,Vx", EV_T1BW},
+   {2, 0x64, 1, 0, -1, "vpblendmd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x64, 1, 1, -1, "vpblendmq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x65, 1, 0, -1, "vblendmps", "Vx,Hx,Wx", EV_BC},
+   {2, 0x65, 1, 1, -1, "vblendmpd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x66, 1, 0, -1, "vpblendmb", "Vx,Hx,Wx", EV_BC},
+   {2, 0x66, 1, 1, -1, "vpblendmw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x68, 3, 0, -1, "vp2intersectd", "kG,Hx,Wx", EV_SAE|EV_BC},
+   {2, 0x68, 3, 1, -1, "vp2intersectq", "kG,Hx,Wx", EV_SAE|EV_BC},
+   {2, 0x70, 1, 1, -1, "vpshldvw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x71, 1, 0, -1, "vpshldvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x71, 1, 1, -1, "vpshldvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x72, 1, 1, -1, "vpshrdvw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x72, 2, 0, -1, "vcvtneps2bf16", "Vh,Wx", EV_BC},
+   {2, 0x72, 2, 1, -1, "vcvtnep{bad}2bf16", "Vh,Wx", EV_BC},
+   {2, 0x72, 3, 0, -1, "vcvtne2ps2bf16", "Vx,Hx,Wx", EV_BC},
+   {2, 0x72, 3, 1, -1, "vcvtne2p{bad}2bf16", "Vx,Hx,Wx", EV_BC},
+   {2, 0x73, 1, 0, -1, "vpshrdvd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x73, 1, 1, -1, "vpshrdvq", "Vx,Hx,Wx", EV_BC},
+   {2, 0x75, 1, 0, -1, "vpermi2b", "Vx,Hx,Wx", EV_BC},
+   {2, 0x75, 1, 1, -1, "vpermi2w", "Vx,Hx,Wx", EV_BC},
+   {2, 0x76, 1, 0, -1, "vpermi2d", "Vx,Hx,Wx", EV_BC},
+   {2, 0x76, 1, 1, -1, "vpermi2q", "Vx,Hx,Wx", EV_BC},
+   {2, 0x77, 1, 0, -1, "vpermi2ps", "Vx,Hx,Wx", EV_BC},
+   {2, 0x77, 1, 1, -1, "vpermi2pd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x78, 1, 0, -1, "vpbroadcastb", "Vx,Wb", EV_VEX},
+   {2, 0x79, 1, 0, -1, "vpbroadcastw", "Vx,Ww", EV_VEX},
+   {2, 0x7a, 1, 0, -1, "vpbroadcastb", "Vx,Ed", EV_NOMEM},
+   {2, 0x7b, 1, 0, -1, "vpbroadcastw", "Vx,Ed", EV_NOMEM},
+   {2, 0x7c, 1, 0, -1, "vpbroadcastd", "Vx,Ed", EV_NOMEM},
+   {2, 0x7c, 1, 1, -1, "vpbroadcastq", "Vx,Eq", EV_NOMEM},
+   {2, 0x7d, 1, 0, -1, "vpermt2b", "Vx,Hx,Wx", EV_BC},
+   {2, 0x7d, 1, 1, -1, "vpermt2w", "Vx,Hx,Wx", EV_BC},
+   {2, 0x7e, 1, 0, -1, "vpermt2d", "Vx,Hx,Wx", EV_BC},
+   {2, 0x7e, 1, 1, -1, "vpermt2q", "Vx,Hx,Wx", EV_BC},
+   {2, 0x7f, 1, 0, -1, "vpermt2ps", "Vx,Hx,Wx", EV_BC},
+   {2, 0x7f, 1, 1, -1, "vpermt2pd", "Vx,Hx,Wx", EV_BC},
+   {2, 0x83, 1, 1, -1, "vpmultishiftqb", "Vx,Hx,Wx", EV_BC},
+   {2, 0x88, 1, 0, -1, "vexpandps", "Vx,Wx", EV_T1},
+   {2, 0x88, 1, 1, -1, "vexpandpd", "Vx,Wx", EV_T1},
+   {2, 0x89, 1, 0, -1, "vpexpandd", "Vx,Wx", EV_T1},
+   {2, 0x89, 1, 1, -1, "vpexpandq", "Vx,Wx", EV_T1},
+   {2, 0x8a, 1, 0, -1, "vcompressps", "Wx,Vx", EV_T1},
+   {2, 0x8a, 1, 1, -1, "vcompresspd", "Wx,Vx", EV_T1},
+   {2, 0x8b, 1, 0, -1, "vpcompressd", "Wx,Vx", EV_T1},
+   {2, 0x8b, 1, 1, -1, "vpcompressq", "Wx,Vx", EV_T1},
+   {2, 0x8d, 1, 0, -1, "vpermb", "Vx,Hx,Wx", EV_BC},
+   {2, 0x8d, 1, 1, -1, "vpermw", "Vx,Hx,Wx", EV_BC},
+   {2, 0x8f, 1, 2, -1, "vpshufbitqmb", "kG,Hx,Wx", EV_BC},
+   {2, 0x90, 1, 0, -1, "vpgatherdd", "Vx,vdx", EV_NONE},
+   {2, 0x90, 1, 1, -1, "vpgatherdq", "Vx,vqh", EV_NONE},
+   {2, 0x91, 1, 0, -1, "vpgatherqd", "Vh,vdx", EV_NONE},
+   {2, 0x91, 1, 1, -1, "vpgatherqq", "Vx,vqx", EV_NONE},
+   {2, 0x92, 1, 0, -1, "vgatherdps", "Vx,vdx", EV_NONE},
+   {2, 0x92, 1, 1, -1, "vgatherdpd", "Vx,vqh", EV_NONE},
+   {2, 0x93, 1, 0, -1, "vgatherqps", "Vh,vdx", EV_NONE},
+   {2, 0x93, 1, 1, -1, "vgatherqpd", "Vx,vqx", EV_NONE},
+   {2, 0x96, 1, 0, -1, "vfmaddsub132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x96, 1, 1, -1, "vfmaddsub132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x97, 1, 0, -1, "vfmsubadd132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x97, 1, 1, -1, "vfmsubadd132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x98, 1, 0, -1, "vfmadd132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x98, 1, 1, -1, "vfmadd132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x99, 1, 0, -1, "vfmadd132ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0x99, 1, 1, -1, "vfmadd132sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0x9a, 1, 0, -1, "vfmsub132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9a, 1, 1, -1, "vfmsub132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9a, 3, 0, -1, "v4fmaddps", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x9a, 3, 1, -1, "v4fmaddp{bad}", "Vx,Hx,Mo", EV_NONE},
+   {2, 0x9b, 1, 0, -1, "vfmsub132ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0x9b, 1, 1, -1, "vfmsub132sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0x9b, 3, 0, -1, "v4fmaddss", "Vo,Ho,Mo", EV_NONE},
+   {2, 0x9b, 3, 1, -1, "v4fmadds{bad}", "Vo,Ho,Mo", EV_NONE},
+   {2, 0x9c, 1, 0, -1, "vfnmadd132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9c, 1, 1, -1, "vfnmadd132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9d, 1, 0, -1, "vfnmadd132ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0x9d, 1, 1, -1, "vfnmadd132sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0x9e, 1, 0, -1, "vfnmsub132ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9e, 1, 1, -1, "vfnmsub132pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0x9f, 1, 0, -1, "vfnmsub132ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0x9f, 1, 1, -1, "vfnmsub132sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xa0, 1, 0, -1, "vpscatterdd", "vdx,Vx", EV_NONE},
+   {2, 0xa0, 1, 1, -1, "vpscatterdq", "vqh,Vx", EV_NONE},
+   {2, 0xa1, 1, 0, -1, "vpscatterqd", "vdx,Vh", EV_NONE},
+   {2, 0xa1, 1, 1, -1, "vpscatterqq", "vqx,Vx", EV_NONE},
+   {2, 0xa2, 1, 0, -1, "vscatterdps", "vdx,Vx", EV_NONE},
+   {2, 0xa2, 1, 1, -1, "vscatterdpd", "vqh,Vx", EV_NONE},
+   {2, 0xa3, 1, 0, -1, "vscatterqps", "vdx,Vh", EV_NONE},
+   {2, 0xa3, 1, 1, -1, "vscatterqpd", "vqx,Vx", EV_NONE},
+   {2, 0xa6, 1, 0, -1, "vfmaddsub213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa6, 1, 1, -1, "vfmaddsub213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa7, 1, 0, -1, "vfmsubadd213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa7, 1, 1, -1, "vfmsubadd213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa8, 1, 0, -1, "vfmadd213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa8, 1, 1, -1, "vfmadd213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xa9, 1, 0, -1, "vfmadd213ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xa9, 1, 1, -1, "vfmadd213sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xaa, 1, 0, -1, "vfmsub213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xaa, 1, 1, -1, "vfmsub213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xaa, 3, 0, -1, "v4fnmaddps", "Vx,Hx,Mo", EV_NONE},
+   {2, 0xaa, 3, 1, -1, "v4fnmaddp{bad}", "Vx,Hx,Mo", EV_NONE},
+   {2, 0xab, 1, 0, -1, "vfmsub213ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xab, 1, 1, -1, "vfmsub213sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xab, 3, 0, -1, "v4fnmaddss", "Vo,Ho,Mo", EV_NONE},
+   {2, 0xab, 3, 1, -1, "v4fnmadds{bad}", "Vo,Ho,Mo", EV_NONE},
+   {2, 0xac, 1, 0, -1, "vfnmadd213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xac, 1, 1, -1, "vfnmadd213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xad, 1, 0, -1, "vfnmadd213ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xad, 1, 1, -1, "vfnmadd213sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xae, 1, 0, -1, "vfnmsub213ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xae, 1, 1, -1, "vfnmsub213pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xaf, 1, 0, -1, "vfnmsub213ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xaf, 1, 1, -1, "vfnmsub213sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xb4, 1, 1, -1, "vpmadd52luq", "Vx,Hx,Wx", EV_BC},
+   {2, 0xb5, 1, 1, -1, "vpmadd52huq", "Vx,Hx,Wx", EV_BC},
+   {2, 0xb6, 1, 0, -1, "vfmaddsub231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb6, 1, 1, -1, "vfmaddsub231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb7, 1, 0, -1, "vfmsubadd231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb7, 1, 1, -1, "vfmsubadd231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb8, 1, 0, -1, "vfmadd231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb8, 1, 1, -1, "vfmadd231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xb9, 1, 0, -1, "vfmadd231ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xb9, 1, 1, -1, "vfmadd231sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xba, 1, 0, -1, "vfmsub231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xba, 1, 1, -1, "vfmsub231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xbb, 1, 0, -1, "vfmsub231ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xbb, 1, 1, -1, "vfmsub231sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xbc, 1, 0, -1, "vfnmadd231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xbc, 1, 1, -1, "vfnmadd231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xbd, 1, 0, -1, "vfnmadd231ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xbd, 1, 1, -1, "vfnmadd231sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xbe, 1, 0, -1, "vfnmsub231ps", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xbe, 1, 1, -1, "vfnmsub231pd", "Vx,Hx,Wx", EV_VEX|EV_ER|EV_BC},
+   {2, 0xbf, 1, 0, -1, "vfnmsub231ss", "Vo,Ho,Wd", EV_VEX|EV_ER},
+   {2, 0xbf, 1, 1, -1, "vfnmsub231sd", "Vo,Ho,Wq", EV_VEX|EV_ER},
+   {2, 0xc4, 1, 0, -1, "vpconflictd", "Vx,Wx", EV_BC},
+   {2, 0xc4, 1, 1, -1, "vpconflictq", "Vx,Wx", EV_BC},
+   {2, 0xc6, 1, 0,  1, "vgatherpf0dps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 0,  2, "vgatherpf1dps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 0,  5, "vscatterpf0dps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 0,  6, "vscatterpf1dps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 1,  1, "vgatherpf0dpd", "vqh", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 1,  2, "vgatherpf1dpd", "vqh", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 1,  5, "vscatterpf0dpd", "vqh", EV_L512|EV_NOREG},
+   {2, 0xc6, 1, 1,  6, "vscatterpf1dpd", "vqh", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 0,  1, "vgatherpf0qps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 0,  2, "vgatherpf1qps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 0,  5, "vscatterpf0qps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 0,  6, "vscatterpf1qps", "vdx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 1,  1, "vgatherpf0qpd", "vqx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 1,  2, "vgatherpf1qpd", "vqx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 1,  5, "vscatterpf0qpd", "vqx", EV_L512|EV_NOREG},
+   {2, 0xc7, 1, 1,  6, "vscatterpf1qpd", "vqx", EV_L512|EV_NOREG},
+   {2, 0xc8, 1, 0, -1, "vexp2ps", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xc8, 1, 1, -1, "vexp2pd", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xca, 1, 0, -1, "vrcp28ps", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xca, 1, 1, -1, "vrcp28pd", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xcb, 1, 0, -1, "vrcp28ss", "Vo,Ho,Wd", EV_SAE},
+   {2, 0xcb, 1, 1, -1, "vrcp28sd", "Vo,Ho,Wq", EV_SAE},
+   {2, 0xcc, 1, 0, -1, "vrsqrt28ps", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xcc, 1, 1, -1, "vrsqrt28pd", "Vx,Wx", EV_SAE|EV_BC},
+   {2, 0xcd, 1, 0, -1, "vrsqrt28ss", "Vo,Ho,Wd", EV_SAE},
+   {2, 0xcd, 1, 1, -1, "vrsqrt28sd", "Vo,Ho,Wq", EV_SAE},
+   {2, 0xcf, 1, 0, -1, "vgf2p8mulb", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0xdc, 1, 2, -1, "vaesenc", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0xdd, 1, 2, -1, "vaesenclast", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0xde, 1, 2, -1, "vaesdec", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {2, 0xdf, 1, 2, -1, "vaesdeclast", "Vx,Hx,Wx", EV_VEX|EV_BC},
+   {3, 0x00, 1, 1, -1, "vpermq", "Vx,Wx,Ib", EV_VEX|EV_BC|EV_NO128},
+   {3, 0x01, 1, 1, -1, "vpermpd", "Vx,Wx,Ib", EV_VEX|EV_BC|EV_NO128},
+   {3, 0x03, 1, 0, -1, "valignd", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x03, 1, 1, -1, "valignq", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x04, 1, 0, -1, "vpermilps", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0x05, 1, 0, -1, "vpermilp{bad}", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0x05, 1, 1, -1, "vpermilpd", "Vx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0x08, 0, 0, -1, "vrndscaleph", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x08, 0, 1, -1, "vrndscalep{bad}", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x08, 1, 0, -1, "vrndscaleps", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x08, 1, 1, -1, "vrndscalep{bad}", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x09, 1, 0, -1, "vrndscalep{bad}", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x09, 1, 1, -1, "vrndscalepd", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x0a, 0, 0, -1, "vrndscalesh", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x0a, 0, 1, -1, "vrndscales{bad}", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x0a, 1, 0, -1, "vrndscaless", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x0a, 1, 1, -1, "vrndscales{bad}", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x0b, 1, 0, -1, "vrndscales{bad}", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x0b, 1, 1, -1, "vrndscalesd", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x0f, 1, 2, -1, "vpalignr", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0x14, 1, 2, -1, "vpextrb", "Rb,Vo,Ib", EV_VEX|EV_L128},
+   {3, 0x15, 1, 2, -1, "vpextrw", "Rw,Vo,Ib", EV_VEX|EV_L128},
+   {3, 0x16, 1, 0, -1, "vpextrd", "Ed,Vo,Ib", EV_VEX|EV_L128},
+   {3, 0x16, 1, 1, -1, "vpextrq", "Eq,Vo,Ib", EV_VEX|EV_L128},
+   {3, 0x17, 1, 2, -1, "vextractps", "Ed,Vo,Ib", EV_VEX|EV_L128},
+   {3, 0x18, 1, 0, -1, "vinsertf32x4", "Vx,Hx,Wo,Ib", EV_NO128},
+   {3, 0x18, 1, 1, -1, "vinsertf64x2", "Vx,Hx,Wo,Ib", EV_NO128},
+   {3, 0x19, 1, 0, -1, "vextractf32x4", "Wo,Vx,Ib", EV_NO128},
+   {3, 0x19, 1, 1, -1, "vextractf64x2", "Wo,Vx,Ib", EV_NO128},
+   {3, 0x1a, 1, 0, -1, "vinsertf32x8", "Vx,Hx,Wh,Ib", EV_L512},
+   {3, 0x1a, 1, 1, -1, "vinsertf64x4", "Vx,Hx,Wh,Ib", EV_L512},
+   {3, 0x1b, 1, 0, -1, "vextractf32x8", "Wh,Vx,Ib", EV_L512},
+   {3, 0x1b, 1, 1, -1, "vextractf64x4", "Wh,Vx,Ib", EV_L512},
+   {3, 0x1d, 1, 0, -1, "vcvtps2ph", "Wh,Vx,Ib", EV_VEX|EV_SAE},
+   {3, 0x1e, 1, 0, -1, "vpcmpud", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x1e, 1, 1, -1, "vpcmpuq", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x1f, 1, 0, -1, "vpcmpd", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x1f, 1, 1, -1, "vpcmpq", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x20, 1, 2, -1, "vpinsrb", "Vo,Ho,Rb,Ib", EV_VEX|EV_L128},
+   {3, 0x21, 1, 0, -1, "vinsertps", "Vo,Ho,Wd,Ib", EV_VEX|EV_L128},
+   {3, 0x22, 1, 0, -1, "vpinsrd", "Vo,Ho,Ed,Ib", EV_VEX|EV_L128},
+   {3, 0x22, 1, 1, -1, "vpinsrq", "Vo,Ho,Eq,Ib", EV_VEX|EV_L128},
+   {3, 0x23, 1, 0, -1, "vshuff32x4", "Vx,Hx,Wx,Ib", EV_BC|EV_NO128},
+   {3, 0x23, 1, 1, -1, "vshuff64x2", "Vx,Hx,Wx,Ib", EV_BC|EV_NO128},
+   {3, 0x25, 1, 0, -1, "vpternlogd", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x25, 1, 1, -1, "vpternlogq", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x26, 0, 0, -1, "vgetmantph", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x26, 0, 1, -1, "vgetmantp{bad}", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x26, 1, 0, -1, "vgetmantps", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x26, 1, 1, -1, "vgetmantpd", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x27, 0, 0, -1, "vgetmantsh", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x27, 0, 1, -1, "vgetmants{bad}", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x27, 1, 0, -1, "vgetmantss", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x27, 1, 1, -1, "vgetmantsd", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x38, 1, 0, -1, "vinserti32x4", "Vx,Hx,Wo,Ib", EV_NO128},
+   {3, 0x38, 1, 1, -1, "vinserti64x2", "Vx,Hx,Wo,Ib", EV_NO128},
+   {3, 0x39, 1, 0, -1, "vextracti32x4", "Wo,Vx,Ib", EV_NO128},
+   {3, 0x39, 1, 1, -1, "vextracti64x2", "Wo,Vx,Ib", EV_NO128},
+   {3, 0x3a, 1, 0, -1, "vinserti32x8", "Vx,Hx,Wh,Ib", EV_L512},
+   {3, 0x3a, 1, 1, -1, "vinserti64x4", "Vx,Hx,Wh,Ib", EV_L512},
+   {3, 0x3b, 1, 0, -1, "vextracti32x8", "Wh,Vx,Ib", EV_L512},
+   {3, 0x3b, 1, 1, -1, "vextracti64x4", "Wh,Vx,Ib", EV_L512},
+   {3, 0x3e, 1, 0, -1, "vpcmpub", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x3e, 1, 1, -1, "vpcmpuw", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x3f, 1, 0, -1, "vpcmpb", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x3f, 1, 1, -1, "vpcmpw", "kG,Hx,Wx,Ib", EV_BC|EV_PCMP},
+   {3, 0x42, 0, 0, -1, "vdbpsadbw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x42, 1, 0, -1, "vdbpsadbw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x42, 2, 0, -1, "vdbpsadbw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x42, 3, 0, -1, "vdbpsadbw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x43, 1, 0, -1, "vshufi32x4", "Vx,Hx,Wx,Ib", EV_BC|EV_NO128},
+   {3, 0x43, 1, 1, -1, "vshufi64x2", "Vx,Hx,Wx,Ib", EV_BC|EV_NO128},
+   {3, 0x44, 1, 2, -1, "vpclmulqdq", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0x50, 1, 0, -1, "vrangeps", "Vx,Hx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x50, 1, 1, -1, "vrangepd", "Vx,Hx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x51, 1, 0, -1, "vrangess", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x51, 1, 1, -1, "vrangesd", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x54, 1, 0, -1, "vfixupimmps", "Vx,Hx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x54, 1, 1, -1, "vfixupimmpd", "Vx,Hx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x55, 1, 0, -1, "vfixupimmss", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x55, 1, 1, -1, "vfixupimmsd", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x56, 0, 0, -1, "vreduceph", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x56, 0, 1, -1, "vreducep{bad}", "Vx,Wx,Ib", EV_SAE|EV_BCW},
+   {3, 0x56, 1, 0, -1, "vreduceps", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x56, 1, 1, -1, "vreducepd", "Vx,Wx,Ib", EV_SAE|EV_BC},
+   {3, 0x57, 0, 0, -1, "vreducesh", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x57, 0, 1, -1, "vreduces{bad}", "Vo,Ho,Ww,Ib", EV_SAE},
+   {3, 0x57, 1, 0, -1, "vreducess", "Vo,Ho,Wd,Ib", EV_SAE},
+   {3, 0x57, 1, 1, -1, "vreducesd", "Vo,Ho,Wq,Ib", EV_SAE},
+   {3, 0x66, 0, 0, -1, "vfpclassph", "kG,Wx,Ib", EV_BCW},
+   {3, 0x66, 0, 1, -1, "vfpclassp{bad}", "kG,Wx,Ib", EV_BCW},
+   {3, 0x66, 1, 0, -1, "vfpclassps", "kG,Wx,Ib", EV_BC},
+   {3, 0x66, 1, 1, -1, "vfpclasspd", "kG,Wx,Ib", EV_BC},
+   {3, 0x67, 0, 0, -1, "vfpclasssh", "kG,Ww,Ib", EV_NONE},
+   {3, 0x67, 0, 1, -1, "vfpclasss{bad}", "kG,Ww,Ib", EV_NONE},
+   {3, 0x67, 1, 0, -1, "vfpclassss", "kG,Wd,Ib", EV_NONE},
+   {3, 0x67, 1, 1, -1, "vfpclasssd", "kG,Wq,Ib", EV_NONE},
+   {3, 0x70, 0, 1, -1, "vpshldw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x70, 1, 1, -1, "vpshldw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x70, 2, 1, -1, "vpshldw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x70, 3, 1, -1, "vpshldw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x71, 1, 0, -1, "vpshldd", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x71, 1, 1, -1, "vpshldq", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x72, 0, 1, -1, "vpshrdw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x72, 1, 1, -1, "vpshrdw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x72, 2, 1, -1, "vpshrdw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x72, 3, 1, -1, "vpshrdw", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x73, 1, 0, -1, "vpshrdd", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0x73, 1, 1, -1, "vpshrdq", "Vx,Hx,Wx,Ib", EV_BC},
+   {3, 0xc2, 0, 0, -1, "vcmpph", "kG,Hx,Wx,Ib", EV_SAE|EV_BCW|EV_CMP},
+   {3, 0xc2, 0, 1, -1, "vcmpp{bad}", "kG,Hx,Wx,Ib", EV_SAE|EV_BCW|EV_CMP},
+   {3, 0xc2, 2, 0, -1, "vcmpsh", "kG,Ho,Ww,Ib", EV_SAE|EV_CMP},
+   {3, 0xc2, 2, 1, -1, "vcmps{bad}", "kG,Ho,Ww,Ib", EV_SAE|EV_CMP},
+   {3, 0xce, 1, 1, -1, "vgf2p8affineqb", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {3, 0xcf, 1, 1, -1, "vgf2p8affineinvqb", "Vx,Hx,Wx,Ib", EV_VEX|EV_BC},
+   {5, 0x10, 2, 0, -1, "vmovsh", "Vo,Ho,Wo|Vo,Ww", EV_NONE},
+   {5, 0x10, 2, 1, -1, "vmovs{bad}", "Vo,Ho,Wo|Vo,Ww", EV_NONE},
+   {5, 0x11, 2, 0, -1, "vmovsh", "Wo,Ho,Vo|Ww,Vo", EV_NONE},
+   {5, 0x11, 2, 1, -1, "vmovs{bad}", "Wo,Ho,Vo|Ww,Vo", EV_NONE},
+   {5, 0x1d, 0, 0, -1, "vcvtss2sh", "Vo,Ho,Wd", EV_ER},
+   {5, 0x1d, 0, 1, -1, "vcvtss2s{bad}", "Vo,Ho,Wd", EV_ER},
+   {5, 0x1d, 1, 0, -1, "vcvtps2phx", "Vh,Wx", EV_ER|EV_BC},
+   {5, 0x1d, 1, 1, -1, "vcvtps2p{bad}x", "Vh,Wx", EV_ER|EV_BC},
+   {5, 0x2a, 2, 0, -1, "vcvtsi2sh", "Vo,Ho,Ed", EV_ER},
+   {5, 0x2a, 2, 1, -1, "vcvtsi2sh", "Vo,Ho,Eq", EV_ER},
+   {5, 0x2c, 2, 0, -1, "vcvttsh2si", "Gd,Ww", EV_SAE},
+   {5, 0x2c, 2, 1, -1, "vcvttsh2si", "Gq,Ww", EV_SAE},
+   {5, 0x2d, 2, 0, -1, "vcvtsh2si", "Gd,Ww", EV_ER},
+   {5, 0x2d, 2, 1, -1, "vcvtsh2si", "Gq,Ww", EV_ER},
+   {5, 0x2e, 0, 0, -1, "vucomish", "Vo,Ww", EV_SAE},
+   {5, 0x2e, 0, 1, -1, "vucomis{bad}", "Vo,Ww", EV_SAE},
+   {5, 0x2f, 0, 0, -1, "vcomish", "Vo,Ww", EV_SAE},
+   {5, 0x2f, 0, 1, -1, "vcomis{bad}", "Vo,Ww", EV_SAE},
+   {5, 0x51, 0, 0, -1, "vsqrtph", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x51, 0, 1, -1, "vsqrtp{bad}", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x51, 2, 0, -1, "vsqrtsh", "Vo,Ho,Ww", EV_ER},
+   {5, 0x51, 2, 1, -1, "vsqrts{bad}", "Vo,Ho,Ww", EV_ER},
+   {5, 0x58, 0, 0, -1, "vaddph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x58, 0, 1, -1, "vaddp{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x58, 2, 0, -1, "vaddsh", "Vo,Ho,Ww", EV_ER},
+   {5, 0x58, 2, 1, -1, "vadds{bad}", "Vo,Ho,Ww", EV_ER},
+   {5, 0x59, 0, 0, -1, "vmulph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x59, 0, 1, -1, "vmulp{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x59, 2, 0, -1, "vmulsh", "Vo,Ho,Ww", EV_ER},
+   {5, 0x59, 2, 1, -1, "vmuls{bad}", "Vo,Ho,Ww", EV_ER},
+   {5, 0x5a, 0, 0, -1, "vcvtph2pd", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x5a, 0, 1, -1, "vcvtp{bad}2pd", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x5a, 1, 0, -1, "vcvtp{bad}2ph", "Vo,Wx", EV_ER|EV_BC},
+   {5, 0x5a, 1, 1, -1, "vcvtpd2ph", "Vo,Wx", EV_ER|EV_BC},
+   {5, 0x5a, 2, 0, -1, "vcvtsh2sd", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x5a, 2, 1, -1, "vcvts{bad}2sd", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x5a, 3, 0, -1, "vcvts{bad}2sh", "Vo,Ho,Wq", EV_ER},
+   {5, 0x5a, 3, 1, -1, "vcvtsd2sh", "Vo,Ho,Wq", EV_ER},
+   {5, 0x5b, 0, 0, -1, "vcvtdq2ph", "Vh,Wx", EV_ER|EV_BC},
+   {5, 0x5b, 0, 1, -1, "vcvtqq2ph", "Vo,Wx", EV_ER|EV_BC},
+   {5, 0x5b, 1, 0, -1, "vcvtph2dq", "Vx,Wh", EV_ER|EV_BCW},
+   {5, 0x5b, 1, 1, -1, "vcvtp{bad}2dq", "Vx,Wh", EV_ER|EV_BCW},
+   {5, 0x5b, 2, 0, -1, "vcvttph2dq", "Vx,Wh", EV_SAE|EV_BCW},
+   {5, 0x5b, 2, 1, -1, "vcvttp{bad}2dq", "Vx,Wh", EV_SAE|EV_BCW},
+   {5, 0x5c, 0, 0, -1, "vsubph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x5c, 0, 1, -1, "vsubp{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x5c, 2, 0, -1, "vsubsh", "Vo,Ho,Ww", EV_ER},
+   {5, 0x5c, 2, 1, -1, "vsubs{bad}", "Vo,Ho,Ww", EV_ER},
+   {5, 0x5d, 0, 0, -1, "vminph", "Vx,Hx,Wx", EV_SAE|EV_BCW},
+   {5, 0x5d, 0, 1, -1, "vminp{bad}", "Vx,Hx,Wx", EV_SAE|EV_BCW},
+   {5, 0x5d, 2, 0, -1, "vminsh", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x5d, 2, 1, -1, "vmins{bad}", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x5e, 0, 0, -1, "vdivph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x5e, 0, 1, -1, "vdivp{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {5, 0x5e, 2, 0, -1, "vdivsh", "Vo,Ho,Ww", EV_ER},
+   {5, 0x5e, 2, 1, -1, "vdivs{bad}", "Vo,Ho,Ww", EV_ER},
+   {5, 0x5f, 0, 0, -1, "vmaxph", "Vx,Hx,Wx", EV_SAE|EV_BCW},
+   {5, 0x5f, 0, 1, -1, "vmaxp{bad}", "Vx,Hx,Wx", EV_SAE|EV_BCW},
+   {5, 0x5f, 2, 0, -1, "vmaxsh", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x5f, 2, 1, -1, "vmaxs{bad}", "Vo,Ho,Ww", EV_SAE},
+   {5, 0x6e, 1, 2, -1, "vmovw", "Vo,Rw", EV_NONE},
+   {5, 0x78, 0, 0, -1, "vcvttph2udq", "Vx,Wh", EV_SAE|EV_BCW},
+   {5, 0x78, 0, 1, -1, "vcvttp{bad}2udq", "Vx,Wh", EV_SAE|EV_BCW},
+   {5, 0x78, 1, 0, -1, "vcvttph2uqq", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x78, 1, 1, -1, "vcvttp{bad}2uqq", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x78, 2, 0, -1, "vcvttsh2usi", "Gd,Ww", EV_SAE},
+   {5, 0x78, 2, 1, -1, "vcvttsh2usi", "Gq,Ww", EV_SAE},
+   {5, 0x79, 0, 0, -1, "vcvtph2udq", "Vx,Wh", EV_ER|EV_BCW},
+   {5, 0x79, 0, 1, -1, "vcvtp{bad}2udq", "Vx,Wh", EV_ER|EV_BCW},
+   {5, 0x79, 1, 0, -1, "vcvtph2uqq", "Vx,Wu", EV_ER|EV_BCW},
+   {5, 0x79, 1, 1, -1, "vcvtp{bad}2uqq", "Vx,Wu", EV_ER|EV_BCW},
+   {5, 0x79, 2, 0, -1, "vcvtsh2usi", "Gd,Ww", EV_ER},
+   {5, 0x79, 2, 1, -1, "vcvtsh2usi", "Gq,Ww", EV_ER},
+   {5, 0x7a, 1, 0, -1, "vcvttph2qq", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x7a, 1, 1, -1, "vcvttp{bad}2qq", "Vx,Wu", EV_SAE|EV_BCW},
+   {5, 0x7a, 3, 0, -1, "vcvtudq2ph", "Vh,Wx", EV_ER|EV_BC},
+   {5, 0x7a, 3, 1, -1, "vcvtuqq2ph", "Vo,Wx", EV_ER|EV_BC},
+   {5, 0x7b, 1, 0, -1, "vcvtph2qq", "Vx,Wu", EV_ER|EV_BCW},
+   {5, 0x7b, 1, 1, -1, "vcvtp{bad}2qq", "Vx,Wu", EV_ER|EV_BCW},
+   {5, 0x7b, 2, 0, -1, "vcvtusi2sh", "Vo,Ho,Ed", EV_ER},
+   {5, 0x7b, 2, 1, -1, "vcvtusi2sh", "Vo,Ho,Eq", EV_ER},
+   {5, 0x7c, 0, 0, -1, "vcvttph2uw", "Vx,Wx", EV_SAE|EV_BCW},
+   {5, 0x7c, 0, 1, -1, "vcvttp{bad}2uw", "Vx,Wx", EV_SAE|EV_BCW},
+   {5, 0x7c, 1, 0, -1, "vcvttph2w", "Vx,Wx", EV_SAE|EV_BCW},
+   {5, 0x7c, 1, 1, -1, "vcvttp{bad}2w", "Vx,Wx", EV_SAE|EV_BCW},
+   {5, 0x7d, 0, 0, -1, "vcvtph2uw", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 0, 1, -1, "vcvtp{bad}2uw", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 1, 0, -1, "vcvtph2w", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 1, 1, -1, "vcvtp{bad}2w", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 2, 0, -1, "vcvtw2ph", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 2, 1, -1, "vcvtw2p{bad}", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 3, 0, -1, "vcvtuw2ph", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7d, 3, 1, -1, "vcvtuw2p{bad}", "Vx,Wx", EV_ER|EV_BCW},
+   {5, 0x7e, 1, 2, -1, "vmovw", "Rw,Vo", EV_NONE},
+   {6, 0x13, 0, 0, -1, "vcvtsh2ss", "Vo,Ho,Ww", EV_SAE},
+   {6, 0x13, 0, 1, -1, "vcvts{bad}2ss", "Vo,Ho,Ww", EV_SAE},
+   {6, 0x13, 1, 0, -1, "vcvtph2psx", "Vx,Wh", EV_SAE|EV_BCW},
+   {6, 0x13, 1, 1, -1, "vcvtp{bad}2psx", "Vx,Wh", EV_SAE|EV_BCW},
+   {6, 0x2c, 1, 0, -1, "vscalefph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x2c, 1, 1, -1, "vscalefp{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x2d, 1, 0, -1, "vscalefsh", "Vo,Ho,Ww", EV_ER},
+   {6, 0x2d, 1, 1, -1, "vscalefs{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0x42, 1, 0, -1, "vgetexpph", "Vx,Wx", EV_SAE|EV_BCW},
+   {6, 0x42, 1, 1, -1, "vgetexpp{bad}", "Vx,Wx", EV_SAE|EV_BCW},
+   {6, 0x43, 1, 0, -1, "vgetexpsh", "Vo,Ho,Ww", EV_SAE},
+   {6, 0x43, 1, 1, -1, "vgetexps{bad}", "Vo,Ho,Ww", EV_SAE},
+   {6, 0x4c, 1, 0, -1, "vrcpph", "Vx,Wx", EV_BCW},
+   {6, 0x4c, 1, 1, -1, "vrcpp{bad}", "Vx,Wx", EV_BCW},
+   {6, 0x4d, 1, 0, -1, "vrcpsh", "Vo,Ho,Ww", EV_NONE},
+   {6, 0x4d, 1, 1, -1, "vrcps{bad}", "Vo,Ho,Ww", EV_NONE},
+   {6, 0x4e, 1, 0, -1, "vrsqrtph", "Vx,Wx", EV_BCW},
+   {6, 0x4e, 1, 1, -1, "vrsqrtp{bad}", "Vx,Wx", EV_BCW},
+   {6, 0x4f, 1, 0, -1, "vrsqrtsh", "Vo,Ho,Ww", EV_NONE},
+   {6, 0x4f, 1, 1, -1, "vrsqrts{bad}", "Vo,Ho,Ww", EV_NONE},
+   {6, 0x56, 2, 0, -1, "vfmaddcph", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0x56, 2, 1, -1, "vfmaddcp{bad}", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0x56, 3, 0, -1, "vfcmaddcph", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0x56, 3, 1, -1, "vfcmaddcp{bad}", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0x57, 2, 0, -1, "vfmaddcsh", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0x57, 2, 1, -1, "vfmaddcs{bad}", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0x57, 3, 0, -1, "vfcmaddcsh", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0x57, 3, 1, -1, "vfcmaddcs{bad}", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0x96, 1, 0, -1, "vfmaddsub132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x96, 1, 1, -1, "vfmaddsub132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x97, 1, 0, -1, "vfmsubadd132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x97, 1, 1, -1, "vfmsubadd132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x98, 1, 0, -1, "vfmadd132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x98, 1, 1, -1, "vfmadd132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x99, 1, 0, -1, "vfmadd132sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0x99, 1, 1, -1, "vfmadd132s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9a, 1, 0, -1, "vfmsub132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9a, 1, 1, -1, "vfmsub132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9b, 1, 0, -1, "vfmsub132sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9b, 1, 1, -1, "vfmsub132s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9c, 1, 0, -1, "vfnmadd132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9c, 1, 1, -1, "vfnmadd132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9d, 1, 0, -1, "vfnmadd132sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9d, 1, 1, -1, "vfnmadd132s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9e, 1, 0, -1, "vfnmsub132ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9e, 1, 1, -1, "vfnmsub132p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0x9f, 1, 0, -1, "vfnmsub132sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0x9f, 1, 1, -1, "vfnmsub132s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xa6, 1, 0, -1, "vfmaddsub213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa6, 1, 1, -1, "vfmaddsub213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa7, 1, 0, -1, "vfmsubadd213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa7, 1, 1, -1, "vfmsubadd213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa8, 1, 0, -1, "vfmadd213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa8, 1, 1, -1, "vfmadd213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xa9, 1, 0, -1, "vfmadd213sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xa9, 1, 1, -1, "vfmadd213s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xaa, 1, 0, -1, "vfmsub213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xaa, 1, 1, -1, "vfmsub213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xab, 1, 0, -1, "vfmsub213sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xab, 1, 1, -1, "vfmsub213s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xac, 1, 0, -1, "vfnmadd213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xac, 1, 1, -1, "vfnmadd213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xad, 1, 0, -1, "vfnmadd213sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xad, 1, 1, -1, "vfnmadd213s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xae, 1, 0, -1, "vfnmsub213ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xae, 1, 1, -1, "vfnmsub213p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xaf, 1, 0, -1, "vfnmsub213sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xaf, 1, 1, -1, "vfnmsub213s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xb6, 1, 0, -1, "vfmaddsub231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb6, 1, 1, -1, "vfmaddsub231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb7, 1, 0, -1, "vfmsubadd231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb7, 1, 1, -1, "vfmsubadd231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb8, 1, 0, -1, "vfmadd231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb8, 1, 1, -1, "vfmadd231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xb9, 1, 0, -1, "vfmadd231sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xb9, 1, 1, -1, "vfmadd231s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xba, 1, 0, -1, "vfmsub231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xba, 1, 1, -1, "vfmsub231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xbb, 1, 0, -1, "vfmsub231sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xbb, 1, 1, -1, "vfmsub231s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xbc, 1, 0, -1, "vfnmadd231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xbc, 1, 1, -1, "vfnmadd231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xbd, 1, 0, -1, "vfnmadd231sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xbd, 1, 1, -1, "vfnmadd231s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xbe, 1, 0, -1, "vfnmsub231ph", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xbe, 1, 1, -1, "vfnmsub231p{bad}", "Vx,Hx,Wx", EV_ER|EV_BCW},
+   {6, 0xbf, 1, 0, -1, "vfnmsub231sh", "Vo,Ho,Ww", EV_ER},
+   {6, 0xbf, 1, 1, -1, "vfnmsub231s{bad}", "Vo,Ho,Ww", EV_ER},
+   {6, 0xd6, 2, 0, -1, "vfmulcph", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0xd6, 2, 1, -1, "vfmulcp{bad}", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0xd6, 3, 0, -1, "vfcmulcph", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0xd6, 3, 1, -1, "vfcmulcp{bad}", "Vx,Hx,Wx", EV_ER|EV_BC|EV_DEST},
+   {6, 0xd7, 2, 0, -1, "vfmulcsh", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0xd7, 2, 1, -1, "vfmulcs{bad}", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0xd7, 3, 0, -1, "vfcmulcsh", "Vo,Ho,Wd", EV_ER|EV_DEST},
+   {6, 0xd7, 3, 1, -1, "vfcmulcs{bad}", "Vo,Ho,Wd", EV_ER|EV_DEST},
+};
+
+/* VEX opmask instructions by map, opcode, mandatory prefix and VEX.W, as    */
+/* "register|memory" forms where an empty form is (bad). Those with a vvvv   */
+/* operand are VEX.L1, the others VEX.L0.                                    */
+struct OpMask {
+   uint8_t map;
+   uint8_t opcode;
+   uint8_t pp;
+   uint8_t w;
+   const char* mnem;
+   const char* args;
+};
+
+static const OpMask KMASK[] = {
+   {1, 0x41, 0, 0, "kandw", "kG,kH,kE|"},
+   {1, 0x41, 0, 1, "kandq", "kG,kH,kE|"},
+   {1, 0x41, 1, 0, "kandb", "kG,kH,kE|"},
+   {1, 0x41, 1, 1, "kandd", "kG,kH,kE|"},
+   {1, 0x42, 0, 0, "kandnw", "kG,kH,kE|"},
+   {1, 0x42, 0, 1, "kandnq", "kG,kH,kE|"},
+   {1, 0x42, 1, 0, "kandnb", "kG,kH,kE|"},
+   {1, 0x42, 1, 1, "kandnd", "kG,kH,kE|"},
+   {1, 0x44, 0, 0, "knotw", "kG,kE|"},
+   {1, 0x44, 0, 1, "knotq", "kG,kE|"},
+   {1, 0x44, 1, 0, "knotb", "kG,kE|"},
+   {1, 0x44, 1, 1, "knotd", "kG,kE|"},
+   {1, 0x45, 0, 0, "korw", "kG,kH,kE|"},
+   {1, 0x45, 0, 1, "korq", "kG,kH,kE|"},
+   {1, 0x45, 1, 0, "korb", "kG,kH,kE|"},
+   {1, 0x45, 1, 1, "kord", "kG,kH,kE|"},
+   {1, 0x46, 0, 0, "kxnorw", "kG,kH,kE|"},
+   {1, 0x46, 0, 1, "kxnorq", "kG,kH,kE|"},
+   {1, 0x46, 1, 0, "kxnorb", "kG,kH,kE|"},
+   {1, 0x46, 1, 1, "kxnord", "kG,kH,kE|"},
+   {1, 0x47, 0, 0, "kxorw", "kG,kH,kE|"},
+   {1, 0x47, 0, 1, "kxorq", "kG,kH,kE|"},
+   {1, 0x47, 1, 0, "kxorb", "kG,kH,kE|"},
+   {1, 0x47, 1, 1, "kxord", "kG,kH,kE|"},
+   {1, 0x4a, 0, 0, "kaddw", "kG,kH,kE|"},
+   {1, 0x4a, 0, 1, "kaddq", "kG,kH,kE|"},
+   {1, 0x4a, 1, 0, "kaddb", "kG,kH,kE|"},
+   {1, 0x4a, 1, 1, "kaddd", "kG,kH,kE|"},
+   {1, 0x4b, 0, 0, "kunpckwd", "kG,kH,kE|"},
+   {1, 0x4b, 0, 1, "kunpckdq", "kG,kH,kE|"},
+   {1, 0x4b, 1, 0, "kunpckbw", "kG,kH,kE|"},
+   {1, 0x90, 0, 0, "kmovw", "kG,kE|kG,Mw"},
+   {1, 0x90, 0, 1, "kmovq", "kG,kE|kG,Mq"},
+   {1, 0x90, 1, 0, "kmovb", "kG,kE|kG,Mb"},
+   {1, 0x90, 1, 1, "kmovd", "kG,kE|kG,Md"},
+   {1, 0x91, 0, 0, "kmovw", "|Mw,kG"},
+   {1, 0x91, 0, 1, "kmovq", "|Mq,kG"},
+   {1, 0x91, 1, 0, "kmovb", "|Mb,kG"},
+   {1, 0x91, 1, 1, "kmovd", "|Md,kG"},
+   {1, 0x92, 0, 0, "kmovw", "kG,Ed|"},
+   {1, 0x92, 1, 0, "kmovb", "kG,Ed|"},
+   {1, 0x92, 3, 0, "kmovd", "kG,Ed|"},
+   {1, 0x92, 3, 1, "kmovq", "kG,Eq|"},
+   {1, 0x93, 0, 0, "kmovw", "Gd,kE|"},
+   {1, 0x93, 1, 0, "kmovb", "Gd,kE|"},
+   {1, 0x93, 3, 0, "kmovd", "Gd,kE|"},
+   {1, 0x93, 3, 1, "kmovq", "Gq,kE|"},
+   {1, 0x98, 0, 0, "kortestw", "kG,kE|"},
+   {1, 0x98, 0, 1, "kortestq", "kG,kE|"},
+   {1, 0x98, 1, 0, "kortestb", "kG,kE|"},
+   {1, 0x98, 1, 1, "kortestd", "kG,kE|"},
+   {1, 0x99, 0, 0, "ktestw", "kG,kE|"},
+   {1, 0x99, 0, 1, "ktestq", "kG,kE|"},
+   {1, 0x99, 1, 0, "ktestb", "kG,kE|"},
+   {1, 0x99, 1, 1, "ktestd", "kG,kE|"},
+   {3, 0x30, 1, 0, "kshiftrb", "kG,kE,Ib|"},
+   {3, 0x30, 1, 1, "kshiftrw", "kG,kE,Ib|"},
+   {3, 0x31, 1, 0, "kshiftrd", "kG,kE,Ib|"},
+   {3, 0x31, 1, 1, "kshiftrq", "kG,kE,Ib|"},
+   {3, 0x32, 1, 0, "kshiftlb", "kG,kE,Ib|"},
+   {3, 0x32, 1, 1, "kshiftlw", "kG,kE,Ib|"},
+   {3, 0x33, 1, 0, "kshiftld", "kG,kE,Ib|"},
+   {3, 0x33, 1, 1, "kshiftlq", "kG,kE,Ib|"},
+};
+
+/* XOP instructions by map, opcode and ModRM.reg (8 for any), "W0/W1" where */
+/* VEX.W swaps two sources. Without a "/" VEX.W must be 0 unless it sizes a */
+/* "y" register; VEX.L1 needs an "x" operand, except for bextr.             */
+struct OpXop {
+   uint8_t map;
+   uint8_t opcode;
+   uint8_t reg;
+   const char* mnem;
+   const char* args;
+};
+
+static const OpXop XOP[] = {
+   {8, 0x85, 8, "vpmacssww", "Vo,Ho,Wo,Lo"},
+   {8, 0x86, 8, "vpmacsswd", "Vo,Ho,Wo,Lo"},
+   {8, 0x87, 8, "vpmacssdql", "Vo,Ho,Wo,Lo"},
+   {8, 0x8e, 8, "vpmacssdd", "Vo,Ho,Wo,Lo"},
+   {8, 0x8f, 8, "vpmacssdqh", "Vo,Ho,Wo,Lo"},
+   {8, 0x95, 8, "vpmacsww", "Vo,Ho,Wo,Lo"},
+   {8, 0x96, 8, "vpmacswd", "Vo,Ho,Wo,Lo"},
+   {8, 0x97, 8, "vpmacsdql", "Vo,Ho,Wo,Lo"},
+   {8, 0x9e, 8, "vpmacsdd", "Vo,Ho,Wo,Lo"},
+   {8, 0x9f, 8, "vpmacsdqh", "Vo,Ho,Wo,Lo"},
+   {8, 0xa2, 8, "vpcmov", "Vx,Hx,Wx,Lx/Vx,Hx,Lx,Wx"},
+   {8, 0xa3, 8, "vpperm", "Vo,Ho,Wo,Lo/Vo,Ho,Lo,Wo"},
+   {8, 0xa6, 8, "vpmadcsswd", "Vo,Ho,Wo,Lo"},
+   {8, 0xb6, 8, "vpmadcswd", "Vo,Ho,Wo,Lo"},
+   {8, 0xc0, 8, "vprotb", "Vo,Wo,Ib"},
+   {8, 0xc1, 8, "vprotw", "Vo,Wo,Ib"},
+   {8, 0xc2, 8, "vprotd", "Vo,Wo,Ib"},
+   {8, 0xc3, 8, "vprotq", "Vo,Wo,Ib"},
+   {8, 0xcc, 8, "vpcomb", "Vo,Ho,Wo,Ib"},
+   {8, 0xcd, 8, "vpcomw", "Vo,Ho,Wo,Ib"},
+   {8, 0xce, 8, "vpcomd", "Vo,Ho,Wo,Ib"},
+   {8, 0xcf, 8, "vpcomq", "Vo,Ho,Wo,Ib"},
+   {8, 0xec, 8, "vpcomub", "Vo,Ho,Wo,Ib"},
+   {8, 0xed, 8, "vpcomuw", "Vo,Ho,Wo,Ib"},
+   {8, 0xee, 8, "vpcomud", "Vo,Ho,Wo,Ib"},
+   {8, 0xef, 8, "vpcomuq", "Vo,Ho,Wo,Ib"},
+   {9, 0x01, 1, "blcfill", "By,Ey"},
+   {9, 0x01, 2, "blsfill", "By,Ey"},
+   {9, 0x01, 3, "blcs", "By,Ey"},
+   {9, 0x01, 4, "tzmsk", "By,Ey"},
+   {9, 0x01, 5, "blcic", "By,Ey"},
+   {9, 0x01, 6, "blsic", "By,Ey"},
+   {9, 0x01, 7, "t1mskc", "By,Ey"},
+   {9, 0x02, 1, "blcmsk", "By,Ey"},
+   {9, 0x02, 6, "blci", "By,Ey"},
+   {9, 0x12, 0, "llwpcb", "Ey"},
+   {9, 0x12, 1, "slwpcb", "Ey"},
+   {9, 0x80, 8, "vfrczps", "Vx,Wx"},
+   {9, 0x81, 8, "vfrczpd", "Vx,Wx"},
+   {9, 0x82, 8, "vfrczss", "Vo,Wd"},
+   {9, 0x83, 8, "vfrczsd", "Vo,Wq"},
+   {9, 0x90, 8, "vprotb", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x91, 8, "vprotw", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x92, 8, "vprotd", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x93, 8, "vprotq", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x94, 8, "vpshlb", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x95, 8, "vpshlw", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x96, 8, "vpshld", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x97, 8, "vpshlq", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x98, 8, "vpshab", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x99, 8, "vpshaw", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x9a, 8, "vpshad", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0x9b, 8, "vpshaq", "Vo,Wo,Ho/Vo,Ho,Wo"},
+   {9, 0xc1, 8, "vphaddbw", "Vo,Wo"},
+   {9, 0xc2, 8, "vphaddbd", "Vo,Wo"},
+   {9, 0xc3, 8, "vphaddbq", "Vo,Wo"},
+   {9, 0xc6, 8, "vphaddwd", "Vo,Wo"},
+   {9, 0xc7, 8, "vphaddwq", "Vo,Wo"},
+   {9, 0xcb, 8, "vphadddq", "Vo,Wo"},
+   {9, 0xd1, 8, "vphaddubw", "Vo,Wo"},
+   {9, 0xd2, 8, "vphaddubd", "Vo,Wo"},
+   {9, 0xd3, 8, "vphaddubq", "Vo,Wo"},
+   {9, 0xd6, 8, "vphadduwd", "Vo,Wo"},
+   {9, 0xd7, 8, "vphadduwq", "Vo,Wo"},
+   {9, 0xdb, 8, "vphaddudq", "Vo,Wo"},
+   {9, 0xe1, 8, "vphsubbw", "Vo,Wo"},
+   {9, 0xe2, 8, "vphsubwd", "Vo,Wo"},
+   {9, 0xe3, 8, "vphsubdq", "Vo,Wo"},
+   {10, 0x10, 8, "bextr", "Gy,Ey,Id"},
+   {10, 0x12, 0, "lwpins", "By,Ed,Id"},
+   {10, 0x12, 1, "lwpval", "By,Ed,Id"},
+};
+/* -------------------------------------------------------------------------- */
+
+
+/* --------------------------------- Context -------------------------------- */
+struct Ctx {
+   const uint8_t* code;
+   size_t size;
+   size_t pos = 0;
+   uint64_t addr;
+   size_t start = 0;       /* first byte after legacy prefixes and REX */
+   size_t op_end = 0;      /* first byte after the opcode */
+   bool bad = false;
+   bool truncated = false;
+   size_t bad_len = 0;
+
+   /* prefixes */
+   bool opsize = false;
+   bool adsize = false;
+   uint8_t rep = 0;
+   uint8_t num_rep = 0;
+   uint8_t seg = 0;
+   uint8_t num_seg = 0;
+   bool seg_used = false;
+   uint8_t rex = 0;
+   uint8_t rex_used = 0;
+   bool lock = false;
+   bool opsize_used = false;
+   bool adsize_used = false;
+
+   /* vex */
+   bool vex = false;
+   uint8_t vex_l = 0;
+   uint8_t vex_w = 0;
+   uint8_t vex_v = 0;
+   bool vex_legacy = false;   /* 66/F2/F3 before VEX: printed, then erased */
+
+   /* evex: vex_l is the vector length, 2 for 512 bits */
+   bool evex = false;
+   bool evex_b = false;
+   bool evex_z = false;
+   uint8_t evex_aaa = 0;
+   uint8_t evex_r = 0;     /* R', V' and X as bit 4 of a register number */
+   uint8_t evex_v = 0;
+   uint8_t evex_x = 0;
+   uint8_t evex_ll = 0;    /* L'L as written, the rounding mode with EVEX.b */
+   bool evex_len = false;  /* an operand before a broadcast shows the length */
+   uint16_t eflags = 0;
+
+   /* modrm */
+   bool has_modrm = false;
+   uint8_t mod = 0;
+   uint8_t reg = 0;
+   uint8_t rm = 0;
+   bool has_sib = false;
+   uint8_t scale = 0;
+   uint8_t index = 0;
+   uint8_t base = 0;
+   int64_t disp = 0;
+   bool rip = false;       /* objdump comments on rip-relative operands */
+   bool pad = false;       /* padded to 6 columns whatever the prefixes */
+
+   /* operand size of the current entry */
+   uint8_t flags = 0;
+
+   string mnem;
+   string ops;
+};
+
+
+static bool need(Ctx& c, size_t k) {
+   if (c.pos + k > c.size || c.pos + k > 15) {
+      c.bad = c.truncated = true;
+      return false;
+   }
+   return true;
+}
+
+
+/* invalid opcode: objdump stops right after the opcode bytes */
+static void bad_opcode(Ctx& c) {
+   if (!c.bad) {
+      c.bad = true;
+      c.bad_len = c.op_end;
+   }
+}
+
+
+/* invalid operand: objdump throws away all but the first opcode byte */
+static void bad_operand(Ctx& c) {
+   if (!c.bad) {
+      c.bad = true;
+      c.bad_len = c.start + 1;
+   }
+}
+
+
+static uint8_t opcode(Ctx& c) {
+   auto b = c.code[c.pos++];
+   c.op_end = c.pos;
+   return b;
+}
+
+
+static uint64_t fetch(Ctx& c, uint8_t k) {
+   if (!need(c, k)) {
+      c.pos = std::min<size_t>(c.size, 15);
+      return 0;
+   }
+   uint64_t v = 0;
+   for (uint8_t i = 0; i < k; ++i)
+      v |= (uint64_t)c.code[c.pos + i] << (i << 3);
+   c.pos += k;
+   return v;
+}
+
+
+static int64_t sext(uint64_t v, uint8_t bits) {
+   auto shift = 64 - bits;
+   return (int64_t)(v << shift) >> shift;
+}
+
+
+static string hex(uint64_t v) {
+   char buf[24];
+   snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)v);
+   return string(buf);
+}
+
+
+static uint64_t mask(uint64_t v, uint8_t bits) {
+   return (bits >= 64)? v: (v & ((1ULL << bits) - 1));
+}
+
+
+/* 66 and 67 left unused are printed as data16 and addr32 */
+static bool data16(Ctx& c) {
+   c.opsize_used = true;
+   return c.opsize;
+}
+
+
+static bool addr32(Ctx& c) {
+   c.adsize_used = true;
+   return c.adsize;
+}
+
+
+static bool rex_bit(Ctx& c, uint8_t bit) {
+   if (c.rex & bit) {
+      c.rex_used |= bit | 0x40;
+      return true;
+   }
+   return false;
+}
+
+
+/* operand size in bits for v */
+static uint8_t osize(Ctx& c) {
+   /* REX.W is left unused by stack and branch operands */
+   if (c.flags & F64)
+      return 64;
+   if (c.flags & D64)
+      return data16(c)? 16: 64;
+   if (rex_bit(c, 0x8))
+      return 64;
+   return data16(c)? 16: 32;
+}
+
+
+static const char* gpr(Ctx& c, uint8_t num, uint8_t bits) {
+   switch (bits) {
+      case 8:
+         /* only spl/bpl/sil/dil tell a REX apart from its absence */
+         if (c.rex != 0 && num >= 4 && num < 8) {
+            c.rex_used |= 0x40;
+            return R8_REX[num];
+         }
+         return R8[num];
+      case 16:
+         return R16[num];
+      case 32:
+         return R32[num];
+      default:
+         return R64[num];
+   }
+}
+
+
+static bool modrm(Ctx& c) {
+   if (c.has_modrm)
+      return true;
+   if (!need(c, 1))
+      return false;
+   auto b = c.code[c.pos++];
+   c.has_modrm = true;
+   c.mod = b >> 6;
+   c.reg = (b >> 3) & 7;
+   c.rm = b & 7;
+   if (c.mod == 3)
+      return true;
+   if (c.rm == 4) {
+      if (!need(c, 1))
+         return false;
+      auto s = c.code[c.pos++];
+      c.has_sib = true;
+      c.scale = s >> 6;
+      c.index = (s >> 3) & 7;
+      c.base = s & 7;
+   }
+   if (c.mod == 1)
+      c.disp = sext(fetch(c, 1), 8);
+   else if (c.mod == 2 || (c.mod == 0 && (c.rm == 5 ||
+   (c.has_sib && c.base == 5))))
+      c.disp = sext(fetch(c, 4), 32);
+   return !c.bad;
+}
+
+
+/* log2 of the memory size in bytes for the vector size codes, -1 if none */
+static int8_t mem_log(char s, Ctx& c) {
+   switch (s) {
+      case 'b': return 0;
+      case 'w': return 1;
+      case 'd': return 2;
+      case 'q': return 3;
+      case 'o': return 4;
+      case 'x': return 4 + c.vex_l;
+      case 'h': return 3 + c.vex_l;
+      case 'u': return 2 + c.vex_l;
+      case 'e': return 1 + c.vex_l;
+      case 'm': return c.vex_l? 4 + c.vex_l: 3;
+      case 'f': return c.vex_w? 3: 2;
+      default:  return -1;
+   }
+}
+
+
+static const char* size_ptr(char s, Ctx& c) {
+   static const char* const ptr[7] = {"BYTE PTR ", "WORD PTR ", "DWORD PTR ",
+      "QWORD PTR ", "XMMWORD PTR ", "YMMWORD PTR ", "ZMMWORD PTR "};
+   switch (s) {
+      case 't': return "TBYTE PTR ";
+      case 'p': return data16(c)? "DWORD PTR ": "FWORD PTR ";
+   }
+   auto k = mem_log(s, c);
+   return (k < 0)? "": ptr[k];
+}
+
+
+static string xmm(Ctx& c, uint8_t num, char s) {
+   static const char* const name[3] = {"xmm", "ymm", "zmm"};
+   uint8_t l = 0;
+   if (s == 'x' || s == 'm')
+      l = c.vex_l;
+   else if (s == 'h')
+      l = c.vex_l >> 1;
+   else if (s == 'y')
+      l = 1;
+   /* objdump leaves {1toN} off a broadcast once the length is known */
+   if (s == 'x' || s == 'm' || (s == 'h' && c.vex_l == 2))
+      c.evex_len = true;
+   return name[l] + std::to_string(num);
+}
+
+
+/* a VSIB index is the vector register of size code vsib */
+static string mem(Ctx& c, const char* ptr, char vsib = 0) {
+   string s = ptr;
+   /* REX.B counts as used even without a base register */
+   uint8_t rex_b = rex_bit(c, 0x1)? 8: 0;
+   if (c.seg == 0x64 || c.seg == 0x65) {
+      s += (c.seg == 0x64)? "fs:": "gs:";
+      c.seg_used = true;
+   }
+   auto const* const* areg = addr32(c)? R32: R64;
+
+   /* rip-relative */
+   if (!c.has_sib && c.mod == 0 && c.rm == 5) {
+      c.rip = true;
+      s += addr32(c)? "[eip": "[rip";
+      if (c.disp != 0)
+         s += "+" + hex((uint64_t)c.disp);
+      return s + "]";
+   }
+
+   uint8_t base = c.has_sib? c.base: c.rm;
+   bool has_base = !(c.mod == 0 && base == 5);
+   uint8_t rbase = base | rex_b;
+   bool has_index = false;
+   uint8_t rindex = 0;
+   if (c.has_sib) {
+      rindex = c.index | (rex_bit(c, 0x2)? 8: 0);
+      has_index = (rindex != 4 || vsib != 0);
+   }
+   bool has_disp = has_base || (c.has_sib && (has_index || c.scale != 0));
+
+   if (!has_disp) {
+      /* absolute disp32 through SIB */
+      if (addr32(c)) {
+         s += "[eiz+" + hex((uint32_t)c.disp) + "]";
+         return s;
+      }
+      if (c.seg != 0x64 && c.seg != 0x65)
+         s += "ds:";
+      return s + hex((uint64_t)c.disp);
+   }
+
+   s += "[";
+   if (has_base)
+      s += areg[rbase];
+   if (c.has_sib && (c.scale != 0 || has_index || (has_base && base != 4))) {
+      if (has_base)
+         s += "+";
+      if (vsib != 0)
+         s += xmm(c, rindex | c.evex_v, vsib);
+      else
+         s += has_index? areg[rindex]: (addr32(c)? "eiz": "riz");
+      if (c.scale != 0)
+         s += "*" + std::to_string(1 << c.scale);
+   }
+   if (c.disp != 0) {
+      if (c.disp < 0)
+         s += "-" + hex((uint64_t)(-c.disp));
+      else
+         s += "+" + hex((uint64_t)c.disp);
+   }
+   return s + "]";
+}
+
+
+/* decimal branch target, as left behind by the objdump clean-up */
+static string target(uint64_t t) {
+   if ((t >> 60) != 0) {
+      char buf[24];
+      snprintf(buf, sizeof(buf), "%llx", (unsigned long long)t);
+      return (std::strncmp(buf, "fff", 3) == 0)? "0x" + string(buf): string(buf);
+   }
+   if (t == 0)
+      return "0";
+   if (t >= (1ULL << 36))
+      return "-1";
+   return std::to_string((int32_t)(uint32_t)t);
+}
+
+
+static string imm(Ctx& c, char s) {
+   switch (s) {
+      case 'b':
+         return hex(fetch(c, 1));
+      case 'w':
+         return hex(fetch(c, 2));
+      case 'd':
+         return hex(fetch(c, 4));
+      case '4':
+         return hex(c.code[c.pos - 1] & 0xf);
+      case 's': {
+         auto bits = osize(c);
+         return hex(mask((uint64_t)sext(fetch(c, 1), 8), bits));
+      }
+      case 'z': {
+         auto bits = osize(c);
+         if (bits == 16)
+            return hex(fetch(c, 2));
+         auto v = sext(fetch(c, 4), 32);
+         return hex(mask((uint64_t)v, bits));
+      }
+      case 'v': {
+         auto bits = osize(c);
+         return hex(fetch(c, bits / 8));
+      }
+   }
+   return "";
+}
+
+
+/* EVEX.b on memory broadcasts one element, or is (bad) if not allowed */
+static string evex_mem(Ctx& c, const char* ptr, char vsib = 0) {
+   if (!c.evex_b)
+      return mem(c, ptr, vsib);
+   if (!(c.eflags & (EV_BC|EV_BCW)))
+      return mem(c, "", vsib) + "{bad}";
+   auto elem = (c.eflags & EV_BCW)? 2: c.vex_w? 8: 4;
+   auto s = mem(c, (elem == 2)? "WORD BCST ": (elem == 8)? "QWORD BCST ":
+                "DWORD BCST ", vsib);
+   if (!c.evex_len)
+      s += "{1to" + std::to_string((16 << c.vex_l) / elem) + "}";
+   return s;
+}
+
+
+/* one operand; empty string with c.bad set on invalid encodings */
+static string operand(Ctx& c, const string& tok) {
+   if (tok == "AL")
+      return "al";
+   if (tok == "CL")
+      return "cl";
+   if (tok == "DX")
+      return "dx";
+   if (tok == "1")
+      return "1";
+   if (tok == "rAX")
+      return gpr(c, 0, osize(c));
+   if (tok == "eAX")
+      return data16(c)? "ax": "eax";
+   if (tok == "ST")
+      return "st";
+   if (tok == "T")
+      return "st(" + std::to_string(c.rm) + ")";
+   if (tok == "FS")
+      return "fs";
+   if (tok == "GS")
+      return "gs";
+   if (tok == "XMM0")
+      return "xmm0";
+
+   auto k = tok[0];
+   auto s = (tok.length() > 1)? tok[1]: '_';
+   auto bits = [&](char sz) -> uint8_t {
+      switch (sz) {
+         case 'b': return 8;
+         case 'w': return 16;
+         case 'd': return 32;
+         case 'q': return 64;
+         case 'y': return rex_bit(c, 0x8)? 64: 32;
+         case 'z': return data16(c)? 16: 32;
+         case 'a': return addr32(c)? 32: 64;
+         default:  return osize(c);
+      }
+   };
+
+   switch (k) {
+      case 'Z': {
+         auto num = (uint8_t)((c.code[c.pos-1] & 7) | (rex_bit(c, 0x1)? 8: 0));
+         return gpr(c, num, bits(s));
+      }
+      case 'G': {
+         auto num = (uint8_t)(c.reg | (rex_bit(c, 0x4)? 8: 0));
+         if (c.evex_r != 0)
+            return "(bad)";
+         return gpr(c, num, bits(s));
+      }
+      case 'E':
+      case 'M': {
+         if (c.mod == 3) {
+            if (k == 'M') {
+               if (c.flags & MODT)
+                  bad_opcode(c);
+               else
+                  bad_operand(c);
+               return "";
+            }
+            auto num = (uint8_t)(c.rm | (rex_bit(c, 0x1)? 8: 0));
+            return gpr(c, num, bits(s));
+         }
+         switch (s) {
+            case 'v': return mem(c, size_ptr("wdq"[bits(s)/32], c));
+            case 'y': return mem(c, size_ptr(bits(s) == 64? 'q': 'd', c));
+            case 'z': return mem(c, size_ptr(data16(c)? 'w': 'd', c));
+            default:  return evex_mem(c, size_ptr(s, c));
+         }
+      }
+      case 'R':
+         if (c.mod == 3)
+            return R32[c.rm | (rex_bit(c, 0x1)? 8: 0)];
+         return evex_mem(c, size_ptr(s, c));
+      case 'K':
+         return R64[c.rm | (rex_bit(c, 0x1)? 8: 0)];
+      case 'S':
+         if (s == 'w')
+            return SREG[c.reg];
+         /* 8c: register destination takes the operand size */
+         if (c.mod == 3) {
+            auto num = (uint8_t)(c.rm | (rex_bit(c, 0x1)? 8: 0));
+            return gpr(c, num, osize(c));
+         }
+         return mem(c, "WORD PTR ");
+      case 'C':
+         return "cr" + std::to_string(c.reg | (rex_bit(c, 0x4)? 8: 0));
+      case 'D':
+         return "dr" + std::to_string(c.reg | (rex_bit(c, 0x4)? 8: 0));
+      case 'I':
+         return imm(c, s);
+      case 'J': {
+         /* 66 without REX.W takes a rel16, the target wraps at 16 bits */
+         if (s == 'z' && !(c.rex & 0x8) && data16(c)) {
+            auto rel = sext(fetch(c, 2), 16);
+            return target((c.addr + c.pos + rel) & 0xffff);
+         }
+         int64_t rel = (s == 'b')? sext(fetch(c, 1), 8): sext(fetch(c, 4), 32);
+         return target(c.addr + c.pos + rel);
+      }
+      case 'O': {
+         auto moffs = fetch(c, addr32(c)? 4: 8);
+         /* objdump still prints addr32, which the clean-up erases */
+         c.adsize_used = false;
+         string seg = "ds:";
+         if (c.seg == 0x64 || c.seg == 0x65) {
+            seg = (c.seg == 0x64)? "fs:": "gs:";
+            c.seg_used = true;
+         }
+         return seg + hex(moffs);
+      }
+      case 'X':
+      case 'Y': {
+         string ptr;
+         switch (s) {
+            case 'b': ptr = "BYTE PTR "; break;
+            case 'l': ptr = "BYTE PTR "; break;
+            case 'z': ptr = data16(c)? "WORD PTR ": "DWORD PTR "; break;
+            default:  ptr = size_ptr("wdq"[osize(c)/32], c); break;
+         }
+         if (k == 'Y')
+            return ptr + (addr32(c)? "es:[edi]": "es:[rdi]");
+         /* any segment override applies, only fs/gs are shown */
+         string seg = "ds:";
+         if (c.seg != 0) {
+            if (c.seg == 0x64 || c.seg == 0x65)
+               seg = (c.seg == 0x64)? "fs:": "gs:";
+            c.seg_used = true;
+         }
+         if (s == 'l')
+            return ptr + seg + (addr32(c)? "[ebx]": "[rbx]");
+         return ptr + seg + (addr32(c)? "[esi]": "[rsi]");
+      }
+      case 'V':
+         return xmm(c, c.reg | (rex_bit(c, 0x4)? 8: 0) | c.evex_r, s);
+      case 'H':
+         return xmm(c, c.vex_v | c.evex_v, s);
+      /* objdump takes no 256-bit form of a general register */
+      case 'B':
+         return c.vex_l? "(bad)": gpr(c, c.vex_v, bits(s));
+      case 'L':
+         return xmm(c, (uint8_t)(fetch(c, 1) >> 4), s);
+      case 'U':
+      case 'W':
+         if (c.mod == 3)
+            return xmm(c, c.rm | (rex_bit(c, 0x1)? 8: 0) | c.evex_x, s);
+         if (k == 'U' && c.evex) {
+            /* objdump keeps only 62 and P0 */
+            c.bad = true;
+            c.bad_len = c.start + 2;
+            return "";
+         }
+         if (k == 'U') {
+            if (c.flags & MODT)
+               bad_opcode(c);
+            else
+               bad_operand(c);
+            return "";
+         }
+         return evex_mem(c, size_ptr(s, c));
+      case 'k':
+         /* opmask registers are k0-k7 */
+         if (s == 'G')
+            return (rex_bit(c, 0x4) || c.evex_r)? "(bad)":
+                   "k" + std::to_string(c.reg);
+         if (s == 'H')
+            return (c.vex_v > 7 || c.evex_v)? "(bad)":
+                   "k" + std::to_string(c.vex_v);
+         return rex_bit(c, 0x1)? "(bad)": "k" + std::to_string(c.rm);
+      case 't':
+         /* tile registers are tmm0-tmm7, a tile memory needs a SIB byte */
+         if (s == 'G')
+            return rex_bit(c, 0x4)? "(bad)": "tmm" + std::to_string(c.reg);
+         if (s == 'H')
+            return (c.vex_v > 7)? "(bad)": "tmm" + std::to_string(c.vex_v);
+         if (s == 'E')
+            return rex_bit(c, 0x1)? "(bad)": "tmm" + std::to_string(c.rm);
+         if (!c.has_sib) {
+            c.bad = true;
+            c.bad_len = c.op_end + 1;
+            return "";
+         }
+         return mem(c, "");
+      case 'v':
+         /* VSIB: a vector index needs a SIB byte */
+         if (c.mod == 3) {
+            bad_operand(c);
+            return "";
+         }
+         if (!c.has_sib) {
+            c.bad = true;
+            c.bad_len = c.op_end + 1;
+            return "";
+         }
+         return evex_mem(c, size_ptr(s, c), tok[2]);
+      case 'P':
+         return "mm" + std::to_string(c.reg);
+      case 'N':
+      case 'Q':
+         if (c.mod == 3)
+            return "mm" + std::to_string(c.rm);
+         if (k == 'N') {
+            if (c.flags & MODT)
+               bad_opcode(c);
+            else
+               bad_operand(c);
+            return "";
+         }
+         return mem(c, size_ptr(s, c));
+   }
+   bad_opcode(c);
+   return "";
+}
+
+
+static void operands(Ctx& c, const char* args) {
+   if (args == nullptr || args[0] == '\0')
+      return;
+   string a = args;
+   size_t start = 0;
+   while (start <= a.length() && !c.bad) {
+      auto end = a.find(',', start);
+      if (end == string::npos)
+         end = a.length();
+      auto op = operand(c, a.substr(start, end - start));
+      if (!c.ops.empty())
+         c.ops += ",";
+      c.ops += op;
+      start = end + 1;
+   }
+   /* after an invalid operand objdump reads the imm8 operands that are */
+   /* left from the byte after the first opcode byte                    */
+   if (c.bad && !c.evex && c.bad_len == c.start + 1)
+      for (auto p = a.find(",Ib", start - 1); p != string::npos;
+      p = a.find(",Ib", p + 1))
+         ++c.bad_len;
+}
+
+
+static bool needs_modrm(const char* args) {
+   if (args == nullptr)
+      return false;
+   for (auto p = args; *p != '\0'; ++p)
+      if ((p == args || p[-1] == ',' || p[-1] == '|') &&
+      std::strchr("EGMRKSCDVWUPQNTktv", *p) && std::strncmp(p, "ST", 2) != 0 &&
+      std::strncmp(p, "DX", 2) != 0 && std::strncmp(p, "CL", 2) != 0 &&
+      std::strncmp(p, "GS", 2) != 0)
+         return true;
+   return false;
+}
+
+
+/* value of the trailing imm8 operand */
+static uint64_t last_imm(const string& ops) {
+   auto p = ops.rfind(',');
+   return (p == string::npos)? 0: std::strtoull(ops.c_str() + p + 1, nullptr,
+                                                16);
+}
+/* -------------------------------------------------------------------------- */
+
+
+/* ---------------------------------- Maps ---------------------------------- */
+static void decode_entry(Ctx& c, const Op& op, const char* args) {
+   c.flags = op.flags;
+   if (op.flags & BAD || op.mnem == nullptr) {
+      bad_opcode(c);
+      return;
+   }
+   /* K ignores ModRM.mod, no SIB or displacement follows */
+   if (args != nullptr && (args[0] == 'K' || std::strstr(args, ",K"))) {
+      if (!need(c, 1))
+         return;
+      auto b = c.code[c.pos++];
+      c.has_modrm = true;
+      c.mod = 3;
+      c.reg = (b >> 3) & 7;
+      c.rm = b & 7;
+   }
+   if (needs_modrm(args) && !modrm(c))
+      return;
+   c.mnem = op.mnem;
+   auto bar = (args == nullptr)? nullptr: std::strchr(args, '|');
+   if (bar == nullptr)
+      operands(c, args);
+   else if (c.mod == 3)
+      operands(c, string(args, bar).c_str());
+   else
+      operands(c, bar + 1);
+}
+
+
+/* mandatory prefix: F2/F3 (last one wins) take precedence over 66, an entry */
+/* missing for it is (bad); 66 still sizes v operands                        */
+static uint8_t mandatory(Ctx& c, const Op4& op) {
+   bool sse = op.op[1].mnem || op.op[2].mnem || op.op[3].mnem ||
+              (op.op[1].flags & BAD);
+   if (!sse)
+      return 0;
+   if (c.rep != 0) {
+      auto k = (c.rep == 0xf3)? 2: 3;
+      c.rep = 0;
+      return k;
+   }
+   if (c.opsize) {
+      c.opsize_used = true;
+      return 1;
+   }
+   return 0;
+}
+
+
+/* VEX.L and VEX.W allowed by the VL0.. of an entry */
+static bool vex_lw(Ctx& c, uint8_t v) {
+   return !(((v & VL0) && c.vex_l) || ((v & VL1) && !c.vex_l) ||
+            ((v & VW0) && c.vex_w) || ((v & VW1) && !c.vex_w));
+}
+
+
+/* whether an operand reads VEX.vvvv */
+static bool reads_vvvv(const string& args) {
+   for (size_t p = 0; p < args.length(); ++p)
+      if ((p == 0 || args[p-1] == ',') && (args[p] == 'H' || args[p] == 'B' ||
+      args.compare(p, 2, "tH") == 0))
+         return true;
+   return false;
+}
+
+
+static void decode_sse(Ctx& c, const Op4& op) {
+   uint8_t k = 0;
+   if (c.vex) {
+      /* VEX.pp is the mandatory prefix, without any fallback */
+      k = (c.rep == 0xf3)? 2: (c.rep == 0xf2)? 3: c.opsize? 1: 0;
+      c.rep = 0;
+      c.opsize = false;
+   }
+   else
+      k = mandatory(c, op);
+   auto const& e = op.op[k];
+   if (e.mnem == nullptr || (c.vex? e.vargs: e.args) == nullptr ||
+   (c.vex && !vex_lw(c, e.vex))) {
+      bad_opcode(c);
+      return;
+   }
+   /* register and memory forms come from separate tables, except for these */
+   /* where a mismatch is an invalid operand                                */
+   static const char* const one_form[] = {"movbe","movntq","maskmovq",
+      "maskmovdqu","movq2dq","movdq2q","extrq","insertq","aadd","aand","aor",
+      "axor"};
+   c.flags = e.flags;
+   if (std::none_of(std::begin(one_form), std::end(one_form),
+   [&](const char* m) { return std::strcmp(e.mnem, m) == 0; }) &&
+   !(c.vex && (e.vex & VRM)))
+      c.flags |= MODT;
+   if (needs_modrm(c.vex? e.vargs: e.args) && !modrm(c))
+      return;
+   string m = e.mnem;
+   auto slash = m.find('/');
+   if (slash != string::npos)
+      m = c.vex_w? m.substr(slash + 1): m.substr(0, slash);
+   if (c.mod == 3 && m == "movlps")
+      m = "movhlps";
+   else if (c.mod == 3 && m == "movhps")
+      m = "movlhps";
+
+   if (c.vex) {
+      c.mnem = (e.flags & PLAIN)? m: "v" + m;
+      string vargs = e.vargs;
+      slash = vargs.find('/');
+      if (slash != string::npos)
+         vargs = c.vex_w? vargs.substr(slash + 1): vargs.substr(0, slash);
+      auto bar = vargs.find('|');
+      if (bar != string::npos)
+         vargs = (c.mod == 3)? vargs.substr(0, bar): vargs.substr(bar + 1);
+      /* an empty form is (bad), and so is a VEX.vvvv no operand reads */
+      if (vargs.empty() || (c.vex_v != 0 && !reads_vvvv(vargs))) {
+         bad_opcode(c);
+         return;
+      }
+      operands(c, vargs.c_str());
+   }
+   else {
+      c.mnem = m;
+      operands(c, e.args);
+   }
+
+   /* suffix selected by REX.W / VEX.W */
+   if (c.mnem == "pextr" || c.mnem == "vpextr" || c.mnem == "pinsr" ||
+   c.mnem == "vpinsr" || c.mnem == "wrss" || c.mnem == "wruss")
+      c.mnem += (c.rex_used & 0x8)? "q": "d";
+   if ((c.mnem == "movd" || c.mnem == "vmovd") && (c.rex_used & 0x8))
+      c.mnem.back() = 'q';
+
+   /* cmp pseudo-ops */
+   if ((e.flags & CMP) && !c.bad) {
+      auto v = last_imm(c.ops);
+      if (v < (c.vex? 32u: 8u)) {
+         auto suffix = c.mnem.substr(c.mnem.length() - 2);
+         c.mnem = c.mnem.substr(0, c.mnem.length() - 2) +
+                  (c.vex? AVX_CMP[v]: SSE_CMP[v]) + suffix;
+         c.ops.erase(c.ops.rfind(','));
+      }
+   }
+}
+
+
+/* pclmulqdq pseudo-ops: imm8 0-3, 0x10 and 0x11 */
+static void pclmul(Ctx& c) {
+   auto v = last_imm(c.ops);
+   if (v > 0x11 || (v > 3 && v < 0x10))
+      return;
+   if (v >= 0x10)
+      v = v - 0x10 + 2;
+   c.mnem.replace(c.mnem.find("qdq"), 3, string((v & 1)? "hq": "lq") +
+                  ((v & 2)? "hq": "lq") + "dq");
+   c.ops.erase(c.ops.rfind(','));
+}
+
+
+static void decode_three(Ctx& c, const Op38* table, size_t num) {
+   if (!need(c, 1))
+      return;
+   auto b = opcode(c);
+   for (size_t i = 0; i < num; ++i)
+      if (table[i].opcode == b) {
+         decode_sse(c, table[i].op);
+         if (!c.bad && (c.mnem == "pclmulqdq" || c.mnem == "vpclmulqdq"))
+            pclmul(c);
+         /* a gather's destination, index and mask must all differ */
+         if (!c.bad && c.mnem.find("gather") != string::npos) {
+            auto dst = c.reg | ((c.rex & 0x4)? 8: 0);
+            auto index = c.index | ((c.rex & 0x2)? 8: 0);
+            if (dst == index || dst == c.vex_v || index == c.vex_v) {
+               c.bad = true;
+               c.bad_len = c.pos;
+            }
+         }
+         return;
+      }
+   bad_opcode(c);
+}
+
+
+static void decode_x87(Ctx& c, uint8_t b) {
+   if (!modrm(c))
+      return;
+   auto row = b - 0xd8;
+   const char* m = nullptr;
+   if (c.mod != 3) {
+      auto const& op = X87_MEM[row][c.reg];
+      if (op.mnem != nullptr) {
+         decode_entry(c, op, op.args);
+         /* 66 gives the 16-bit environment and state layouts */
+         if ((row == 1 || row == 5) && (c.reg == 4 || c.reg == 6) &&
+         data16(c))
+            c.mnem += "w";
+         return;
+      }
+      c.ops = mem(c, "");
+   }
+   else {
+      auto const& op = X87_REG[row][c.reg];
+      if (!(op.flags & (SPEC|BAD))) {
+         decode_entry(c, op, op.args);
+         return;
+      }
+      if (row == 1 && c.reg == 2 && c.rm == 0)
+         m = "fnop";
+      else if (row == 1 && c.reg >= 4)
+         m = X87_D9[c.reg - 4][c.rm];
+      else if (row == 2 && c.reg == 5 && c.rm == 1)
+         m = "fucompp";
+      else if (row == 3 && c.reg == 4) {
+         static const char* const db[8] = {"fneni(8087 only)",
+            "fndisi(8087 only)","fnclex","fninit","fnsetpm(287 only)",
+            "frstpm(287 only)",0,0};
+         m = db[c.rm];
+      }
+      else if (row == 6 && c.reg == 3 && c.rm == 1)
+         m = "fcompp";
+      else if (row == 7 && c.reg == 4 && c.rm == 0) {
+         c.mnem = "fnstsw";
+         c.ops = "ax";
+         return;
+      }
+   }
+   if (m != nullptr)
+      c.mnem = m;
+   else {
+      /* x87 (bad) still consumes its ModRM */
+      c.bad = true;
+      c.bad_len = c.pos;
+   }
+}
+
+
+static void decode_grp7(Ctx& c) {
+   if (!modrm(c))
+      return;
+   if (c.mod != 3) {
+      static const Op mem7[8] = {{"sgdt","M_"}, {"sidt","M_"}, {"lgdt","M_"},
+         {"lidt","M_"}, {"smsw","Mw"}, {0,0,BAD}, {"lmsw","Ew"},
+         {"invlpg","Mb"}};
+      if (c.reg == 5 && c.rep == 0xf3) {
+         c.rep = 0;
+         c.mnem = "rstorssp";
+         operands(c, "Mq");
+      }
+      else
+         decode_entry(c, mem7[c.reg], mem7[c.reg].args);
+      return;
+   }
+   /* register forms that the last of F2/F3, then 66, select; the  */
+   /* selecting prefix is consumed, an unlisted one is (bad)       */
+   static const struct {
+      uint8_t modrm;
+      const char* mnem[4];
+   } by_prefix[] = {
+      {0xc6, {"wrmsrns",0,"wrmsrlist","rdmsrlist"}},
+      {0xcc, {0,"tdcall",0,0}},
+      {0xcd, {0,"seamret",0,0}},
+      {0xce, {0,"seamops",0,0}},
+      {0xcf, {"encls","seamcall",0,0}},
+      {0xd9, {"vmmcall",0,"vmgexit","vmgexit"}},
+      {0xe8, {"serialize",0,"setssbsy","xsusldtrk"}},
+      {0xe9, {0,0,0,"xresldtrk"}},
+      {0xea, {0,0,"saveprevssp",0}},
+      {0xec, {0,0,"uiret",0}},
+      {0xed, {0,0,"testui",0}},
+      {0xee, {"rdpkru",0,"clui",0}},
+      {0xef, {"wrpkru",0,"stui",0}},
+      {0xfa, {"monitorx",0,"mcommit",0}},
+      {0xfb, {"mwaitx",0,0,0}},
+      {0xfd, {"rdpru",0,"rmpquery",0}},
+      {0xfe, {"invlpgb",0,"rmpadjust","rmpupdate"}},
+      {0xff, {"tlbsync",0,"psmash","pvalidate"}},
+   };
+   auto b = (uint8_t)(0xc0 | (c.reg << 3) | c.rm);
+   for (auto const& e: by_prefix)
+      if (e.modrm == b) {
+         auto k = (c.rep == 0xf3)? 2: (c.rep == 0xf2)? 3: c.opsize? 1: 0;
+         if (e.mnem[k] == nullptr) {
+            bad_opcode(c);
+            return;
+         }
+         if (k >= 2)
+            c.rep = 0;
+         else if (k == 1)
+            c.opsize_used = true;
+         c.mnem = e.mnem[k];
+         return;
+      }
+   static const char* const reg7[8][8] = {
+      {"enclv","vmcall","vmlaunch","vmresume","vmxoff","pconfig",0,0},
+      {"monitor","mwait","clac","stac",0,0,0,"encls"},
+      {"xgetbv","xsetbv",0,0,"vmfunc","xend","xtest","enclu"},
+      {"vmrun","vmmcall","vmload","vmsave","stgi","clgi","skinit","invlpga"},
+      {0,0,0,0,0,0,0,0},
+      {"serialize",0,0,0,0,0,"rdpkru","wrpkru"},
+      {0,0,0,0,0,0,0,0},
+      {"swapgs","rdtscp","monitorx","mwaitx","clzero","rdpru","invlpgb",
+       "tlbsync"},
+   };
+   if (c.reg == 4 || c.reg == 6) {
+      c.mnem = (c.reg == 4)? "smsw": "lmsw";
+      operands(c, (c.reg == 4)? "Sv": "Ew");
+      return;
+   }
+   auto m = reg7[c.reg][c.rm];
+   if (m == nullptr)
+      bad_opcode(c);
+   else
+      c.mnem = m;
+}
+
+
+/* 0f ae: the last of F2/F3 selects the form, then 66; prefixes that select */
+/* nothing are printed and ignored                                           */
+static void decode_grp15(Ctx& c) {
+   if (!modrm(c))
+      return;
+   if (c.vex) {
+      /* only ldmxcsr and stmxcsr have VEX forms */
+      if (c.mod == 3 || (c.reg != 2 && c.reg != 3) || c.vex_l || c.vex_v)
+         bad_opcode(c);
+      else {
+         c.mnem = (c.reg == 2)? "vldmxcsr": "vstmxcsr";
+         c.ops = mem(c, "DWORD PTR ");
+      }
+      return;
+   }
+   uint8_t p = (c.rep == 0xf3)? 2: (c.rep == 0xf2)? 3: c.opsize? 1: 0;
+   if (c.mod != 3) {
+      if (c.reg <= 3 || (p == 0 && c.reg <= 6)) {
+         static const char* const m15[7] = {"fxsave","fxrstor","ldmxcsr",
+            "stmxcsr","xsave","xrstor","xsaveopt"};
+         c.mnem = m15[c.reg];
+         if (c.reg == 2 || c.reg == 3)
+            c.ops = mem(c, "DWORD PTR ");
+         else {
+            if (rex_bit(c, 0x8))
+               c.mnem += "64";
+            c.ops = mem(c, "");
+         }
+      }
+      else if (p == 0 && c.reg == 7) {
+         c.mnem = "clflush";
+         c.ops = mem(c, "BYTE PTR ");
+      }
+      else if (p == 1 && c.reg >= 6) {
+         c.opsize = false;
+         c.mnem = (c.reg == 6)? "clwb": "clflushopt";
+         c.ops = mem(c, "BYTE PTR ");
+      }
+      else if (p == 2 && (c.reg == 4 || c.reg == 6)) {
+         c.rep = 0;
+         c.mnem = (c.reg == 4)? "ptwrite": "clrssbsy";
+         if (c.reg == 4)
+            operands(c, "Ey");
+         else
+            c.ops = mem(c, "QWORD PTR ");
+      }
+      else
+         bad_opcode(c);
+      return;
+   }
+
+   auto num = [&]() { return (uint8_t)(c.rm | (rex_bit(c, 0x1)? 8: 0)); };
+   if (p == 2 && c.reg <= 4) {
+      static const char* const base[5] = {"rdfsbase","rdgsbase","wrfsbase",
+         "wrgsbase","ptwrite"};
+      c.rep = 0;
+      c.mnem = base[c.reg];
+      c.flags = 0;
+      operands(c, (c.reg == 4)? "Ey": "Ev");
+   }
+   else if (p == 2 && c.reg == 5) {
+      c.rep = 0;
+      c.mnem = rex_bit(c, 0x8)? "incsspq": "incsspd";
+      c.ops = gpr(c, num(), (c.rex_used & 0x8)? 64: 32);
+   }
+   else if (p == 2 && c.reg == 6) {
+      c.rep = 0;
+      c.mnem = "umonitor";
+      c.ops = addr32(c)? R32[num()]: R64[num()];
+   }
+   else if ((p == 1 || p == 3) && c.reg == 6) {
+      if (p == 1)
+         c.opsize = false;
+      else
+         c.rep = 0;
+      c.mnem = (p == 1)? "tpause": "umwait";
+      operands(c, "Ey");
+   }
+   else if (p == 0 && (c.reg == 5 || (c.reg == 6 && c.rm == 0)))
+      c.mnem = (c.reg == 5)? "lfence": "mfence";
+   else if (c.reg == 7 && c.rm == 0)
+      c.mnem = "sfence";
+   else
+      bad_opcode(c);
+}
+
+
+/* 0f c7: the last of F2/F3, else 66, selects the vmx and rdpid forms; */
+/* other prefixes are printed and ignored                              */
+static void decode_grp9(Ctx& c) {
+   if (!modrm(c))
+      return;
+   uint8_t p = (c.rep == 0xf3)? 2: (c.rep == 0xf2)? 3: c.opsize? 1: 0;
+   if (c.reg == 1) {
+      if (c.mod == 3)
+         bad_operand(c);
+      else if (rex_bit(c, 0x8)) {
+         c.mnem = "cmpxchg16b";
+         c.ops = mem(c, "OWORD PTR ");
+      }
+      else {
+         c.mnem = "cmpxchg8b";
+         c.ops = mem(c, "QWORD PTR ");
+      }
+      return;
+   }
+   if (c.mod != 3) {
+      static const char* const vmx[4] = {"vmptrld","vmclear","vmxon",0};
+      if (c.reg >= 3 && c.reg <= 5) {
+         static const char* const xsave[3] = {"xrstors","xsavec","xsaves"};
+         c.mnem = xsave[c.reg - 3];
+         if (rex_bit(c, 0x8))
+            c.mnem += "64";
+         c.ops = mem(c, "");
+      }
+      else if ((c.reg == 6 && vmx[p] != nullptr) || c.reg == 7) {
+         if (c.reg == 7)
+            c.mnem = "vmptrst";
+         else {
+            c.mnem = vmx[p];
+            if (p == 1)
+               c.opsize_used = true;
+            else if (p >= 2)
+               c.rep = 0;
+         }
+         c.ops = mem(c, "QWORD PTR ");
+      }
+      else
+         bad_opcode(c);
+   }
+   else if (c.reg < 6 || p == 3)
+      bad_opcode(c);
+   else if (p == 2) {
+      c.rep = 0;
+      c.mnem = (c.reg == 6)? "senduipi": "rdpid";
+      c.ops = R64[c.rm | (rex_bit(c, 0x1)? 8: 0)];
+   }
+   else {
+      c.mnem = (c.reg == 6)? "rdrand": "rdseed";
+      operands(c, "Ev");
+   }
+}
+
+
+/* 0f 71-73: shifts by immediate */
+static void decode_shift_imm(Ctx& c, uint8_t b) {
+   if (!modrm(c))
+      return;
+   static const char* const names[3][8] = {
+      {0,0,"psrlw",0,"psraw",0,"psllw",0},
+      {0,0,"psrld",0,"psrad",0,"pslld",0},
+      {0,0,"psrlq","psrldq",0,0,"psllq","pslldq"},
+   };
+   auto m = names[b - 0x71][c.reg];
+   bool xmm_form = c.opsize || c.vex;
+   if (m == nullptr || c.mod != 3 || c.rep != 0 || (c.vex && !c.opsize) ||
+   ((c.reg == 3 || c.reg == 7) && !xmm_form)) {
+      bad_opcode(c);
+      return;
+   }
+   c.opsize = false;
+   c.mnem = c.vex? string("v") + m: string(m);
+   if (c.vex)
+      operands(c, "Hx,Ux,Ib");
+   else if (xmm_form)
+      operands(c, "Uo,Ib");
+   else
+      operands(c, "Nq,Ib");
+}
+
+
+/* 0f 0f: 3dnow, the operation is selected by a trailing imm8; not lifted */
+/* but kept as objdump prints it, on xmm registers under 66                */
+static void decode_3dnow(Ctx& c) {
+   static const std::pair<uint8_t,const char*> ops[] = {{0x0c,"pi2fw"},
+      {0x0d,"pi2fd"}, {0x1c,"pf2iw"}, {0x1d,"pf2id"}, {0x8a,"pfnacc"},
+      {0x8e,"pfpnacc"}, {0x90,"pfcmpge"}, {0x94,"pfmin"}, {0x96,"pfrcp"},
+      {0x97,"pfrsqrt"}, {0x9a,"pfsub"}, {0x9e,"pfadd"}, {0xa0,"pfcmpgt"},
+      {0xa4,"pfmax"}, {0xa6,"pfrcpit1"}, {0xa7,"pfrsqit1"}, {0xaa,"pfsubr"},
+      {0xae,"pfacc"}, {0xb0,"pfcmpeq"}, {0xb4,"pfmul"}, {0xb6,"pfrcpit2"},
+      {0xb7,"pmulhrw"}, {0xbb,"pswapd"}, {0xbf,"pavgusb"}};
+   if (!modrm(c))
+      return;
+   operands(c, data16(c)? "Vo,Wo": "Pq,Qq");
+   if (!need(c, 1))
+      return;
+   auto suffix = c.code[c.pos++];
+   auto e = std::find_if(std::begin(ops), std::end(ops),
+            [&](const std::pair<uint8_t,const char*>& x) {
+               return x.first == suffix; });
+   if (e == std::end(ops))
+      bad_operand(c);
+   else
+      c.mnem = e->second;
+}
+
+
+/* 0f 1a/1b: MPX, the last of F2/F3 or else 66 selects the form; not lifted */
+/* but kept as objdump prints it, addressing memory with 64 bits whatever 67 */
+static void decode_bnd(Ctx& c, uint8_t b) {
+   static const char* const names[2][4] = {
+      {"bndldx","bndmov","bndcl","bndcu"},
+      {"bndstx","bndmov","bndmk","bndcn"},
+   };
+   if (!modrm(c))
+      return;
+   uint8_t p = (c.rep == 0xf3)? 2: (c.rep == 0xf2)? 3: c.opsize? 1: 0;
+   bool store = (b == 0x1b);
+   /* without a bound register operand the register forms are nops */
+   bool sib_only = (p == 0 || (p == 2 && store));
+   if (c.mod == 3 && sib_only) {
+      c.mnem = "nop";
+      operands(c, "Ev");
+      return;
+   }
+   if (p >= 2)
+      c.rep = 0;
+   else if (p == 1)
+      c.opsize_used = true;
+   auto bnd = [](uint8_t num) {
+      return (num > 3)? string("(bad)"): "bnd" + std::to_string(num);
+   };
+   auto reg = bnd(c.reg | (rex_bit(c, 0x4)? 8: 0));
+   string rm;
+   if (c.mod == 3) {
+      auto num = (uint8_t)(c.rm | (rex_bit(c, 0x1)? 8: 0));
+      rm = (p == 1)? bnd(num): string(R64[num]);
+   }
+   else if (!c.has_sib && c.mod == 0 && c.rm == 5 && sib_only)
+      rm = "(bad)";
+   else {
+      auto adsize = c.adsize;
+      c.adsize = false;
+      rm = mem(c, "");
+      c.adsize = adsize;
+      c.adsize_used = false;
+   }
+   c.mnem = names[store][p];
+   c.ops = (store && p <= 1)? rm + "," + reg: reg + "," + rm;
+}
+
+
+static void decode_two(Ctx& c) {
+   if (!need(c, 1))
+      return;
+   auto b = opcode(c);
+   auto const& op = TWO[b];
+   if (!(op.op[0].flags & SPEC)) {
+      if (op.op[0].flags & GRP) {
+         if (!modrm(c))
+            return;
+         auto g = std::atoi(op.op[0].mnem);
+         /* 0f 18: register forms are hint nops */
+         if (g == 9 && c.mod == 3) {
+            c.mnem = "nop";
+            operands(c, "Ev");
+            return;
+         }
+         /* prefetchit0/1 take a rip-relative byte, else they are nops */
+         /* padded apart from their prefixes                            */
+         if (g == 9 && c.reg >= 6) {
+            if (!c.has_sib && c.mod == 0 && c.rm == 5 && !c.opsize &&
+            c.rep == 0) {
+               c.mnem = (c.reg == 6)? "prefetchit1": "prefetchit0";
+               c.ops = mem(c, "BYTE PTR ");
+            }
+            else {
+               c.mnem = "nop";
+               c.pad = true;
+               operands(c, "Ev");
+            }
+            return;
+         }
+         auto const& e = GROUP[g][c.reg];
+         decode_entry(c, e, e.args);
+         return;
+      }
+      if (op.op[1].mnem || op.op[2].mnem || op.op[3].mnem ||
+      (op.op[1].flags & BAD))
+         decode_sse(c, op);
+      else
+         decode_entry(c, op.op[0], op.op[0].args);
+      /* push/pop of fs and gs show a 16-bit operand size */
+      if ((b == 0xa0 || b == 0xa1 || b == 0xa8 || b == 0xa9) &&
+      !(c.rex & 0x8) && data16(c))
+         c.mnem += "w";
+      return;
+   }
+   switch (b) {
+      case 0x01:
+         decode_grp7(c);
+         break;
+      case 0x07:
+      case 0x35:
+         c.mnem = (b == 0x07)? "sysret": "sysexit";
+         c.mnem += rex_bit(c, 0x8)? "q": "d";
+         break;
+      case 0x0f:
+         decode_3dnow(c);
+         break;
+      case 0x1a:
+      case 0x1b:
+         decode_bnd(c, b);
+         break;
+      case 0x1c:
+         if (modrm(c) && c.mod != 3 && c.reg == 0 && !c.opsize && c.rep == 0) {
+            c.mnem = "cldemote";
+            c.ops = mem(c, "BYTE PTR ");
+         }
+         else if (!c.bad) {
+            c.mnem = "nop";
+            operands(c, "Ev");
+         }
+         break;
+      case 0x1e:
+         if (c.rep == 0xf3 && need(c, 1) && (c.code[c.pos] == 0xfa ||
+         c.code[c.pos] == 0xfb)) {
+            c.mnem = (c.code[c.pos] == 0xfa)? "endbr64": "endbr32";
+            c.rep = 0;
+            c.pos++;
+         }
+         else if (c.rep == 0xf3 && modrm(c) && c.mod == 3 && c.reg == 1) {
+            c.rep = 0;
+            c.mnem = rex_bit(c, 0x8)? "rdsspq": "rdsspd";
+            c.ops = gpr(c, c.rm | (rex_bit(c, 0x1)? 8: 0),
+                        (c.rex_used & 0x8)? 64: 32);
+         }
+         else if (modrm(c)) {
+            c.mnem = "nop";
+            operands(c, "Ev");
+         }
+         break;
+      case 0x38:
+         decode_three(c, THREE_38, sizeof(THREE_38)/sizeof(Op38));
+         break;
+      case 0x3a:
+         decode_three(c, THREE_3A, sizeof(THREE_3A)/sizeof(Op38));
+         break;
+      case 0x71:
+      case 0x72:
+      case 0x73:
+         decode_shift_imm(c, b);
+         break;
+      case 0x77:
+         if (c.opsize || c.rep != 0)
+            bad_opcode(c);
+         else
+            c.mnem = "emms";
+         break;
+      case 0xa6:
+      case 0xa7:
+         /* VIA padlock; other forms of its ModRM.reg are an invalid */
+         /* operand, other ModRM.reg an invalid opcode               */
+         if (need(c, 1) && (c.code[c.pos] & 0xc7) == 0xc0 &&
+         ((c.code[c.pos] >> 3) & 7) < (b == 0xa6? 3: 6)) {
+            static const char* const a6[3] = {"montmul","xsha1","xsha256"};
+            static const char* const a7[6] = {"xstore-rng","xcrypt-ecb",
+               "xcrypt-cbc","xcrypt-ctr","xcrypt-cfb","xcrypt-ofb"};
+            auto r = (c.code[c.pos++] >> 3) & 7;
+            c.mnem = (b == 0xa6)? a6[r]: a7[r];
+         }
+         else if (c.pos < c.size &&
+         ((c.code[c.pos] >> 3) & 7) < (b == 0xa6? 3: 6))
+            bad_operand(c);
+         else
+            bad_opcode(c);
+         break;
+      case 0xae:
+         decode_grp15(c);
+         break;
+      case 0xc7:
+         decode_grp9(c);
+         break;
+   }
+}
+
+
+/* opmask instructions are not lifted, objdump's text is kept */
+static void decode_kmask(Ctx& c, uint8_t map, uint8_t op, uint8_t pp) {
+   auto e = std::find_if(std::begin(KMASK), std::end(KMASK),
+            [&](const OpMask& x) { return x.map == map && x.opcode == op &&
+                                   x.pp == pp && x.w == c.vex_w; });
+   if (e == std::end(KMASK)) {
+      bad_opcode(c);
+      return;
+   }
+   if (!modrm(c))
+      return;
+   string args = e->args;
+   auto bar = args.find('|');
+   args = (c.mod == 3)? args.substr(0, bar): args.substr(bar + 1);
+   auto vvvv = args.find("kH") != string::npos;
+   if (args.empty() || c.vex_l != vvvv || (!vvvv && c.vex_v != 0)) {
+      bad_opcode(c);
+      return;
+   }
+   /* the mandatory prefix is taken */
+   c.opsize = false;
+   c.rep = 0;
+   c.mnem = e->mnem;
+   operands(c, args.c_str());
+}
+
+
+static void decode_vex(Ctx& c, uint8_t b) {
+   /* legacy 66/f2/f3 are ignored, a REX makes the whole thing (bad) */
+   auto legacy_rex = c.rex;
+   c.rex = 0;
+   c.vex_legacy = c.opsize || c.rep != 0;
+   uint8_t map = 1;
+   uint8_t pp = 0;
+   if (b == 0xc5) {
+      auto v = (uint8_t)fetch(c, 1);
+      if (!(v & 0x80))
+         c.rex |= 0x4;
+      c.vex_v = (~v >> 3) & 0xf;
+      c.vex_l = (v >> 2) & 1;
+      pp = v & 3;
+   }
+   else {
+      auto v1 = (uint8_t)fetch(c, 1);
+      auto v2 = (uint8_t)fetch(c, 1);
+      if (!(v1 & 0x80))
+         c.rex |= 0x4;
+      if (!(v1 & 0x40))
+         c.rex |= 0x2;
+      if (!(v1 & 0x20))
+         c.rex |= 0x1;
+      if (v2 & 0x80)
+         c.rex |= 0x8;
+      map = v1 & 0x1f;
+      c.vex_w = v2 >> 7;
+      c.vex_v = (~v2 >> 3) & 0xf;
+      c.vex_l = (v2 >> 2) & 1;
+      pp = v2 & 3;
+   }
+   if (c.bad)
+      return;
+   if (c.rex != 0)
+      c.rex |= 0x40;
+   /* VEX bits are always consumed */
+   c.rex_used = c.rex;
+   c.vex = true;
+   c.opsize = (pp == 1);
+   c.rep = (pp == 2)? 0xf3: (pp == 3)? 0xf2: 0;
+
+   switch (map) {
+      case 1: {
+         if (!need(c, 1))
+            return;
+         auto op = opcode(c);
+         auto const& e = TWO[op];
+         if (op == 0x77) {
+            if (c.vex_v != 0)
+               bad_opcode(c);
+            else
+               c.mnem = c.vex_l? "vzeroall": "vzeroupper";
+         }
+         else if (std::memchr("\x41\x42\x44\x45\x46\x47\x4a\x4b\x90\x91"
+         "\x92\x93\x98\x99", op, 14) != nullptr)
+            decode_kmask(c, map, op, pp);
+         else if (op >= 0x71 && op <= 0x73)
+            decode_shift_imm(c, op);
+         else if (op == 0xae)
+            decode_grp15(c);
+         else if (e.op[0].flags & (SPEC|GRP|BAD))
+            bad_opcode(c);
+         else
+            decode_sse(c, e);
+         break;
+      }
+      case 2:
+         if (need(c, 1) && c.code[c.pos] == 0xf3 && pp == 0) {
+            /* BMI group 17 */
+            static const char* const grp17[8] = {0,"blsr","blsmsk","blsi"};
+            opcode(c);
+            if (!modrm(c))
+               return;
+            if (grp17[c.reg] == nullptr || c.vex_l) {
+               bad_opcode(c);
+               return;
+            }
+            c.mnem = grp17[c.reg];
+            operands(c, "By,Ey");
+         }
+         else
+            decode_three(c, THREE_38, sizeof(THREE_38)/sizeof(Op38));
+         break;
+      case 3:
+         if (need(c, 1) && c.code[c.pos] >= 0x30 && c.code[c.pos] <= 0x33)
+            decode_kmask(c, map, opcode(c), pp);
+         else
+            decode_three(c, THREE_3A, sizeof(THREE_3A)/sizeof(Op38));
+         break;
+      default:
+         /* unknown map: only the c4 byte is consumed */
+         bad_operand(c);
+         return;
+   }
+   if (legacy_rex != 0 && !c.bad) {
+      c.bad = true;
+      c.bad_len = c.pos;
+   }
+}
+
+
+/* P0: R X B R' 0 m m m   P1: W v v v v 1 p p   P2: z L' L b V' a a a */
+static void decode_evex(Ctx& c) {
+   if (!need(c, 1))
+      return;
+   auto p0 = c.code[c.pos];
+   auto map = p0 & 0xf;
+   if (map == 0 || map == 4 || map > 6) {
+      bad_opcode(c);
+      return;
+   }
+   c.pos++;
+   if (!need(c, 1))
+      return;
+   if (!(c.code[c.pos] & 0x4)) {
+      c.bad = true;
+      c.bad_len = c.pos;
+      return;
+   }
+   auto p = fetch(c, 2);
+   auto p1 = (uint8_t)p;
+   auto p2 = (uint8_t)(p >> 8);
+   if (!need(c, 1))
+      return;
+   auto op = opcode(c);
+   if (!modrm(c))
+      return;
+
+   auto legacy_rex = c.rex;
+   c.rex = 0x40 | ((p0 & 0x80)? 0: 0x4) | ((p0 & 0x40)? 0: 0x2) |
+           ((p0 & 0x20)? 0: 0x1) | ((p1 & 0x80)? 0x8: 0);
+   c.rex_used = c.rex;
+   c.vex = c.evex = true;
+   c.vex_w = p1 >> 7;
+   c.vex_v = (~p1 >> 3) & 0xf;
+   c.evex_z = p2 >> 7;
+   c.evex_ll = (p2 >> 5) & 3;
+   c.evex_b = (p2 >> 4) & 1;
+   c.evex_aaa = p2 & 7;
+   c.evex_r = (p0 & 0x10)? 0: 16;
+   c.evex_v = (p2 & 0x8)? 0: 16;
+   c.evex_x = (c.mod == 3 && !(p0 & 0x40))? 16: 0;
+   /* EVEX.b on registers takes L'L for rounding: the length is 512 bits */
+   c.vex_l = (c.evex_b && c.mod == 3)? 2: c.evex_ll;
+
+   auto key = [](const OpEvex& e) {
+      return (uint32_t)(e.map << 16 | e.opcode << 8 | e.pp);
+   };
+   uint32_t k = map << 16 | op << 8 | (p1 & 3);
+   auto e = std::lower_bound(std::begin(EVEX), std::end(EVEX), k,
+            [&](const OpEvex& x, uint32_t k) { return key(x) < k; });
+   while (e != std::end(EVEX) && key(*e) == k &&
+   ((e->w != 2 && e->w != c.vex_w) || (e->reg >= 0 && e->reg != c.reg)))
+      ++e;
+   if (e == std::end(EVEX) || key(*e) != k) {
+      bad_opcode(c);
+      return;
+   }
+   auto f = e->flags;
+   bool len = (f & EV_L128)? c.vex_l == 0: (f & EV_L512)? c.vex_l == 2:
+              (f & EV_NO128)? (c.vex_l == 1 || c.vex_l == 2): c.vex_l < 3;
+   if (!len || (c.evex_z && c.evex_aaa == 0) ||
+   (f & (c.mod == 3? EV_NOREG: EV_NOMEM))) {
+      bad_opcode(c);
+      return;
+   }
+
+   /* register and memory forms as "r|m" */
+   string m = e->mnem;
+   string args = e->args;
+   auto bar = m.find('|');
+   if (bar != string::npos)
+      m = (c.mod == 3)? m.substr(0, bar): m.substr(bar + 1);
+   bar = args.find('|');
+   if (bar != string::npos)
+      args = (c.mod == 3)? args.substr(0, bar): args.substr(bar + 1);
+   /* an unused vvvv must be 1111 */
+   if (c.vex_v != 0 && args[0] != 'H' && args.find(",H") == string::npos &&
+   args.find("kH") == string::npos) {
+      bad_opcode(c);
+      return;
+   }
+
+   /* disp8 is scaled by the memory operand size, or by one element */
+   if (c.mod == 1) {
+      int8_t n = 0;
+      for (size_t i = 0; i < args.length(); i = args.find(',', i) + 1) {
+         if (std::strchr("EMRWv", args[i]) != nullptr)
+            n = mem_log(args[i + 1], c);
+         if (args.find(',', i) == string::npos)
+            break;
+      }
+      if (c.evex_b && (f & (EV_BC|EV_BCW)))
+         n = c.vex_w? ((f & EV_BCW)? 2: 3): ((f & EV_BCW)? 1: 2);
+      else if (f & EV_T1)
+         n = c.vex_w? 3: 2;
+      else if (f & EV_T1BW)
+         n = c.vex_w;
+      c.disp *= (1 << n);
+   }
+
+   c.eflags = f;
+   c.mnem = m;
+   operands(c, args.c_str());
+   if (c.bad)
+      return;
+   if (legacy_rex != 0) {
+      c.bad = true;
+      c.bad_len = c.pos;
+      return;
+   }
+
+   /* gathers and scatters need a mask and cannot zero, and a gather with */
+   /* EVEX.b cannot write its index                                      */
+   auto dst = c.reg | ((c.rex & 0x4)? 8: 0) | c.evex_r;
+   auto vsib = args.find('v') != string::npos;
+   if (vsib && (c.evex_aaa == 0 || c.evex_z || (c.evex_b && args[0] == 'V'
+   && dst == (c.index | ((c.rex & 0x2)? 8: 0) | c.evex_v)))) {
+      c.bad = true;
+      c.bad_len = c.pos;
+      return;
+   }
+   if (f & EV_DEST) {
+      if (dst == (c.vex_v | c.evex_v) || (c.mod == 3 && dst ==
+      (c.rm | ((c.rex & 0x1)? 8: 0) | c.evex_x))) {
+         c.bad = true;
+         c.bad_len = c.pos;
+         return;
+      }
+   }
+
+   /* EVEX.b on registers: rounding or {sae} after the last register */
+   static const char* const rc[4] = {"rn", "rd", "ru", "rz"};
+   if (c.evex_b && c.mod == 3 && (f & (EV_ER|EV_SAE)))
+      c.ops.insert((args.back() == 'b')? c.ops.rfind(','): c.ops.length(),
+                   (f & EV_ER)? "{" + string(rc[c.evex_ll]) + "-sae}":
+                   string("{sae}"));
+
+   /* pseudo-ops */
+   if (f & EV_CMP) {
+      auto v = last_imm(c.ops);
+      if (v < 32) {
+         auto suffix = c.mnem.substr(c.mnem.length() - 2);
+         c.mnem = c.mnem.substr(0, c.mnem.length() - 2) + AVX_CMP[v] + suffix;
+         c.ops.erase(c.ops.rfind(','));
+      }
+   }
+   else if (f & EV_PCMP) {
+      static const char* const pcmp[8] = {"eq","lt","le",0,"neq","nlt","nle",0};
+      auto v = last_imm(c.ops);
+      if (v < 8 && pcmp[v] != nullptr) {
+         c.mnem.insert(5, pcmp[v]);
+         c.ops.erase(c.ops.rfind(','));
+      }
+   }
+   else if (c.mnem == "vpclmulqdq")
+      pclmul(c);
+
+   /* ... otherwise a (bad) rounding operand at the end */
+   if (c.evex_b && c.mod == 3 && !(f & (EV_ER|EV_SAE)))
+      c.ops += string((f & EV_RCBAD)? "{": ",{") + rc[c.evex_ll] + "-bad}";
+   /* {kN}{z} on the first operand */
+   if (c.evex_aaa != 0)
+      c.ops.insert(std::min(c.ops.find(','), c.ops.length()), "{k" +
+                   std::to_string(c.evex_aaa) + "}" + (c.evex_z? "{z}": ""));
+
+   /* {evex} marks what VEX could have encoded */
+   if ((f & EV_VEX) && c.evex_ll < 2 && !c.evex_b && c.evex_aaa == 0 &&
+   !c.evex_z && c.evex_r == 0 && c.evex_v == 0 && c.evex_x == 0)
+      c.mnem = "{evex} " + c.mnem;
+}
+
+
+/* XOP is not lifted either, objdump's text is kept */
+static void decode_xop(Ctx& c) {
+   /* a REX before XOP is printed as rex.*, which the clean-up made nop */
+   auto legacy_rex = c.rex;
+   c.rex = 0;
+   uint8_t map = c.code[c.pos] & 0x1f;
+   if (map > 0xa) {
+      bad_opcode(c);
+      return;
+   }
+   auto v1 = (uint8_t)fetch(c, 1);
+   auto v2 = (uint8_t)fetch(c, 1);
+   if (c.bad)
+      return;
+   if (!(v1 & 0x80))
+      c.rex |= 0x4;
+   if (!(v1 & 0x40))
+      c.rex |= 0x2;
+   if (!(v1 & 0x20))
+      c.rex |= 0x1;
+   if (v2 & 0x80)
+      c.rex |= 0x8;
+   if (c.rex != 0)
+      c.rex |= 0x40;
+   c.rex_used = c.rex;
+   c.vex_w = v2 >> 7;
+   c.vex_v = (~v2 >> 3) & 0xf;
+   c.vex_l = (v2 >> 2) & 1;
+   if (!need(c, 1))
+      return;
+   auto op = opcode(c);
+   auto match = [&](const OpXop& x) {
+      return x.map == map && x.opcode == op &&
+             (x.reg == 8 || !c.has_modrm || x.reg == c.reg);
+   };
+   auto e = std::find_if(std::begin(XOP), std::end(XOP), match);
+   if (e == std::end(XOP) || (v2 & 3) != 0) {
+      bad_opcode(c);
+      return;
+   }
+   if (!modrm(c))
+      return;
+   e = std::find_if(std::begin(XOP), std::end(XOP), match);
+   string args = (e == std::end(XOP))? "": e->args;
+   auto slash = args.find('/');
+   if (slash != string::npos)
+      args = c.vex_w? args.substr(slash + 1): args.substr(0, slash);
+   else if (c.vex_w && args.find('y') == string::npos)
+      args.clear();
+   if (args.empty() || (c.vex_l && args.find('x') == string::npos &&
+   std::strcmp(e->mnem, "bextr") != 0) || (c.vex_v != 0 &&
+   args.find('H') == string::npos && args.find('B') == string::npos) ||
+   (c.mod != 3 && map == 9 && op == 0x12)) {
+      bad_opcode(c);
+      return;
+   }
+   c.vex = true;
+   c.mnem = e->mnem;
+   operands(c, args.c_str());
+
+   /* vpcom pseudo-ops */
+   if (!c.bad && c.mnem.compare(0, 5, "vpcom") == 0) {
+      static const char* const cmp[8] = {"lt","le","gt","ge","eq","neq",
+                                         "false","true"};
+      auto v = last_imm(c.ops);
+      if (v < 8) {
+         c.mnem.insert(5, cmp[v]);
+         c.ops.erase(c.ops.rfind(','));
+      }
+   }
+   if (legacy_rex != 0) {
+      c.rex |= 0x40;
+      c.rex_used = 0;
+   }
+}
+
+static void decode_one(Ctx& c, uint8_t b) {
+   auto const& op = ONE[b];
+   if (op.flags & GRP) {
+      c.flags = op.flags;
+      if (!modrm(c))
+         return;
+      auto g = std::atoi(op.mnem);
+      auto e = GROUP[g][c.reg];
+      if ((g == 11 || g == 12) && c.reg == 7 && c.mod == 3 && c.rm == 0) {
+         c.mnem = (g == 11)? "xabort": "xbegin";
+         c.flags = F64;
+         operands(c, (g == 11)? "Ib": "Jz");
+         return;
+      }
+      if (e.flags & BAD || e.mnem == nullptr) {
+         bad_opcode(c);
+         return;
+      }
+      /* group operands come from the one-byte entry unless overridden */
+      auto args = (e.args != nullptr)? e.args: op.args;
+      c.flags = (uint8_t)(op.flags & ~GRP) | e.flags;
+      c.mnem = e.mnem;
+      operands(c, args);
+      return;
+   }
+   if (!(op.flags & SPEC)) {
+      decode_entry(c, op, op.args);
+      if (b >= 0xb8 && b <= 0xbf && (c.rex_used & 0x8))
+         c.mnem = "movabs";
+      /* 67 makes moffs 32-bit and e3 test ecx */
+      else if (b >= 0xa0 && b <= 0xa3 && c.adsize)
+         c.mnem = "mov";
+      else if (b == 0xe3 && addr32(c))
+         c.mnem = "jecxz";
+      /* stack and branch operations show a 16-bit operand size, retf */
+      /* a 64-bit one too                                              */
+      else if ((b == 0xca || b == 0xcb) && rex_bit(c, 0x8))
+         c.mnem += "q";
+      else if (std::memchr("\x68\x6a\x9c\x9d\xc2\xc3\xc8\xc9\xca\xcb\xe8"
+      "\xe9", b, 12) != nullptr && !(c.rex & 0x8) && data16(c))
+         c.mnem += "w";
+      return;
+   }
+   switch (b) {
+      case 0x0f:
+         decode_two(c);
+         break;
+      case 0x62:
+         decode_evex(c);
+         break;
+      case 0x90:
+         if (rex_bit(c, 0x1)) {
+            c.mnem = "xchg";
+            c.flags = 0;
+            operands(c, "Zv,rAX");
+         }
+         else if (c.rep == 0xf3) {
+            c.rep = 0;
+            c.mnem = "pause";
+         }
+         else if (data16(c)) {
+            c.mnem = "xchg";
+            c.ops = "ax,ax";
+         }
+         else
+            c.mnem = "nop";
+         break;
+      case 0x98:
+         c.mnem = rex_bit(c, 0x8)? "cdqe": data16(c)? "cbw": "cwde";
+         break;
+      case 0x99:
+         c.mnem = rex_bit(c, 0x8)? "cqo": data16(c)? "cwd": "cdq";
+         break;
+      case 0xc4:
+      case 0xc5:
+         decode_vex(c, b);
+         break;
+      case 0xcf:
+         c.mnem = rex_bit(c, 0x8)? "iretq": data16(c)? "iretw": "iret";
+         break;
+      default:
+         decode_x87(c, b);
+         break;
+   }
+}
+/* -------------------------------------------------------------------------- */
+
+
+uint8_t Decoder::decode(const uint8_t* code, size_t size, uint64_t addr,
+string& itc) {
+   itc.clear();
+   if (size == 0)
+      return 0;
+
+   Ctx c;
+   c.code = code;
+   c.size = size;
+   c.addr = addr;
+
+   /* legacy prefixes, then REX; fwait is a prefix of x87 instructions */
+   size_t fwait = 0;
+   auto prefix = [&](uint8_t b) {
+      return b == 0x66 || b == 0x67 || b == 0xf0 || b == 0xf2 || b == 0xf3 ||
+             b == 0x26 || b == 0x2e || b == 0x36 || b == 0x3e || b == 0x64 ||
+             b == 0x65 || (b == 0x9b && fwait == 0);
+   };
+   for (; c.pos < size && c.pos < 14 && prefix(code[c.pos]); ++c.pos)
+      switch (code[c.pos]) {
+         case 0x66: c.opsize = true; break;
+         case 0x67: c.adsize = true; break;
+         case 0xf2:
+         case 0xf3: c.rep = code[c.pos]; ++c.num_rep; break;
+         case 0xf0: c.lock = true; break;
+         case 0x9b: fwait = c.pos + 1; break;
+         default:
+            c.seg = code[c.pos];
+            ++c.num_seg;
+            break;
+      }
+   if (fwait != 0) {
+      /* not followed by x87: fwait takes the prefixes before it */
+      auto p = c.pos + ((c.pos < size && (code[c.pos] & 0xf0) == 0x40)? 1: 0);
+      if (p >= size || code[p] < 0xd8 || code[p] > 0xdf) {
+         bool seg = false;
+         for (size_t i = 0; i + 1 < fwait; ++i)
+            seg = seg || (code[i] != 0x66 && code[i] != 0x67 &&
+                          code[i] != 0xf0 && code[i] != 0xf2 && code[i] != 0xf3);
+         itc = seg? "nop": "fwait";
+         return (uint8_t)fwait;
+      }
+   }
+   if (c.pos < size && (code[c.pos] & 0xf0) == 0x40) {
+      c.rex = code[c.pos++];
+      /* a REX that is not last before the opcode stands alone */
+      if (c.pos < size && (prefix(code[c.pos]) || (code[c.pos] & 0xf0) == 0x40)) {
+         itc = "nop";
+         return (uint8_t)c.pos;
+      }
+   }
+   c.start = c.pos;
+
+   if (need(c, 1)) {
+      auto b = opcode(c);
+      /* 8f with a map select >= 8 in place of ModRM is XOP */
+      if (b == 0x8f && c.pos < size && (code[c.pos] & 0x1f) >= 8)
+         decode_xop(c);
+      else
+         decode_one(c, b);
+   }
+
+   auto len = (uint8_t)(c.truncated? 1: c.bad? c.bad_len: c.pos);
+
+   /* what the objdump clean-up turned into nop or hlt */
+   bool notrack = (c.seg == 0x3e && c.num_seg == 1 &&
+                  (c.mnem == "jmp" || c.mnem == "call") &&
+                  c.has_modrm && (c.reg == 2 || c.reg == 4));
+   if (c.bad || c.mnem.empty() ||
+   (c.num_seg > 0 && !notrack && (!c.seg_used || c.num_seg > 1)) ||
+   (c.rex != 0 && c.rex != c.rex_used) ||
+   c.ops.find("riz") != string::npos || c.ops.find("FWORD") != string::npos ||
+   c.ops.find("(bad)") != string::npos ||
+   c.ops.find('?') != string::npos) {
+      itc = "nop";
+      return len;
+   }
+   if (c.mnem == "int1" || c.mnem == "int3") {
+      itc = "hlt";
+      return len;
+   }
+
+   /* fwait + fnstcw is printed as fstcw */
+   if (fwait != 0 && c.mnem.compare(0, 2, "fn") == 0 && c.mnem != "fnop")
+      c.mnem.erase(1, 1);
+   if (notrack)
+      itc = "notrack ";
+   /* F2/F3 on a locked memory write, xchg or a release store are HLE hints */
+   if ((c.rep == 0xf2 || c.rep == 0xf3) && c.has_modrm && c.mod != 3 &&
+   !c.vex) {
+      static const char* const lockable[] = {"add","or","adc","sbb","and",
+         "sub","xor","not","neg","inc","dec","bts","btr","btc","cmpxchg",
+         "cmpxchg8b","cmpxchg16b","xadd","xchg"};
+      auto b = c.code[c.start];
+      auto dst = c.ops.find("PTR") < c.ops.find(',');
+      if ((b == 0x86 || b == 0x87) || (c.rep == 0xf3 && (b == 0x88 ||
+      b == 0x89 || b == 0xc6 || b == 0xc7)) || (c.lock && dst &&
+      std::any_of(std::begin(lockable), std::end(lockable),
+      [&](const char* m) { return c.mnem == m; })))
+         itc += (c.rep == 0xf2)? "xacquire ": "xrelease ";
+   }
+   if (c.rep == 0xf3 && c.mnem == "stos")
+      itc += "rep ";
+   else if (c.rep == 0xf3 && c.mnem == "cmps")
+      itc += "repz ";
+   itc += c.mnem;
+   if (!c.ops.empty()) {
+      /* objdump pads prefixes and mnemonic to 6 columns; prefixes the   */
+      /* clean-up erased still count, and are at least that long        */
+      bool erased = c.lock || c.num_rep > 1 || c.vex_legacy ||
+                    (c.rep != 0 && itc.find("rep") == string::npos) ||
+                    (c.opsize && !c.opsize_used) ||
+                    (c.adsize && !c.adsize_used);
+      if ((c.pad || !erased) && itc.length() < 6)
+         itc.append(6 - itc.length(), ' ');
+      itc += " " + c.ops;
+      /* what is left of "        # <addr> <sym>" after the cut */
+      if (c.rip)
+         itc.append(8, ' ');
+   }
+   return len;
+}
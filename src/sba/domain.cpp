@@ -1059,6 +1059,39 @@ void Taint::lshift(const Taint& object) {
 }
 
 /* ------------------------------- BaseStride ------------------------------- */
+static constexpr size_t FREE_STRIDE_MAX = 1 << 16;
+/* other thread_locals holding values may be destroyed after the list */
+static thread_local bool free_strides_closed = false;
+struct FreeStrides: vector<void*> {
+   ~FreeStrides() {
+      free_strides_closed = true;
+      for (auto p: *this)
+         ::operator delete(p);
+   }
+};
+static thread_local FreeStrides free_strides;
+
+
+void* BaseStride::operator new(size_t size) {
+   if (size == sizeof(BaseStride) && !free_strides_closed
+   && !free_strides.empty()) {
+      auto p = free_strides.back();
+      free_strides.pop_back();
+      return p;
+   }
+   return ::operator new(size);
+}
+
+
+void BaseStride::operator delete(void* p) {
+   if (p != nullptr && !free_strides_closed
+   && free_strides.size() < FREE_STRIDE_MAX)
+      free_strides.push_back(p);
+   else
+      ::operator delete(p);
+}
+
+
 /* 			                     (SJA's Domain) 			                     */
 BaseStride::~BaseStride() {
    if (x != nullptr) delete x;
@@ -10,8 +10,127 @@
 #include "../../include/sba/insn.h"
 #include "../../include/sba/expr.h"
 #include "../../include/sba/domain.h"
+#include <mutex>
 
 using namespace SBA;
+// ------------------------------------ Expr -----------------------------------
+/* node fields compared by STRICT equality, with children already interned */
+struct ExprKey {
+   uint8_t type;
+   uint8_t mode;
+   uint8_t op;
+   IMM val;
+   array<const Expr*,3> child;
+   bool operator==(const ExprKey& k) const = default;
+};
+
+
+struct ExprKeyHash {
+   size_t operator()(const ExprKey& k) const {
+      uint64_t h = ((uint64_t)k.type << 16) ^ ((uint64_t)k.mode << 8) ^ k.op;
+      h = (h ^ (uint64_t)k.val) * 0x9e3779b97f4a7c15ULL;
+      for (auto c: k.child)
+         h = (h ^ (uint64_t)c) * 0x9e3779b97f4a7c15ULL;
+      return (size_t)(h ^ (h >> 32));
+   }
+};
+
+
+/* split by hash so that parser threads rarely wait on the same lock */
+struct ExprPool {
+   std::mutex lock;
+   unordered_map<ExprKey,Expr*,ExprKeyHash> nodes;
+};
+static constexpr size_t POOL_SHARDS = 64;
+
+
+static ExprPool& pool(size_t hash) {
+   static array<ExprPool,POOL_SHARDS> p;
+   return p[(hash >> 7) % POOL_SHARDS];
+}
+
+
+/* only integer constants: STRICT equality ignores the type of a constant */
+static bool expr_key(const Expr* e, ExprKey& k) {
+   k = ExprKey{(uint8_t)e->expr_type(), (uint8_t)e->expr_mode(), 0, 0,
+               {nullptr, nullptr, nullptr}};
+   switch (e->expr_type()) {
+      case Expr::EXPR_TYPE::CONSTANT:
+         if (((Const*)e)->const_type() != Const::CONST_TYPE::INTEGER)
+            return false;
+         k.val = ((Const*)e)->to_int();
+         return true;
+      case Expr::EXPR_TYPE::VAR:
+         if (((Var*)e)->var_type() == Var::VAR_TYPE::REG) {
+            k.val = (IMM)(((Reg*)e)->reg());
+            return true;
+         }
+         k.op = 1;
+         k.child[0] = ((Mem*)e)->addr();
+         break;
+      case Expr::EXPR_TYPE::SUBREG:
+         k.val = ((SubReg*)e)->bytenum();
+         k.child[0] = ((SubReg*)e)->expr();
+         break;
+      case Expr::EXPR_TYPE::CONVERSION:
+         k.op = (uint8_t)(((Conversion*)e)->conv_type());
+         k.child = {((Conversion*)e)->expr(), ((Conversion*)e)->size(),
+                    ((Conversion*)e)->pos()};
+         break;
+      case Expr::EXPR_TYPE::ARITHMETIC:
+         if (((Arithmetic*)e)->arith_type() != Arithmetic::ARITH_TYPE::BINARY)
+            return false;
+         k.op = (uint8_t)(((Binary*)e)->op());
+         k.child = {((Binary*)e)->operand(0), ((Binary*)e)->operand(1),
+                    nullptr};
+         break;
+      default:
+         return false;
+   }
+   if (k.child[0] == nullptr)
+      return false;
+   for (auto c: k.child)
+      if (c != nullptr && !c->shared())
+         return false;
+   return true;
+}
+
+
+Expr* Expr::intern(Expr* e) {
+   ExprKey k;
+   if (e == nullptr || e->shared_ || !expr_key(e, k))
+      return e;
+   auto h = ExprKeyHash{}(k);
+   auto& p = pool(h);
+   std::lock_guard<std::mutex> guard(p.lock);
+   auto [it, fresh] = p.nodes.emplace(k, e);
+   if (fresh)
+      e->shared_ = true;
+   else
+      delete e;
+   return it->second;
+}
+
+
+bool Expr::identical(RTL_EQUAL eq, RTL* v, bool& res) const {
+   /* interned nodes are STRICT-equal iff they are the same node */
+   if (v == this)
+      return (res = true);
+   if (eq == RTL_EQUAL::STRICT && shared_ && v != nullptr &&
+   v->rtl_type() == RTL_TYPE::EXPR && ((Expr*)v)->shared_) {
+      res = false;
+      return true;
+   }
+   return false;
+}
+
+
+#if ENABLE_SUPPORT_CONSTRAINT == true
+   const AbsId& Expr::expr_id(const State& s) {
+      static const AbsId bad;
+      return bad;
+   }
+#endif
 // ---------------------------------- Const ------------------------------------
 Const::Const(CONST_TYPE typeConst, Expr* expr): Expr(EXPR_TYPE::CONSTANT,
 EXPR_MODE::NONE) {
@@ -26,7 +145,7 @@ EXPR_MODE::NONE) {
       default:
          break;
    }
-   delete expr;
+   release(expr);
 }
 
 
@@ -43,6 +162,10 @@ string Const::to_string() const {
 
 
 bool Const::equal(RTL_EQUAL eq, RTL* v) const {
+   bool res;
+   if (identical(eq, v, res))
+      return res;
+
    if (v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -78,16 +201,17 @@ AbsVal Const::eval(State& s) {
 
 #if ENABLE_SUPPORT_CONSTRAINT == true
    const AbsId& Const::expr_id(const State& s) {
-      if (!run_expr_id_)
-         return expr_id_;
-      run_expr_id_ = false;
-      expr_id_ = AbsId(i_);
-      return expr_id_;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_id)
+         return c.expr_id;
+      c.run_expr_id = false;
+      c.expr_id = AbsId(i_);
+      return c.expr_id;
    }
 #endif
 // ------------------------------------ Mem ------------------------------------
 Mem::~Mem() {
-   delete addr_;
+   release(addr_);
 }
 
 
@@ -98,6 +222,10 @@ string Mem::to_string() const {
 
 
 bool Mem::equal(RTL_EQUAL eq, RTL* v) const {
+   bool res;
+   if (identical(eq, v, res))
+      return res;
+
    if (v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -136,22 +264,29 @@ Expr* Mem::clone() {
 
 
 AbsVal Mem::eval(State& s) {
+   auto aval_addr = addr_->eval(s);
+   return eval(s, std::move(aval_addr));
+}
+
+
+AbsVal Mem::eval(State& s, AbsVal aval_addr) {
    EVAL_MEMORY(s);
 }
 
 
 #if ENABLE_SUPPORT_CONSTRAINT == true
    const AbsId& Mem::expr_id(const State& s) {
-      if (!run_expr_id_)
-         return expr_id_;
-      run_expr_id_ = false;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_id)
+         return c.expr_id;
+      c.run_expr_id = false;
 
       auto const& addr_id_ = addr_->simplify()->expr_id(s);
       if (addr_id_.reg_expr())
-         expr_id_ = AbsId(addr_id_.reg, addr_id_.offset, 0);
+         c.expr_id = AbsId(addr_id_.reg, addr_id_.offset, 0);
       else if (addr_id_.const_expr())
-         expr_id_ = AbsId(SYSTEM::Reg::UNKNOWN, addr_id_.offset, 0);
-      return expr_id_;
+         c.expr_id = AbsId(SYSTEM::Reg::UNKNOWN, addr_id_.offset, 0);
+      return c.expr_id;
    }
 #endif
 
@@ -162,7 +297,7 @@ bool Mem::contains(RTL* subExpr) const {
 // ------------------------------------ Reg ------------------------------------
 Reg::Reg(EXPR_MODE mode, Expr* r): Var(VAR_TYPE::REG, mode) {
    r_ = SYSTEM::to_reg(r->to_string());
-   delete r;
+   release(r);
 }
 
 
@@ -173,6 +308,10 @@ string Reg::to_string() const {
 
 
 bool Reg::equal(RTL_EQUAL eq, RTL* v) const {
+   bool res;
+   if (identical(eq, v, res))
+      return res;
+
    if (v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -213,12 +352,13 @@ AbsVal Reg::eval(State& s) {
 
 #if ENABLE_SUPPORT_CONSTRAINT == true
    const AbsId& Reg::expr_id(const State& s) {
-      if (!run_expr_id_)
-         return expr_id_;
-      run_expr_id_ = false;
-      expr_id_ = (r_ == SYSTEM::INSN_PTR)?
-                  AbsId(s.loc.insn->next_offset()): AbsId(r_, 0);
-      return expr_id_;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_id)
+         return c.expr_id;
+      c.run_expr_id = false;
+      c.expr_id = (r_ == SYSTEM::INSN_PTR)?
+                    AbsId(s.loc.insn->next_offset()): AbsId(r_, 0);
+      return c.expr_id;
    }
 #endif
 // ---------------------------------- SubReg -----------------------------------
@@ -226,12 +366,12 @@ SubReg::SubReg(EXPR_MODE mode, Expr* expr, Expr* byteNum):
 Expr(EXPR_TYPE::SUBREG, mode) {
    expr_ = expr;
    byteNum_ = Util::to_int(byteNum->to_string());
-   delete byteNum;
+   release(byteNum);
 }
 
 
 SubReg::~SubReg() {
-   delete expr_;
+   release(expr_);
 }
 
 
@@ -243,6 +383,10 @@ string SubReg::to_string() const {
 
 
 bool SubReg::equal(RTL_EQUAL eq, RTL* v) const {
+   bool res;
+   if (identical(eq, v, res))
+      return res;
+
    if (v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -284,6 +428,12 @@ Expr* SubReg::clone() {
 
 
 AbsVal SubReg::eval(State& s) {
+   auto res = expr_->eval(s);
+   return eval(s, std::move(res));
+}
+
+
+AbsVal SubReg::eval(State& s, AbsVal res) {
    EVAL_SUBREG(s);
 }
 
@@ -301,9 +451,9 @@ Expr(EXPR_TYPE::IFELSE, mode) {
 
 
 IfElse::~IfElse() {
-   delete cmp_;
-   delete if_;
-   delete else_;
+   release(cmp_);
+   release(if_);
+   release(else_);
 }
 
 
@@ -363,6 +513,13 @@ Expr* IfElse::clone() {
 
 
 AbsVal IfElse::eval(State& s) {
+   auto res = if_->eval(s);
+   auto op2 = else_->eval(s);
+   return eval(s, std::move(res), std::move(op2));
+}
+
+
+AbsVal IfElse::eval(State& s, AbsVal res, AbsVal op2) {
    EVAL_IFELSE(s);
 }
 
@@ -375,11 +532,9 @@ bool IfElse::contains(RTL* subExpr) const {
 Conversion::~Conversion() {
    if (typeOp_ == OP::ANY)
       return;
-   delete expr_;
-   if (size_ != nullptr)
-      delete size_;
-   if (pos_ != nullptr)
-      delete pos_;
+   release(expr_);
+   release(size_);
+   release(pos_);
 }
 
 
@@ -403,6 +558,10 @@ string Conversion::to_string() const {
 
 
 bool Conversion::equal(RTL_EQUAL eq, RTL* v) const {
+   bool res;
+   if (identical(eq, v, res))
+      return res;
+
    if (v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -469,18 +628,25 @@ Expr* Conversion::clone() {
 
 
 AbsVal Conversion::eval(State& s) {
+   auto res = simplify()->eval(s);
+   return eval(s, std::move(res));
+}
+
+
+AbsVal Conversion::eval(State& s, AbsVal res) {
    EVAL_CONVERSION(s);
 }
 
 
 #if ENABLE_SUPPORT_CONSTRAINT == true
    const AbsId& Conversion::expr_id(const State& s) {
-      if (!run_expr_id_)
-         return expr_id_;
-      run_expr_id_ = false;
-      expr_id_ = (typeOp_ != OP::ZERO_EXTRACT && typeOp_ != OP::SIGN_EXTRACT)?
-                  simplify()->expr_id(s): AbsId();
-      return expr_id_;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_id)
+         return c.expr_id;
+      c.run_expr_id = false;
+      c.expr_id = (typeOp_!=OP::ZERO_EXTRACT && typeOp_!=OP::SIGN_EXTRACT)?
+                    simplify()->expr_id(s): AbsId();
+      return c.expr_id;
    }
 #endif
 
@@ -522,7 +688,7 @@ AbsVal NoType::eval(State& s) {
 // ----------------------------------- Unary ---------------------------------
 Unary::~Unary() {
    if (op_ != OP::ANY)
-      delete operand_;
+      release(operand_);
 }
 
 
@@ -577,6 +743,12 @@ Expr* Unary::clone() {
 
 
 AbsVal Unary::eval(State& s) {
+   auto res = operand_->eval(s);
+   return eval(s, std::move(res));
+}
+
+
+AbsVal Unary::eval(State& s, AbsVal res) {
    EVAL_UNARY(s);
 }
 
@@ -587,8 +759,8 @@ bool Unary::contains(RTL* rtl) const {
 // ----------------------------------- Binary ----------------------------------
 Binary::~Binary() {
    if (op_ != OP::ANY) {
-      delete operands_[0];
-      delete operands_[1];
+      release(operands_[0]);
+      release(operands_[1]);
    }
 }
 
@@ -604,6 +776,10 @@ string Binary::to_string() const {
 
 
 bool Binary::equal(RTL_EQUAL eq, RTL* _v) const {
+   bool res;
+   if (identical(eq, _v, res))
+      return res;
+
    if (_v == nullptr)
       return (eq == RTL_EQUAL::PARTIAL);
 
@@ -652,35 +828,44 @@ Expr* Binary::clone() {
 
 
 AbsVal Binary::eval(State& s) {
+   auto res = operands_[0]->eval(s);
+   auto op2 = operands_[1]->eval(s);
+   return eval(s, std::move(res), std::move(op2));
+}
+
+
+AbsVal Binary::eval(State& s, AbsVal res, AbsVal op2) {
    EVAL_BINARY(s);
 }
 
 
 #if ENABLE_SUPPORT_CONSTRAINT == true
    const AbsId& Binary::expr_id(const State& s) {
-      if (!run_expr_id_)
-         return expr_id_;
-      run_expr_id_ = false;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_id)
+         return c.expr_id;
+      c.run_expr_id = false;
 
       auto const& p = expr_pair(s);
       if (p.bad())
-         return expr_id_;
+         return c.expr_id;
 
       if (!p.lhs.const_expr() && p.rhs.const_expr()) {
          switch (op_) {
             case Binary::OP::PLUS:
-               expr_id_ = p.lhs;
-               expr_id_.offset += p.rhs.offset;
+               c.expr_id = p.lhs;
+               c.expr_id.offset += p.rhs.offset;
                break;
             case Binary::OP::MINUS:
-               expr_id_ = p.lhs;
-               expr_id_.offset -= p.rhs.offset;
+               c.expr_id = p.lhs;
+               c.expr_id.offset -= p.rhs.offset;
+               break;
             case Binary::OP::AND:
                if (p.rhs.offset==7 || p.rhs.offset==15 || p.rhs.offset==255)
-                  expr_id_ = p.lhs;
+                  c.expr_id = p.lhs;
                break;
             case Binary::OP::XOR:
-               expr_id_ = p.lhs;
+               c.expr_id = p.lhs;
                break;
             default:
                break;
@@ -689,15 +874,15 @@ AbsVal Binary::eval(State& s) {
       else if (!p.rhs.const_expr() && p.lhs.const_expr()) {
          switch (op_) {
             case Binary::OP::PLUS:
-               expr_id_ = p.rhs;
-               expr_id_.offset += p.lhs.offset;
+               c.expr_id = p.rhs;
+               c.expr_id.offset += p.lhs.offset;
                break;
             case Binary::OP::AND:
                if (p.rhs.offset==7 || p.rhs.offset==15 || p.rhs.offset==255)
-                  expr_id_ = p.rhs;
+                  c.expr_id = p.rhs;
                break;
             case Binary::OP::XOR:
-               expr_id_ = p.rhs;
+               c.expr_id = p.rhs;
                break;
             default:
                break;
@@ -706,50 +891,55 @@ AbsVal Binary::eval(State& s) {
       else if (p.lhs.const_expr() && p.rhs.const_expr()) {
          switch (op_) {
             case Binary::OP::PLUS:
-               expr_id_ = AbsId(p.lhs.offset + p.rhs.offset);
+               c.expr_id = AbsId(p.lhs.offset + p.rhs.offset);
                break;
             case Binary::OP::MINUS:
-               expr_id_ = AbsId(p.lhs.offset - p.rhs.offset);
+               c.expr_id = AbsId(p.lhs.offset - p.rhs.offset);
                break;
             default:
                break;
          }
       }
-      return expr_id_;
+      return c.expr_id;
    }
 
    const AbsPair& Binary::expr_pair(const State& s) {
-      if (!run_expr_pair_)
-         return expr_pair_;
-      run_expr_pair_ = false;
+      auto& c = s.loc.insn->expr_cache(this);
+      if (!c.run_expr_pair)
+         return c.expr_pair;
+      c.run_expr_pair = false;
 
       auto const& x = operands_[0]->expr_id(s);
       auto const& y = operands_[1]->expr_id(s);
       if (x.bad() || y.bad())
-         expr_pair_ = AbsPair();
+         c.expr_pair = AbsPair();
       else {
          // const propagation
          if (!x.const_expr() && !y.const_expr()) {
-            if (operand_const(1) != _oo)
-               expr_pair_ = AbsPair(x, AbsId(operand_const(1)));
-            else if (operand_const(0) != _oo)
-               expr_pair_ = AbsPair(AbsId(operand_const(0)), y);
+            if (c.operand_const[1] != _oo)
+               c.expr_pair = AbsPair(x, AbsId(c.operand_const[1]));
+            else if (c.operand_const[0] != _oo)
+               c.expr_pair = AbsPair(AbsId(c.operand_const[0]), y);
          }
          else
-            expr_pair_ = AbsPair(x, y);
+            c.expr_pair = AbsPair(x, y);
          // convert to unsigned const in comparison
          if (op_ == OP::COMPARE) {
-            if (expr_pair_.rhs.const_expr() && expr_pair_.rhs.offset < 0)
-               expr_pair_.rhs.offset = (IMM)(Util::cast_int(
-                                             expr_pair_.rhs.offset,
+            if (c.expr_pair.rhs.const_expr() && c.expr_pair.rhs.offset < 0)
+               c.expr_pair.rhs.offset = (IMM)(Util::cast_int(
+                                             c.expr_pair.rhs.offset,
                                              operands_[0]->mode_size(), false));
-            else if (expr_pair_.lhs.const_expr() && expr_pair_.lhs.offset < 0)
-               expr_pair_.lhs.offset = (IMM)(Util::cast_int(
-                                             expr_pair_.lhs.offset,
+            else if (c.expr_pair.lhs.const_expr() && c.expr_pair.lhs.offset < 0)
+               c.expr_pair.lhs.offset = (IMM)(Util::cast_int(
+                                             c.expr_pair.lhs.offset,
                                              operands_[1]->mode_size(), false));
          }
       }
-      return expr_pair_;
+      return c.expr_pair;
+   }
+
+   IMM Binary::operand_const(const State& s, uint8_t idx) const {
+      return s.loc.insn->expr_cache(this).operand_const[idx];
    }
 #endif
 
@@ -760,8 +950,7 @@ bool Binary::contains(RTL* rtl) const {
 }
 // ---------------------------------- Compare ----------------------------------
 Compare::~Compare() {
-   if (expr_ != nullptr)
-      delete expr_;
+   release(expr_);
 }
 
 
@@ -9,6 +9,11 @@
 #include "../../include/sba/program.h"
 #include "../../include/sba/rtl.h"
 #include "../../include/sba/parser.h"
+#include "../../include/sba/channel.h"
+#include "../../include/sba/lift_cache.h"
+#include "../../include/sba/lift_template.h"
+#include "../../include/sba/lifter_pool.h"
+#include "../../include/sba/rtl_image.h"
 #include <cstring>
 #include <unistd.h>
 #include <caml/alloc.h>
@@ -20,6 +25,10 @@
 #include <string>       // 用于 std::string
 #include <filesystem>   // 用于文件系统操作 (C++17)
 #include <map>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <sstream>
 
 using namespace SBA;
 
@@ -27,17 +36,333 @@ using namespace SBA;
 int Framework::session;
 string Framework::d_base;
 string Framework::d_session;
+/* hash of the loaded automaton, RTL lifted by another one is not reused */
+static uint64_t lift_version = 0;
 
 // 启动规则学习，输入auto给ocaml
-static void ocaml_load(const string& f_auto) {
+static bool ocaml_load(const string& f_auto) {
    static const value * closure_f = nullptr;
    if (closure_f == nullptr)
       closure_f = caml_named_value("Load callback");
    auto s = f_auto.c_str();
-   caml_callback(*closure_f, caml_alloc_initialized_string(strlen(s), s));
+   return Bool_val(caml_callback(*closure_f,
+          caml_alloc_initialized_string(strlen(s), s)));
 }
 
 
+#if ENABLE_FAST_AUTOMATON
+static bool ocaml_save_fast(const string& f_auto) {
+   static const value * closure_f = nullptr;
+   if (closure_f == nullptr)
+      closure_f = caml_named_value("Save fast callback");
+   auto s = f_auto.c_str();
+   return Bool_val(caml_callback(*closure_f,
+          caml_alloc_initialized_string(strlen(s), s)));
+}
+
+
+/* load the compact copy of f_auto kept in d_base, creating it on first use */
+static string load_automaton(const string& d_base, const string& f_auto) {
+   namespace fs = std::filesystem;
+   std::error_code ec;
+   auto f_fast = d_base + fs::path(f_auto).filename().string() + ".fast";
+   auto t_auto = fs::last_write_time(f_auto, ec);
+   if (!ec && fs::exists(f_fast, ec) && fs::last_write_time(f_fast, ec) >=
+   t_auto && !ec && ocaml_load(f_fast))
+      return f_fast;
+
+   if (!ocaml_load(f_auto))
+      return "";
+   /* concurrent processes may convert at once, publish with a rename */
+   auto f_tmp = f_fast + "." + std::to_string(getpid());
+   if (ocaml_save_fast(f_tmp)) {
+      fs::rename(f_tmp, f_fast, ec);
+      if (!ec)
+         return f_fast;
+   }
+   fs::remove(f_tmp, ec);
+   return f_auto;
+}
+#endif
+
+
+/* parse one lifted instruction, false if the whole load must be aborted */
+static bool load_insn(vector<tuple<IMM,RTL*,vector<uint8_t>>>& res, IMM
+offset, const string& itc, const string& rtl, vector<uint8_t>&& raw_bytes,
+const unordered_set<IMM>& noreturn_calls) {
+   RTL* object = nullptr;
+   if (!noreturn_calls.contains(offset))
+      object = Parser::process(rtl);
+   else {
+      object = new Exit(Exit::EXIT_TYPE::HALT);
+      raw_bytes = SYSTEM::HLT_BYTES;
+      LOG2("fix: instruction " << offset << " is a non-returning call");
+   }
+
+   res.push_back({offset, object, std::move(raw_bytes)});
+   if (object == nullptr) {
+      LOG2("error: failed to lift at " << offset << ": " << itc);
+      #if ABORT_UNLIFTED_INSN == true
+         return false;
+      #endif
+   }
+   return true;
+}
+
+
+/* one lifted instruction on its way to the parser, raw is the hex text of */
+/* raw_bytes when they are read from a file and not decoded yet            */
+struct StreamInsn {
+   IMM offset;
+   string itc;
+   string rtl;
+   vector<uint8_t> raw_bytes;
+   string raw;
+};
+using StreamBatch = pair<size_t,vector<StreamInsn>>;   /* sequence, insns */
+
+
+static uint8_t hex_digit(char c) {
+   return c <= '9'? c - '0': (c | 0x20) - 'a' + 10;
+}
+
+
+/* parse batches popped from q on LOAD_WORKERS threads into arena; they may */
+/* finish out of order and are merged back by their sequence numbers, with */
+/* the logs of each batch buffered and written in the same order; complete */
+/* is cleared if the load was aborted                                      */
+static vector<tuple<IMM,RTL*,vector<uint8_t>>> parse_batches(
+Channel<StreamBatch>& q, const unordered_set<IMM>& noreturn_calls,
+Arena* arena, bool& complete) {
+   using Parsed = vector<tuple<IMM,RTL*,vector<uint8_t>>>;
+   using Done = tuple<size_t,Parsed,string>;            /* sequence, insns, log */
+   vector<vector<Done>> done(Util::workers(LOAD_WORKERS));
+   std::atomic<bool> ok = true;
+   vector<std::thread> workers;
+   for (size_t w = 0; w < done.size(); ++w)
+      workers.emplace_back([&, w]() {
+         Arena::Scope scope(arena);
+         StreamBatch b;
+         /* keep draining after an abort so that the other stages finish */
+         while (q.pop(b)) {
+            Parsed res;
+            res.reserve(b.second.size());
+            std::ostringstream log;
+            LOG_STREAM = &log;
+            for (auto& x: b.second) {
+               if (!ok)
+                  break;
+               for (size_t i = 0; i + 1 < x.raw.length(); i += 3)
+                  x.raw_bytes.push_back(hex_digit(x.raw[i]) << 4 |
+                                        hex_digit(x.raw[i+1]));
+               if (!load_insn(res, x.offset, x.itc, x.rtl,
+               std::move(x.raw_bytes), noreturn_calls))
+                  ok = false;
+            }
+            LOG_STREAM = nullptr;
+            done[w].push_back({b.first, std::move(res), log.str()});
+         }
+      });
+   for (auto& t: workers)
+      t.join();
+
+   vector<Done*> order;
+   size_t total = 0;
+   for (auto& d: done)
+      for (auto& x: d) {
+         order.push_back(&x);
+         total += std::get<1>(x).size();
+      }
+   std::sort(order.begin(), order.end(), [](auto a, auto b) {
+      return std::get<0>(*a) < std::get<0>(*b);
+   });
+   Parsed res;
+   res.reserve(total);
+   if (!ok)
+      complete = false;
+   for (auto x: order) {
+      LOG_OUT << std::get<2>(*x);
+      for (auto& y: std::get<1>(*x)) {
+         if (!ok)
+            delete std::get<1>(y);
+         else
+            res.push_back(std::move(y));
+      }
+   }
+   return res;
+}
+
+
+#if ENABLE_STREAMING_LIFT
+#if ENABLE_LIFT_CACHE
+/* asm -> RTL translations of previous runs with the same automaton */
+static LiftCache lift_cache;
+#endif
+
+
+static string ocaml_lift_one(const string& itc) {
+   static const value* closure_f = nullptr;
+   if (closure_f == nullptr)
+      closure_f = caml_named_value("Lift one callback");
+   auto rtl = caml_callback(*closure_f,
+              caml_alloc_initialized_string(itc.length(), itc.c_str()));
+   return string(String_val(rtl), caml_string_length(rtl));
+}
+
+
+#if ENABLE_LIFT_TEMPLATE
+/* instructions differing only in constants share one automaton traversal */
+static TemplateLifter lift_template;
+#endif
+
+
+/* workers with their own OCaml runtime, empty if lifting in process */
+static LifterPool lifter_pool;
+
+
+/* RTL known without running the automaton */
+static bool lift_known(const string& itc, string& rtl) {
+   #if ENABLE_LIFT_CACHE
+      if (lift_cache.find(itc, rtl))
+         return true;
+   #endif
+   #if ENABLE_LIFT_TEMPLATE
+      if (lift_template.find(itc, rtl)) {
+         #if ENABLE_LIFT_CACHE
+            lift_cache.insert(itc, rtl);
+         #endif
+         return true;
+      }
+   #endif
+   return false;
+}
+
+
+/* RTL produced by the automaton */
+static void lift_learn(const string& itc, const string& rtl) {
+   #if ENABLE_LIFT_TEMPLATE
+      lift_template.learn(itc, rtl);
+   #endif
+   #if ENABLE_LIFT_CACHE
+      lift_cache.insert(itc, rtl);
+   #endif
+}
+
+
+/* disassemble -> lift -> parse without intermediate files: the decoder and */
+/* the parsers run on their own threads, the lifter stays on this thread    */
+/* because the OCaml runtime belongs to it; each batch is a shard whose     */
+/* unknown instructions go to a lifter worker, shards are merged in order   */
+struct StreamShard {
+   vector<StreamInsn> batch;
+   vector<size_t> misses;
+   int worker;
+};
+
+
+static vector<tuple<IMM,RTL*,vector<uint8_t>>> stream_load(const
+SYSTEM::Object& info, const unordered_set<IMM>& noreturn_calls, Arena* arena,
+bool& complete) {
+   vector<tuple<IMM,RTL*,vector<uint8_t>>> res;
+   Channel<vector<StreamInsn>> asm_q(STREAM_QUEUE_SIZE);
+   Channel<StreamBatch> rtl_q(STREAM_QUEUE_SIZE);
+
+   std::thread disassembler([&]() {
+      vector<StreamInsn> batch;
+      batch.reserve(STREAM_BATCH_SIZE);
+      SYSTEM::disassemble(info, [&](uint64_t addr, const string& itc, const
+      uint8_t* code, uint8_t len) {
+         batch.push_back({(IMM)addr, itc, "", vector<uint8_t>(code,code+len),
+                          ""});
+         if (batch.size() == STREAM_BATCH_SIZE) {
+            asm_q.push(std::move(batch));
+            batch.clear();
+            batch.reserve(STREAM_BATCH_SIZE);
+         }
+      });
+      if (!batch.empty())
+         asm_q.push(std::move(batch));
+      asm_q.close();
+   });
+
+   std::thread parser([&]() {
+      res = parse_batches(rtl_q, noreturn_calls, arena, complete);
+   });
+
+   std::deque<StreamShard> shards;
+   size_t seq = 0;
+   vector<int> idle;
+   for (int w = (int)lifter_pool.size() - 1; w >= 0; --w)
+      idle.push_back(w);
+
+   auto finish = [&]() {
+      auto& s = shards.front();
+      vector<string> rtls;
+      /* a worker that failed is out of sync and never used again; its */
+      /* shard is lifted again below but the lift is not kept as whole */
+      if (s.worker >= 0 && lifter_pool.receive(s.worker, rtls))
+         idle.push_back(s.worker);
+      else if (s.worker >= 0)
+         complete = false;
+      /* lift in process if there is no worker or it failed */
+      if (rtls.size() != s.misses.size()) {
+         rtls.clear();
+         for (auto i: s.misses)
+            rtls.push_back(ocaml_lift_one(s.batch[i].itc));
+      }
+      for (size_t k = 0; k < s.misses.size(); ++k) {
+         auto& x = s.batch[s.misses[k]];
+         x.rtl = std::move(rtls[k]);
+         lift_learn(x.itc, x.rtl);
+      }
+      rtl_q.push({seq++, std::move(s.batch)});
+      shards.pop_front();
+   };
+
+   vector<StreamInsn> batch;
+   while (asm_q.pop(batch)) {
+      StreamShard s{std::move(batch), {}, -1};
+      vector<const string*> itcs;
+      for (size_t i = 0; i < s.batch.size(); ++i) {
+         auto& x = s.batch[i];
+         if (!noreturn_calls.contains(x.offset) && !lift_known(x.itc, x.rtl)) {
+            s.misses.push_back(i);
+            itcs.push_back(&x.itc);
+         }
+      }
+      if (!s.misses.empty() && lifter_pool.size() > 0) {
+         while (idle.empty() && !shards.empty())
+            finish();
+         if (!idle.empty()) {
+            s.worker = idle.back();
+            idle.pop_back();
+            if (!lifter_pool.send(s.worker, itcs)) {
+               s.worker = -1;
+               complete = false;
+            }
+         }
+      }
+      shards.push_back(std::move(s));
+      while (!shards.empty() && (shards.front().worker < 0 ||
+      shards.size() > lifter_pool.size()))
+         finish();
+   }
+   while (!shards.empty())
+      finish();
+   rtl_q.close();
+   #if ENABLE_LIFT_CACHE
+      lift_cache.flush();
+   #endif
+   #if ENABLE_LIFT_TEMPLATE
+      LOG2("lift: " << lift_template.hits() << " instantiated, "
+                    << lift_template.misses() << " lifted by templates");
+   #endif
+
+   disassembler.join();
+   parser.join();
+   return res;
+}
+#else
 static void ocaml_lift(const string& f_asm, const string& f_rtl) {
    static const value* closure_f = nullptr;
    if (closure_f == nullptr)
@@ -85,67 +410,102 @@ static void ocaml_lift(const string& f_asm, const string& f_rtl) {
 
 
 
+/* the files are read in lockstep on this thread and cut into batches at */
+/* line boundaries, which are parsed and decoded by parse_batches()      */
 static vector<tuple<IMM,RTL*,vector<uint8_t>>> load(const string& f_asm,
 const string& f_rtl, const string& f_raw, const unordered_set<IMM>&
-noreturn_calls = {}) {
-   string itc, rtl, raw;
+noreturn_calls, Arena* arena, bool& complete) {
    vector<tuple<IMM,RTL*,vector<uint8_t>>> res;
-   string one_byte;
-   vector<uint8_t> raw_bytes;
+   Channel<StreamBatch> q(STREAM_QUEUE_SIZE);
+   std::thread parser([&]() {
+      res = parse_batches(q, noreturn_calls, arena, complete);
+   });
 
+   string itc, rtl, raw;
    fstream f1(f_asm, fstream::in);
    fstream f2(f_rtl, fstream::in);
    fstream f3(f_raw, fstream::in);
 
+   StreamBatch batch{0, {}};
+   batch.second.reserve(STREAM_BATCH_SIZE);
    while (getline(f1,itc) && getline(f2,rtl) && getline(f3,raw)) {
-      RTL* object = nullptr;
       IMM offset = Util::to_int(itc.substr(2, itc.find(" ")-2));
-      auto it = noreturn_calls.find(offset);
-      if (it == noreturn_calls.end()) {
-         object = Parser::process(rtl);
-         raw_bytes.clear();
-         for (IMM i = 0; i < (IMM)(raw.length()); i += 3)
-            raw_bytes.push_back((uint8_t)Util::to_int("0x" + raw.substr(i,2)));
-      }
-      else {
-         object = new Exit(Exit::EXIT_TYPE::HALT);
-         raw_bytes = SYSTEM::HLT_BYTES;
-         LOG2("fix: instruction " << offset << " is a non-returning call");
-      }
-
-      res.push_back({offset, object, raw_bytes});
-      if (object == nullptr) {
-         LOG2("error: failed to lift at " << offset << ": "
-            << itc.substr(itc.find(" ")+1, string::npos));
-         #if ABORT_UNLIFTED_INSN == true
-            for (auto [offset, object, raw_bytes]: res)
-               delete object;
-            break;
-         #endif
+      batch.second.push_back({offset, itc.substr(itc.find(" ")+1,
+                              string::npos), std::move(rtl), {},
+                              std::move(raw)});
+      if (batch.second.size() == STREAM_BATCH_SIZE) {
+         auto seq = batch.first;
+         q.push(std::move(batch));
+         batch = StreamBatch{seq + 1, {}};
+         batch.second.reserve(STREAM_BATCH_SIZE);
       }
    }
+   if (!batch.second.empty())
+      q.push(std::move(batch));
+   q.close();
    f1.close();
    f2.close();
    f3.close();
 
+   parser.join();
    return res;
 }
+#endif
+
+
+/* disassemble, lift and parse all instructions of info into arena; complete */
+/* tells whether the automaton was loaded and nothing failed on the way     */
+static vector<tuple<IMM,RTL*,vector<uint8_t>>> lift(const SYSTEM::Object&
+info, Arena* arena, bool& complete) {
+   // 得到构造函数和虚表
+   auto noreturn_calls = SYSTEM::noreturn_calls(info);
+   complete = lift_version != 0;
+
+   #if ENABLE_STREAMING_LIFT
+      return stream_load(info, noreturn_calls, arena, complete);
+   #else
+      auto f_asm = Framework::d_session + "asm";
+      auto f_rtl = Framework::d_session + "rtl";
+      auto f_raw = Framework::d_session + "raw";
+      // 反汇编data段，并且写入adm和raw文件里面
+      SYSTEM::disassemble(info, f_asm, f_raw);
+      ocaml_lift(f_asm, f_rtl);
+      return load(f_asm, f_rtl, f_raw, noreturn_calls, arena, complete);
+   #endif
+}
 
 
 Program* Framework::create_program(const string& f_obj, const vector<IMM>&
 fptrs, const unordered_map<IMM,unordered_set<IMM>>& indirect_targets) {
-   auto f_asm = Framework::d_session + "asm";
-   auto f_rtl = Framework::d_session + "rtl";
-   auto f_raw = Framework::d_session + "raw";
-   // 反汇编data段，并且写入adm和raw文件里面
-   SYSTEM::disassemble(f_obj, f_asm, f_raw);
-   ocaml_lift(f_asm, f_rtl);
-   
+   SYSTEM::Object info;
+   if (!SYSTEM::load(info, f_obj))
+      return nullptr;
 
-   // 得到构造函数和虚表
-   auto noreturn_calls = SYSTEM::noreturn_calls(f_obj);
-   auto offset_rtl_raw = load(f_asm, f_rtl, f_raw, noreturn_calls);
-   auto p = new Program(f_obj, offset_rtl_raw, fptrs, indirect_targets);
+   /* RTL of all insns lives in one arena, handed over to the program */
+   auto arena = new Arena();
+   #if ENABLE_RTL_IMAGE
+      auto key = RTLImage::key(f_obj, lift_version);
+      char hex[17];
+      snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)key);
+      auto f_image = Framework::d_base + "rtl-" + hex + ".img";
+      vector<tuple<IMM,RTL*,vector<uint8_t>>> offset_rtl_raw;
+      if (RTLImage::load(f_image, key, offset_rtl_raw, arena)) {
+         LOG2("load: " << offset_rtl_raw.size() << " insns from " << f_image);
+      }
+      else {
+         /* an insn the lifter has no RTL for is kept, as a rerun gives */
+         /* the same; a failed automaton, load or worker is not         */
+         bool complete = false;
+         offset_rtl_raw = lift(info, arena, complete);
+         if (complete && !RTLImage::save(f_image, key, offset_rtl_raw))
+            LOG1("warning: failed to save " << f_image);
+      }
+   #else
+      bool complete = false;
+      auto offset_rtl_raw = lift(info, arena, complete);
+   #endif
+   auto p = new Program(f_obj, std::move(info), offset_rtl_raw, fptrs,
+                        indirect_targets, arena);
    
    if (!p->faulty)
       return p;
@@ -175,10 +535,36 @@ void Framework::setup(const string& d_base, const string& f_auto) {
    argv[3] = t3;
    argv[4] = nullptr;
    caml_startup(argv);
-   ocaml_load(f_auto);
+   #if ENABLE_FAST_AUTOMATON
+      auto f_loaded = load_automaton(d_base, f_auto);
+   #else
+      auto f_loaded = ocaml_load(f_auto)? f_auto: string("");
+   #endif
+   if (f_loaded.empty())
+      LOG1("error: failed to load automaton " << f_auto);
+
+   #if ENABLE_STREAMING_LIFT
+      /* forked before any thread or cache exists, with the automaton loaded */
+      size_t workers = LIFT_WORKERS > 0? LIFT_WORKERS:
+                       std::thread::hardware_concurrency();
+      if (workers > 1)
+         lifter_pool.start(workers, ocaml_lift_one);
+   #endif
+
+   lift_version = LiftCache::version(f_loaded);
+   #if ENABLE_STREAMING_LIFT && ENABLE_LIFT_CACHE
+      char hex[17];
+      snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)lift_version);
+      auto f_cache = d_base + "lift-" + hex + ".cache";
+      if (!lift_cache.open(f_cache, lift_version))
+         LOG1("warning: lift cache " << f_cache << " is unavailable");
+   #endif
 }
 
 
 void Framework::clean() {
+   #if ENABLE_STREAMING_LIFT
+      lifter_pool.stop();
+   #endif
    std::filesystem::remove_all(d_session);
 }
@@ -16,20 +16,22 @@
 #include "../../include/sba/domain.h"
 
 using namespace SBA;
+/* buffers of tarjan(), kept to reuse their room across functions */
+static thread_local vector<Block*> tarjan_stack;
+static thread_local vector<pair<Block*,uint32_t>> tarjan_dfs;
 /* -------------------------------- Function -------------------------------- */
 Function::~Function() {
    /* if summary() not called */
    if (!s_list_.empty()) {
-      s_.clear();
+      clear();
       if (pseudo_entry_ != nullptr)
          delete pseudo_entry_;
+      if (pseudo_exit_ != nullptr) {
+         delete pseudo_exit_->first();
+         delete pseudo_exit_;
+      }
       for (auto scc: s_list_)
          delete scc;
-      #if ENABLE_RESOLVE_ICF
-         for (auto [i, expr]: target_expr)
-            delete expr;
-      #endif
-      CUSTOM_ANALYSIS_CLEAR();
    }
 }
 
@@ -47,6 +49,11 @@ void Function::summary() {
       delete pseudo_entry_;
       pseudo_entry_ = nullptr;
    }
+   if (pseudo_exit_ != nullptr) {
+      delete pseudo_exit_->first();
+      delete pseudo_exit_;
+      pseudo_exit_ = nullptr;
+   }
    for (auto scc: s_list_)
       delete scc;
    s_list_.clear();
@@ -54,66 +61,91 @@ void Function::summary() {
 }
 
 
-void Function::tarjan(Block* u, IMM& cnt, stack<Block*>& st) {
-   ++cnt;
-   u->num = cnt;
-   u->low = cnt;
-   st.push(u);
-   Util::Visited.push_back(u);
-
-   for (auto const& [v,c]: u->succ()) {
-      if (v->faulty) {
-         faulty = true;
-         return;
-      }
-      else if (v->num == 0) {
-         tarjan(v, cnt, st);
-         if (faulty)
+/* Tarjan's algorithm with an explicit stack of (block, next successor), */
+/* so the size of a function is not bounded by the call stack            */
+void Function::tarjan(Block* root) {
+   IMM cnt = 0;
+   tarjan_stack.clear();
+   tarjan_dfs.clear();
+   auto visit = [&](Block* u) {
+      ++cnt;
+      u->num = cnt;
+      u->low = cnt;
+      tarjan_stack.push_back(u);
+      tarjan_dfs.push_back({u, 0});
+      Util::Visited.push_back(u);
+   };
+
+   visit(root);
+   while (!tarjan_dfs.empty()) {
+      auto [u, e] = tarjan_dfs.back();
+      auto succ = u->succ();
+      if (e < succ.size()) {
+         ++tarjan_dfs.back().second;
+         auto v = succ[e].first;
+         if (v->faulty) {
+            faulty = true;
             return;
-         u->low = std::min(u->low, v->low);
+         }
+         else if (v->num == 0)
+            visit(v);
+         else if (v->num > 0)
+            u->low = std::min(u->low, v->num);
+         continue;
       }
-      else if (v->num > 0)
-         u->low = std::min(u->low, v->num);
-   }
 
-   if (u->num == u->low) {
-      auto scc = new SCC();
-      s_list_.push_back(scc);
-      while (true) {
-         auto v = st.top();
-         st.pop();
-         v->attach(scc);
-         v->num = -1;
-         if (u == v)
-            break;
+      tarjan_dfs.pop_back();
+      if (!tarjan_dfs.empty()) {
+         auto p = tarjan_dfs.back().first;
+         p->low = std::min(p->low, u->low);
+      }
+      if (u->num == u->low) {
+         auto scc = new SCC(this);
+         s_list_.push_back(scc);
+         while (true) {
+            auto v = tarjan_stack.back();
+            tarjan_stack.pop_back();
+            v->attach(scc);
+            v->num = -1;
+            if (u == v)
+               break;
+         }
       }
    }
 }
 
-/* reverse postorder for s_list_ */
+/* reverse postorder for s_list_, (scc, next ext_target) on an explicit stack */
 void Function::rev_postorder(Block* header) {
-   auto scc = header->parent;
-   scc->build_cfg(header);
-   for (auto u: scc->ext_target) {
-      auto nscc = u->parent;
-      if (nscc->block_list().empty()) {
-         rev_postorder(u);
-         nscc->ext_target.clear();
+   vector<pair<SCC*,uint32_t>> dfs;
+   auto visit = [&](Block* u) {
+      u->parent->build_cfg(u);
+      dfs.push_back({u->parent, 0});
+   };
+
+   visit(header);
+   while (!dfs.empty()) {
+      auto [scc, k] = dfs.back();
+      if (k < scc->ext_target.size()) {
+         ++dfs.back().second;
+         auto u = scc->ext_target[k];
+         if (u->parent->block_list().empty())
+            visit(u);
+         continue;
       }
+      dfs.pop_back();
+      if (!dfs.empty())
+         scc->ext_target.clear();
+      s_list_.push_back(scc);
    }
-   s_list_.push_back(scc);
 }
 
 
 void Function::build_cfg() {
-   IMM cnt = 0;
-   stack<Block*> st;
-
    Util::Visited.clear();
-   tarjan(entry_, cnt, st);
+   tarjan(entry_);
    if (faulty) {
-      for (int k = 0; k < Util::Visited.count(); ++k)
-         Util::Visited.get(k)->detach();
+      for (auto b: Util::Visited)
+         b->detach();
       return;
    }
 
@@ -121,15 +153,19 @@ void Function::build_cfg() {
    rev_postorder(entry_);
    std::reverse(s_list_.begin(), s_list_.end());
 
-   pseudo_entry_ = new Block(vector<Insn*>{});
+   pseudo_entry_ = new Block(container->cfg(), vector<Insn*>{});
    pseudo_entry_->succ(entry_,COMPARE::NONE,false);
    entry_->pred(pseudo_entry_);
 
-   pseudo_exit_ = new Block(vector<Insn*>{new Insn(oo, new Exit(Exit::EXIT_TYPE::HALT), SYSTEM::HLT_BYTES)});
+   pseudo_exit_ = new Block(container->cfg(), vector<Insn*>{new Insn(oo, new Exit(Exit::EXIT_TYPE::HALT), SYSTEM::HLT_BYTES)});
    for (auto scc: s_list_)
-   for (auto b: scc->block_list())
+   for (auto b: scc->block_list()) {
       if (b->succ().empty())
          pseudo_exit_->pred(b);
+      /* indirect transfers end a block */
+      if (b->last()->indirect())
+         icf_sites_.push_back(b->last());
+   }
 
    #if ENABLE_RESOLVE_ICF && ENABLE_SUPPORT_CONSTRAINT
       for (auto scc: s_list_)
@@ -166,12 +202,29 @@ void Function::analyze(const State::StateConfig& conf,Program* p) {
    for (auto scc: s_list_)
       scc->execute(s_);
    if(s_.lea == 3){
-      p->vtables.insert(vfunc_table);
+      p->vtable(vfunc_table);
    }
    s_.lea = 0;
 }
 
 
+/* drop the results of analyze(), the cfg is kept for the next one */
+void Function::clear() {
+   s_.clear();
+   #if ENABLE_RESOLVE_ICF
+      for (auto [i, expr]: target_expr)
+         delete expr;
+      target_expr.clear();
+   #endif
+   jtable_result.clear();
+   this_pointer = false;
+   this_points.clear();
+   lea_dst.clear();
+   vfunc_table = 0;
+   CUSTOM_ANALYSIS_CLEAR();
+}
+
+
 vector<AbsVal> Function::track(TRACK trackType, const UnitId& id,
 const Loc& loc, const vector<Insn*>& insns) {
    LOG3("############## track " << id.to_string() << " ##############");
@@ -208,22 +261,20 @@ const Loc& loc, const vector<Insn*>& insns) {
 vector<ExprLoc> Function::find_def(SYSTEM::Reg reg, const Loc& loc) const {
    vector<ExprLoc> res;
    auto pattern = new Reg(Expr::EXPR_MODE::DI, reg);
+   auto assign = new Assign(nullptr, nullptr);
    for (auto l: s_.use_def(get_id(reg), loc)) {
-      auto stmt = l.insn->stmt();
-      auto vec = stmt->find(RTL::RTL_EQUAL::RELAXED, pattern);
-      for (auto r: vec) {
-         auto a = (Assign*)(stmt->find_container(r, [](const RTL* rtl)->bool {
-            return (Assign*)(*rtl) != nullptr;
-         }));
-         /* ignore clobber, since we're looking for source expressions */
-         if (a != nullptr) {
-            auto src = a->src()->simplify();
-            auto dst = a->dst()->simplify();
-            if (dst->contains(r))
-               res.push_back(ExprLoc{src, l});
-         }
+      /* ignore clobber, since we're looking for source expressions */
+      /* interned subtrees can occur more than once in an insn, so  */
+      /* look for reg in each destination instead of by address     */
+      for (auto x: l.insn->stmt()->find(RTL::RTL_EQUAL::OPCODE, assign)) {
+         auto a = (Assign*)x;
+         auto src = a->src()->simplify();
+         auto dst = a->dst()->simplify();
+         auto n = dst->find(RTL::RTL_EQUAL::RELAXED, pattern).size();
+         res.insert(res.end(), n, ExprLoc{src, l});
       }
    }
+   delete assign;
    delete pattern;
    return res;
 }
@@ -15,7 +15,7 @@ using namespace SBA;
 // ---------------------------------- Insn -------------------------------------
 Insn::Insn(IMM offset, RTL* rtl, const vector<uint8_t>& raw_bytes):
 parent(nullptr), gap(true), offset_(offset), stmt_((Statement*)rtl),
-raw_bytes_(raw_bytes), transfer_(nullptr) {
+raw_bytes_(raw_bytes), transfer_(nullptr), pc_rel_(nullptr) {
    refresh();
 }
 
@@ -35,6 +35,12 @@ void Insn::replace(RTL* rtl, const vector<uint8_t>& raw_bytes) {
       delete transfer_;
    stmt_ = (Statement*)rtl;
    raw_bytes_ = raw_bytes;
+   #if ENABLE_SUPPORT_CONSTRAINT == true
+      expr_cache_.clear();
+   #endif
+   #if ENABLE_BYTECODE_EVAL == true
+      bytecode_.clear();
+   #endif
    refresh();
 }
 
@@ -59,19 +65,152 @@ void Insn::execute(State& s) const {
 }
 
 
+AbsVal Insn::eval(State& s, Expr* e) {
+   #if ENABLE_BYTECODE_EVAL == true
+      return bytecode_.eval(s, e);
+   #else
+      return e->eval(s);
+   #endif
+}
+
+
+Expr* Insn::simplify(Expr* e) {
+   #if ENABLE_BYTECODE_EVAL == true
+      return bytecode_.simplify(e);
+   #else
+      return e->simplify();
+   #endif
+}
+
+
+#if ENABLE_SUPPORT_CONSTRAINT == true
+   Insn::ExprCache& Insn::expr_cache(const Expr* e) {
+      for (auto& c: expr_cache_)
+         if (c.expr == e)
+            return c;
+      auto& c = expr_cache_.emplace_back();
+      c.expr = e;
+      return c;
+   }
+#endif
+
+
+/* nodes that decide the transfer of an insn: the first of each kind in  */
+/* the pre-order of RTL::find(), collected in one walk without patterns */
+struct TransferNodes {
+   Call* call = nullptr;         /* (call ..)             */
+   Assign* jump = nullptr;       /* (set pc ..)           */
+   Binary* pc_rel = nullptr;     /* (plus (reg ip) ..)    */
+};
+
+
+static void classify(Expr* e, TransferNodes& t) {
+   if (e == nullptr || t.pc_rel != nullptr)
+      return;
+   switch (e->expr_type()) {
+      case Expr::EXPR_TYPE::VAR:
+         if (((Var*)e)->var_type() == Var::VAR_TYPE::MEM)
+            classify(((Mem*)e)->addr(), t);
+         break;
+      case Expr::EXPR_TYPE::SUBREG:
+         classify(((SubReg*)e)->expr(), t);
+         break;
+      case Expr::EXPR_TYPE::IFELSE:
+         classify(((IfElse*)e)->cmp_expr(), t);
+         classify(((IfElse*)e)->if_expr(), t);
+         classify(((IfElse*)e)->else_expr(), t);
+         break;
+      case Expr::EXPR_TYPE::CONVERSION:
+         classify(((Conversion*)e)->expr(), t);
+         classify(((Conversion*)e)->size(), t);
+         classify(((Conversion*)e)->pos(), t);
+         break;
+      case Expr::EXPR_TYPE::ARITHMETIC:
+         switch (((Arithmetic*)e)->arith_type()) {
+            case Arithmetic::ARITH_TYPE::UNARY:
+               classify(((Unary*)e)->operand(), t);
+               break;
+            case Arithmetic::ARITH_TYPE::BINARY: {
+               auto bin = (Binary*)e;
+               auto a = bin->operand(0);
+               if (bin->op() == Binary::OP::PLUS && a != nullptr &&
+               a->expr_type() == Expr::EXPR_TYPE::VAR &&
+               ((Var*)a)->var_type() == Var::VAR_TYPE::REG &&
+               ((Reg*)a)->reg() == SYSTEM::INSN_PTR)
+                  t.pc_rel = bin;
+               else {
+                  classify(a, t);
+                  classify(bin->operand(1), t);
+               }
+               break;
+            }
+            /* like Compare::find(), operands of a comparison are skipped */
+            default:
+               break;
+         }
+         break;
+      default:
+         break;
+   }
+}
+
+
+static void classify(Statement* stmt, TransferNodes& t) {
+   if (stmt == nullptr)
+      return;
+   switch (stmt->stmt_type()) {
+      case Statement::STATEMENT_TYPE::PARALLEL:
+         for (auto s: ((Parallel*)stmt)->stmts())
+            classify(s, t);
+         break;
+      case Statement::STATEMENT_TYPE::SEQUENCE:
+         for (auto s: ((Sequence*)stmt)->stmts())
+            classify(s, t);
+         break;
+      case Statement::STATEMENT_TYPE::ASSIGN: {
+         auto assign = (Assign*)stmt;
+         auto dst = assign->dst();
+         if (t.jump == nullptr && dst != nullptr &&
+         dst->expr_type() == Expr::EXPR_TYPE::NOTYPE &&
+         dst->to_string().compare("pc") == 0)
+            t.jump = assign;
+         classify(dst, t);
+         /* (set (reg ..) (call ..)) of a call that returns a value */
+         auto src = assign->src();
+         if (src != nullptr && src->rtl_type() == RTL::RTL_TYPE::STATEMENT)
+            classify((Statement*)(*src), t);
+         else
+            classify(src, t);
+         break;
+      }
+      case Statement::STATEMENT_TYPE::CALL:
+         if (t.call == nullptr)
+            t.call = (Call*)stmt;
+         classify(((Call*)stmt)->target(), t);
+         break;
+      case Statement::STATEMENT_TYPE::CLOBBER:
+         classify(((Clobber*)stmt)->expr(), t);
+         break;
+      default:
+         break;
+   }
+}
+
+
 void Insn::refresh() {
+   pc_rel_ = nullptr;
    if (!empty()) {
       RTL* tmp;
-      vector<RTL*> vec;
+      TransferNodes t;
+      classify(stmt_, t);
+      if (t.pc_rel != nullptr)
+         pc_rel_ = t.pc_rel->operand(1);
 
       /* (call (mem (reg ..)) */
       /* (call (mem (mem ..))) */
       /* (call (mem (const_int ..))) */
-      tmp = new Call(nullptr);
-      vec = stmt_->find(RTL::RTL_EQUAL::OPCODE, tmp);
-      delete tmp;
-      if (!vec.empty()) {
-         tmp = vec.front();
+      if (t.call != nullptr) {
+         tmp = t.call;
          auto target = ((Mem*)(((Call*)tmp)->target()))->addr();
          switch (target->expr_type()) {
             /* direct transfer */
@@ -103,11 +242,8 @@ void Insn::refresh() {
       }
 
       /* (set pc ..) */
-      tmp = new Assign(new NoType("pc"), nullptr);
-      vec = stmt_->find(RTL::RTL_EQUAL::PARTIAL, tmp);
-      delete tmp;
-      if (!vec.empty()) {
-         tmp = vec.front();
+      if (t.jump != nullptr) {
+         tmp = t.jump;
          auto target = ((Assign*)tmp)->src();
          switch (target->expr_type()) {
             /* direct transfer */
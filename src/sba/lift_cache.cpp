@@ -0,0 +1,269 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/lift_cache.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using std::string;
+using std::string_view;
+using std::vector;
+using std::function;
+using namespace SBA;
+
+/* file:   magic[8] version[8] record*                  */
+/* record: key_len[4] val_len[4] checksum[8] key val    */
+static const char MAGIC[8] = {'S','B','A','L','I','F','T','1'};
+static constexpr size_t HEADER_SIZE = 16;
+static constexpr size_t RECORD_HEADER_SIZE = 16;
+
+
+static uint64_t fnv1a(const void* data, size_t size, uint64_t h =
+0xcbf29ce484222325ULL) {
+   auto p = (const uint8_t*)data;
+   for (size_t i = 0; i < size; ++i) {
+      h ^= p[i];
+      h *= 0x100000001b3ULL;
+   }
+   return h;
+}
+
+
+static uint64_t checksum(string_view key, string_view val) {
+   uint64_t h = fnv1a(key.data(), key.size());
+   h = fnv1a("\n", 1, h);
+   return fnv1a(val.data(), val.size(), h);
+}
+
+
+/* walk the records in p[pos..end), returns the end of the last valid one */
+static size_t scan(const uint8_t* p, size_t pos, size_t end, const
+function<void(string_view,string_view)>& fn) {
+   while (end - pos >= RECORD_HEADER_SIZE) {
+      uint32_t klen, vlen;
+      uint64_t sum;
+      std::memcpy(&klen, p + pos, 4);
+      std::memcpy(&vlen, p + pos + 4, 4);
+      std::memcpy(&sum, p + pos + 8, 8);
+      auto n = RECORD_HEADER_SIZE + (size_t)klen + (size_t)vlen;
+      if (klen == 0 || n > end - pos)
+         break;
+      string_view key((const char*)p + pos + RECORD_HEADER_SIZE, klen);
+      string_view val(key.data() + klen, vlen);
+      if (checksum(key, val) != sum)
+         break;
+      if (fn)
+         fn(key, val);
+      pos += n;
+   }
+   return pos;
+}
+
+
+static bool write_all(int fd, const void* data, size_t size, size_t offset) {
+   auto p = (const uint8_t*)data;
+   while (size > 0) {
+      auto n = pwrite(fd, p, size, (off_t)offset);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return false;
+      p += n;
+      size -= (size_t)n;
+      offset += (size_t)n;
+   }
+   return true;
+}
+
+
+static bool read_all(int fd, void* data, size_t size, size_t offset) {
+   auto p = (uint8_t*)data;
+   while (size > 0) {
+      auto n = pread(fd, p, size, (off_t)offset);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return false;
+      p += n;
+      size -= (size_t)n;
+      offset += (size_t)n;
+   }
+   return true;
+}
+/* -------------------------------------------------------------------------- */
+
+
+LiftCache::~LiftCache() {
+   close();
+}
+
+
+bool LiftCache::open(const string& file, uint64_t version) {
+   close();
+   fd_ = ::open(file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+   if (fd_ < 0)
+      return false;
+   flock(fd_, LOCK_EX);
+
+   /* create the header, or refuse a file written for another automaton */
+   struct stat st;
+   bool ok = fstat(fd_, &st) == 0;
+   if (ok && (size_t)st.st_size < HEADER_SIZE) {
+      uint8_t header[HEADER_SIZE];
+      std::memcpy(header, MAGIC, 8);
+      std::memcpy(header + 8, &version, 8);
+      ok = ftruncate(fd_, 0) == 0 && write_all(fd_, header, HEADER_SIZE, 0);
+      st.st_size = HEADER_SIZE;
+   }
+   else if (ok) {
+      uint8_t header[HEADER_SIZE];
+      ok = read_all(fd_, header, HEADER_SIZE, 0) &&
+           std::memcmp(header, MAGIC, 8) == 0 &&
+           std::memcmp(header + 8, &version, 8) == 0;
+   }
+
+   if (ok) {
+      size_ = (size_t)st.st_size;
+      auto ptr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (ptr != MAP_FAILED) {
+         data_ = (const uint8_t*)ptr;
+         valid_end_ = scan(data_, HEADER_SIZE, size_,
+                      [&](string_view key, string_view val) {
+                         index_.emplace(key, val);
+                      });
+      }
+      else {
+         size_ = 0;
+         ok = false;
+      }
+   }
+
+   flock(fd_, LOCK_UN);
+   if (!ok) {
+      ::close(fd_);
+      fd_ = -1;
+   }
+   return ok;
+}
+
+
+void LiftCache::close() {
+   flush();
+   if (data_ != nullptr)
+      munmap((void*)data_, size_);
+   if (fd_ >= 0)
+      ::close(fd_);
+   fd_ = -1;
+   data_ = nullptr;
+   size_ = 0;
+   valid_end_ = 0;
+   index_.clear();
+   owned_.clear();
+   pending_.clear();
+}
+
+
+bool LiftCache::find(const string& itc, string& rtl) {
+   if (fd_ < 0)
+      return false;
+   auto it = index_.find(normalize(itc));
+   if (it == index_.end())
+      return false;
+   rtl.assign(it->second);
+   return true;
+}
+
+
+void LiftCache::insert(const string& itc, const string& rtl) {
+   if (fd_ < 0)
+      return;
+   auto& key = normalize(itc);
+   if (key.empty() || index_.contains(key))
+      return;
+   string_view k = owned_.emplace_back(key);
+   string_view v = owned_.emplace_back(rtl);
+   index_.emplace(k, v);
+   pending_.push_back({k, v});
+}
+
+
+void LiftCache::flush() {
+   if (fd_ < 0 || pending_.empty())
+      return;
+
+   string buf;
+   for (auto [key, val]: pending_) {
+      uint32_t klen = (uint32_t)key.size();
+      uint32_t vlen = (uint32_t)val.size();
+      uint64_t sum = checksum(key, val);
+      buf.append((const char*)&klen, 4);
+      buf.append((const char*)&vlen, 4);
+      buf.append((const char*)&sum, 8);
+      buf.append(key);
+      buf.append(val);
+   }
+   pending_.clear();
+
+   flock(fd_, LOCK_EX);
+   struct stat st;
+   if (fstat(fd_, &st) == 0) {
+      /* records appended by other processes since the last look are kept, */
+      /* a torn tail can only come from a crashed writer and is dropped    */
+      auto end = valid_end_;
+      auto file_size = (size_t)st.st_size;
+      bool ok = true;
+      if (file_size > end) {
+         vector<uint8_t> tail(file_size - end);
+         ok = read_all(fd_, tail.data(), tail.size(), end);
+         if (ok)
+            end += scan(tail.data(), 0, tail.size(), nullptr);
+      }
+      if (ok && (file_size == end || ftruncate(fd_, (off_t)end) == 0)) {
+         if (write_all(fd_, buf.data(), buf.size(), end))
+            end += buf.size();
+         valid_end_ = end;
+      }
+   }
+   flock(fd_, LOCK_UN);
+}
+
+
+uint64_t LiftCache::version(const string& f_auto) {
+   std::ifstream f(f_auto, std::ios::binary);
+   if (!f)
+      return 0;
+   vector<char> buf(1 << 20);
+   uint64_t h = fnv1a(MAGIC, 8);
+   while (f.read(buf.data(), buf.size()) || f.gcount() > 0)
+      h = fnv1a(buf.data(), (size_t)f.gcount(), h);
+   return h;
+}
+
+
+/* same instruction text modulo whitespace */
+const string& LiftCache::normalize(const string& itc) {
+   key_.clear();
+   bool space = false;
+   for (auto c: itc) {
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+         space = !key_.empty();
+      else {
+         if (space)
+            key_ += ' ';
+         key_ += c;
+         space = false;
+      }
+   }
+   return key_;
+}
@@ -0,0 +1,214 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/lift_template.h"
+
+using std::string;
+using std::vector;
+using namespace SBA;
+
+
+static bool ident(char c) {
+   return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9') || c == '.' || c == '_' || c == '@';
+}
+
+
+static int hex_digit(char c) {
+   if (c >= '0' && c <= '9') return c - '0';
+   if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+   if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+   return -1;
+}
+
+
+/* parse a decimal or 0x-prefixed literal at s[i], returns its end or i if */
+/* it is not a standalone literal that fits in 64 bits                     */
+static size_t number(const string& s, size_t i, uint64_t& val) {
+   auto j = i;
+   val = 0;
+   if (s[j] == '0' && j + 2 < s.length() && (s[j+1] == 'x' || s[j+1] == 'X')
+   && hex_digit(s[j+2]) >= 0) {
+      for (j += 2; j < s.length() && hex_digit(s[j]) >= 0; ++j)
+         val = (val << 4) | (uint64_t)hex_digit(s[j]);
+      if (j - i > 18)
+         return i;
+   }
+   else {
+      for (; j < s.length() && s[j] >= '0' && s[j] <= '9'; ++j)
+         val = val * 10 + (uint64_t)(s[j] - '0');
+      if (j - i > 19)
+         return i;
+   }
+   return (j < s.length() && ident(s[j]))? i: j;
+}
+
+
+static int64_t apply(uint64_t val, uint8_t width, uint8_t fn) {
+   switch (fn) {
+      case 0:
+         return (int64_t)val;
+      case 1:
+         return (int64_t)(0 - val);
+      default:
+         return width == 64? (int64_t)val:
+                (int64_t)(val << (64 - width)) >> (64 - width);
+   }
+}
+/* -------------------------------------------------------------------------- */
+
+
+bool TemplateLifter::find(const string& itc, string& rtl) {
+   if (!abstract(itc))
+      return false;
+   auto it = templates_.find(key_);
+   if (it == templates_.end() || it->second.state != STATE::READY)
+      return false;
+   ++hits_;
+   rtl = instantiate(it->second);
+   return true;
+}
+
+
+void TemplateLifter::learn(const string& itc, const string& rtl) {
+   if (!abstract(itc))
+      return;
+   ++misses_;
+   auto& t = templates_[key_];
+   switch (t.state) {
+      case STATE::BUILD:
+         if (!rtl.empty() && build(t, rtl)) {
+            t.state = STATE::VALIDATE;
+            t.count = 0;
+            t.seen = vals_;
+         }
+         else if (++t.count >= ATTEMPTS)
+            t.state = STATE::BAD;
+         break;
+      case STATE::VALIDATE:
+         if (!rtl.empty() && rtl == instantiate(t)) {
+            /* a repeated hole value proves nothing about that hole */
+            if (fresh(t)) {
+               t.seen.insert(t.seen.end(), vals_.begin(), vals_.end());
+               if (++t.count >= VALIDATIONS) {
+                  t.state = STATE::READY;
+                  t.seen.clear();
+               }
+            }
+         }
+         else {
+            t.state = STATE::BAD;
+            t.pieces.clear();
+            t.seen.clear();
+         }
+         break;
+      default:
+         break;
+   }
+}
+
+
+/* replace the literals of itc (except 0, 1 and register indices) by holes */
+bool TemplateLifter::abstract(const string& itc) {
+   key_.clear();
+   vals_.clear();
+   widths_.clear();
+   for (size_t i = 0; i < itc.length();) {
+      auto c = itc[i];
+      if (c < '0' || c > '9' || (i > 0 && (ident(itc[i-1]) || itc[i-1] == '('))) {
+         key_ += c;
+         ++i;
+         continue;
+      }
+      uint64_t val;
+      auto j = number(itc, i, val);
+      if (j == i || val <= 1) {
+         for (j = (j == i? i + 1: j); i < j; ++i)
+            key_ += itc[i];
+         continue;
+      }
+      uint8_t width = val < 0x100? 8: val < 0x10000? 16: val < 0x100000000? 32: 64;
+      key_ += '#';
+      key_ += (char)('0' + width / 8);
+      key_ += ((val >> (width - 1)) & 1)? 's': 'u';
+      vals_.push_back(val);
+      widths_.push_back(width);
+      i = j;
+   }
+   return !vals_.empty();
+}
+
+
+/* map the integers of rtl to the holes, false if one is ambiguous */
+bool TemplateLifter::build(Template& t, const string& rtl) const {
+   t.pieces.clear();
+   string text;
+   for (size_t i = 0; i < rtl.length();) {
+      auto c = rtl[i];
+      auto neg = (c == '-' && i + 1 < rtl.length() && rtl[i+1] >= '0' &&
+                  rtl[i+1] <= '9');
+      if ((!neg && (c < '0' || c > '9')) || (i > 0 && ident(rtl[i-1]))) {
+         text += c;
+         ++i;
+         continue;
+      }
+
+      uint64_t val;
+      auto begin = neg? i + 1: i;
+      auto j = number(rtl, begin, val);
+      if (j == begin) {
+         text += c;
+         ++i;
+         continue;
+      }
+      auto r = (int64_t)(neg? 0 - val: val);
+
+      Piece p;
+      for (size_t h = 0; h < vals_.size(); ++h)
+         for (uint8_t fn = 0; fn <= 2; ++fn)
+            if (apply(vals_[h], widths_[h], fn) == r) {
+               if (p.hole >= 0 && p.hole != (int16_t)h)
+                  return false;
+               if (p.hole < 0) {
+                  p.hole = (int16_t)h;
+                  p.fn = fn;
+               }
+               break;
+            }
+
+      if (p.hole < 0)
+         text.append(rtl, i, j - i);
+      else {
+         p.text = std::move(text);
+         t.pieces.push_back(std::move(p));
+         text.clear();
+      }
+      i = j;
+   }
+   t.pieces.push_back({std::move(text), -1, 0});
+   return true;
+}
+
+
+/* true if every hole of the current instance has a value not seen in it */
+bool TemplateLifter::fresh(const Template& t) const {
+   for (size_t k = 0; k < t.seen.size(); ++k)
+      if (t.seen[k] == vals_[k % vals_.size()])
+         return false;
+   return true;
+}
+
+
+string TemplateLifter::instantiate(const Template& t) const {
+   string rtl;
+   for (auto const& p: t.pieces) {
+      rtl += p.text;
+      if (p.hole >= 0)
+         rtl += std::to_string(apply(vals_[p.hole], widths_[p.hole], p.fn));
+   }
+   return rtl;
+}
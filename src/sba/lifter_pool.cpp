@@ -0,0 +1,163 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/lifter_pool.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+using std::string;
+using std::vector;
+using namespace SBA;
+
+/* message: count[4] size[8] (len[4] bytes)* */
+static constexpr size_t MSG_HEADER_SIZE = 12;
+
+
+static bool write_all(int fd, const void* data, size_t size) {
+   auto p = (const uint8_t*)data;
+   while (size > 0) {
+      auto n = ::send(fd, p, size, MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return false;
+      p += n;
+      size -= (size_t)n;
+   }
+   return true;
+}
+
+
+static bool read_all(int fd, void* data, size_t size) {
+   auto p = (uint8_t*)data;
+   while (size > 0) {
+      auto n = ::read(fd, p, size);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return false;
+      p += n;
+      size -= (size_t)n;
+   }
+   return true;
+}
+
+
+static void pack(string& msg, const string& item) {
+   uint32_t len = (uint32_t)item.size();
+   msg.append((const char*)&len, 4);
+   msg.append(item);
+}
+
+
+static bool write_msg(int fd, string& msg, uint32_t count) {
+   uint64_t size = msg.size() - MSG_HEADER_SIZE;
+   std::memcpy(msg.data(), &count, 4);
+   std::memcpy(msg.data() + 4, &size, 8);
+   return write_all(fd, msg.data(), msg.size());
+}
+
+
+static bool read_msg(int fd, vector<string>& items) {
+   uint8_t header[MSG_HEADER_SIZE];
+   if (!read_all(fd, header, MSG_HEADER_SIZE))
+      return false;
+   uint32_t count;
+   uint64_t size;
+   std::memcpy(&count, header, 4);
+   std::memcpy(&size, header + 4, 8);
+   string payload(size, '\0');
+   if (!read_all(fd, payload.data(), size))
+      return false;
+
+   items.clear();
+   items.reserve(count);
+   size_t pos = 0;
+   for (uint32_t i = 0; i < count; ++i) {
+      uint32_t len;
+      if (size - pos < 4)
+         return false;
+      std::memcpy(&len, payload.data() + pos, 4);
+      pos += 4;
+      if (size - pos < len)
+         return false;
+      items.emplace_back(payload, pos, len);
+      pos += len;
+   }
+   return pos == size;
+}
+
+
+[[noreturn]] static void serve(int fd, const LifterPool::Lift& lift) {
+   vector<string> itcs;
+   string msg;
+   while (read_msg(fd, itcs)) {
+      msg.assign(MSG_HEADER_SIZE, '\0');
+      for (auto const& itc: itcs)
+         pack(msg, lift(itc));
+      if (!write_msg(fd, msg, (uint32_t)itcs.size()))
+         break;
+   }
+   _exit(0);
+}
+/* -------------------------------------------------------------------------- */
+
+
+LifterPool::~LifterPool() {
+   stop();
+}
+
+
+size_t LifterPool::start(size_t n, const Lift& lift) {
+   stop();
+   for (size_t i = 0; i < n; ++i) {
+      int fds[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+         break;
+      auto pid = fork();
+      if (pid < 0) {
+         close(fds[0]);
+         close(fds[1]);
+         break;
+      }
+      if (pid == 0) {
+         /* earlier workers must see EOF once the parent lets them go */
+         for (auto const& w: workers_)
+            close(w.fd);
+         close(fds[0]);
+         serve(fds[1], lift);
+      }
+      close(fds[1]);
+      workers_.push_back({pid, fds[0]});
+   }
+   return workers_.size();
+}
+
+
+void LifterPool::stop() {
+   for (auto const& w: workers_)
+      close(w.fd);
+   for (auto const& w: workers_)
+      while (waitpid(w.pid, nullptr, 0) < 0 && errno == EINTR);
+   workers_.clear();
+}
+
+
+bool LifterPool::send(size_t w, const vector<const string*>& itcs) {
+   string msg(MSG_HEADER_SIZE, '\0');
+   for (auto itc: itcs)
+      pack(msg, *itc);
+   return write_msg(workers_[w].fd, msg, (uint32_t)itcs.size());
+}
+
+
+bool LifterPool::receive(size_t w, vector<string>& rtls) {
+   return read_msg(workers_[w].fd, rtls);
+}
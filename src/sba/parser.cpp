@@ -9,112 +9,167 @@
 #include "../../include/sba/expr.h"
 #include "../../include/sba/common.h"
 #include "../../include/sba/parser.h"
+#include "../../include/sba/perfect_hash.h"
 
 using namespace SBA;
 /* -------------------------------------------------------------------------- */
-static vector<RTL*> pre;
-static vector<RTL*> post;
-static RTL* process_rtl(const string& s);
+/* Single pass over the RTL text: every node is parsed where it starts, atoms */
+/* are views into the line and only become objects when they are needed.     */
 /* -------------------------------------------------------------------------- */
-static string extract_opcode(const string& s) {
-   /* (a) no space: "simple_return", "43", "UNSPEC_NTPOFF" --> NoType */
-   /* (b) have space: "(mem :DI (reg :DI ax))" --> "mem"              */
-   auto p = s.find(' ');
-   return (p == string::npos)? s: s.substr(1, p-1);
+using std::string_view;
+static thread_local vector<RTL*> pre;
+static thread_local vector<RTL*> post;
+struct Operand {
+   string_view op;      /* opcode of a node, or the atom itself */
+   RTL* rtl;            /* nullptr for an atom not built yet    */
+};
+static RTL* process_rtl(string_view s, size_t& pos, string_view& op);
+/* -------------------------------------------------------------------------- */
+/* opcodes resolved through a compile-time perfect hash, names in enum order */
+enum class OPCODE: uint8_t {
+   PARALLEL, SET, CALL, CLOBBER, SIMPLE_RETURN, TRAP_IF, HALT, NOP,
+   UNSPEC, UNSPEC_VOLATILE, REG, CONST_INT, CONST_DOUBLE, MEM, SUBREG,
+   IF_THEN_ELSE, PRE_DEC, POST_DEC, PRE_INC, POST_INC, PRE_MODIFY,
+   POST_MODIFY, NEG, NOT, ABS, SQRT, CLZ, CTZ, BSWAP, PLUS, MINUS, MULT,
+   DIV, UDIV, MOD, UMOD, AND, IOR, XOR, ASHIFT, ASHIFTRT, LSHIFTRT, ROTATE,
+   ROTATERT, COMPARE, EQ, NE, GT, GTU, GE, GEU, LT, LTU, LE, LEU, UNLE,
+   UNLT, UNEQ, LTGT, ORDERED, UNORDERED, ZERO_EXTRACT, SIGN_EXTRACT,
+   TRUNCATE, SSTRUNCATE, USTRUNCATE, FLOAT, UNSIGNED_FLOAT, FIX,
+   UNSIGNED_FIX, ZERO_EXTEND, SIGN_EXTEND, FLOAT_EXTEND, STRICT_LOW_PART,
+   UNKNOWN
+};
+static constexpr PerfectHash opcodes(std::array<string_view,74>{
+   "parallel", "set", "call", "clobber", "simple_return", "trap_if", "halt",
+   "nop", "unspec", "unspec_volatile", "reg", "const_int", "const_double",
+   "mem", "subreg", "if_then_else", "pre_dec", "post_dec", "pre_inc",
+   "post_inc", "pre_modify", "post_modify", "neg", "not", "abs", "sqrt",
+   "clz", "ctz", "bswap", "plus", "minus", "mult", "div", "udiv", "mod",
+   "umod", "and", "ior", "xor", "ashift", "ashiftrt", "lshiftrt", "rotate",
+   "rotatert", "compare", "eq", "ne", "gt", "gtu", "ge", "geu", "lt", "ltu",
+   "le", "leu", "unle", "unlt", "uneq", "ltgt", "ordered", "unordered",
+   "zero_extract", "sign_extract", "truncate", "sstruncate", "ustruncate",
+   "float", "unsigned_float", "fix", "unsigned_fix", "zero_extend",
+   "sign_extend", "float_extend", "strict_low_part"
+});
+static constexpr PerfectHash modes(Expr::MODE_STR);
+
+
+static OPCODE opcode(string_view s) {
+   auto i = opcodes.find(s);
+   return i < 0? OPCODE::UNKNOWN: (OPCODE)i;
 }
 
 
-static pair<IMM,Expr::EXPR_MODE> extract_mode(const string& s) {
+static string_view extract_token(string_view s, size_t& pos) {
+   /* "ax)", "43 ", "simple_return" --> up to the next ' ' or ')' */
+   auto start = pos;
+   while (pos < s.length() && s[pos] != ' ' && s[pos] != ')')
+      ++pos;
+   return s.substr(start, pos - start);
+}
+
+
+static pair<IMM,Expr::EXPR_MODE> extract_mode(string_view s, size_t& pos) {
    /* (a) "(mem :SI (reg :DI ax))" --> ":SI" */
    /* (b) "(set (..) (..)" --> ""            */
-   auto mode_str = string("");
-   auto p1 = s.find(' ') + 1;
-   if (s.at(p1) == ':') {
-      auto p2 = s.find(' ', p1);
-      mode_str = s.substr(p1, p2-p1);
+   if (pos + 1 < s.length() && s[pos] == ' ' && s[pos+1] == ':') {
+      auto p = pos + 1;
+      auto mode_str = extract_token(s, p);
+      if (p < s.length() && s[p] == ' ') {
+         auto i = modes.find(mode_str);
+         if (i >= 0 && i < (int)Expr::EXPR_MODE::NONE) {
+            pos = p;
+            return {(IMM)(Expr::MODE_SZ[i]), (Expr::EXPR_MODE)i};
+         }
+      }
    }
-
-   for (int i = 0; i < 42; ++i)
-      if (mode_str.compare(Expr::MODE_STR[i]) == 0)
-         return {(IMM)(Expr::MODE_SZ[i]), (Expr::EXPR_MODE)i};
    return {0, Expr::EXPR_MODE::NONE};
 }
 
 
-static vector<RTL*> extract_operands(const string& op, Expr::EXPR_MODE mode,
-const string& str) {
-   vector<RTL*> res;
-   size_t p1, p2, t1, t2;
+/* (a) no space: "simple_return", "43", "UNSPEC_NTPOFF" */
+static RTL* process_atom(string_view s) {
+   switch (opcode(s)) {
+      case OPCODE::PARALLEL:
+         return new Parallel(vector<Statement*>{});
+      case OPCODE::SET:
+      case OPCODE::CALL:
+      case OPCODE::CLOBBER:
+         return nullptr;
+      case OPCODE::SIMPLE_RETURN:
+         return new Exit(Exit::EXIT_TYPE::RET);
+      case OPCODE::TRAP_IF:
+      case OPCODE::HALT:
+         return new Exit(Exit::EXIT_TYPE::HALT);
+      case OPCODE::NOP:
+         return new Nop();
+      default:
+         return new NoType(string(s));
+   }
+}
 
-   string s = str;
-   /* s has no space --> no operand */
-   if (s.find(' ') == string::npos)
-      return res;
 
-   /* (parallel ([] X Y Z)) --> (parallel X Y Z) */
-   if (op.compare("parallel") == 0) {
-      s.erase(10, 4);
-      s.erase(s.length()-1, 1);
-   }
+static void delete_operands(const vector<Operand>& operands) {
+   for (auto const& x: operands)
+      if (x.rtl != nullptr && x.rtl->rtl_type() == RTL::RTL_TYPE::EXPR)
+         Expr::release((Expr*)(x.rtl));
+      else
+         delete x.rtl;
+}
 
-   /* skip opcode and mode */
-   p1 = s.find(' ') + 1;
-   if (mode != Expr::EXPR_MODE::NONE)
-      p1 = s.find(' ', p1) + 1;
-
-   /* parse operands */
-   while (true) {
-      /* " GeneralType " or " GeneralType)" */
-      /*   | <- p1            | <- p1       */
-      if (s[p1] != '(') {
-         t1 = s.find(' ', p1+1);
-         t2 = s.find(')', p1+1);
-         res.push_back(process_rtl(s.substr(p1, std::min(t1,t2) - p1)));
-         if (t2 < t1)
-            break;
-         else
-            p1 = t1 + 1;
+
+/* subtrees are interned, the root of an insn stays owned by the insn */
+static RTL* share(RTL* rtl) {
+   #if ENABLE_SHARED_EXPR
+      if (rtl->rtl_type() == RTL::RTL_TYPE::EXPR)
+         return Expr::intern((Expr*)rtl);
+   #endif
+   return rtl;
+}
+
+
+/* a shared node can be referenced twice, any other node is copied */
+static Expr* copy(Expr* e) {
+   return e->shared()? e: e->clone();
+}
+
+
+static bool extract_operands(string_view s, size_t& pos, vector<Operand>&
+operands) {
+   /* " X Y Z)" --> X, Y, Z */
+   size_t open = 0;
+   while (pos < s.length() && s[pos] == ' ') {
+      ++pos;
+      string_view op;
+      if (pos < s.length() && s[pos] != '(') {
+         op = extract_token(s, pos);
+         open += std::count(op.begin(), op.end(), '(');
+         operands.push_back({op, nullptr});
       }
-      /* " (...) "  */
-      /*   | <- p1  */
       else {
-         p2 = p1;
-         int count = 1;
-         while (p2 != string::npos) {
-            t1 = s.find('(', p2+1);
-            t2 = s.find(')', p2+1);
-            if (t1 < t2) {
-               p2 = t1;
-               ++count;
-            }
-            else {
-               p2 = t2;
-               --count;
-               if (count == 0) {
-                  res.push_back(process_rtl(s.substr(p1, p2-p1+1)));
-                  break;
-               }
-            }
-         }
-         /* " (...))"              */
-         /*     | | <- p2          */
-         /*     | <-- last operand */
-         if (p2 == s.length()-2)
-            break;
-         /* " (...) ..."           */
-         /*       | <- p2          */
-         else
-            p1 = p2 + 2;
+         auto rtl = process_rtl(s, pos, op);
+         if (rtl == nullptr)
+            return false;
+         operands.push_back({op, share(rtl)});
       }
    }
-
-   return res;
+   /* " [(const_int 0)] 7)": operands stop at the first ')' after an atom, */
+   /* the node still ends at the ')' matching its own '('                  */
+   for (; pos < s.length() && (open > 0 || s[pos] != ')'); ++pos)
+      if (s[pos] == '(')
+         ++open;
+      else if (s[pos] == ')')
+         --open;
+   if (pos >= s.length())
+      return false;
+   ++pos;
+   return true;
 }
 
 
 static void delete_elem(const vector<Expr*>& elem) {
    for (auto e: elem)
-      delete e;
+      Expr::release(e);
 }
 
 
@@ -128,253 +183,257 @@ static void delete_elem(const vector<Expr*>& elem) {
 }
 
 
-static RTL* process_rtl(const string& s) {
+static RTL* process_rtl(string_view s, size_t& pos, string_view& op) {
    /* (0) unlifted RTL */
-   if (s.empty())
+   if (pos >= s.length())
       return nullptr;
+   if (s[pos] != '(') {
+      op = extract_token(s, pos);
+      return process_atom(op);
+   }
 
-   auto op = extract_opcode(s);
-   auto [sz, mode] = extract_mode(s);
-   vector<Expr*> elem;
-   for (auto e: extract_operands(op, mode ,s))
-      elem.push_back((Expr*)e);
+   /* (b) have space: "(mem :DI (reg :DI ax))" --> "mem", ":DI", operands */
+   auto start = pos++;
+   op = extract_token(s, pos);
+   auto code = opcode(op);
+   auto [sz, mode] = extract_mode(s, pos);
+   vector<Operand> operands;
+   /* (parallel ([] X Y Z)) --> (parallel X Y Z) */
+   auto wrapped = (code == OPCODE::PARALLEL && s.substr(pos, 5) == " ([] ");
+   if (wrapped)
+      pos += 4;
+   if (!extract_operands(s, pos, operands) ||
+   (wrapped && (pos >= s.length() || s[pos++] != ')'))) {
+      delete_operands(operands);
+      return nullptr;
+   }
+
+   /* var and const directly from the atom, no intermediate object */
+   if (code == OPCODE::REG || code == OPCODE::CONST_INT) {
+      if (operands.size() != 1 || operands[0].rtl != nullptr ||
+      operands[0].op.empty()) {
+         delete_operands(operands);
+         return nullptr;
+      }
+      auto x = operands[0].op;
+      if (code == OPCODE::REG) {
+         auto r = SYSTEM::to_reg(x);
+         return r == SYSTEM::Reg::UNKNOWN? nullptr: new Reg(mode, r);
+      }
+      size_t i = (x[0] != '-'? 0: 1);
+      i = x.substr(0,2) != "0x"? i: i + 2;
+      if (i >= x.length())
+         return nullptr;
+      for (; i<x.length(); ++i)
+         if (x[i] < '0' || x[i] > '9')
+            return nullptr;
+      return new Const(Util::to_int(string(x)));
+   }
 
    /* if any operand is faulty, it is faulty */
-   for (auto e: elem)
-      if (e == nullptr) {
-         delete_elem(elem);
+   vector<Expr*> elem;
+   elem.reserve(operands.size());
+   for (auto& x: operands) {
+      if (x.rtl == nullptr)
+         x.rtl = process_atom(x.op);
+      if (x.rtl == nullptr) {
+         delete_operands(operands);
          return nullptr;
       }
+   }
+   for (auto const& x: operands)
+      elem.push_back((Expr*)(x.rtl));
 
-   /* (1) statements */
-   {
-      if (op.compare("parallel") == 0) {
+   switch (code) {
+      /* (1) statements */
+      case OPCODE::PARALLEL: {
          vector<Statement*> vec;
-         for (auto e: elem) {
-            auto str = extract_opcode(e->to_string());
-            if (str.compare("unspec")==0 || str.compare("unspec_volatile")==0) {
-               delete e;
+         for (size_t i = 0; i < elem.size(); ++i) {
+            auto x = opcode(operands[i].op);
+            if (x == OPCODE::UNSPEC || x == OPCODE::UNSPEC_VOLATILE) {
+               Expr::release(elem[i]);
                vec.push_back(new Nop());
             }
             else
-               vec.push_back((Statement*)e);
+               vec.push_back((Statement*)(elem[i]));
          }
          return new Parallel(vec);
       }
-      else if (op.compare("set") == 0)
+      case OPCODE::SET:
          RETURN_RTL(2, new Assign(elem[0], elem[1]))
-      else if (op.compare("call") == 0)
+      case OPCODE::CALL:
          RETURN_RTL(1, new Call((Mem*)(elem[0])))
-      else if (op.compare("clobber") == 0)
+      case OPCODE::CLOBBER:
          RETURN_RTL(1, new Clobber(elem[0]))
-      else if (op.compare("simple_return") == 0)
+      case OPCODE::SIMPLE_RETURN:
          return new Exit(Exit::EXIT_TYPE::RET);
-      else if (op.compare("trap_if") == 0 || op.compare("halt") == 0)
+      case OPCODE::TRAP_IF:
+      case OPCODE::HALT:
          return new Exit(Exit::EXIT_TYPE::HALT);
-      else if (op.compare("nop") == 0)
+      case OPCODE::NOP:
          return new Nop();
-   }
-
-   if (s.find(' ') == string::npos)
-      return new NoType(s);
 
-   /* (2) embedded side-effect --> wrapped in a sequence */
-   {
-      Expr* src = nullptr;
-      /* (pre_dec:DI (reg:DI ax)) --> src = ax-8 */
-      if (op.find("_dec") != string::npos) {
-         if (elem.size() != 1) {
+      /* (2) embedded side-effect --> wrapped in a sequence */
+      case OPCODE::PRE_DEC:
+      case OPCODE::POST_DEC:
+      case OPCODE::PRE_INC:
+      case OPCODE::POST_INC:
+      case OPCODE::PRE_MODIFY:
+      case OPCODE::POST_MODIFY: {
+         Expr* src = nullptr;
+         /* (pre_dec:DI (reg:DI ax)) --> src = ax-8 */
+         /* (pre_inc:DI (reg:DI ax)) --> src = ax+8 */
+         /* (pre_modify:DI (reg:DI ax) (reg:DI bx)) --> src = bx */
+         auto modify = (code == OPCODE::PRE_MODIFY ||
+                        code == OPCODE::POST_MODIFY);
+         if (elem.size() != (modify? 2: 1)) {
             delete_elem(elem);
             return nullptr;
          }
-         else
-            src = new Binary(Binary::OP::PLUS,mode,elem[0]->clone(),new Const(-sz));
-      }
-      /* (pre_inc:DI (reg:DI ax)) --> src = ax+8 */
-      else if (op.find("_inc") != string::npos) {
-         if (elem.size() != 1) {
-            delete_elem(elem);
-            return nullptr;
-         }
-         else
-            src = new Binary(Binary::OP::PLUS,mode,elem[0]->clone(),new Const(sz));
-      }
-      /* (pre_modify:DI (reg:DI ax) (reg:DI bx)) --> src = bx */
-      else if (op.find("_modify") != string::npos) {
-         if (elem.size() != 2) {
-            delete_elem(elem);
-            return nullptr;
+         else if (modify)
+            src = elem[1];
+         else {
+            auto dec = (code == OPCODE::PRE_DEC || code == OPCODE::POST_DEC);
+            src = new Binary(Binary::OP::PLUS, mode, copy(elem[0]),
+                             new Const(dec? -sz: sz));
          }
+         RTL* stmt = new Assign(copy(elem[0]), src);
+         if (code == OPCODE::PRE_DEC || code == OPCODE::PRE_INC ||
+         code == OPCODE::PRE_MODIFY)
+            pre.push_back(stmt);
          else
-            src = elem[1];
-      }
-      if (src !=nullptr) {
-         RTL* stmt = new Assign(elem[0]->clone(), src);
-         if (op.find("pre") != string::npos) pre.push_back(stmt);
-         else post.push_back(stmt);
+            post.push_back(stmt);
          return elem[0];
       }
-   }
 
-   /* (3) expression */
-   {
+      /* (3) expression */
       /* var */
-      if (op.compare("reg") == 0) {
-         if (elem.size() != 1) {
-            delete_elem(elem);
-            return nullptr;
-         }
-         else {
-            auto s = elem[0]->to_string();
-            if (SYSTEM::to_reg(s) == SYSTEM::Reg::UNKNOWN) {
-               delete_elem(elem);
-               return nullptr;
-            }
-            return new Reg(mode, elem[0]);
-         }
-      }
-      else if (op.compare("mem") == 0)
+      case OPCODE::MEM:
          RETURN_RTL(1, new Mem(mode, elem[0]))
-      else if (op.compare("subreg") == 0)
+      case OPCODE::SUBREG:
          RETURN_RTL(2, new SubReg(mode, elem[0], elem[1]))
       /* const */
-      else if (op.compare("const_int") == 0) {
-         if (elem.size() != 1) {
-            delete_elem(elem);
-            return nullptr;
-         }
-         else {
-            auto s = elem[0]->to_string();
-            size_t i = (s[0] != '-'? 0: 1);
-            i = s.substr(0,2).compare("0x") != 0? i: i + 2;
-            for (; i<s.length(); ++i)
-               if (s[i] < '0' || s[i] > '9') {
-                  delete_elem(elem);
-                  return nullptr;
-               }
-            return new Const(Const::CONST_TYPE::INTEGER, elem[0]);
-         }
-      }
-      else if (op.compare("const_double") == 0)
+      case OPCODE::CONST_DOUBLE:
          RETURN_RTL(1, new Const(Const::CONST_TYPE::DOUBLE, elem[0]))
       /* if_then_else */
-      else if (op.compare("if_then_else") == 0)
+      case OPCODE::IF_THEN_ELSE:
          RETURN_RTL(3, new IfElse(mode, (Compare*)(elem[0]), elem[1], elem[2]))
       /* unary */
-      else if (op.compare("neg") == 0)
+      case OPCODE::NEG:
          RETURN_RTL(1, new Unary(Unary::OP::NEG, mode, elem[0]))
-      else if (op.compare("not") == 0)
+      case OPCODE::NOT:
          RETURN_RTL(1, new Unary(Unary::OP::NOT, mode, elem[0]))
-      else if (op.compare("abs") == 0)
+      case OPCODE::ABS:
          RETURN_RTL(1, new Unary(Unary::OP::ABS, mode, elem[0]))
-      else if (op.compare("sqrt") == 0)
+      case OPCODE::SQRT:
          RETURN_RTL(1, new Unary(Unary::OP::SQRT, mode, elem[0]))
-      else if (op.compare("clz") == 0)
+      case OPCODE::CLZ:
          RETURN_RTL(1, new Unary(Unary::OP::CLZ, mode, elem[0]))
-      else if (op.compare("ctz") == 0)
+      case OPCODE::CTZ:
          RETURN_RTL(1, new Unary(Unary::OP::CTZ, mode, elem[0]))
-      else if (op.compare("bswap") == 0)
+      case OPCODE::BSWAP:
          RETURN_RTL(1, new Unary(Unary::OP::BSWAP, mode, elem[0]))
       /* binary */
-      else if (op.compare("plus") == 0)
+      case OPCODE::PLUS:
          RETURN_RTL(2, new Binary(Binary::OP::PLUS, mode, elem[0], elem[1]))
-      else if (op.compare("minus") == 0)
+      case OPCODE::MINUS:
          RETURN_RTL(2, new Binary(Binary::OP::MINUS, mode, elem[0], elem[1]))
-      else if (op.compare("mult") == 0)
+      case OPCODE::MULT:
          RETURN_RTL(2, new Binary(Binary::OP::MULT, mode, elem[0], elem[1]))
-      else if (op.compare("div") == 0)
+      case OPCODE::DIV:
          RETURN_RTL(2, new Binary(Binary::OP::DIV, mode, elem[0], elem[1]))
-      else if (op.compare("udiv") == 0)
+      case OPCODE::UDIV:
          RETURN_RTL(2, new Binary(Binary::OP::UDIV, mode, elem[0], elem[1]))
-      else if (op.compare("mod") == 0)
+      case OPCODE::MOD:
          RETURN_RTL(2, new Binary(Binary::OP::MOD, mode, elem[0], elem[1]))
-      else if (op.compare("umod") == 0)
+      case OPCODE::UMOD:
          RETURN_RTL(2, new Binary(Binary::OP::UMOD, mode, elem[0], elem[1]))
-      else if (op.compare("and") == 0)
+      case OPCODE::AND:
          RETURN_RTL(2, new Binary(Binary::OP::AND, mode, elem[0], elem[1]))
-      else if (op.compare("ior") == 0)
+      case OPCODE::IOR:
          RETURN_RTL(2, new Binary(Binary::OP::IOR, mode, elem[0], elem[1]))
-      else if (op.compare("xor") == 0)
+      case OPCODE::XOR:
          RETURN_RTL(2, new Binary(Binary::OP::XOR, mode, elem[0], elem[1]))
-      else if (op.compare("ashift") == 0)
+      case OPCODE::ASHIFT:
          RETURN_RTL(2, new Binary(Binary::OP::ASHIFT, mode, elem[0], elem[1]))
-      else if (op.compare("ashiftrt") == 0)
+      case OPCODE::ASHIFTRT:
          RETURN_RTL(2, new Binary(Binary::OP::ASHIFTRT, mode, elem[0], elem[1]))
-      else if (op.compare("lshiftrt") == 0)
+      case OPCODE::LSHIFTRT:
          RETURN_RTL(2, new Binary(Binary::OP::LSHIFTRT, mode, elem[0], elem[1]))
-      else if (op.compare("rotate") == 0)
+      case OPCODE::ROTATE:
          RETURN_RTL(2, new Binary(Binary::OP::ROTATE, mode, elem[0], elem[1]))
-      else if (op.compare("rotatert") == 0)
+      case OPCODE::ROTATERT:
          RETURN_RTL(2, new Binary(Binary::OP::ROTATERT, mode, elem[0], elem[1]))
-      else if (op.compare("compare") == 0)
+      case OPCODE::COMPARE:
          RETURN_RTL(2, new Binary(Binary::OP::COMPARE, mode, elem[0], elem[1]))
-      /* ternary */
       /* compare */
-      else if (op.compare("eq") == 0)
+      case OPCODE::EQ:
          RETURN_RTL(1, new Compare(Compare::OP::EQ, mode, elem[0]))
-      else if (op.compare("ne") == 0)
+      case OPCODE::NE:
          RETURN_RTL(1, new Compare(Compare::OP::NE, mode, elem[0]))
-      else if (op.compare("gt") == 0)
+      case OPCODE::GT:
          RETURN_RTL(1, new Compare(Compare::OP::GT, mode, elem[0]))
-      else if (op.compare("gtu") == 0)
+      case OPCODE::GTU:
          RETURN_RTL(1, new Compare(Compare::OP::GTU, mode, elem[0]))
-      else if (op.compare("ge") == 0)
+      case OPCODE::GE:
          RETURN_RTL(1, new Compare(Compare::OP::GE, mode, elem[0]))
-      else if (op.compare("geu") == 0)
+      case OPCODE::GEU:
          RETURN_RTL(1, new Compare(Compare::OP::GEU, mode, elem[0]))
-      else if (op.compare("lt") == 0)
+      case OPCODE::LT:
          RETURN_RTL(1, new Compare(Compare::OP::LT, mode, elem[0]))
-      else if (op.compare("ltu") == 0)
+      case OPCODE::LTU:
          RETURN_RTL(1, new Compare(Compare::OP::LTU, mode, elem[0]))
-      else if (op.compare("le") == 0)
+      case OPCODE::LE:
          RETURN_RTL(1, new Compare(Compare::OP::LE, mode, elem[0]))
-      else if (op.compare("leu") == 0)
+      case OPCODE::LEU:
          RETURN_RTL(1, new Compare(Compare::OP::LEU, mode, elem[0]))
-      else if (op.compare("unle") == 0)
+      case OPCODE::UNLE:
          RETURN_RTL(1, new Compare(Compare::OP::UNLE, mode, elem[0]))
-      else if (op.compare("unlt") == 0)
+      case OPCODE::UNLT:
          RETURN_RTL(1, new Compare(Compare::OP::UNLT, mode, elem[0]))
-      else if (op.compare("uneq") == 0)
+      case OPCODE::UNEQ:
          RETURN_RTL(1, new Compare(Compare::OP::UNEQ, mode, elem[0]))
-      else if (op.compare("ltgt") == 0)
+      case OPCODE::LTGT:
          RETURN_RTL(1, new Compare(Compare::OP::LTGT, mode, elem[0]))
-      else if (op.compare("ordered") == 0)
+      case OPCODE::ORDERED:
          RETURN_RTL(1, new Compare(Compare::OP::ORDERED, mode, elem[0]))
-      else if (op.compare("unordered") == 0)
+      case OPCODE::UNORDERED:
          RETURN_RTL(1, new Compare(Compare::OP::UNORDERED, mode, elem[0]))
       /* conversion */
-      else if (op.compare("zero_extract") == 0)
+      case OPCODE::ZERO_EXTRACT:
          RETURN_RTL(3, new Conversion(Conversion::OP::ZERO_EXTRACT, mode,
                                       elem[0], elem[1], elem[2]))
-      else if (op.compare("sign_extract") == 0)
+      case OPCODE::SIGN_EXTRACT:
          RETURN_RTL(3, new Conversion(Conversion::OP::SIGN_EXTRACT, mode,
                                       elem[0], elem[1], elem[2]))
-      else if (op.compare("truncate") == 0)
+      case OPCODE::TRUNCATE:
          RETURN_RTL(1, new Conversion(Conversion::OP::TRUNCATE, mode, elem[0]))
-      else if (op.compare("sstruncate") == 0)
+      case OPCODE::SSTRUNCATE:
          RETURN_RTL(1, new Conversion(Conversion::OP::STRUNCATE, mode, elem[0]))
-      else if (op.compare("ustruncate") == 0)
+      case OPCODE::USTRUNCATE:
          RETURN_RTL(1, new Conversion(Conversion::OP::UTRUNCATE, mode, elem[0]))
-      else if (op.compare("float") == 0)
+      case OPCODE::FLOAT:
          RETURN_RTL(1, new Conversion(Conversion::OP::SFLOAT, mode, elem[0]))
-      else if (op.compare("unsigned_float") == 0)
+      case OPCODE::UNSIGNED_FLOAT:
          RETURN_RTL(1, new Conversion(Conversion::OP::UFLOAT, mode, elem[0]))
-      else if (op.compare("fix") == 0)
+      case OPCODE::FIX:
          RETURN_RTL(1, new Conversion(Conversion::OP::FIX, mode, elem[0]))
-      else if (op.compare("unsigned_fix") == 0)
+      case OPCODE::UNSIGNED_FIX:
          RETURN_RTL(1, new Conversion(Conversion::OP::UFIX, mode, elem[0]))
-      else if (op.compare("zero_extend") == 0)
+      case OPCODE::ZERO_EXTEND:
          RETURN_RTL(1, new Conversion(Conversion::OP::ZERO_EXTEND, mode, elem[0]))
-      else if (op.compare("sign_extend") == 0)
+      case OPCODE::SIGN_EXTEND:
          RETURN_RTL(1, new Conversion(Conversion::OP::SIGN_EXTEND, mode, elem[0]))
-      else if (op.compare("float_extend") == 0)
+      case OPCODE::FLOAT_EXTEND:
          RETURN_RTL(1, new Conversion(Conversion::OP::FLOAT_EXTEND, mode, elem[0]))
-      else if (op.compare("strict_low_part") == 0)
+      case OPCODE::STRICT_LOW_PART:
          RETURN_RTL(1, new Conversion(Conversion::OP::STRICT_LOW_PART, mode, elem[0]))
+      default:
+         break;
    }
 
    /* (4) unspec, unspec_volatile, _ --> NoType */
-   return new NoType(s);
+   return new NoType(string(s.substr(start, pos - start)));
 }
 
 
@@ -394,7 +453,13 @@ RTL* Parser::process(const string& s) {
    post = vector<RTL*>{};
 
    if (supported(s)) {
-      auto rtl = process_rtl(s);
+      size_t pos = 0;
+      string_view op;
+      auto rtl = process_rtl(s, pos, op);
+      /* a lone (pre_dec (reg sp)) yields a shared node, insns own their root */
+      if (rtl != nullptr && rtl->rtl_type() == RTL::RTL_TYPE::EXPR &&
+      ((Expr*)rtl)->shared())
+         rtl = ((Expr*)rtl)->clone();
       if (rtl != nullptr) {
          if (!pre.empty() || !post.empty()) {
             vector<Statement*> vec;
@@ -8,35 +8,50 @@
 #include "../../include/sba/program.h"
 #include "../../include/sba/framework.h"
 #include "../../include/sba/function.h"
+#include "../../include/sba/scc.h"
 #include "../../include/sba/block.h"
 #include "../../include/sba/insn.h"
 #include "../../include/sba/rtl.h"
 #include "../../include/sba/expr.h"
 #include "../../include/sba/domain.h"
+#include "../../include/sba/scheduler.h"
+#include <numeric>
+#include <sstream>
 
 using namespace SBA;
 /* -------------------------------- Program --------------------------------- */
-Program::Program(const string& f_obj, const
+Program::Program(const string& f_obj, SYSTEM::Object&& info, const
 vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw, const
-vector<IMM>& fptr_list, const unordered_map<IMM,unordered_set<IMM>>& indirect_targets):
+vector<IMM>& fptr_list, const unordered_map<IMM,unordered_set<IMM>>& indirect_targets,
+Arena* arena):
 faulty(false),
 #if ENABLE_DETECT_UPDATED_FUNCTION
    update_num(0),
 #endif
-icfs_(indirect_targets), f_obj_(f_obj) {
-
-   SYSTEM::load(info_, f_obj_);
-   info_.insns = &i_map_;
-
-   sorted_insns_.reserve(offset_rtl_raw.size());
-   for (auto [offset, rtl, raw]: offset_rtl_raw) {
-      auto insn = new Insn(offset, rtl, raw);
-      i_map_[offset] = insn;
-      sorted_insns_.push_back(insn);
-   }
+arena_(arena != nullptr? arena: new Arena()), icfs_(indirect_targets),
+f_obj_(f_obj), info_(std::move(info)) {
+
+   Arena::Scope scope(arena_);
+   info_.insns = &i_index_;
+
+   /* insns are built on all cores, then indexed in address order */
+   sorted_insns_.resize(offset_rtl_raw.size());
+   Util::parallel_for(offset_rtl_raw.size(), LOAD_WORKERS, [&](size_t lo,
+   size_t hi) {
+      Arena::Scope scope(arena_);
+      for (auto i = lo; i < hi; ++i) {
+         auto const& [offset, rtl, raw] = offset_rtl_raw[i];
+         sorted_insns_[i] = new Insn(offset, rtl, raw);
+      }
+   });
+   vector<IMM> offsets(sorted_insns_.size());
+   for (size_t k = 0; k < sorted_insns_.size(); ++k)
+      offsets[k] = sorted_insns_[k]->offset();
+   i_index_.build(offsets);
+   b_head_.assign(sorted_insns_.size(), nullptr);
 
    for (auto [jump_loc, expr]: indirect_targets)
-      if (i_map_.contains(jump_loc))
+      if (i_index_.contains(jump_loc))
          recent_icfs_.push_back(jump_loc);
 
    fptrs(fptr_list);
@@ -46,18 +61,26 @@ icfs_(indirect_targets), f_obj_(f_obj) {
 
 
 Program::~Program() {
-   for (auto [offset, b]: b_map_)
+   for (auto [fptr, f]: f_cache_)
+      delete f;
+   for (auto b: b_head_)
       delete b;
-   for (auto [offset, i]: i_map_)
+   for (auto i: sorted_insns_)
       delete i;
+   delete arena_;
 }
 
 
 void Program::build_func(IMM entry, const unordered_map<IMM,unordered_set<IMM>>& icfs,
 const vector<IMM>& norets) {
-   for (auto [offset, b]: b_map_)
+   for (auto [fptr, f]: f_cache_)
+      delete f;
+   f_cache_.clear();
+   for (auto& b: b_head_) {
       delete b;
-   b_map_.clear();
+      b = nullptr;
+   }
+   blocks_.reset();
    recent_fptrs_ = vector<IMM>{entry};
    icfs_ = icfs;
    recent_norets_ = unordered_set<IMM>(norets.begin(), norets.end());
@@ -69,182 +92,278 @@ void Program::block_split(Insn* insn) {
    /* [         ][          ] */
    /*      b        b_next    */
    auto b = insn->parent;
-   auto it = std::find(b->insn_list().begin(), b->insn_list().end(), insn);
-   auto b_next = new Block(vector<Insn*>(it, b->insn_list().end()));
+   evict(b);
+   auto i_list = b->insn_list();
+   uint32_t k = 0;
+   while (i_list[k] != insn)
+      ++k;
+   vector<Insn*> tail;
+   for (auto j = k; j < i_list.size(); ++j)
+      tail.push_back(i_list[j]);
+   auto b_next = new (blocks_) Block(cfg_, tail);
    for (auto const& [v, c]: b->succ())
       b_next->succ(v, c);
-   b_map_[b_next->offset()] = b_next;
-   b->shrink_insn_list(it);
+   block(b_next);
+   b->shrink_insn_list(k);
    b->shrink_succ();
    b->succ(b_next, COMPARE::NONE);
 }
 
 
+void Program::block(Block* b) {
+   b_head_[i_index_.find(b->offset())] = b;
+}
+
+
 void Program::block_connect(Block* b, IMM target, COMPARE cond, bool fix_prefix) {
-   auto it = i_map_.find(target);
-   if (it != i_map_.end()) {
-      /* non-existed target, connect now */
-      if (it->second->parent == nullptr) {
-         block_dfs(it->second);
-         b->succ(it->second->parent, cond);
-      }
+   auto i = block_target(b, target, cond, fix_prefix);
+   if (i != nullptr) {
+      block_dfs(i);
+      b->succ(i->parent, cond);
+   }
+}
+
+
+/* connect b to target, or return the insn at target if no block holds it */
+Insn* Program::block_target(Block* b, IMM target, COMPARE cond, bool fix_prefix) {
+   evict(b);
+   auto i = insn(target);
+   if (i != nullptr) {
+      /* non-existed target, connect after block_dfs() */
+      if (i->parent == nullptr)
+         return i;
       /* existed target, connect now */
-      else if (it->second == it->second->parent->first())
-         b->succ(it->second->parent, cond);
+      else if (i == i->parent->first())
+         b->succ(i->parent, cond);
       /* split target, connect later */
       else
-         split_.push_back({b->last(), it->second, cond});
+         split_.push_back({b->last(), i, cond});
    }
    else if (fix_prefix && ENABLE_COMPATIBLE_INPUT) {
       LOG2("fix: suppose " << target << " is a lock-prefix instruction");
-      block_connect(b, target-1, cond);
+      return block_target(b, target-1, cond);
    }
    else
       b->faulty = true;
+   return nullptr;
 }
 
 
+/* targets of a block in the order they are connected */
+enum class TARGET: uint8_t {DIRECT, FALLTHROUGH, CALL, INDIRECT};
+struct DfsTarget {
+   IMM offset;
+   COMPARE cond;
+   TARGET type;
+};
+/* block whose targets from next to the end of dfs_targets are left;     */
+/* pending is the target being explored, connected once the frames above */
+/* it are done                                                           */
+struct DfsFrame {
+   Block* b;
+   size_t first;
+   size_t next;
+   Insn* pending;
+};
+/* shared by nested block_dfs(), the room is kept across calls */
+static thread_local vector<DfsTarget> dfs_targets;
+static thread_local vector<DfsFrame> dfs_frames;
+
+/* Blocks are explored depth-first on an explicit stack: a target in no    */
+/* block yet gets its block built before the next target of the same block */
+/* is connected, so blocks and edges come in the order of a recursive DFS  */
 void Program::block_dfs(Insn* i) {
-   vector<Insn*> i_list{i};
-   while (true) {
-      /* A. transfer */
-      if (i->transfer()) {
-         auto b_curr = new Block(i_list);
-         b_map_[b_curr->offset()] = b_curr;
-         i_list.clear();
-
-         /* direct targets */
-         Array<uint8_t,pair<IMM,COMPARE>,2> cft;
-         if (i->direct()) {
-            /* direct jump */
-            if (!i->call()) {
-               auto target = i->direct_target().first;
-               auto cond = i->cond_op().first;
-               block_connect(b_curr, target, cond, true);
-               if (b_curr->faulty) {
-                  LOG4("error: missing direct target " << target);
-                  #if ABORT_MISSING_DIRECT_TARGET
-                     faulty = true;
-                     return;
-                  #endif
-               }
-            }
-            /* fall-through */
-            if ((i->call() && !recent_norets_.contains(i->offset())) || i->cond_jump()) {
-               auto target = i->direct_target().second;
-               auto cond = i->cond_op().second;
-               block_connect(b_curr, target, cond);
-               if (b_curr->faulty) {
-                  LOG4("error: missing fall-through target " << target);
-                  #if ABORT_MISSING_FALLTHROUGH_TARGET
-                     faulty = true;
-                     return;
-                  #elif ENABLE_COMPATIBLE_INPUT
-                     if (i->call()) {
-                        i->replace(new Exit(Exit::EXIT_TYPE::HALT), SYSTEM::HLT_BYTES);
-                        LOG2("fix: mark " << i->offset() << " as a halt instruction");
-                        b_curr->faulty = false;
-                        b_curr->shrink_succ();
-                     }
-                  #endif
-               }
+   auto base = dfs_frames.size();
+
+   /* A. transfer: a frame for the targets, B. exit, C. non-control */
+   auto open = [&](Insn* i) {
+      vector<Insn*> i_list{i};
+      while (true) {
+         /* A. transfer */
+         if (i->transfer()) {
+            auto b_curr = new (blocks_) Block(cfg_, i_list);
+            block(b_curr);
+            auto first = dfs_targets.size();
+            /* direct targets */
+            if (i->direct()) {
+               /* direct jump */
+               if (!i->call())
+                  dfs_targets.push_back({i->direct_target().first,
+                                         i->cond_op().first, TARGET::DIRECT});
+               /* fall-through */
+               if ((i->call() && !recent_norets_.contains(i->offset()))
+               || i->cond_jump())
+                  dfs_targets.push_back({i->direct_target().second,
+                                   i->cond_op().second, TARGET::FALLTHROUGH});
             }
-         }
-         else {
-            if (i->call()) {
-               auto target = i->direct_target().first;
-               auto cond = i->cond_op().first;
-               block_connect(b_curr, target, cond);
-               if (b_curr->faulty) {
-                  LOG4("error: missing fall-through target " << target);
-                  #if ABORT_MISSING_FALLTHROUGH_TARGET
-                     faulty = true;
-                     return;
-                  #endif
-               }
+            else if (i->call())
+               dfs_targets.push_back({i->direct_target().first,
+                                      i->cond_op().first, TARGET::CALL});
+            /* indirect targets */
+            if (i->indirect() && i->jump()) {
+               auto it = icfs_.find(i->offset());
+               if (it != icfs_.end())
+                  for (auto t: it->second)
+                     dfs_targets.push_back({t, COMPARE::NONE,
+                                            TARGET::INDIRECT});
             }
+            dfs_frames.push_back({b_curr, first, first, nullptr});
+            return;
          }
 
-         /* indirect targets */
-         if (i->indirect() && i->jump()) {
-            auto it = icfs_.find(i->offset());
-            if (it != icfs_.end()) {
-               for (auto t: it->second) {
-                  block_connect(b_curr, t, COMPARE::NONE);
-                  if (b_curr->faulty) {
-                     LOG4("error: missing indirect target " << t);
-                     #if ABORT_MISSING_FALLTHROUGH_TARGET
-                        faulty = true;
-                        return;
-                     #endif
-                  }
-               }
-            }
+         /* B. exit */
+         else if (i->halt()) {
+            auto b_curr = new (blocks_) Block(cfg_, i_list);
+            block(b_curr);
+            return;
          }
 
-         return;
-      }
-
-      /* B. exit */
-      else if (i->halt()) {
-         auto b_curr = new Block(i_list);
-         b_map_[b_curr->offset()] = b_curr;
-         i_list.clear();
-         return;
-      }
-
-      /* C. non-control */
-      else {
-         auto it = i_map_.find(i->next_offset());
-         if (it != i_map_.end()) {
-            auto next = it->second;
-            if (next->parent != nullptr) {
-               auto b_curr = new Block(i_list);
-               b_map_[b_curr->offset()] = b_curr;
-               i_list.clear();
-               b_curr->succ(next->parent, COMPARE::NONE);
-               return;
+         /* C. non-control */
+         else {
+            auto next = insn(i->next_offset());
+            if (next != nullptr) {
+               if (next->parent != nullptr) {
+                  auto b_curr = new (blocks_) Block(cfg_, i_list);
+                  block(b_curr);
+                  b_curr->succ(next->parent, COMPARE::NONE);
+                  return;
+               }
+               else {
+                  i_list.push_back(next);
+                  i = next;
+               }
             }
             else {
-               i_list.push_back(next);
-               i = next;
+               #if ABORT_MISSING_NEXT_INSN
+                  faulty = true;
+                  LOG4("error: missing next instruction for " << i->offset());
+               #else
+                  auto b_curr = new (blocks_) Block(cfg_, i_list);
+                  block(b_curr);
+                  #if ENABLE_COMPATIBLE_INPUT
+                     auto object = new Exit(Exit::EXIT_TYPE::HALT);
+                     i->replace(object, SYSTEM::HLT_BYTES);
+                     LOG2("fix: mark " << i->offset() << " as a halt instruction");
+                     b_curr->shrink_succ();
+                  #else
+                     b_curr->faulty = true;
+                     LOG4("error: missing next instruction at " << i->offset());
+                  #endif
+               #endif
+               return;
             }
          }
-         else {
-            #if ABORT_MISSING_NEXT_INSN
+      }
+   };
+
+   /* after a target is connected, false to leave the rest of the block */
+   auto check = [&](Block* b, const DfsTarget& t) {
+      if (!b->faulty)
+         return true;
+      switch (t.type) {
+         case TARGET::DIRECT:
+            LOG4("error: missing direct target " << t.offset);
+            #if ABORT_MISSING_DIRECT_TARGET
                faulty = true;
-               LOG4("error: missing next instruction for " << i->offset());
-            #else
-               auto b_curr = new Block(i_list);
-               b_map_[b_curr->offset()] = b_curr;
-               #if ENABLE_COMPATIBLE_INPUT
-                  auto object = new Exit(Exit::EXIT_TYPE::HALT);
-                  i->replace(object, SYSTEM::HLT_BYTES);
+               return false;
+            #endif
+            break;
+         case TARGET::FALLTHROUGH:
+            LOG4("error: missing fall-through target " << t.offset);
+            #if ABORT_MISSING_FALLTHROUGH_TARGET
+               faulty = true;
+               return false;
+            #elif ENABLE_COMPATIBLE_INPUT
+               if (b->last()->call()) {
+                  auto i = b->last();
+                  i->replace(new Exit(Exit::EXIT_TYPE::HALT), SYSTEM::HLT_BYTES);
                   LOG2("fix: mark " << i->offset() << " as a halt instruction");
-                  b_curr->shrink_succ();
-               #else
-                  b_curr->faulty = true;
-                  LOG4("error: missing next instruction at " << i->offset());
-               #endif
+                  b->faulty = false;
+                  b->shrink_succ();
+               }
             #endif
-            return;
+            break;
+         case TARGET::CALL:
+            LOG4("error: missing fall-through target " << t.offset);
+            #if ABORT_MISSING_FALLTHROUGH_TARGET
+               faulty = true;
+               return false;
+            #endif
+            break;
+         case TARGET::INDIRECT:
+            LOG4("error: missing indirect target " << t.offset);
+            #if ABORT_MISSING_FALLTHROUGH_TARGET
+               faulty = true;
+               return false;
+            #endif
+            break;
+      }
+      return true;
+   };
+
+   auto close = [&]() {
+      dfs_targets.resize(dfs_frames.back().first);
+      dfs_frames.pop_back();
+   };
+
+   open(i);
+   while (dfs_frames.size() > base) {
+      auto& f = dfs_frames.back();
+      /* blocks reached from the pending target are done */
+      if (f.pending != nullptr) {
+         auto const& t = dfs_targets[f.next-1];
+         f.b->succ(f.pending->parent, t.cond);
+         f.pending = nullptr;
+         if (!check(f.b, t)) {
+            close();
+            continue;
          }
       }
+      if (f.next == dfs_targets.size()) {
+         close();
+         continue;
+      }
+      auto t = dfs_targets[f.next++];
+      auto x = block_target(f.b, t.offset, t.cond, t.type == TARGET::DIRECT);
+      if (x != nullptr) {
+         f.pending = x;
+         open(x);
+      }
+      else if (!check(f.b, t))
+         close();
    }
 }
 /* -------------------------------------------------------------------------- */
+/* cached function of fptr, built if absent; owned by the Program */
 Function* Program::func(IMM fptr) {
    checked_fptrs_.insert(fptr);
-   auto f = new Function(this, b_map_[fptr]);
+   auto it = f_cache_.find(fptr);
+   if (it != f_cache_.end())
+      return it->second;
+
+   for (auto b: reach(fptr))
+      evict(b);
+   auto f = new Function(this, block(fptr));
    if (f->faulty) {
       LOG2("function " << fptr << " is faulty!");
       delete f;
       return nullptr;
    }
+   f_cache_[fptr] = f;
    return f;
 }
 
 
+/* delete the cached function that owns b, which detaches its blocks */
+void Program::evict(Block* b) {
+   if (b->parent == nullptr)
+      return;
+   auto f = b->parent->func();
+   f_cache_.erase(f->offset());
+   delete f;
+}
+
+
 void Program::fptrs(const vector<IMM>& fptr_list) {
    recent_fptrs_ = fptr_list;
    fptrs_.insert(fptr_list.begin(), fptr_list.end());
@@ -252,47 +371,272 @@ void Program::fptrs(const vector<IMM>& fptr_list) {
    sorted_fptrs = vector<IMM>(fptrs_.begin(), fptrs_.end());
    std::sort(sorted_fptrs.begin(), sorted_fptrs.end());
    #endif
+   #if ENABLE_RESOLVE_ICF && ENABLE_SUPPORT_CONSTRAINT
+      /* code_range of a cached function ends at the next fptr */
+      vector<Block*> stale;
+      for (auto [fptr, f]: f_cache_)
+         for (auto [l,h]: f->code_range) {
+            auto it = std::upper_bound(sorted_fptrs.begin(),
+                                       sorted_fptrs.end(), l);
+            if (it != sorted_fptrs.end() && *it < h) {
+               stale.push_back(f->entry());
+               break;
+            }
+         }
+      for (auto b: stale)
+         evict(b);
+   #endif
 }
 
 
 #if ENABLE_DETECT_UPDATED_FUNCTION
 void Program::propagate_update(Block* b) {
    b->update_num = update_num;
-   for (auto p: b->superset_preds)
-      if (p->update_num < update_num)
-         propagate_update(p);
+   vector<Block*> st{b};
+   while (!st.empty()) {
+      auto u = st.back();
+      st.pop_back();
+      if (fptrs_.contains(u->offset()))
+         worklist_.insert(u->offset());
+      for (auto p: u->superset_preds())
+         if (p->update_num < update_num) {
+            p->update_num = update_num;
+            st.push_back(p);
+         }
+   }
 }
 #endif
 
 
 bool Program::updated(IMM fptr) {
    #if ENABLE_DETECT_UPDATED_FUNCTION
-   auto it = b_map_.find(fptr);
-   return (it != b_map_.end() && it->second->update_num == update_num);
+   auto b = block(fptr);
+   return (b != nullptr && b->update_num == update_num);
    #else
    return true;
    #endif
 }
 
-void Program::resolve_vfunc(const string& f_obj){
+/* -------------------------------------------------------------------------- */
+/* Analyze the functions in worklist_ on all cores. Blocks hold the          */
+/* state of the function being analyzed, so functions run together in waves */
+/* where no two of them reach a common block, others wait for a later wave. */
+/* Waves are filled in call graph order, callees before callers. Functions  */
+/* are built and selected on this thread, analyzed by the Scheduler with    */
+/* their logs buffered, then merged in order: logs, resolve_icf(), clear(). */
+void Program::analyze(const State::StateConfig& conf,
+const function<bool(Function*)>& select) {
+   vector<IMM> updated_fptrs(worklist_.begin(), worklist_.end());
+   worklist_.clear();
+   std::sort(updated_fptrs.begin(), updated_fptrs.end());
+   vector<vector<Block*>> blocks(updated_fptrs.size());
+   for (size_t k = 0; k < updated_fptrs.size(); ++k)
+      blocks[k] = reach(updated_fptrs[k]);
+   auto pending = call_order(updated_fptrs, blocks);
+
+   vector<uint32_t> owner;
+   for (uint32_t wave = 1; !pending.empty(); ++wave) {
+      vector<size_t> deferred;
+      vector<Function*> funcs;
+      for (auto k: pending) {
+         if (!claim(blocks[k], wave, owner)) {
+            deferred.push_back(k);
+            continue;
+         }
+         auto f = func(updated_fptrs[k]);
+         if (f != nullptr && select(f))
+            funcs.push_back(f);
+         else
+            /* not run: its blocks stay free for the rest of the wave */
+            release(blocks[k], owner);
+      }
+
+      /* unexplored indirect jumps first, then larger functions */
+      vector<pair<size_t,size_t>> weight(funcs.size(), {0,0});
+      for (size_t k = 0; k < funcs.size(); ++k) {
+         for (auto i: funcs[k]->icf_sites()) {
+            auto it = icfs_.find(i->offset());
+            if (it == icfs_.end() || it->second.empty())
+               ++weight[k].first;
+         }
+         for (auto scc: funcs[k]->scc_list())
+            for (auto b: scc->block_list())
+               weight[k].second += b->insn_list().size();
+      }
+      vector<size_t> order(funcs.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+         auto ux = weight[x].first > 0;
+         auto uy = weight[y].first > 0;
+         return ux != uy? ux: weight[x].second > weight[y].second;
+      });
+
+      vector<std::ostringstream> logs(funcs.size());
+      Scheduler::run(order, ANALYSIS_WORKERS, [&](size_t k) {
+         LOG_STREAM = &logs[k];
+         funcs[k]->analyze(conf, this);
+         LOG_STREAM = nullptr;
+      });
+
+      for (size_t k = 0; k < funcs.size(); ++k) {
+         LOG_OUT << logs[k].str();
+         #if ENABLE_RESOLVE_ICF
+            funcs[k]->resolve_icf();
+         #endif
+         funcs[k]->clear();
+      }
+      pending = std::move(deferred);
+   }
+}
+
+
+/* blocks reachable from fptr, entry first */
+vector<Block*> Program::reach(IMM fptr) {
+   auto entry = block(fptr);
+   if (entry == nullptr)
+      return {};
+   vector<Block*> res{entry};
+   entry->visited = true;
+   for (size_t k = 0; k < res.size(); ++k)
+      for (auto const& [v, c]: res[k]->succ())
+         if (!v->visited) {
+            v->visited = true;
+            res.push_back(v);
+         }
+   for (auto b: res)
+      b->visited = false;
+   return res;
+}
+
+
+/* positions of fptr_list with callees before callers: strongly connected */
+/* components of direct and resolved indirect calls, in Tarjan's order     */
+vector<size_t> Program::call_order(const vector<IMM>& fptr_list,
+const vector<vector<Block*>>& blocks) {
+   auto n = fptr_list.size();
+   unordered_map<IMM,size_t> index;
+   for (size_t k = 0; k < n; ++k)
+      index[fptr_list[k]] = k;
+
+   vector<vector<size_t>> callee(n);
+   for (size_t k = 0; k < n; ++k) {
+      auto edge = [&](IMM target) {
+         auto it = index.find(target);
+         if (it != index.end())
+            callee[k].push_back(it->second);
+      };
+      for (auto b: blocks[k]) {
+         auto i = b->last();
+         if (!i->call())
+            continue;
+         if (i->direct())
+            edge(i->direct_target().first);
+         else {
+            auto it = icfs_.find(i->offset());
+            if (it != icfs_.end())
+               for (auto t: it->second)
+                  edge(t);
+         }
+      }
+   }
+
+   vector<size_t> res;
+   res.reserve(n);
+   vector<uint32_t> num(n, 0);
+   vector<uint32_t> low(n, 0);
+   vector<bool> on_stack(n, false);
+   vector<size_t> st;
+   vector<pair<size_t,size_t>> dfs;    /* node, next callee */
+   uint32_t cnt = 0;
+   auto visit = [&](size_t u) {
+      num[u] = low[u] = ++cnt;
+      on_stack[u] = true;
+      st.push_back(u);
+      dfs.push_back({u, 0});
+   };
+   for (size_t s = 0; s < n; ++s) {
+      if (num[s] != 0)
+         continue;
+      visit(s);
+      while (!dfs.empty()) {
+         auto [u, e] = dfs.back();
+         if (e < callee[u].size()) {
+            ++dfs.back().second;
+            auto v = callee[u][e];
+            if (num[v] == 0)
+               visit(v);
+            else if (on_stack[v])
+               low[u] = std::min(low[u], num[v]);
+            continue;
+         }
+         dfs.pop_back();
+         if (!dfs.empty()) {
+            auto p = dfs.back().first;
+            low[p] = std::min(low[p], low[u]);
+         }
+         if (low[u] == num[u]) {
+            auto first = res.size();
+            while (true) {
+               auto v = st.back();
+               st.pop_back();
+               on_stack[v] = false;
+               res.push_back(v);
+               if (v == u)
+                  break;
+            }
+            std::sort(res.begin() + first, res.end());
+         }
+      }
+   }
+   return res;
+}
+
+
+/* mark blocks as owned by wave, fail if one already is */
+bool Program::claim(const vector<Block*>& blocks, uint32_t wave,
+vector<uint32_t>& owner) {
+   if (owner.size() < cfg_.size())
+      owner.resize(cfg_.size(), 0);
+   for (auto b: blocks)
+      if (owner[b->id()] == wave)
+         return false;
+   for (auto b: blocks)
+      owner[b->id()] = wave;
+   return true;
+}
+
+
+/* undo claim() of blocks that no function of the wave runs on */
+void Program::release(const vector<Block*>& blocks, vector<uint32_t>& owner) {
+   for (auto b: blocks)
+      owner[b->id()] = 0;
+}
+
+
+void Program::vtable(IMM table) {
+   std::lock_guard<std::mutex> lock(vtables_lock_);
+   vtables.insert(table);
+}
+/* -------------------------------------------------------------------------- */
+void Program::resolve_vfunc(){
    // 得到所有的虚函数表地址
-   std::tuple<bool,IMM,unordered_map<IMM, unordered_set<IMM>>> v_tables_pair = ELF_x86::vtables_by_rel(f_obj);
+   std::tuple<bool,IMM,unordered_map<IMM, unordered_set<IMM>>> v_tables_pair = ELF_x86::vtables_by_rel(info_);
    unordered_map<IMM, unordered_set<IMM>> v_tables = std::get<2>(v_tables_pair);
    bool striped = std::get<0>(v_tables_pair);
-   IMM file_offset = std::get<1>(v_tables_pair);
    striped = striped;
    // unordered_map<IMM,IMM> constructors = find_vtable_constructors();
-   std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> vfunc = scan_vfunc(vtables,v_tables,f_obj,file_offset);
+   std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> vfunc = scan_vfunc(vtables,v_tables);
    this->vfunc = vfunc.second;
 }
 
 
 void Program::update() {
+   Arena::Scope scope(arena_);
    /* update existing blocks with recent_icfs_ */
    for (auto jump_loc: recent_icfs_) {
-      auto it = i_map_.find(jump_loc);
-      if (it != i_map_.end() && it->second->parent != nullptr) {
-         auto b = it->second->parent;
+      auto i = insn(jump_loc);
+      if (i != nullptr && i->parent != nullptr) {
+         auto b = i->parent;
          for (auto t: icfs_.at(jump_loc)) {
             block_connect(b, t, COMPARE::NONE);
             if (b->faulty) {
@@ -308,10 +652,10 @@ void Program::update() {
 
    /* blocks reached from recent_fptrs_ */
    for (auto offset: recent_fptrs_) {
-      auto it = i_map_.find(offset);
-      if (it != i_map_.end()) {
-         if (!b_map_.contains(offset))
-            block_dfs(it->second);
+      auto i = insn(offset);
+      if (i != nullptr) {
+         if (block(offset) == nullptr)
+            block_dfs(i);
       }
       #if ABORT_MISSING_FUNCTION_ENTRY
       else {
@@ -349,20 +693,27 @@ void Program::update() {
    #if ENABLE_DETECT_UPDATED_FUNCTION
    ++update_num;
    for (auto jump_loc: recent_icfs_) {
-      auto it = i_map_.find(jump_loc);
-      if (it != i_map_.end() && it->second->parent != nullptr)
-         propagate_update(it->second->parent);
+      auto i = insn(jump_loc);
+      if (i != nullptr && i->parent != nullptr)
+         propagate_update(i->parent);
    }
    for (auto jump_loc: recent_fptrs_) {
-      auto it = i_map_.find(jump_loc);
-      if (it != i_map_.end() && it->second->parent != nullptr) {
-         it->second->parent->update_num = update_num;
-         it->second->parent->superset_preds.clear();
+      auto i = insn(jump_loc);
+      if (i != nullptr && i->parent != nullptr) {
+         i->parent->update_num = update_num;
+         i->parent->clear_superset_preds();
+         if (fptrs_.contains(jump_loc))
+            worklist_.insert(jump_loc);
       }
    }
+   #else
+   for (auto fptr: fptrs_)
+      if (block(fptr) != nullptr)
+         worklist_.insert(fptr);
    #endif
    recent_icfs_.clear();
    recent_fptrs_.clear();
+   cfg_.compact();
 }
 /* -------------------------------------------------------------------------- */
 void Program::icf(IMM jump_loc, const unordered_set<IMM>& targets) {
@@ -486,7 +837,7 @@ uint64_t Program::read(int64_t offset, uint8_t width) const {
 
 
 unordered_set<IMM> Program::definite_fptrs() const {
-   return SYSTEM::definite_fptrs(info_, f_obj_);
+   return SYSTEM::definite_fptrs(info_);
 }
 
 
@@ -593,9 +944,7 @@ vtable_dst里面存储的事所有的虚表表头，所以就可以从表头开
 // 返回2个东西，一个是所有的虚表表头，一个是所有的虚表地址与实际地址的映射
 std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> Program::scan_vfunc(
    std::unordered_set<IMM> constructors,
-   std::unordered_map<IMM, std::unordered_set<IMM>> v_tables,
-   const string& file,
-   IMM file_offset
+   std::unordered_map<IMM, std::unordered_set<IMM>> v_tables
    ) {
    
    // 提取所有的虚表表头地址
@@ -639,75 +988,19 @@ std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> Program::scan_vf
       }
    }
 
-   std::ifstream elf_file(file, std::ios::binary);
-
-   for (const auto& addr : vfunc_set){
-      
-      elf_file.seekg(addr-file_offset, std::ios::beg);
-      IMM new_address = 0;
-      elf_file.read(reinterpret_cast<char*>(&new_address), sizeof(IMM));
-      addr_pair[addr] = new_address;
-   }
+   for (const auto& addr : vfunc_set)
+      addr_pair[addr] = (IMM)read(addr, sizeof(IMM));
    std::pair<std::unordered_set<IMM>,std::unordered_map<IMM, IMM>> result(vtb_h,addr_pair);
 
    return result;
 }
 
 
-std::pair<uint64_t, uint64_t> SBA::Program::get_text_section_range(const std::string& filename) {
-   int fd = open(filename.c_str(), O_RDONLY);
-   if (fd < 0) {
-       throw std::runtime_error("无法打开 ELF 文件: " + filename);
-   }
-
-   Elf64_Ehdr ehdr;
-   if (::read(fd, &ehdr, sizeof(ehdr)) != sizeof(ehdr)) {
-       close(fd);
-       throw std::runtime_error("无法读取 ELF 文件头");
-   }
-
-   if (memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) {
-       close(fd);
-       throw std::runtime_error("不是 ELF 文件");
-   }
-
-   if (ehdr.e_ident[EI_CLASS] != ELFCLASS64) {
-       close(fd);
-       throw std::runtime_error("仅支持 64 位 ELF 文件");
-   }
-
-   std::vector<Elf64_Shdr> shdrs(ehdr.e_shnum);
-   if (lseek(fd, ehdr.e_shoff, SEEK_SET) == -1 ||
-       ::read(fd, shdrs.data(), ehdr.e_shnum * sizeof(Elf64_Shdr)) !=
-           ehdr.e_shnum * sizeof(Elf64_Shdr)) {
-       close(fd);
-       throw std::runtime_error("无法读取节头表");
-   }
-
-   if (ehdr.e_shstrndx >= ehdr.e_shnum) {
-       close(fd);
-       throw std::runtime_error("无效的字符串表索引");
-   }
-   Elf64_Shdr strtab_shdr = shdrs[ehdr.e_shstrndx];
-   std::vector<char> strtab(strtab_shdr.sh_size);
-   if (lseek(fd, strtab_shdr.sh_offset, SEEK_SET) == -1 ||
-       ::read(fd, strtab.data(), strtab_shdr.sh_size) != strtab_shdr.sh_size) {
-       close(fd);
-       throw std::runtime_error("无法读取字符串表");
-   }
-
-   for (size_t i = 0; i < ehdr.e_shnum; ++i) {
-       const char* section_name = strtab.data() + shdrs[i].sh_name;
-       if (std::strcmp(section_name, ".text") == 0) {
-           uint64_t start = shdrs[i].sh_addr;
-           uint64_t size = shdrs[i].sh_size;
-           close(fd);
-           return {start, start + size};
-       }
-   }
-
-   close(fd);
-   throw std::runtime_error("未找到 .text 节");
+std::pair<uint64_t, uint64_t> SBA::Program::get_text_section_range() const {
+   auto text = SYSTEM::section(info_, ".text");
+   if (text == nullptr)
+      throw std::runtime_error("未找到 .text 节");
+   return {text->addr, text->addr + text->size};
 }
 
 
@@ -717,21 +1010,15 @@ unordered_set<IMM> Program::scan_cptrs() const {
    auto cptrs4 = SYSTEM::stored_cptrs(info_, 4);
    res.insert(cptrs4.begin(), cptrs4.end());
 
-   /* pc-relative encoding */
-   auto pc_rel = new Binary(Binary::OP::PLUS, Expr::EXPR_MODE::DI,
-                 new Reg(Expr::EXPR_MODE::DI, SYSTEM::INSN_PTR), nullptr);
+   /* pc-relative encoding, found when the insn was classified */
    for (auto i: sorted_insns_)
-      if (!i->empty()) {
-         auto vec = i->stmt()->find(RTL::RTL_EQUAL::PARTIAL, pc_rel);
-         if (!vec.empty()) {
-            IF_RTL_TYPE(Const, ((Binary*)(vec.front()))->operand(1), c, {
-               auto val = i->next_offset() + c->to_int();
-               if (SYSTEM::code_ptr(info_, val))
-                  res.insert(val);
-            }, {});
-         }
+      if (i->pc_rel() != nullptr) {
+         IF_RTL_TYPE(Const, i->pc_rel(), c, {
+            auto val = i->next_offset() + c->to_int();
+            if (SYSTEM::code_ptr(info_, val))
+               res.insert(val);
+         }, {});
       }
-   delete pc_rel;
 
    return res;
 }
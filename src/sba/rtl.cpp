@@ -342,8 +342,8 @@ select) const {
 }
 // ----------------------------------- Assign ----------------------------------
 Assign::~Assign() {
-   delete dst_;
-   delete src_;
+   Expr::release(dst_);
+   Expr::release(src_);
 }
 
 
@@ -385,14 +385,14 @@ vector<RTL*> Assign::find(RTL_EQUAL eq, RTL* v) {
    return vList;
 }
 void Assign::Execute_ASSIGN(State& state){                                               
-   auto destination = dst()->simplify();                               
-   auto source = src()->simplify();                                    
+   auto destination = state.loc.insn->simplify(dst());
+   auto source = state.loc.insn->simplify(src());
    auto size_d = destination->mode_size();                             
    auto size_s = source->mode_size();                                  
 
    /* dst is register */                                               
    IF_RTL_TYPE(Reg, destination, reg, {                                
-      auto aval_s = source->eval(state);                               
+      auto aval_s = state.loc.insn->eval(state, source);
       aval_s.mode(size_d);                                             
       if (reg->reg() != SYSTEM::FLAGS) {                               
          state.update(get_id(reg->reg()), aval_s);                     
@@ -404,10 +404,10 @@ void Assign::Execute_ASSIGN(State& state){
    }, {                                                                
    /* dst is memory */                                                 
    IF_RTL_TYPE(Mem, destination, mem, {                                
-      auto aval_addr = mem->addr()->eval(state);                       
+      auto aval_addr = state.loc.insn->eval(state, mem->addr());
       auto init_size = mem->addr()->mode_size();                       
       CHECK_UNINIT(state, aval_addr, init_size, 0x1);                  
-      auto aval_s = source->eval(state);                               
+      auto aval_s = state.loc.insn->eval(state, source);
       aval_s.mode(size_d);                                             
       if (ABSVAL(BaseLH,aval_addr).top()) {                            
          state.clobber(REGION::STACK);                                 
@@ -429,7 +429,7 @@ void Assign::Execute_ASSIGN(State& state){
    /* dst is pc */                                                     
    IF_RTL_TYPE(NoType, destination, no_type, {                         
       if (no_type->to_string().compare("pc") == 0) {                   
-         auto aval_s = source->eval(state);                            
+         auto aval_s = state.loc.insn->eval(state, source);
          aval_s.mode(size_d);                                          
          CHECK_UNINIT(state, aval_s, size_s, 0x2);                     
          /* handle indirect jumps */                                   
@@ -443,7 +443,7 @@ void Assign::Execute_ASSIGN(State& state){
                state.update(get_id(reg->reg()),AbsVal(AbsVal::T::PC)); 
             }, {                                                       
             IF_RTL_TYPE(Mem, source, mem, {                            
-               auto aval_addr = mem->addr()->eval(state);              
+               auto aval_addr = state.loc.insn->eval(state, mem->addr());
                auto init_size = mem->addr()->mode_size();              
                CHECK_UNINIT(state, aval_addr, init_size, 0x1);         
                IF_MEMORY_ADDR(aval_addr, r, range, {                   
@@ -587,7 +587,7 @@ const {
 }
 // ----------------------------------- Call ------------------------------------
 Call::~Call() {
-   delete target_;
+   Expr::release(target_);
 }
 
 
@@ -646,7 +646,7 @@ const {
 }
 // ----------------------------------- Clobber ---------------------------------
 Clobber::~Clobber() {
-   delete expr_;
+   Expr::release(expr_);
 }
 
 
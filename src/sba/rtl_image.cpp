@@ -0,0 +1,464 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/rtl_image.h"
+#include "../../include/sba/config.h"
+#include "../../include/sba/arena.h"
+#include "../../include/sba/rtl.h"
+#include "../../include/sba/expr.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace SBA;
+
+/* file:  magic[8] key[8] count[8] body_size[8] checksum[8] body           */
+/* body:  insn*                                                            */
+/* insn:  offset[4] raw_len[1] raw node                                    */
+/* node:  tag[1] fields, children in prefix order, NONE for a nullptr      */
+/*        exprs start with their mode, all integers are little endian      */
+static const char MAGIC[8] = {'S','B','A','R','T','L','0','1'};
+static constexpr size_t HEADER_SIZE = 40;
+
+enum class TAG: uint8_t {NONE, PARALLEL, SEQUENCE, ASSIGN, CALL, CLOBBER,
+                         EXIT, NOP, CONST, MEM, REG, SUBREG, IFELSE,
+                         CONVERSION, NOTYPE, UNARY, BINARY, COMPARE};
+
+
+static uint64_t fnv1a(const void* data, size_t size, uint64_t h =
+0xcbf29ce484222325ULL) {
+   auto p = (const uint8_t*)data;
+   for (size_t i = 0; i < size; ++i) {
+      h ^= p[i];
+      h *= 0x100000001b3ULL;
+   }
+   return h;
+}
+/* --------------------------------- Writer --------------------------------- */
+template<class T> static void put(string& buf, T x) {
+   buf.append((const char*)&x, sizeof(T));
+}
+
+
+static void put_tag(string& buf, TAG tag) {
+   put<uint8_t>(buf, (uint8_t)tag);
+}
+
+
+static bool write_node(string& buf, RTL* rtl);
+
+
+static bool write_expr(string& buf, TAG tag, Expr* e) {
+   put_tag(buf, tag);
+   put<uint8_t>(buf, (uint8_t)(e->expr_mode()));
+   return true;
+}
+
+
+static bool write_stmts(string& buf, TAG tag, const vector<Statement*>& stmts) {
+   put_tag(buf, tag);
+   put<uint32_t>(buf, (uint32_t)stmts.size());
+   for (auto stmt: stmts)
+      if (!write_node(buf, stmt))
+         return false;
+   return true;
+}
+
+
+static bool write_node(string& buf, RTL* rtl) {
+   if (rtl == nullptr) {
+      put_tag(buf, TAG::NONE);
+      return true;
+   }
+
+   if (rtl->rtl_type() == RTL::RTL_TYPE::STATEMENT) {
+      auto stmt = (Statement*)rtl;
+      switch (stmt->stmt_type()) {
+         case Statement::STATEMENT_TYPE::PARALLEL:
+            return write_stmts(buf, TAG::PARALLEL, ((Parallel*)stmt)->stmts());
+         case Statement::STATEMENT_TYPE::SEQUENCE:
+            return write_stmts(buf, TAG::SEQUENCE, ((Sequence*)stmt)->stmts());
+         case Statement::STATEMENT_TYPE::ASSIGN:
+            put_tag(buf, TAG::ASSIGN);
+            return write_node(buf, ((Assign*)stmt)->dst()) &&
+                   write_node(buf, ((Assign*)stmt)->src());
+         case Statement::STATEMENT_TYPE::CALL:
+            put_tag(buf, TAG::CALL);
+            return write_node(buf, ((Call*)stmt)->target());
+         case Statement::STATEMENT_TYPE::CLOBBER:
+            put_tag(buf, TAG::CLOBBER);
+            return write_node(buf, ((Clobber*)stmt)->expr());
+         case Statement::STATEMENT_TYPE::EXIT:
+            put_tag(buf, TAG::EXIT);
+            put<uint8_t>(buf, (uint8_t)(((Exit*)stmt)->exit_type()));
+            return true;
+         case Statement::STATEMENT_TYPE::NOP:
+            put_tag(buf, TAG::NOP);
+            return true;
+         default:
+            return false;
+      }
+   }
+
+   auto e = (Expr*)rtl;
+   switch (e->expr_type()) {
+      case Expr::EXPR_TYPE::CONSTANT: {
+         auto c = (Const*)e;
+         if (c->const_type() != Const::CONST_TYPE::INTEGER &&
+         c->const_type() != Const::CONST_TYPE::DOUBLE)
+            return false;
+         write_expr(buf, TAG::CONST, e);
+         put<uint8_t>(buf, (uint8_t)(c->const_type()));
+         put<int32_t>(buf, (int32_t)(c->to_int()));
+         return true;
+      }
+      case Expr::EXPR_TYPE::VAR:
+         if (((Var*)e)->var_type() == Var::VAR_TYPE::MEM) {
+            write_expr(buf, TAG::MEM, e);
+            return write_node(buf, ((Mem*)e)->addr());
+         }
+         write_expr(buf, TAG::REG, e);
+         put<uint8_t>(buf, (uint8_t)(((Reg*)e)->reg()));
+         return true;
+      case Expr::EXPR_TYPE::SUBREG:
+         write_expr(buf, TAG::SUBREG, e);
+         put<int32_t>(buf, (int32_t)(((SubReg*)e)->bytenum()));
+         return write_node(buf, ((SubReg*)e)->expr());
+      case Expr::EXPR_TYPE::IFELSE:
+         write_expr(buf, TAG::IFELSE, e);
+         return write_node(buf, ((IfElse*)e)->cmp_expr()) &&
+                write_node(buf, ((IfElse*)e)->if_expr()) &&
+                write_node(buf, ((IfElse*)e)->else_expr());
+      case Expr::EXPR_TYPE::CONVERSION: {
+         auto conv = (Conversion*)e;
+         write_expr(buf, TAG::CONVERSION, e);
+         put<uint8_t>(buf, (uint8_t)(conv->conv_type()));
+         return write_node(buf, conv->expr()) &&
+                write_node(buf, conv->size()) &&
+                write_node(buf, conv->pos());
+      }
+      case Expr::EXPR_TYPE::NOTYPE: {
+         auto s = e->to_string();
+         if (s.length() > UINT16_MAX)
+            return false;
+         write_expr(buf, TAG::NOTYPE, e);
+         put<uint16_t>(buf, (uint16_t)(s.length()));
+         buf.append(s);
+         return true;
+      }
+      case Expr::EXPR_TYPE::ARITHMETIC:
+         switch (((Arithmetic*)e)->arith_type()) {
+            case Arithmetic::ARITH_TYPE::UNARY:
+               write_expr(buf, TAG::UNARY, e);
+               put<uint8_t>(buf, (uint8_t)(((Unary*)e)->op()));
+               return write_node(buf, ((Unary*)e)->operand());
+            case Arithmetic::ARITH_TYPE::BINARY:
+               write_expr(buf, TAG::BINARY, e);
+               put<uint8_t>(buf, (uint8_t)(((Binary*)e)->op()));
+               return write_node(buf, ((Binary*)e)->operand(0)) &&
+                      write_node(buf, ((Binary*)e)->operand(1));
+            case Arithmetic::ARITH_TYPE::COMPARE:
+               write_expr(buf, TAG::COMPARE, e);
+               put<uint8_t>(buf, (uint8_t)(((Compare*)e)->op()));
+               return write_node(buf, ((Compare*)e)->expr());
+            default:
+               return false;
+         }
+      default:
+         return false;
+   }
+}
+/* --------------------------------- Reader --------------------------------- */
+struct Reader {
+   const uint8_t* p;
+   const uint8_t* end;
+   bool ok = true;
+
+   template<class T> T get() {
+      T x{};
+      if ((size_t)(end - p) < sizeof(T))
+         ok = false;
+      else {
+         std::memcpy(&x, p, sizeof(T));
+         p += sizeof(T);
+      }
+      return x;
+   }
+};
+
+
+static RTL* read_node(Reader& r);
+
+
+/* a child must be an expr, interned like the parser does for subtrees */
+/* stmt: a statement is taken as it is, as the parser takes a call as */
+/* the source of a set                                                */
+static Expr* read_expr(Reader& r, bool stmt = false) {
+   auto rtl = read_node(r);
+   if (rtl == nullptr)
+      return nullptr;
+   if (stmt && rtl->rtl_type() == RTL::RTL_TYPE::STATEMENT)
+      return (Expr*)rtl;
+   if (rtl->rtl_type() != RTL::RTL_TYPE::EXPR) {
+      delete rtl;
+      r.ok = false;
+      return nullptr;
+   }
+   #if ENABLE_SHARED_EXPR
+      return Expr::intern((Expr*)rtl);
+   #else
+      return (Expr*)rtl;
+   #endif
+}
+
+
+static Statement* read_stmt(Reader& r) {
+   auto rtl = read_node(r);
+   if (rtl != nullptr && rtl->rtl_type() != RTL::RTL_TYPE::STATEMENT) {
+      Expr::release((Expr*)rtl);
+      r.ok = false;
+      return nullptr;
+   }
+   return (Statement*)rtl;
+}
+
+
+static vector<Statement*> read_stmts(Reader& r) {
+   vector<Statement*> stmts;
+   auto n = r.get<uint32_t>();
+   for (uint32_t i = 0; i < n && r.ok; ++i)
+      stmts.push_back(read_stmt(r));
+   return stmts;
+}
+
+
+/* children are read first, a node is built even if one of them failed so */
+/* that its destructor cleans up whatever was read, the caller drops it;  */
+/* operands are cast as unchecked as in the parser                        */
+static RTL* read_node(Reader& r) {
+   auto tag = (TAG)(r.get<uint8_t>());
+   if (!r.ok)
+      return nullptr;
+
+   RTL* res = nullptr;
+   switch (tag) {
+      case TAG::NONE:
+         return nullptr;
+      case TAG::PARALLEL:
+         res = new Parallel(read_stmts(r));
+         break;
+      case TAG::SEQUENCE:
+         res = new Sequence(read_stmts(r));
+         break;
+      case TAG::ASSIGN: {
+         auto dst = read_expr(r);
+         res = new Assign(dst, read_expr(r, true));
+         break;
+      }
+      case TAG::CALL:
+         res = new Call((Mem*)read_expr(r));
+         break;
+      case TAG::CLOBBER:
+         res = new Clobber(read_expr(r));
+         break;
+      case TAG::EXIT:
+         res = new Exit((Exit::EXIT_TYPE)(r.get<uint8_t>()));
+         break;
+      case TAG::NOP:
+         res = new Nop();
+         break;
+      default: {
+         auto mode = (Expr::EXPR_MODE)(r.get<uint8_t>());
+         if ((uint8_t)mode > (uint8_t)Expr::EXPR_MODE::NONE)
+            r.ok = false;
+         switch (tag) {
+            case TAG::CONST: {
+               auto type = (Const::CONST_TYPE)(r.get<uint8_t>());
+               res = new Const(type, (IMM)(r.get<int32_t>()));
+               break;
+            }
+            case TAG::MEM:
+               res = new Mem(mode, read_expr(r));
+               break;
+            case TAG::REG:
+               res = new Reg(mode, (SYSTEM::Reg)(r.get<uint8_t>()));
+               break;
+            case TAG::SUBREG: {
+               auto byte_num = r.get<int32_t>();
+               res = new SubReg(mode, read_expr(r), byte_num);
+               break;
+            }
+            case TAG::IFELSE: {
+               auto cmp = read_expr(r);
+               auto if_expr = read_expr(r);
+               res = new IfElse(mode, (Compare*)cmp, if_expr, read_expr(r));
+               break;
+            }
+            case TAG::CONVERSION: {
+               auto op = (Conversion::OP)(r.get<uint8_t>());
+               auto expr = read_expr(r);
+               auto size = read_expr(r);
+               res = new Conversion(op, mode, expr, size, read_expr(r));
+               break;
+            }
+            case TAG::NOTYPE: {
+               auto len = r.get<uint16_t>();
+               if ((size_t)(r.end - r.p) < len)
+                  r.ok = false;
+               else {
+                  res = new NoType(string((const char*)r.p, len));
+                  r.p += len;
+               }
+               break;
+            }
+            case TAG::UNARY: {
+               auto op = (Unary::OP)(r.get<uint8_t>());
+               res = new Unary(op, mode, read_expr(r));
+               break;
+            }
+            case TAG::BINARY: {
+               auto op = (Binary::OP)(r.get<uint8_t>());
+               auto a = read_expr(r);
+               res = new Binary(op, mode, a, read_expr(r));
+               break;
+            }
+            case TAG::COMPARE: {
+               auto op = (Compare::OP)(r.get<uint8_t>());
+               res = new Compare(op, mode, read_expr(r));
+               break;
+            }
+            default:
+               r.ok = false;
+               break;
+         }
+      }
+   }
+
+   if (!r.ok && res != nullptr) {
+      delete res;
+      res = nullptr;
+   }
+   return res;
+}
+/* -------------------------------------------------------------------------- */
+
+
+uint64_t RTLImage::key(const string& f_obj, uint64_t version) {
+   std::ifstream f(f_obj, std::ios::binary);
+   if (!f)
+      return 0;
+   /* build options the image depends on */
+   static const uint8_t options[] = {ENABLE_COMPATIBLE_INPUT,
+      ABORT_UNLIFTED_INSN, ENABLE_STREAMING_LIFT, ENABLE_LIFT_TEMPLATE,
+      ENABLE_SHARED_EXPR};
+   vector<char> buf(1 << 20);
+   uint64_t h = fnv1a(&version, sizeof(version), fnv1a(MAGIC, 8));
+   h = fnv1a(&VERSION, sizeof(VERSION), h);
+   h = fnv1a(options, sizeof(options), h);
+   while (f.read(buf.data(), buf.size()) || f.gcount() > 0)
+      h = fnv1a(buf.data(), (size_t)f.gcount(), h);
+   return h;
+}
+
+
+bool RTLImage::save(const string& file, uint64_t key, const
+vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw) {
+   string buf(HEADER_SIZE, '\0');
+   for (auto const& [offset, rtl, raw]: offset_rtl_raw) {
+      if (raw.size() > UINT8_MAX)
+         return false;
+      put<int32_t>(buf, (int32_t)offset);
+      put<uint8_t>(buf, (uint8_t)(raw.size()));
+      buf.append((const char*)raw.data(), raw.size());
+      if (!write_node(buf, rtl))
+         return false;
+   }
+
+   uint64_t count = offset_rtl_raw.size();
+   uint64_t body_size = buf.size() - HEADER_SIZE;
+   uint64_t sum = fnv1a(buf.data() + HEADER_SIZE, body_size);
+   std::memcpy(buf.data(), MAGIC, 8);
+   std::memcpy(buf.data() + 8, &key, 8);
+   std::memcpy(buf.data() + 16, &count, 8);
+   std::memcpy(buf.data() + 24, &body_size, 8);
+   std::memcpy(buf.data() + 32, &sum, 8);
+
+   /* concurrent runs may save the same image, publish with a rename */
+   namespace fs = std::filesystem;
+   std::error_code ec;
+   auto f_tmp = file + "." + std::to_string(getpid());
+   std::ofstream f(f_tmp, std::ios::binary | std::ios::trunc);
+   f.write(buf.data(), buf.size());
+   f.close();
+   if (f.good())
+      fs::rename(f_tmp, file, ec);
+   if (!f.good() || ec) {
+      fs::remove(f_tmp, ec);
+      return false;
+   }
+   return true;
+}
+
+
+bool RTLImage::load(const string& file, uint64_t key,
+vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw, Arena* arena) {
+   auto fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return false;
+   struct stat st;
+   void* ptr = MAP_FAILED;
+   if (fstat(fd, &st) == 0 && (size_t)st.st_size >= HEADER_SIZE)
+      ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);
+   if (ptr == MAP_FAILED)
+      return false;
+   auto size = (size_t)st.st_size;
+   auto data = (const uint8_t*)ptr;
+   madvise(ptr, size, MADV_SEQUENTIAL);
+
+   uint64_t k, count, body_size, sum;
+   std::memcpy(&k, data + 8, 8);
+   std::memcpy(&count, data + 16, 8);
+   std::memcpy(&body_size, data + 24, 8);
+   std::memcpy(&sum, data + 32, 8);
+   bool ok = std::memcmp(data, MAGIC, 8) == 0 && k == key &&
+             body_size == size - HEADER_SIZE &&
+             fnv1a(data + HEADER_SIZE, body_size) == sum;
+
+   if (ok) {
+      Arena::Scope scope(arena);
+      Reader r{data + HEADER_SIZE, data + size};
+      offset_rtl_raw.clear();
+      offset_rtl_raw.reserve(count);
+      for (uint64_t i = 0; i < count && r.ok; ++i) {
+         auto offset = (IMM)(r.get<int32_t>());
+         auto len = r.get<uint8_t>();
+         if (!r.ok || (size_t)(r.end - r.p) < len) {
+            r.ok = false;
+            break;
+         }
+         vector<uint8_t> raw(r.p, r.p + len);
+         r.p += len;
+         auto rtl = read_node(r);
+         offset_rtl_raw.push_back({offset, rtl, std::move(raw)});
+      }
+      ok = r.ok && r.p == r.end;
+      if (!ok) {
+         for (auto [offset, rtl, raw]: offset_rtl_raw)
+            if (rtl != nullptr && rtl->rtl_type() == RTL::RTL_TYPE::EXPR)
+               Expr::release((Expr*)rtl);
+            else
+               delete rtl;
+         offset_rtl_raw.clear();
+      }
+   }
+
+   munmap(ptr, size);
+   return ok;
+}
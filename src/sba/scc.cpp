@@ -11,18 +11,34 @@
 #include "../../include/sba/rtl.h"
 
 using namespace SBA;
+/* (block, next successor) of dfs(), kept to reuse its room across SCCs */
+static thread_local vector<pair<Block*,uint32_t>> dfs_stack;
 /* --------------------- Strongly Connected Component ----------------------- */
-void SCC::dfs(Block* u) {
-   u->visited = true;
-   Util::Visited.push_back(u);
-   for (auto const& [v, c]: u->succ()) {
-      v->pred(u);
-      if (v->parent != this)
-         ext_target.push_back(v);
-      else if (!v->visited)
-         dfs(v);
+void SCC::dfs(Block* header) {
+   auto visit = [&](Block* u) {
+      u->visited = true;
+      Util::Visited.push_back(u);
+      dfs_stack.push_back({u, 0});
+   };
+
+   dfs_stack.clear();
+   visit(header);
+   while (!dfs_stack.empty()) {
+      auto [u, e] = dfs_stack.back();
+      auto succ = u->succ();
+      if (e < succ.size()) {
+         ++dfs_stack.back().second;
+         auto v = succ[e].first;
+         v->pred(u);
+         if (v->parent != this)
+            ext_target.push_back(v);
+         else if (!v->visited)
+            visit(v);
+         continue;
+      }
+      dfs_stack.pop_back();
+      b_list_.push_back(u);
    }
-   b_list_.push_back(u);
 }
 
 
@@ -31,8 +47,8 @@ void SCC::build_cfg(Block* header) {
    Util::Visited.clear();
    dfs(header);
    std::reverse(b_list_.begin(), b_list_.end());
-   for (IMM k = 0; k < Util::Visited.count(); ++k)
-      Util::Visited.get(k)->visited = false;
+   for (auto b: Util::Visited)
+      b->visited = false;
 }
 
 
@@ -0,0 +1,63 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+#include "../../include/sba/scheduler.h"
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace SBA;
+// -------------------------------- Scheduler ----------------------------------
+void Scheduler::run(const vector<size_t>& tasks, int workers,
+const function<void(size_t)>& f) {
+   auto w = std::min((size_t)Util::workers(workers), tasks.size());
+   if (w <= 1) {
+      for (auto t: tasks)
+         f(t);
+      return;
+   }
+
+   struct Queue {
+      std::mutex lock;
+      std::deque<size_t> tasks;
+   };
+   vector<Queue> queues(w);
+   for (size_t k = 0; k < tasks.size(); ++k)
+      queues[k % w].tasks.push_back(tasks[k]);
+
+   /* no task is added while running: all deques empty means done */
+   auto take = [&](size_t id, size_t& t) {
+      for (size_t k = 0; k < w; ++k) {
+         auto& q = queues[(id + k) % w];
+         std::lock_guard<std::mutex> lock(q.lock);
+         if (!q.tasks.empty()) {
+            if (k == 0) {
+               t = q.tasks.front();
+               q.tasks.pop_front();
+            }
+            else {
+               t = q.tasks.back();
+               q.tasks.pop_back();
+            }
+            return true;
+         }
+      }
+      return false;
+   };
+   auto run = [&](size_t id) {
+      size_t t;
+      while (take(id, t))
+         f(t);
+   };
+
+   vector<std::thread> threads;
+   for (size_t i = 1; i < w; ++i)
+      threads.emplace_back(run, i);
+   run(0);
+   for (auto& t: threads)
+      t.join();
+}
@@ -12,7 +12,14 @@
 #include "../../include/sba/state.h"
 
 using namespace SBA;
-
+/* frames of load(), kept to reuse their room across loads */
+struct LoadFrame {
+   Block* b;
+   AbsVal* aval;
+   uint32_t e;
+   bool down;
+};
+static thread_local vector<LoadFrame> load_stack;
 /* --------------------------------- State ---------------------------------- */
 State::State(Function* func, const StateConfig& conf): config(conf), f_(func),
 pseudo_entry_(func->pseudo_entry()) {}
@@ -106,8 +113,8 @@ void State::refresh() const {
          auto& uval = loc.block->value(sym);
          auto& aval = (uval.first)[(int)CHANNEL::BLOCK];
          load(uval, aval, sym, id.r(), loc.block);
-         for (IMM k = 0; k < Util::Visited.count(); ++k)
-            Util::Visited.get(k)->visited = false;
+         for (auto b: Util::Visited)
+            b->visited = false;
          LOG4("refresh " << id.to_string());
       }
    }
@@ -178,8 +185,8 @@ vector<Loc> State::use_def(const UnitId& id, const Loc& l) const {
                }
          }
       }
-      for (IMM k = 0; k < Util::Visited.count(); ++k)
-         Util::Visited.get(k)->visited = false;
+      for (auto b: Util::Visited)
+         b->visited = false;
    }
 
    return res;
@@ -191,55 +198,78 @@ UnitVal& State::load(const UnitId& id) const {
    auto& aval = (uval.first)[(int)CHANNEL::BLOCK];
    Util::Visited.clear();
    load(uval, aval, sym, id.r(), loc.block);
-   for (IMM k = 0; k < Util::Visited.count(); ++k)
-      Util::Visited.get(k)->visited = false;
+   for (auto b: Util::Visited)
+      b->visited = false;
    return uval;
 }
 
 
+/* track back from b with an explicit stack of (block, its record, next */
+/* predecessor, whether that predecessor is being loaded), so the length */
+/* of a path is not bounded by the call stack                            */
 void State::load(UnitVal& uval, AbsVal& aval, const IMM sym, const REGION r,
 Block* const b) const {
-   b->visited = true;
-   Util::Visited.push_back(b);
-
-   /* clobber effect */
-   if (r == REGION::STACK || r == REGION::STATIC) {
-      auto recent_d = uval.second;
-      auto recent_c = b->clobber(r);
-      if (recent_c != nullptr && (recent_d == nullptr
-                               || recent_d->offset() < recent_c->offset())) {
-         aval.fill(AbsVal::T::TOP);
-         return;
+   /* a nested load keeps the frames below its base */
+   auto base = load_stack.size();
+
+   /* false if the record of u is settled without its predecessors */
+   auto visit = [&](UnitVal& uval_u, AbsVal& aval_u, Block* u) {
+      u->visited = true;
+      Util::Visited.push_back(u);
+
+      /* clobber effect */
+      if (r == REGION::STACK || r == REGION::STATIC) {
+         auto recent_d = uval_u.second;
+         auto recent_c = u->clobber(r);
+         if (recent_c != nullptr && (recent_d == nullptr
+                                  || recent_d->offset() < recent_c->offset())) {
+            aval_u.fill(AbsVal::T::TOP);
+            return false;
+         }
       }
-   } 
 
-   /* valid record */
-   if (!aval.empty())
-      return;
+      /* valid record */
+      if (!aval_u.empty())
+         return false;
 
-   /* no valid record */
-   /* (a) pseudo_entry: on-demand init */
-   if (b == pseudo_entry_) {
-      (*config.init)(get_id(sym), aval);
-      return;
-   }
-   /* (b) track back */
-   else {
-      aval.fill(AbsVal::T::BOT);
-      for (auto p: b->pred()) {
-         auto pscc = p->parent;
-         /* pred_scc is finalised -> only mark refresh for curr_scc     */
-         /* avoid duplicates -> only mark for the first time track back */
+      /* no valid record */
+      /* (a) pseudo_entry: on-demand init */
+      if (u == pseudo_entry_) {
+         (*config.init)(get_id(sym), aval_u);
+         return false;
+      }
+      /* (b) track back */
+      aval_u.fill(AbsVal::T::BOT);
+      load_stack.push_back({u, &aval_u, 0, false});
+      return true;
+   };
+
+   visit(uval, aval, b);
+   while (load_stack.size() > base) {
+      auto* f = &load_stack.back();
+      auto pred = f->b->pred();
+      if (f->e < pred.size()) {
+         auto p = pred[f->e];
          auto& uval_p = p->value(sym);
          auto& aval_p = (uval_p.first)[(int)CHANNEL::RECORD];
-         if (config.iteration_limit != 0 && pscc == loc.scc && aval_p.empty())
-            p->refresh(sym);
-         if (!p->visited)
-            load(uval_p, aval_p, sym, r, p);
+         if (!f->down) {
+            f->down = true;
+            /* pred_scc is finalised -> only mark refresh for curr_scc     */
+            /* avoid duplicates -> only mark for the first time track back */
+            if (config.iteration_limit != 0 && p->parent == loc.scc &&
+            aval_p.empty())
+               p->refresh(sym);
+            if (!p->visited && visit(uval_p, aval_p, p))
+               continue;
+            /* init may have loaded, and moved the frames */
+            f = &load_stack.back();
+         }
+         f->down = false;
+         ++f->e;
          /* aval_p is the indirect target */
          if (aval_p.pc()) {
-            AbsVal aval_pc(b->offset());
-            aval.abs_union(aval_pc);
+            AbsVal aval_pc(f->b->offset());
+            f->aval->abs_union(aval_pc);
             LOG5("from " << (p != pseudo_entry_?
                   std::to_string(p->offset()):string("pseudo_entry")) << ":\n" <<
                   aval_pc.to_string());
@@ -247,13 +277,15 @@ Block* const b) const {
          else {
             /* cyclic dependency -> BOT */
             if (!aval_p.empty())
-               aval.abs_union(aval_p);
+               f->aval->abs_union(aval_p);
             LOG5("from " << (p != pseudo_entry_?
                   std::to_string(p->offset()):string("pseudo_entry")) << ":\n" <<
                   aval_p.to_string());
          }
+         continue;
       }
-      if (aval.bot())
-         aval.clear();
+      if (f->aval->bot())
+         f->aval->clear();
+      load_stack.pop_back();
    }
 }
@@ -8,11 +8,20 @@
 #include "../../include/sba/framework.h"
 #include "../../include/sba/insn.h"
 #include "../../include/sba/system.h"
+#include "../../include/sba/decoder.h"
 #include <array>
 #include <elf.h>
 #include <cstring>
 #include <vector>
 #include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_AVX2_SCAN 1
+#endif
 
 
 
@@ -29,50 +38,226 @@ using namespace SBA;
 using namespace std;
 
 
-void ELF_x86::load(Object& info, const string& file) {
+/* ---------------------------------- Image --------------------------------- */
+ELF_x86::Image::Image(Image&& other) noexcept: data_(other.data_),
+size_(other.size_) {
+   other.data_ = nullptr;
+   other.size_ = 0;
+}
+
+
+ELF_x86::Image& ELF_x86::Image::operator=(Image&& other) noexcept {
+   if (this != &other) {
+      release();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+   }
+   return *this;
+}
+
+
+ELF_x86::Image::~Image() {
+   release();
+}
+
+
+void ELF_x86::Image::release() {
+   if (data_ != nullptr)
+      munmap((void*)data_, size_);
+   data_ = nullptr;
+   size_ = 0;
+}
+
+
+bool ELF_x86::Image::map(const string& file) {
+   release();
+   int fd = open(file.c_str(), O_RDONLY);
+   if (fd < 0)
+      return false;
+   struct stat st;
+   if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      close(fd);
+      return false;
+   }
+   auto ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (ptr == MAP_FAILED)
+      return false;
+   data_ = (const uint8_t*)ptr;
+   size_ = (size_t)st.st_size;
+   return true;
+}
+/* -------------------------------------------------------------------------- */
+
+
+/* bounds-checked copy of a file structure out of raw_bytes */
+template<class T> static bool fetch(const ELF_x86::Image& raw, uint64_t offset,
+T& out) {
+   if (offset > raw.size() || raw.size() - offset < sizeof(T))
+      return false;
+   std::memcpy(&out, raw.data() + offset, sizeof(T));
+   return true;
+}
+
+
+static string fetch_str(const ELF_x86::Image& raw, uint64_t offset,
+uint64_t limit) {
+   limit = std::min<uint64_t>(limit, raw.size());
    string s;
-   string cmd;
+   for (auto i = offset; i < limit && raw[i] != 0; ++i)
+      s.push_back((char)raw[i]);
+   return s;
+}
+
+
+static void load_symbols(const ELF_x86::Object& info,
+const ELF_x86::Section& sec, vector<ELF_x86::Symbol>& res) {
+   if (sec.link >= info.sections.size() || sec.entsize < sizeof(Elf64_Sym))
+      return;
+   auto const& strtab = info.sections[sec.link];
+   for (uint64_t k = 0; k + sec.entsize <= sec.size; k += sec.entsize) {
+      Elf64_Sym sym;
+      if (!fetch(info.raw_bytes, sec.offset + k, sym))
+         break;
+      res.push_back({fetch_str(info.raw_bytes, strtab.offset + sym.st_name,
+                               strtab.offset + strtab.size),
+                     sym.st_value, sym.st_size,
+                     (uint8_t)ELF64_ST_TYPE(sym.st_info),
+                     (uint8_t)ELF64_ST_BIND(sym.st_info), sym.st_shndx});
+   }
+}
+
+
+static void load_relocations(const ELF_x86::Object& info,
+const ELF_x86::Section& sec, vector<ELF_x86::Relocation>& res) {
+   if (sec.entsize < sizeof(Elf64_Rela))
+      return;
+   for (uint64_t k = 0; k + sec.entsize <= sec.size; k += sec.entsize) {
+      Elf64_Rela rel;
+      if (!fetch(info.raw_bytes, sec.offset + k, rel))
+         break;
+      res.push_back({rel.r_offset, (uint32_t)ELF64_R_TYPE(rel.r_info),
+                     (uint32_t)ELF64_R_SYM(rel.r_info), rel.r_addend});
+   }
+}
+
+
+/* page-granular vaddr -> phdr map, so that read() needs no phdr walk */
+static const uint8_t PAGE_BITS = 12;
+static const uint64_t MAX_INDEXED_PAGES = 1 << 22;
+static void index_phdr(ELF_x86::Object& info) {
+   info.page_phdr.clear();
+   if (info.phdr.empty() || info.phdr.size() > UINT16_MAX)
+      return;
+   auto first_vaddr = std::get<0>(info.phdr.front());
+   auto last_end = std::get<0>(info.phdr.back()) + std::get<3>(info.phdr.back());
+   info.page_base = first_vaddr >> PAGE_BITS;
+   auto num_pages = (last_end >> PAGE_BITS) - info.page_base + 1;
+   if (num_pages > MAX_INDEXED_PAGES)
+      return;
+   info.page_phdr.resize(num_pages);
+   size_t k = 0;
+   for (uint64_t page = 0; page < num_pages; ++page) {
+      auto start = (info.page_base + page) << PAGE_BITS;
+      while (k+1 < info.phdr.size() && std::get<0>(info.phdr[k+1]) <= start)
+         ++k;
+      info.page_phdr[page] = (uint16_t)k;
+   }
+}
+
+
+/* index of the last phdr with vaddr <= addr, or -1 if there is none */
+static int find_phdr(const ELF_x86::Object& info, uint64_t addr) {
+   auto const& phdr = info.phdr;
+   if (phdr.empty() || addr < std::get<0>(phdr.front()))
+      return -1;
+   size_t k;
+   auto page = (addr >> PAGE_BITS) - info.page_base;
+   if (info.page_phdr.empty())
+      k = 0;
+   else if (page < info.page_phdr.size())
+      k = info.page_phdr[page];
+   else
+      k = phdr.size() - 1;
+   /* several phdrs may start inside one page */
+   while (k+1 < phdr.size() && std::get<0>(phdr[k+1]) <= addr)
+      ++k;
+   return (int)k;
+}
+
+
+bool ELF_x86::load(Object& info, const string& file) {
+   /* raw bytes */
+   if (!info.raw_bytes.map(file)) {
+      std::cerr << "Failed to open ELF file " << file << "\n";
+      return false;
+   }
+
+   /* file header */
+   auto const& raw = info.raw_bytes;
+   Elf64_Ehdr ehdr;
+   if (!fetch(raw, 0, ehdr) || std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0
+   || ehdr.e_ident[EI_CLASS] != ELFCLASS64) {
+      std::cerr << "Not a valid ELF64 file " << file << "\n";
+      return false;
+   }
 
    /* program headers */
-   cmd = string("readelf -Wl ") + file + string(" | grep LOAD")
-       + string(" | awk '{print $2 \"\\n\" $3 \"\\n\" $5 \"\\n\" $6}' > ")
-       + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   while (getline(f1, s)) {
-      auto foffset = stoull(s, nullptr, 16);
-      getline(f1, s);
-      auto vaddr = stoull(s, nullptr, 16);
-      getline(f1, s);
-      auto fsize = stoull(s, nullptr, 16);
-      getline(f1, s);
-      auto msize = stoull(s, nullptr, 16);
-      info.phdr.push_back({vaddr, foffset, fsize, msize});
+   for (uint16_t k = 0; k < ehdr.e_phnum; ++k) {
+      Elf64_Phdr phdr;
+      if (!fetch(raw, ehdr.e_phoff + (uint64_t)k * ehdr.e_phentsize, phdr))
+         break;
+      if (phdr.p_type == PT_LOAD)
+         info.phdr.push_back({phdr.p_vaddr, phdr.p_offset,
+                              phdr.p_filesz, phdr.p_memsz});
    }
-   f1.close();
    std::sort(info.phdr.begin(), info.phdr.end());
+   index_phdr(info);
 
-   /* raw bytes */
-   std::ifstream f2(file, std::ios::in | std::ios::binary);
-   info.raw_bytes = vector<uint8_t>(std::istreambuf_iterator<char>(f2),
-                                    std::istreambuf_iterator<char>());
-   f2.close();
+   /* section headers */
+   vector<Elf64_Shdr> shdrs;
+   for (uint16_t k = 0; k < ehdr.e_shnum; ++k) {
+      Elf64_Shdr shdr;
+      if (!fetch(raw, ehdr.e_shoff + (uint64_t)k * ehdr.e_shentsize, shdr))
+         break;
+      shdrs.push_back(shdr);
+   }
+   for (auto const& shdr: shdrs) {
+      string name;
+      if (ehdr.e_shstrndx < shdrs.size()) {
+         auto const& shstrtab = shdrs[ehdr.e_shstrndx];
+         name = fetch_str(raw, shstrtab.sh_offset + shdr.sh_name,
+                          shstrtab.sh_offset + shstrtab.sh_size);
+      }
+      info.sections.push_back({name, shdr.sh_type, shdr.sh_flags,
+                               shdr.sh_addr, shdr.sh_offset, shdr.sh_size,
+                               shdr.sh_entsize, shdr.sh_link});
+   }
 
-   /* code segments */
-   cmd = string("readelf -WS ") + file + string(" | awk '$8 ~/X/'")
-       + string(" | awk '{print $4 \"\\n\" $6}' >")
-       + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-
-   fstream f3(Framework::d_session, fstream::in);
-   while (getline(f3, s)) {
-      auto addr = stoull("0x" + s, nullptr, 16);
-      getline(f3, s);
-      auto size = stoull("0x" + s, nullptr, 16);
-      info.code_segment.push_back({addr, addr+size-1});
+   /* code segments, symbols, relocations */
+   for (auto const& sec: info.sections) {
+      if ((sec.flags & SHF_EXECINSTR) && sec.size > 0)
+         info.code_segment.push_back({(IMM)sec.addr, (IMM)(sec.addr+sec.size-1)});
+      if (sec.type == SHT_DYNSYM)
+         load_symbols(info, sec, info.dynsym);
+      else if (sec.type == SHT_SYMTAB)
+         load_symbols(info, sec, info.symtab);
+      else if (sec.type == SHT_RELA && (sec.flags & SHF_ALLOC))
+         load_relocations(info, sec, sec.name.compare(".rela.plt") == 0?
+                                     info.rela_plt: info.rela_dyn);
    }
-   f3.close();
+
+   return true;
+}
+
+
+const ELF_x86::Section* ELF_x86::section(const Object& info, const string& name) {
+   for (auto const& sec: info.sections)
+      if (sec.name.compare(name) == 0)
+         return &sec;
+   return nullptr;
 }
 
 
@@ -81,13 +266,9 @@ uint64_t ELF_x86::read(const Object& info, int64_t offset, uint8_t width) {
    uint64_t final_foffset = 0;
    uint64_t final_fsize = 0;
    uint64_t final_msize = 0;
-   for (auto const& [vaddr, foffset, fsize, msize]: info.phdr)
-      if (vaddr <= (uint64_t)offset) {
-         final_vaddr = vaddr;
-         final_foffset = foffset;
-         final_fsize = fsize;
-         final_msize = msize;
-      }
+   auto k = find_phdr(info, (uint64_t)offset);
+   if (k >= 0)
+      std::tie(final_vaddr, final_foffset, final_fsize, final_msize) = info.phdr[k];
 
    /* uninit values are filled with zero */
    uint64_t dist = (uint64_t)offset - final_vaddr;
@@ -96,22 +277,46 @@ uint64_t ELF_x86::read(const Object& info, int64_t offset, uint8_t width) {
 
    /* address beyond binary bounds */
    uint64_t adj_offset = final_foffset + dist;
-   if (adj_offset >= info.raw_bytes.size())
+   if (adj_offset >= info.raw_bytes.size() ||
+   info.raw_bytes.size() - adj_offset < width)
       return 0x8000000080000000;
 
+   auto ptr = info.raw_bytes.data() + adj_offset;
+   #if ENDIAN == 0
+   switch (width) {
+      case 1:
+         return *ptr;
+      case 2: {
+         uint16_t val;
+         std::memcpy(&val, ptr, 2);
+         return val;
+      }
+      case 4: {
+         uint32_t val;
+         std::memcpy(&val, ptr, 4);
+         return val;
+      }
+      case 8: {
+         uint64_t val;
+         std::memcpy(&val, ptr, 8);
+         return val;
+      }
+   }
+   #endif
+
    uint64_t val = 0;
    for (uint8_t i = 0; i < width; ++i)
       #if ENDIAN == 0
-      val += ((uint64_t)info.raw_bytes[adj_offset+i] << (uint64_t)(i<<3));
+      val += ((uint64_t)ptr[i] << (uint64_t)(i<<3));
       #else
-      val += ((uint64_t)info.raw_bytes[adj_offset+i] << (uint64_t)((width-1-i)<<3));
+      val += ((uint64_t)ptr[i] << (uint64_t)((width-1-i)<<3));
       #endif
    return val;
 }
 
 
 bool ELF_x86::code_ptr(const Object& info, IMM ptr) {
-   if (!info.insns->empty())
+   if (info.insns != nullptr && !info.insns->empty())
       return info.insns->contains(ptr);
    else {
       for (auto [l,h]: info.code_segment)
@@ -122,81 +327,181 @@ bool ELF_x86::code_ptr(const Object& info, IMM ptr) {
 }
 
 
+/* values v at every byte position with lo <= v <= lo + span (unsigned) */
+template<class T> static void scan_range(const uint8_t* p, size_t from, size_t n,
+uint64_t lo, uint64_t span, vector<uint64_t>& res) {
+   for (auto i = from; i + sizeof(T) <= n; ++i) {
+      T v;
+      std::memcpy(&v, p + i, sizeof(T));
+      if ((uint64_t)v - lo <= span)
+         res.push_back(v);
+   }
+}
+
+
+#if HAVE_AVX2_SCAN
+/* 8 shifted loads cover 32 byte positions of 8-byte values per step */
+__attribute__((target("avx2")))
+static size_t scan_range_avx2_8(const uint8_t* p, size_t n, uint64_t lo,
+uint64_t span, vector<uint64_t>& res) {
+   auto bias = _mm256_set1_epi64x(INT64_MIN);
+   auto vlo = _mm256_set1_epi64x((int64_t)lo);
+   auto vspan = _mm256_set1_epi64x((int64_t)(span ^ (uint64_t)INT64_MIN));
+   size_t i = 0;
+   for (; i + 40 <= n; i += 32)
+      for (int k = 0; k < 8; ++k) {
+         auto v = _mm256_loadu_si256((const __m256i*)(p + i + k));
+         auto d = _mm256_xor_si256(_mm256_sub_epi64(v, vlo), bias);
+         auto out = _mm256_cmpgt_epi64(d, vspan);
+         auto mask = ~_mm256_movemask_pd(_mm256_castsi256_pd(out)) & 0xf;
+         while (mask != 0) {
+            auto j = __builtin_ctz(mask);
+            mask &= mask - 1;
+            uint64_t val;
+            std::memcpy(&val, p + i + k + 8*j, 8);
+            res.push_back(val);
+         }
+      }
+   return i;
+}
+
+
+/* 4 shifted loads cover 32 byte positions of 4-byte values per step */
+__attribute__((target("avx2")))
+static size_t scan_range_avx2_4(const uint8_t* p, size_t n, uint32_t lo,
+uint32_t span, vector<uint64_t>& res) {
+   auto bias = _mm256_set1_epi32(INT32_MIN);
+   auto vlo = _mm256_set1_epi32((int32_t)lo);
+   auto vspan = _mm256_set1_epi32((int32_t)(span ^ (uint32_t)INT32_MIN));
+   size_t i = 0;
+   for (; i + 36 <= n; i += 32)
+      for (int k = 0; k < 4; ++k) {
+         auto v = _mm256_loadu_si256((const __m256i*)(p + i + k));
+         auto d = _mm256_xor_si256(_mm256_sub_epi32(v, vlo), bias);
+         auto out = _mm256_cmpgt_epi32(d, vspan);
+         auto mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(out)) & 0xff;
+         while (mask != 0) {
+            auto j = __builtin_ctz(mask);
+            mask &= mask - 1;
+            uint32_t val;
+            std::memcpy(&val, p + i + k + 4*j, 4);
+            res.push_back(val);
+         }
+      }
+   return i;
+}
+#endif
+
+
 unordered_set<IMM> ELF_x86::stored_cptrs(const Object& info, uint8_t size) {
    unordered_set<IMM> cptrs;
-   for (IMM offset = 0; offset < (IMM)(info.raw_bytes.size()-size+1); ++offset) {
-      auto val = ELF_x86::read(info, offset, size);
-      if (ELF_x86::code_ptr(info, val))
-         cptrs.insert(val);
+   if (info.code_segment.empty())
+      return cptrs;
+
+   /* bounds of all code ranges: cheap filter before the exact code_ptr() */
+   uint64_t lo = UINT64_MAX;
+   uint64_t hi = 0;
+   for (auto [l,h]: info.code_segment) {
+      lo = std::min<uint64_t>(lo, (uint64_t)l);
+      hi = std::max<uint64_t>(hi, (uint64_t)h);
+   }
+   auto span = hi - lo;
+   auto span4 = std::min<uint64_t>(span, UINT32_MAX - std::min<uint64_t>(lo, UINT32_MAX));
+   #if HAVE_AVX2_SCAN
+   static const bool avx2 = __builtin_cpu_supports("avx2");
+   #endif
+
+   /* only data that is loaded but not executable can hold stored cptrs */
+   vector<uint64_t> candidates;
+   for (auto const& sec: info.sections) {
+      if (!(sec.flags & SHF_ALLOC) || (sec.flags & SHF_EXECINSTR) ||
+      sec.type == SHT_NOBITS || sec.offset >= info.raw_bytes.size())
+         continue;
+      auto p = info.raw_bytes.data() + sec.offset;
+      auto n = std::min<uint64_t>(sec.size, info.raw_bytes.size() - sec.offset);
+      size_t from = 0;
+      switch (size) {
+         case 8:
+            #if HAVE_AVX2_SCAN
+            if (avx2)
+               from = scan_range_avx2_8(p, n, lo, span, candidates);
+            #endif
+            scan_range<uint64_t>(p, from, n, lo, span, candidates);
+            break;
+         case 4:
+            if (lo > UINT32_MAX)
+               break;
+            #if HAVE_AVX2_SCAN
+            if (avx2)
+               from = scan_range_avx2_4(p, n, (uint32_t)lo, (uint32_t)span4,
+                                        candidates);
+            #endif
+            scan_range<uint32_t>(p, from, n, lo, span4, candidates);
+            break;
+         case 2:
+            scan_range<uint16_t>(p, from, n, lo, span, candidates);
+            break;
+         case 1:
+            scan_range<uint8_t>(p, from, n, lo, span, candidates);
+            break;
+      }
    }
+
+   for (auto val: candidates)
+      if (ELF_x86::code_ptr(info, (IMM)val))
+         cptrs.insert((IMM)val);
    return cptrs;
 }
 
 
-unordered_set<IMM> ELF_x86::definite_fptrs(const Object& info, const string& file) {
-   // 等效命令 readelf --dyn-syms a.out | grep 'FUNC' | grep -v 'UND' | awk '{print $2}' | sed 's/^0*//' > /tmp/temp
+unordered_set<IMM> ELF_x86::definite_fptrs(const Object& info) {
+   unordered_set<IMM> fptrs;
+   auto add = [&](uint64_t fptr) {
+      if (ELF_x86::code_ptr(info, (IMM)fptr))
+         fptrs.insert((IMM)fptr);
+   };
+
    // 从动态符号表中提取文件中定义的动态函数的地址。
-   auto cmd = string("readelf --dyn-syms ") + file
-            + string("| grep 'FUNC' | grep -v 'UND' ")
-            + string("| awk '{print $2}' | sed 's/^0*//' > ")
-            + Framework::d_session + string("temp; ")
-   //等效命令 readelf -Wr a.out | grep 'R_X86_64_RELATIVE\|R_X86_64_IRELATIVE' | awk '{print $4}' | sed 's/^0*//' >> /tmp/temp
+   for (auto const& sym: info.dynsym)
+      if (sym.type == STT_FUNC && sym.shndx != SHN_UNDEF)
+         add(sym.value);
+
    //提取与相对地址重定位相关的目标地址，通常是数据段或函数指针的初始化值。
    // R_X86_64_RELATIVE：表示直接相对地址重定位，通常用于初始化数据段中的指针。
    // R_X86_64_IRELATIVE：表示间接相对地址重定位，通常涉及运行时计算的地址（如函数指针）。
-            + string("readelf -Wr ") + file
-            + string("| grep 'R_X86_64_RELATIVE\\|R_X86_64_IRELATIVE' ")
-            + string("| awk '{print $4}' | sed 's/^0*//' >> ")
-            + Framework::d_session + string("temp; ")
-   // 等效命令 objdump -d a.out | grep 'callq  ' | grep -v '\*' | grep '^  ' | awk '{print $(NF-1)}' | sort -u >> /tmp/temp
-   // 提取反汇编中直接 callq 指令的目标地址，通常是函数入口点或 PLT 条目
-            + string("objdump -d ") + file
-             + string("| grep 'callq  ' | grep -v '\\*' | grep '^  ' ")
-             + string("| awk '{print $(NF-1)}' | sort -u >> ")
-             + Framework::d_session + string("temp");
-   (void)!system(cmd.c_str());
+   for (auto const* rels: {&info.rela_dyn, &info.rela_plt})
+      for (auto const& rel: *rels)
+         if (rel.type == R_X86_64_RELATIVE || rel.type == R_X86_64_IRELATIVE)
+            add(rel.addend);
 
-   string s;
-   unordered_set<IMM> fptrs;
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   while (getline(f1,s)) {
-      auto fptr = stoull("0x"+s, nullptr, 16);
-      if (ELF_x86::code_ptr(info, fptr))
-         fptrs.insert(stoull("0x"+s, nullptr, 16));
-   }
-   f1.close();
+   // 提取直接 call 指令的目标地址，通常是函数入口点或 PLT 条目
+   // call_insns() 按字节扫描，只保留起点是已知指令的 call
+   for (auto [call, target]: ELF_x86::call_insns(info))
+      if (ELF_x86::code_ptr(info, call))
+         add(target);
 
    return fptrs;
 }
 
 // ELF_x86::noreturn_fptrs 是一个分析工具，通过解析 ELF 文件的重定位表和导入符号，找出调用不可返回函数的地址。
-unordered_set<IMM> ELF_x86::noreturn_fptrs(const string& file) {
-   // 过滤出类型为 R_X86_64_JUMP_SLOT 的重定位条目，这些条目通常与动态链接的函数调用（如通过 PLT 表）相关。
-   // 从每一行提取第 1 列（偏移地址）和第 5 列（符号名）。
-   // 删去前导0。删去版本号
-   auto cmd = string("readelf -r ") + file
-            + string(" | grep 'R_X86_64_JUMP_SLO' | awk '{print $1, $5}'")
-            + string(" | sed 's/^0*//' | cut -d'@' -f1 > ")
-            + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-// 筛选出与不可返回函数对应的重定位地址   
-   string s;
+unordered_set<IMM> ELF_x86::noreturn_fptrs(const Object& info) {
+   // 类型为 R_X86_64_JUMP_SLOT 的重定位条目，这些条目通常与动态链接的函数调用（如通过 PLT 表）相关。
+   // 筛选出与不可返回函数对应的重定位地址（GOT 表项）
    unordered_set<IMM> sym_noret;
-   // 
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   while (getline(f1, s)) {
-      auto sym_name = s.substr(s.find(" ") + 1, string::npos);
+   for (auto const& rel: info.rela_plt) {
+      if (rel.type != R_X86_64_JUMP_SLOT || rel.sym >= info.dynsym.size())
+         continue;
+      auto const& sym_name = info.dynsym[rel.sym].name;
       for (auto const& noret: noreturn_definite)
          if (sym_name.compare(noret) == 0) {
-            sym_noret.insert(Util::to_int("0x" + s.substr(0, s.find(" "))));
+            sym_noret.insert((IMM)rel.offset);
             break;
          }
    }
-   f1.close();
 
    // 
    unordered_set<IMM> res;
-   for (auto [call, sym]: ELF_x86::import_symbols(file))
+   for (auto [call, sym]: ELF_x86::import_symbols(info))
       if (sym_noret.contains(sym))
          res.insert(call);
    return res;
@@ -213,331 +518,218 @@ IMM to_big_endian(IMM val) {
 
 //通过.rel.dyn重定位表，找到所有的待重定位的虚表地址
 // 虚表会在加载的时候被重定位，而加载到实际的内存中
-std::tuple<bool, IMM ,unordered_map<IMM, unordered_set<IMM>>> ELF_x86::vtables_by_rel(const string& file){
+std::tuple<bool, IMM ,unordered_map<IMM, unordered_set<IMM>>> ELF_x86::vtables_by_rel(const Object& info){
    // 实际虚函数地址 -- 虚表中的表项们（可能有多个）
    unordered_map<IMM, unordered_set<IMM>>  res;
-   bool striped;
 /* 
-请根据上面的代码，按照下面的逻辑生成地址：
-1.查看elf中的.rel.dyn段，寻找所有的待重定位地址
+1.查看elf中的.rela.dyn段，寻找所有的待重定位地址
 2.筛选出上述地址中地址处于.data.rel.ro段中的
 3.得到的地址再查看地址开始的8字节数据，以该数据为地址，在符号表中查看是否存在
 最后得到满足上述3种条件的地址
-*/    // 打开文件
-   std::ifstream elf_file(file, std::ios::binary);
-   if (!elf_file) {
-      std::cerr << "Failed to open ELF file\n";
-      return {false,0,res};
-   }
-
-   // 读取 ELF 文件头
-   Elf64_Ehdr elf_header;
-   elf_file.read(reinterpret_cast<char*>(&elf_header), sizeof(Elf64_Ehdr));
-   if (std::strncmp(reinterpret_cast<char*>(&elf_header.e_ident[0]), "\x7f\x45\x4c\x46", 4) != 0) {
-      std::cerr << "Not a valid ELF file\n";
-      return {false,0,res};
-   }
-
-   // 获取程序头信息并查找 .rel.dyn 段
-   std::vector<Elf64_Phdr> program_headers(elf_header.e_phnum);
-   elf_file.seekg(elf_header.e_phoff, std::ios::beg);
-   elf_file.read(reinterpret_cast<char*>(program_headers.data()), elf_header.e_phnum * sizeof(Elf64_Phdr));
-   if (!elf_file) {
-      std::cerr << "Failed to read program headers\n";
-      return {false,0,res};
-   }
-
-   Elf64_Shdr data_rel_ro_section;
-   Elf64_Shdr rel_dyn_section;
-   
-   bool found_data_rel_ro = false;
-   std::vector<Elf64_Rela> relocations;
-
-   // 读取 ELF 文件中的节头信息
-   std::vector<Elf64_Shdr> section_headers(elf_header.e_shnum);
-   elf_file.seekg(elf_header.e_shoff, std::ios::beg);  // 定位到段头表的位置
-   elf_file.read(reinterpret_cast<char*>(section_headers.data()), elf_header.e_shnum * sizeof(Elf64_Shdr)); // 读取段头信息
-   // if (!elf_file) {
-   //    std::cerr << "Failed to read section headers.\n";
-   //    return res; // 如果读取失败，则返回空结果
-   // }
-
-   // 读取节名称字符串表（.shstrtab）
-   Elf64_Shdr shstrtab_section = section_headers[elf_header.e_shstrndx];
-   std::vector<char> shstrtab_data(shstrtab_section.sh_size);
-   elf_file.seekg(shstrtab_section.sh_offset, std::ios::beg);
-   elf_file.read(shstrtab_data.data(), shstrtab_section.sh_size);
-   if (!elf_file) {
-      std::cerr << "Failed to read .shstrtab\n";
-      return {false,0,res};
-   }
-
-   // 遍历端头信息，查找".rel.dyn"节
-   for (const auto& section : section_headers) {
-      if (section.sh_name == 0) continue; // 跳过无效节
-
-      // 获取节的名字，使用 sh_name 来从 .shstrtab 中获取字符串
-      std::string section_name(&shstrtab_data[section.sh_name]);
-      if (section_name == ".rela.dyn") {
-         rel_dyn_section = section;
-
-         elf_file.seekg(rel_dyn_section.sh_addr, std::ios::beg);
-
-         // 获取 .rel.dyn 段的大小
-         size_t remaining_size = rel_dyn_section.sh_size;
-         
-         // 读取重定位信息
-         Elf64_Rela relocation;
-         while (remaining_size >= sizeof(Elf64_Rela) && elf_file.read(reinterpret_cast<char*>(&relocation), sizeof(Elf64_Rela))) {
-            if(relocation.r_info == R_X86_64_RELATIVE){
-               relocations.push_back(relocation);
-            }
-            remaining_size -= sizeof(Elf64_Rela);  // 更新剩余的大小
-         }
-         
-         // 检查读取是否超出了段的大小
-         if (remaining_size != 0) {
-            std::cerr << "Warning: Read beyond the size of .rel.dyn section." << std::endl;
-         }
-
-         break;
-      }
-   }
-
-
-
-   // 遍历段头信息，查找 ".data.rel.ro" 节
-   for (const auto& section : section_headers) {
-      if (section.sh_name == 0) continue; // 跳过无效节
-
-      // 获取节的名字，使用 sh_name 来从 .shstrtab 中获取字符串
-      std::string section_name(&shstrtab_data[section.sh_name]);
-      if (section_name == ".data.rel.ro") {
-         data_rel_ro_section = section;
-         found_data_rel_ro = true;
-         break;
-      }
-   }
-
-   if (!found_data_rel_ro) {
+*/
+   auto data_rel_ro = ELF_x86::section(info, ".data.rel.ro");
+   if (data_rel_ro == nullptr)
       return {false,0,res};
-   }
-
-   std::vector<Elf64_Sym> symbol_table;
-
-   
-   // 遍历节头查找符号表节 (.symtab 和 .dynsym)
-   for (const auto& section : section_headers) {
-      if (section.sh_type == SHT_SYMTAB || section.sh_type == SHT_DYNSYM) {
-            // 获取节的名字
-            std::string section_name(&shstrtab_data[section.sh_name]);
-
-            // 如果是符号表节（.symtab 或 .dynsym）
-            if (section_name == ".symtab" || section_name == ".dynsym") {
-               // 读取符号表的内容
-               elf_file.seekg(section.sh_offset, std::ios::beg);
-               size_t num_symbols = section.sh_size / sizeof(Elf64_Sym);
-               
-               // 将读取的符号表内容添加到符号表中
-               std::vector<Elf64_Sym> section_symbol_table(num_symbols);
-               elf_file.read(reinterpret_cast<char*>(section_symbol_table.data()), section.sh_size);
-
-               if (!elf_file) {
-                  striped == true;
-               }else{
-                  striped = false;
-               }
 
-               // 将当前符号表合并到总符号表中
-               symbol_table.insert(symbol_table.end(), section_symbol_table.begin(), section_symbol_table.end());
-            }
-      }
-   }
+   // 没有符号表时不做符号过滤
+   bool striped = info.symtab.empty() && info.dynsym.empty();
+   unordered_set<uint64_t> func_syms;
+   for (auto const* syms: {&info.symtab, &info.dynsym})
+      for (auto const& sym: *syms)
+         if (sym.type == STT_FUNC)
+            func_syms.insert(sym.value);
 
    // 计算出.data.rel.ro段的地址偏移
-   uint64_t file_offset;
-   // 查找地址所在的程序段
-   for (const auto& phdr : program_headers) {
-      // 只处理载入到内存中的段
-      if (phdr.p_type == PT_LOAD) {
-         // 获取虚拟地址段的起始地址和文件偏移
-         uint64_t segment_vaddr = phdr.p_vaddr;
-         uint64_t segment_offset = phdr.p_offset;
-
-         // 检查当前虚拟地址是否位于该段内
-         if (data_rel_ro_section.sh_addr >= segment_vaddr && data_rel_ro_section.sh_addr < segment_vaddr + phdr.p_memsz) {
-            // 将虚拟地址转换为文件地址
-            file_offset =   segment_vaddr - segment_offset;
-         }
-      }
+   IMM file_offset = 0;
+   for (auto [vaddr, foffset, fsize, msize]: info.phdr)
+      if (vaddr <= data_rel_ro->addr && data_rel_ro->addr < vaddr + msize)
+         file_offset = (IMM)(vaddr - foffset);
+
+   // 查找符合条件的重定位地址
+   auto lo = data_rel_ro->addr;
+   auto hi = data_rel_ro->addr + data_rel_ro->size;
+   for (auto const& rel: info.rela_dyn) {
+      if (rel.type != R_X86_64_RELATIVE || rel.offset < lo || rel.offset >= hi)
+         continue;
+      // 读取地址起始的8字节数据，作为新地址
+      auto new_address = (IMM)ELF_x86::read(info, (int64_t)rel.offset, 8);
+      if (striped || func_syms.contains((uint64_t)new_address))
+         res[new_address].insert((IMM)rel.offset);
    }
 
-    // 查找符合条件的重定位地址
-    for (const auto& relocation : relocations) {
-        uint64_t address = relocation.r_offset;
-
-        // 检查地址是否位于 .data.rel.ro 段内
-        if (address >= data_rel_ro_section.sh_addr && address < data_rel_ro_section.sh_addr + data_rel_ro_section.sh_size) {
-
-            // 读取地址起始的8字节数据，作为新地址
-            address -= file_offset;
-            elf_file.seekg(address, std::ios::beg);
-            IMM new_address = 0;
-            elf_file.read(reinterpret_cast<char*>(&new_address), sizeof(IMM));
-            // new_address = to_big_endian(new_address);
-            if(striped)   {
-               res[new_address].insert(address);
-               continue;
-            }
-
-            // 检查符号表中是否有该地址
-            for (const auto& symbol : symbol_table) {
-                if (symbol.st_value == new_address && ELF64_ST_TYPE(symbol.st_info) == STT_FUNC) {
-                    res[new_address].insert(address+file_offset); // 插入符合条件的地址
-                    break;
-                }
-            }
-        }
-    }
-
-    return {striped,file_offset, res};
-
+   return {striped,file_offset, res};
 }
 
 // 找到以立即数地址进行call 无返回函数的call指令地址
-unordered_set<IMM> ELF_x86::noreturn_calls(const string& file) {
+unordered_set<IMM> ELF_x86::noreturn_calls(const Object& info) {
    unordered_set<IMM> res;
-   auto noret = noreturn_fptrs(file);
-   for (auto [offset, target]: ELF_x86::call_insns(file))
+   auto noret = noreturn_fptrs(info);
+   for (auto [offset, target]: ELF_x86::call_insns(info))
       if (noret.contains(target))
          res.insert(offset);
    return res;
 }
 
-// 反汇编：调用 objdump 将 ELF 文件反汇编为汇编指令和原始字节。
-// 精简汇编代码：清理冗余前缀、替换无效指令、格式化数值，最终生成适合阅读的汇编代码，保存到 f_asm。
-// 提取原始字节：将每条指令的机器码（十六进制字节）保存到 f_raw。
-// 临时文件管理：使用 Framework::d_session 下的临时文件存储中间结果。
-void ELF_x86::disassemble(const string& file, const string& f_asm, const
-string& f_raw) {
-   /* disassembly */
-   string s;
-   auto cmd = string("objdump --prefix-addresses -M intel -d ") + file
-            + string("| cut -d' ' -f1,3- | cut -d'<' -f1 | cut -d'#' -f1 ")
-            + string("| grep '^0' > ") + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-
-   static array<string,7> rm_prefix = {" bnd ", " lock ", " data16 ",
-                        " addr32 ", " rep ", " repz ", " repnz "};
-   static array<string,4> rm_pattern = {"*1]", "*1-", "*1+", "+0x0]"};
-   static array<string,3> to_hlt = {"int1", "int3", "icebp"};
-   static array<string,11> to_nop = {"rex", "(bad)", "FWORD", "?", "riz",
-                        " fs ", " ss ", " ds ", " cs ", " gs ", " es "};
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   fstream f2(f_asm, fstream::out);
-   while (getline(f1,s)) {
-      auto p1 = s.find_first_not_of("0");
-      auto p2 = s.find(" ",p1);
-      auto offset = Util::to_int("0x" + s.substr(p1,p2-p1));
-
-      /* skip faulty */
-      auto skip_insn = false;
-      for (auto const& x: to_nop)
-         if (s.find(x) != string::npos) {
-            f2 << ".L" << offset << " nop\n";
-            skip_insn = true;
-            break;
-         }
-      if (skip_insn)
+// 反汇编：用内置的 Decoder 线性扫描可执行节，输出与原 objdump 清理后的结果一致。
+// 每个符号处重新同步，连续的 0 字节按 objdump 的规则跳过。
+// 每条指令以 (地址, 汇编, 机器码, 长度) 交给 emit。
+void ELF_x86::disassemble(const Object& info, const function<void(uint64_t,
+const string&,const uint8_t*,uint8_t)>& emit) {
+   auto const& raw = info.raw_bytes;
+   auto const& syms = info.symtab.empty()? info.dynsym: info.symtab;
+   string itc;
+
+   for (size_t idx = 0; idx < info.sections.size(); ++idx) {
+      auto const& sec = info.sections[idx];
+      if (!(sec.flags & SHF_EXECINSTR) || sec.type == SHT_NOBITS ||
+      sec.size == 0 || sec.offset + sec.size > raw.size())
          continue;
 
-      /* refine */
-      for (auto const& x: to_hlt)
-         if (s.find(x) != string::npos) {
-            s.replace(p2+1, string::npos, "hlt");
-            break;
+      /* objdump restarts decoding at every symbol of the section, */
+      /* and data objects placed in code are not disassembled       */
+      map<uint64_t,bool> data;
+      for (auto const& sym: syms)
+         if (sym.shndx == idx && !sym.name.empty() && sym.type != STT_SECTION
+         && sym.type != STT_FILE && sym.value >= sec.addr &&
+         sym.value < sec.addr + sec.size) {
+            auto obj = (sym.type == STT_OBJECT);
+            auto [it, fresh] = data.insert({sym.value, obj});
+            if (!fresh)
+               it->second = it->second && obj;
          }
-      if (s.find("rep stos")==string::npos && s.find("repz cmps")==string::npos)
-         for (auto const& x: rm_prefix) {
-            auto it = s.find(x);
-            while (it != string::npos) {
-               s.erase(it, x.length()-1);
-               it = s.find(x);
+      data.insert({sec.addr, false});
+      data[sec.addr + sec.size] = false;
+
+      auto code = raw.data() + sec.offset;
+      for (auto it = data.begin(); std::next(it) != data.end(); ++it) {
+         if (it->second)
+            continue;
+         auto pos = it->first - sec.addr;
+         auto stop = std::next(it)->first - sec.addr;
+         while (pos < stop) {
+            /* skip zeros: 8+ bytes (a multiple of 4 unless it reaches the */
+            /* stop), or fewer than 3 bytes right before the stop           */
+            auto z = pos;
+            while (z < stop && code[z] == 0)
+               ++z;
+            if (z - pos >= 8 || (z == stop && z - pos < 3)) {
+               pos = (z == stop)? z: pos + ((z - pos) & ~(uint64_t)3);
+               continue;
             }
-         }
-      for (auto const& x: rm_pattern) {
-         p1 = s.find(x);
-         while (p1 != string::npos) {
-            s.erase(p1, x.length()-1);
-            p1 = s.find(x);
+
+            auto addr = sec.addr + pos;
+            auto len = Decoder::decode(code + pos, stop - pos, addr, itc);
+            emit(addr, itc, code + pos, len);
+            pos += len;
          }
       }
+   }
+}
 
-      /* prepend 0x to hex */
-      auto itc = s.substr(s.find(" ")+1, string::npos);
-      p1 = itc.find(" 0");
-      if (p1 != string::npos && p1 < itc.length()-2 && itc[p1+2] != 'x') {
-         ++p1;
-         p2 = itc.find_first_not_of("0",p1);
-         auto val = Util::to_int("0x" + itc.substr(p2,string::npos));
-         itc.replace(p1, string::npos, std::to_string(val));
-      }
-      p1 = itc.find(" fff");
-      if (p1 != string::npos)
-         itc.insert(p1+1, "0x");
 
-      f2 << ".L" << offset << " " << itc << "\n";
-   }
+// 汇编写入 f_asm（".L<addr> <itc>"），每条指令的机器码（十六进制字节）写入 f_raw。
+void ELF_x86::disassemble(const Object& info, const string& f_asm, const
+string& f_raw) {
+   static const char* const digits = "0123456789abcdef";
+   fstream f1(f_asm, fstream::out);
+   fstream f2(f_raw, fstream::out);
+   string bytes;
+   disassemble(info, [&](uint64_t addr, const string& itc, const uint8_t* code,
+   uint8_t len) {
+      f1 << ".L" << addr << " " << itc << "\n";
+      bytes.clear();
+      for (uint8_t i = 0; i < len; ++i) {
+         if (i > 0)
+            bytes += ' ';
+         bytes += digits[code[i] >> 4];
+         bytes += digits[code[i] & 0xf];
+      }
+      f2 << bytes << "\n";
+   });
    f1.close();
    f2.close();
-
-   /* raw bytes */
-   cmd = string("objdump --prefix-addresses --show-raw-insn -d ") + file
-       + string(" | grep '^0' | cut -d'\t' -f1 | cut -d' ' -f3-")
-       + string(" | awk '{$1=$1;print}' > ") + f_raw;
-   (void)!system(cmd.c_str());
 }
 
 
-vector<pair<IMM,IMM>> ELF_x86::import_symbols(const string& file) {
-   // 提取出所有包含jmp 和rip的指令 ，即直接跳转
-   auto cmd = string("objdump --prefix-addresses --no-show-raw-insn -M intel -d ")
-            + file + string(" | grep -P 'jmp.*\\[rip'")
-            + string (" | awk '{print $1 \"\\n\" $(NF-1)}'")
-            + string(" | sed 's/^0*//' | paste -d ' ' - - > ")
-            + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-   // 以键值对的形式存储跳转指令的地址和目标地址
-   string s;
+// 提取 PLT 桩中的 jmp [rip+X]，以键值对的形式存储跳转指令的地址和 GOT 表项地址
+// 带 endbr64 的桩（.plt.sec）同时记录桩的入口地址，因为 call 指向入口
+vector<pair<IMM,IMM>> ELF_x86::import_symbols(const Object& info) {
+   auto const& raw = info.raw_bytes;
    vector<pair<IMM,IMM>> res;
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   while (getline(f1, s)) {
-      auto addr_call = Util::to_int("0x"+s.substr(0,s.find(" ")));
-      auto addr_sym = Util::to_int("0x"+s.substr(s.find(" ")+1, string::npos));
-      res.push_back({addr_call, addr_sym});
+   for (auto const& sec: info.sections) {
+      if (sec.name.rfind(".plt", 0) != 0 || sec.type == SHT_NOBITS)
+         continue;
+      auto lo = sec.offset;
+      auto hi = std::min<uint64_t>(sec.offset + sec.size, raw.size());
+      uint64_t endbr = 0;
+      for (auto p = lo; p < hi;) {
+         auto b = raw.data() + p;
+         auto n = hi - p;
+         auto addr = sec.addr + (p - lo);
+         auto match = [&](std::initializer_list<uint8_t> pattern) {
+            if (n < pattern.size())
+               return false;
+            return std::equal(pattern.begin(), pattern.end(), b);
+         };
+         /* endbr64 */
+         if (match({0xf3, 0x0f, 0x1e, 0xfa})) {
+            endbr = addr;
+            p += 4;
+         }
+         /* (bnd) jmp QWORD PTR [rip+disp32] */
+         else if (match({0xff, 0x25}) || match({0xf2, 0xff, 0x25})) {
+            auto len = (b[0] == 0xf2)? 7: 6;
+            if (n < (uint64_t)len)
+               break;
+            int32_t disp;
+            std::memcpy(&disp, b + len - 4, 4);
+            auto slot = (IMM)(addr + len + disp);
+            res.push_back({(IMM)addr, slot});
+            if (endbr != 0 && endbr + 4 == addr)
+               res.push_back({(IMM)endbr, slot});
+            p += len;
+         }
+         /* push QWORD PTR [rip+disp32], (bnd) jmp rel32, push imm32, nops */
+         else if (match({0xff, 0x35}) || match({0xf2, 0xe9}) ||
+                  match({0x66, 0x0f, 0x1f, 0x44}))
+            p += 6;
+         else if (match({0x68}) || match({0xe9}) || match({0x0f, 0x1f, 0x44}))
+            p += 5;
+         else if (match({0x0f, 0x1f, 0x40}))
+            p += 4;
+         else if (match({0x0f, 0x1f, 0x80}))
+            p += 7;
+         else
+            p += 1;
+      }
    }
-   f1.close();
    return res;
 }
 
 // 提取所有call + 立即数地址的指令，将其指令地址和目标地址以键值对存起来
-vector<pair<IMM,IMM>> ELF_x86::call_insns(const string& file) {
-   auto cmd = string("objdump --prefix-addresses --no-show-raw-insn -M intel -d ")
-            + file + string(" | cut -d' ' -f1,3- | grep -P 'call   [0-9]+' ")
-            + string (" | awk '{print $1 \"\\n\" $3}'")
-            + string(" | sed 's/^0*//' | paste -d ' ' - - > ")
-            + Framework::d_session + "temp";
-   (void)!system(cmd.c_str());
-
-   string s;
+// 按字节扫描可执行节中的 e8 rel32，目标必须落在代码段内；
+// 结果是直接 call 的超集，在指令起点上是精确的
+vector<pair<IMM,IMM>> ELF_x86::call_insns(const Object& info) {
+   auto const& raw = info.raw_bytes;
    vector<pair<IMM,IMM>> res;
-   fstream f1(Framework::d_session + "temp", fstream::in);
-   while (getline(f1, s)) {
-      auto insn_call = Util::to_int("0x"+s.substr(0,s.find(" ")));
-      auto addr_call = Util::to_int("0x"+s.substr(s.find(" ")+1, string::npos));
-      res.push_back({insn_call, addr_call});
+   for (auto const& sec: info.sections) {
+      if (!(sec.flags & SHF_EXECINSTR) || sec.type == SHT_NOBITS)
+         continue;
+      auto lo = sec.offset;
+      auto hi = std::min<uint64_t>(sec.offset + sec.size, raw.size());
+      for (auto p = lo; p + 5 <= hi; ++p)
+         if (raw[p] == 0xe8) {
+            int32_t disp;
+            std::memcpy(&disp, raw.data() + p + 1, 4);
+            auto insn_call = sec.addr + (p - lo);
+            auto addr_call = insn_call + 5 + disp;
+            for (auto [l,h]: info.code_segment)
+               if ((uint64_t)l <= addr_call && addr_call <= (uint64_t)h) {
+                  res.push_back({(IMM)insn_call, (IMM)addr_call});
+                  break;
+               }
+         }
    }
-   f1.close();
    return res;
 }
 
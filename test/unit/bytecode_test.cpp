@@ -0,0 +1,184 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* Bytecode::eval() against the recursive Expr::eval(): the functions of a   */
+/* sample binary are analyzed, then every block is replayed as track() does  */
+/* and each sub-expression of each insn is evaluated both ways on the same   */
+/* State, before the insn executes. The values must be identical.           */
+/* usage: bytecode_test <dir or binary>...                                  */
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/state.h"
+#include "../../include/sba/domain.h"
+#include "../../include/sba/program.h"
+#include "../../include/sba/function.h"
+#include "../../include/sba/scc.h"
+#include "../../include/sba/block.h"
+#include "../../include/sba/insn.h"
+#include "../../include/sba/bytecode.h"
+#include "../../include/sba/rtl.h"
+#include "../../include/sba/expr.h"
+#include "sample.h"
+#include <iostream>
+
+using namespace SBA;
+
+static function<void(const UnitId&, AbsVal&)> init = [](const UnitId& id,
+AbsVal& out) -> void {
+   ABSVAL(BaseLH,out) = !bounded(id.r(),id.i())? BaseLH(BaseLH::T::TOP):
+                                                 BaseLH(get_sym(id));
+   if (id.r() == REGION::REGISTER &&
+   SYSTEM::call_args.contains((SYSTEM::Reg)(id.i())))
+      ABSVAL(BaseStride,out) = BaseStride(BaseStride::T::DYNAMIC);
+   else
+      ABSVAL(BaseStride,out) = BaseStride(BaseStride::T::TOP);
+   ABSVAL(Taint,out) = SYSTEM::call_args.contains((SYSTEM::Reg)(id.i()))?
+                       Taint(0x0): Taint(0xffffffff);
+};
+
+
+/* every expression of a statement, parents before operands */
+static void collect(Expr* e, vector<Expr*>& out) {
+   if (e == nullptr)
+      return;
+   out.push_back(e);
+   switch (e->expr_type()) {
+      case Expr::EXPR_TYPE::VAR:
+         if (((Var*)e)->var_type() == Var::VAR_TYPE::MEM)
+            collect(((Mem*)e)->addr(), out);
+         break;
+      case Expr::EXPR_TYPE::SUBREG:
+         collect(((SubReg*)e)->expr(), out);
+         break;
+      case Expr::EXPR_TYPE::IFELSE:
+         collect(((IfElse*)e)->cmp_expr(), out);
+         collect(((IfElse*)e)->if_expr(), out);
+         collect(((IfElse*)e)->else_expr(), out);
+         break;
+      case Expr::EXPR_TYPE::CONVERSION:
+         collect(((Conversion*)e)->expr(), out);
+         collect(((Conversion*)e)->size(), out);
+         collect(((Conversion*)e)->pos(), out);
+         break;
+      case Expr::EXPR_TYPE::ARITHMETIC:
+         switch (((Arithmetic*)e)->arith_type()) {
+            case Arithmetic::ARITH_TYPE::UNARY:
+               collect(((Unary*)e)->operand(), out);
+               break;
+            case Arithmetic::ARITH_TYPE::BINARY:
+               collect(((Binary*)e)->operand(0), out);
+               collect(((Binary*)e)->operand(1), out);
+               break;
+            case Arithmetic::ARITH_TYPE::COMPARE:
+               collect(((Compare*)e)->expr(), out);
+               break;
+         }
+         break;
+      default:
+         break;
+   }
+}
+
+
+static void collect(Statement* stmt, vector<Expr*>& out) {
+   if (stmt == nullptr)
+      return;
+   switch (stmt->stmt_type()) {
+      case Statement::STATEMENT_TYPE::PARALLEL:
+         for (auto s: ((Parallel*)stmt)->stmts())
+            collect(s, out);
+         break;
+      case Statement::STATEMENT_TYPE::SEQUENCE:
+         for (auto s: ((Sequence*)stmt)->stmts())
+            collect(s, out);
+         break;
+      case Statement::STATEMENT_TYPE::ASSIGN:
+         collect(((Assign*)stmt)->dst(), out);
+         collect(((Assign*)stmt)->src(), out);
+         break;
+      case Statement::STATEMENT_TYPE::CALL:
+         collect(((Call*)stmt)->target(), out);
+         break;
+      case Statement::STATEMENT_TYPE::CLOBBER:
+         collect(((Clobber*)stmt)->expr(), out);
+         break;
+      default:
+         break;
+   }
+}
+
+
+/* replay the blocks of an analyzed function, like Function::track() */
+static size_t compare(Function* f, const State::StateConfig& conf,
+size_t& count, const string& file) {
+   size_t diff = 0;
+   Bytecode bytecode;
+   State s(f, conf);
+   s.loc.func = f;
+   vector<Expr*> exprs;
+   for (auto scc: f->scc_list()) {
+      s.loc.scc = scc;
+      for (auto b: scc->block_list()) {
+         s.loc.block = b;
+         s.refresh();
+         for (auto i: b->insn_list()) {
+            s.loc.insn = i;
+            exprs.clear();
+            collect(i->stmt(), exprs);
+            for (auto e: exprs) {
+               auto x = bytecode.eval(s, e).to_string();
+               auto y = e->eval(s).to_string();
+               ++count;
+               if (x != y && ++diff <= 10)
+                  std::cerr << file << ": insn " << i->offset() << " "
+                            << e->to_string() << "\n   bytecode:  [" << x
+                            << "]\n   recursive: [" << y << "]\n";
+            }
+            i->execute(s);
+         }
+         s.clear_track();
+      }
+   }
+   return diff;
+}
+
+
+/* number of differing values, the first few are printed */
+static size_t check(const string& file) {
+   SYSTEM::Object info;
+   vector<tuple<IMM,RTL*,vector<uint8_t>>> offset_rtl_raw;
+   vector<IMM> fptr_list;
+   if (!sample(file, info, offset_rtl_raw, fptr_list)) {
+      std::cerr << file << ": failed to load\n";
+      return 1;
+   }
+
+   State::StateConfig conf{true, true, false, 1, &init};
+   Program p(file, std::move(info), offset_rtl_raw, fptr_list, {});
+   size_t diff = 0;
+   size_t count = 0;
+   size_t funcs = 0;
+   for (auto fptr: fptr_list) {
+      auto f = p.func(fptr);
+      if (f == nullptr)
+         continue;
+      f->analyze(conf, &p);
+      diff += compare(f, conf, count, file);
+      f->clear();
+      ++funcs;
+   }
+   std::cout << file << ": " << funcs << " functions, " << count
+             << " values, " << diff << " differing\n";
+   return (funcs == 0 || count == 0)? 1: diff;
+}
+
+
+
+int main(int argc, char** argv) {
+   return for_each_binary(argc, argv, check) == 0? 0: 1;
+}
@@ -0,0 +1,191 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* CFG keeps insns and edges of blocks in windows of flat arrays that move */
+/* as they grow. Random runs of block creation, edges added to existing    */
+/* blocks, splits as Program::block_split() does them, cleared lists,      */
+/* deleted blocks whose ids are reused, and compact(), are checked after   */
+/* every step against a plain adjacency list per block. Each run ends by   */
+/* piling up enough moved windows for compact() to pack the arrays.       */
+/* usage: cfg_test                                                         */
+
+#include "../../include/sba/common.h"
+#include "../../include/sba/cfg.h"
+#include "../../include/sba/block.h"
+#include "../../include/sba/insn.h"
+#include <iostream>
+#include <random>
+
+using namespace SBA;
+
+/* lists of one block as a plain adjacency list */
+struct Model {
+   vector<Insn*> insns;
+   vector<pair<Block*,COMPARE>> succ;
+   vector<Block*> pred;
+   vector<Block*> sup;
+};
+
+
+/* number of blocks whose lists differ from the model, the first printed */
+static size_t compare(const unordered_map<Block*,Model>& model,
+const string& name, size_t step) {
+   size_t diff = 0;
+   for (auto const& [b, m]: model) {
+      auto i_list = b->insn_list();
+      auto succ = b->succ();
+      auto pred = b->pred();
+      auto sup = b->superset_preds();
+      auto same = vector<Insn*>(i_list.begin(), i_list.end()) == m.insns
+               && vector<pair<Block*,COMPARE>>(succ.begin(), succ.end())
+                  == m.succ
+               && vector<Block*>(pred.begin(), pred.end()) == m.pred
+               && vector<Block*>(sup.begin(), sup.end()) == m.sup;
+      if (!same && ++diff <= 10)
+         std::cerr << name << ": step " << step << ": block " << b->id()
+                   << " differs\n";
+   }
+   return diff;
+}
+
+
+/* steps of one run from seed, number of steps that differ */
+static size_t run(unsigned seed, size_t steps) {
+   static const COMPARE conds[] = {COMPARE::NONE, COMPARE::EQ, COMPARE::NE,
+                                   COMPARE::LT, COMPARE::GE};
+   std::mt19937 gen(seed);
+   auto name = "seed " + std::to_string(seed);
+   CFG cfg;
+   unordered_map<Block*,Model> model;
+   vector<Block*> blocks;
+   vector<Insn*> insns;
+   auto pick = [&]() {return blocks[gen() % blocks.size()];};
+
+   auto create = [&](const vector<Insn*>& i_list) {
+      auto b = new Block(cfg, i_list);
+      model[b] = Model{i_list};
+      blocks.push_back(b);
+      return b;
+   };
+   auto connect = [&](Block* u, Block* v, COMPARE c, bool back_edge) {
+      u->succ(v, c, back_edge);
+      model[u].succ.push_back({v, c});
+      if (back_edge)
+         model[v].sup.push_back(u);
+   };
+
+   size_t failed = 0;
+   size_t deleted = 0;
+   for (size_t step = 0; step < steps; ++step) {
+      auto r = blocks.empty()? 0: gen() % 100;
+      /* new block */
+      if (r < 10) {
+         vector<Insn*> i_list;
+         for (auto n = 1 + gen() % 12; n > 0; --n) {
+            insns.push_back(new Insn(4096 + insns.size(), nullptr, {0x90}));
+            i_list.push_back(insns.back());
+         }
+         create(i_list);
+      }
+      /* edge to an existing block */
+      else if (r < 55)
+         connect(pick(), pick(), conds[gen() % 5], gen() % 4 != 0);
+      /* predecessor, as SCC::dfs() adds them */
+      else if (r < 75) {
+         auto u = pick();
+         auto v = pick();
+         v->pred(u);
+         model[v].pred.push_back(u);
+      }
+      /* split as Program::block_split(): the tail takes the successors */
+      else if (r < 87) {
+         auto b = pick();
+         auto i_list = b->insn_list();
+         if (i_list.size() >= 2) {
+            uint32_t k = 1 + gen() % (i_list.size() - 1);
+            vector<Insn*> tail(model[b].insns.begin() + k,
+                               model[b].insns.end());
+            auto b_next = create(tail);
+            for (auto const& [v, c]: b->succ())
+               connect(b_next, v, c, true);
+            b->shrink_insn_list(k);
+            model[b].insns.resize(k);
+            b->shrink_succ();
+            model[b].succ.clear();
+            connect(b, b_next, COMPARE::NONE, true);
+         }
+      }
+      /* lists dropped by Block::detach() and the fall-through fix */
+      else if (r < 92) {
+         auto b = pick();
+         if (gen() % 2 == 0) {
+            b->detach();
+            model[b].pred.clear();
+         }
+         else {
+            b->shrink_succ();
+            model[b].succ.clear();
+         }
+      }
+      /* delete a block no list refers to, its id and windows are reused */
+      else if (r < 97) {
+         unordered_set<Block*> used;
+         for (auto const& [u, m]: model) {
+            for (auto const& [v, c]: m.succ)
+               used.insert(v);
+            used.insert(m.pred.begin(), m.pred.end());
+            used.insert(m.sup.begin(), m.sup.end());
+         }
+         vector<Block*> unused;
+         for (auto b: blocks)
+            if (!used.contains(b))
+               unused.push_back(b);
+         if (!unused.empty()) {
+            auto b = unused[gen() % unused.size()];
+            model.erase(b);
+            blocks.erase(std::find(blocks.begin(), blocks.end(), b));
+            delete b;
+            ++deleted;
+         }
+      }
+      else
+         cfg.compact();
+      failed += (compare(model, name, step) != 0);
+   }
+
+   /* a block deleted and built again with more insns each time, so its */
+   /* old windows pile up until compact() packs the arrays              */
+   auto b = create({insns.front()});
+   for (size_t n = 2; n <= 100; ++n) {
+      model.erase(b);
+      blocks.pop_back();
+      delete b;
+      vector<Insn*> i_list(insns.begin(), insns.begin() + n);
+      b = create(i_list);
+      for (auto v: blocks)
+         if (gen() % 8 == 0)
+            connect(b, v, COMPARE::NONE, false);
+   }
+   cfg.compact();
+   failed += (compare(model, name, steps) != 0);
+
+   for (auto b: blocks)
+      delete b;
+   for (auto i: insns)
+      delete i;
+   std::cout << name << ": " << steps << " steps, " << cfg.size()
+             << " ids, " << deleted << " deleted, " << failed << " differing\n";
+   return failed;
+}
+
+
+int main(int argc, char** argv) {
+   size_t failed = 0;
+   for (unsigned seed = 1; seed <= 20; ++seed)
+      failed += (run(seed, 3000) != 0);
+   return failed == 0? 0: 1;
+}
@@ -0,0 +1,358 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* Decoder against the objdump pipeline it replaced: every sample binary,    */
+/* every one-byte and 0f opcode with each ModRM and under each prefix, and   */
+/* every VEX opcode under each prefix and vector length, is disassembled     */
+/* both ways and the asm and raw lines must be the same.                     */
+/* usage: decoder_test <dir or binary>...                                    */
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/decoder.h"
+#include "sample.h"
+#include <filesystem>
+#include <iostream>
+#include <unistd.h>
+
+using namespace SBA;
+namespace fs = std::filesystem;
+
+/* the clean-up ELF_x86::disassemble() used to run on objdump's output */
+static bool objdump(const string& file, vector<string>& asm_lines,
+vector<string>& raw_lines) {
+   auto temp = fs::temp_directory_path() / ("sba_decoder_"
+             + std::to_string(getpid()));
+   auto cmd = string("objdump --prefix-addresses -M intel -d ") + file
+            + string("| cut -d' ' -f1,3- | cut -d'<' -f1 | cut -d'#' -f1 ")
+            + string("| grep '^0' > ") + temp.string();
+   if (system(cmd.c_str()) != 0)
+      return false;
+
+   static array<string,7> rm_prefix = {" bnd ", " lock ", " data16 ",
+                        " addr32 ", " rep ", " repz ", " repnz "};
+   static array<string,4> rm_pattern = {"*1]", "*1-", "*1+", "+0x0]"};
+   static array<string,3> to_hlt = {"int1", "int3", "icebp"};
+   static array<string,11> to_nop = {"rex", "(bad)", "FWORD", "?", "riz",
+                        " fs ", " ss ", " ds ", " cs ", " gs ", " es "};
+   string s;
+   fstream f1(temp, fstream::in);
+   while (getline(f1,s)) {
+      auto p1 = s.find_first_not_of("0");
+      auto p2 = s.find(" ",p1);
+      auto offset = Util::to_int("0x" + s.substr(p1,p2-p1));
+
+      auto skip_insn = false;
+      for (auto const& x: to_nop)
+         if (s.find(x) != string::npos) {
+            asm_lines.push_back(".L" + std::to_string(offset) + " nop");
+            skip_insn = true;
+            break;
+         }
+      if (skip_insn)
+         continue;
+
+      for (auto const& x: to_hlt)
+         if (s.find(x) != string::npos) {
+            s.replace(p2+1, string::npos, "hlt");
+            break;
+         }
+      if (s.find("rep stos")==string::npos && s.find("repz cmps")==string::npos)
+         for (auto const& x: rm_prefix) {
+            auto it = s.find(x);
+            while (it != string::npos) {
+               s.erase(it, x.length()-1);
+               it = s.find(x);
+            }
+         }
+      for (auto const& x: rm_pattern) {
+         p1 = s.find(x);
+         while (p1 != string::npos) {
+            s.erase(p1, x.length()-1);
+            p1 = s.find(x);
+         }
+      }
+
+      auto itc = s.substr(s.find(" ")+1, string::npos);
+      p1 = itc.find(" 0");
+      if (p1 != string::npos && p1 < itc.length()-2 && itc[p1+2] != 'x') {
+         ++p1;
+         p2 = itc.find_first_not_of("0",p1);
+         auto val = Util::to_int("0x" + itc.substr(p2,string::npos));
+         itc.replace(p1, string::npos, std::to_string(val));
+      }
+      p1 = itc.find(" fff");
+      if (p1 != string::npos)
+         itc.insert(p1+1, "0x");
+      asm_lines.push_back(".L" + std::to_string(offset) + " " + itc);
+   }
+   f1.close();
+
+   cmd = string("objdump --prefix-addresses --show-raw-insn -d ") + file
+       + string(" | grep '^0' | cut -d'\t' -f1 | cut -d' ' -f3-")
+       + string(" | awk '{$1=$1;print}' > ") + temp.string();
+   if (system(cmd.c_str()) != 0)
+      return false;
+   f1.open(temp, fstream::in);
+   while (getline(f1,s))
+      raw_lines.push_back(s);
+   f1.close();
+   fs::remove(temp);
+   return true;
+}
+
+
+/* raw line of one insn as objdump prints it */
+static string raw(const uint8_t* code, uint8_t len) {
+   static const char* const digits = "0123456789abcdef";
+   string bytes;
+   for (uint8_t i = 0; i < len; ++i) {
+      if (i > 0)
+         bytes += ' ';
+      bytes += digits[code[i] >> 4];
+      bytes += digits[code[i] & 0xf];
+   }
+   return bytes;
+}
+
+
+static bool decoder(const string& file, vector<string>& asm_lines,
+vector<string>& raw_lines) {
+   SYSTEM::Object info;
+   if (!SYSTEM::load(info, file))
+      return false;
+   SYSTEM::disassemble(info, [&](uint64_t addr, const string& itc,
+   const uint8_t* code, uint8_t len) {
+      asm_lines.push_back(".L" + std::to_string(addr) + " " + itc);
+      raw_lines.push_back(raw(code, len));
+   });
+   return true;
+}
+
+
+/* number of differing lines, the first few are printed */
+static size_t compare(const string& file, const char* what,
+const vector<string>& x, const vector<string>& y) {
+   size_t diff = 0;
+   for (size_t i = 0; i < std::max(x.size(), y.size()); ++i) {
+      auto const& a = i < x.size()? x[i]: string("<none>");
+      auto const& b = i < y.size()? y[i]: string("<none>");
+      if (a == b)
+         continue;
+      if (++diff <= 10)
+         std::cerr << file << ": " << what << " line " << i+1
+                   << "\n   objdump: [" << a << "]\n   decoder: [" << b
+                   << "]\n";
+   }
+   return diff;
+}
+
+
+/* encodings the sample binaries lack: AVX-512, opmask, FMA4, XOP, gathers, */
+/* 16-bit operand and 32-bit address sizes, HLE hints and 0f c7 memory     */
+static size_t fixed() {
+   static const vector<pair<vector<uint8_t>,string>> cases = {
+      {{0xc4,0xe1,0xf8,0x90,0xca}, "kmovq  k1,k2"},
+      {{0xc5,0xf8,0x90,0x08}, "kmovw  k1,WORD PTR [rax]"},
+      {{0xc5,0xf8,0x93,0xc1}, "kmovw  eax,k1"},
+      {{0x62,0xf1,0x7f,0x48,0x6f,0x00}, "vmovdqu8 zmm0,ZMMWORD PTR [rax]"},
+      {{0x62,0xf2,0x7d,0x48,0x78,0xca}, "vpbroadcastb zmm1,xmm2"},
+      {{0x62,0xf1,0x75,0xc9,0xfe,0xc2}, "vpaddd zmm0{k1}{z},zmm1,zmm2"},
+      {{0x62,0xf1,0x7d,0x58,0xfe,0x40,0x01},
+       "vpaddd zmm0,zmm0,DWORD BCST [rax+0x4]"},
+      {{0x62,0xf1,0xfd,0x28,0x7f,0x05,0x10,0x00,0x00,0x00},
+       "vmovdqa64 YMMWORD PTR [rip+0x10],ymm0        "},
+      {{0x62,0xf1,0x7d,0x2a,0x6f,0xc1}, "vmovdqa32 ymm0{k2},ymm1"},
+      {{0xc4,0xe3,0x71,0x68,0xc2,0x30}, "vfmaddps xmm0,xmm1,xmm2,xmm3"},
+      {{0x8f,0xe9,0x60,0x92,0xd1}, "vprotd xmm2,xmm1,xmm3"},
+      {{0x8f,0xe8,0x78,0xc2,0xc1,0x07}, "vprotd xmm0,xmm1,0x7"},
+      {{0x8f,0xe8,0x60,0xcc,0xd1,0x04}, "vpcomeqb xmm2,xmm3,xmm1"},
+      {{0xc4,0xe2,0x69,0x90,0x04,0x88},
+       "vpgatherdd xmm0,DWORD PTR [rax+xmm1*4],xmm2"},
+      {{0xc5,0xf8,0xae,0x10}, "vldmxcsr DWORD PTR [rax]"},
+      {{0x66,0xc4,0xe2,0x70,0xf2,0xc2}, "andn eax,ecx,edx"},
+      {{0x62,0xf1,0x7d,0x48,0x6f,0xd1}, "vmovdqa32 zmm2,zmm1"},
+      {{0x67,0xe3,0x05}, "jecxz  8"},
+      {{0x66,0xc9}, "leavew"},
+      {{0x66,0xc3}, "retw"},
+      {{0x66,0x9d}, "popfw"},
+      {{0x48,0x8e,0xde}, "mov    ds,rsi"},
+      {{0x48,0xcb}, "retfq"},
+      {{0xf3,0xf0,0x01,0x00}, "xrelease add DWORD PTR [rax],eax"},
+      {{0xf2,0x86,0x00}, "xacquire xchg BYTE PTR [rax],al"},
+      {{0x67,0xa1,0x10,0x20,0x30,0x40}, "mov eax,ds:0x40302010"},
+      {{0x0f,0xc7,0x30}, "vmptrld QWORD PTR [rax]"},
+      {{0x66,0x0f,0xc7,0x30}, "vmclear QWORD PTR [rax]"},
+      {{0x0f,0xc7,0x38}, "vmptrst QWORD PTR [rax]"},
+      {{0x0f,0xc7,0x28}, "xsaves [rax]"},
+      {{0x48,0x0f,0xc7,0x18}, "xrstors64 [rax]"},
+   };
+   size_t diff = 0;
+   for (auto const& [code, text]: cases) {
+      string itc;
+      auto len = Decoder::decode(code.data(), code.size(), 0, itc);
+      if (len == code.size() && itc == text)
+         continue;
+      if (++diff <= 10)
+         std::cerr << "fixed: expected [" << text << "] (" << code.size()
+                   << " bytes)\n   decoder: [" << itc << "] (" << (int)len
+                   << " bytes)\n";
+   }
+   return diff;
+}
+
+
+/* objdump and the decoder on encodings of 16 bytes each, padded with nops */
+/* so that both meet again at the next one whatever length either gives    */
+static size_t fuzz(const string& name, const vector<uint8_t>& code) {
+   /* objdump reads the bytes as the code of an ELF object */
+   auto temp = (fs::temp_directory_path() / ("sba_" + name + "_"
+               + std::to_string(getpid()))).string();
+   fstream f(temp + ".bin", fstream::out | fstream::binary);
+   f.write((const char*)code.data(), code.size());
+   f.close();
+   auto cmd = "objcopy -I binary -O elf64-x86-64 -B i386:x86-64 "
+              "--rename-section .data=.text,alloc,load,readonly,code,contents "
+            + temp + ".bin " + temp + ".o";
+   vector<string> asm1, raw1, asm2, raw2;
+   auto ok = system(cmd.c_str()) == 0 && objdump(temp + ".o", asm1, raw1);
+   std::error_code ec;
+   fs::remove(temp + ".bin", ec);
+   fs::remove(temp + ".o", ec);
+   if (!ok) {
+      std::cerr << name << ": failed to disassemble\n";
+      return 1;
+   }
+
+   for (size_t pos = 0; pos < code.size();) {
+      string itc;
+      auto len = Decoder::decode(code.data() + pos, code.size() - pos, pos,
+                                 itc);
+      asm2.push_back(".L" + std::to_string(pos) + " " + itc);
+      raw2.push_back(raw(code.data() + pos, len));
+      pos += len;
+   }
+
+   /* lines of each encoding, so that one length that differs counts once; */
+   /* a branch out of the object keeps the space before its cut symbol     */
+   auto slots = [&](const vector<string>& asm_lines,
+   const vector<string>& raw_lines) {
+      vector<string> res(code.size() / 16);
+      for (size_t i = 0; i < asm_lines.size(); ++i) {
+         size_t addr = std::stoull(asm_lines[i].substr(2));
+         auto& x = res[std::min(addr / 16, res.size() - 1)];
+         auto s = asm_lines[i];
+         if (s.find(" 0xfff") != string::npos)
+            s.erase(s.find_last_not_of(' ') + 1);
+         x += s + " [" + (i < raw_lines.size()? raw_lines[i]:
+              string("<none>")) + "] ";
+      }
+      return res;
+   };
+   auto x = slots(asm1, raw1);
+   auto y = slots(asm2, raw2);
+   size_t diff = 0;
+   for (size_t k = 0; k < x.size(); ++k)
+      if (x[k] != y[k] && ++diff <= 10)
+         std::cerr << name << ": " << raw(code.data() + 16*k, 6)
+                   << "\n   objdump: " << x[k] << "\n   decoder: " << y[k]
+                   << "\n";
+   std::cout << name << ": " << x.size() << " encodings, " << diff
+             << " differing\n";
+   return diff;
+}
+
+
+static void add(vector<uint8_t>& code, const vector<uint8_t>& bytes) {
+   auto start = code.size();
+   code.insert(code.end(), bytes.begin(), bytes.end());
+   code.resize(start + 16, 0x90);
+}
+
+
+/* every VEX opcode of maps 1-3 with each VEX.pp, VEX.L and VEX.W, in the  */
+/* 2-byte form too, with VEX.vvvv unused or not, and a register and a       */
+/* memory ModRM                                                             */
+static size_t vex_fuzz() {
+   vector<uint8_t> code;
+   for (unsigned op = 0; op < 256; ++op)
+      for (uint8_t modrm: {0xd1, 0x10})
+         for (uint8_t vvvv: {0x78, 0x50})
+            for (uint8_t l = 0; l < 2; ++l)
+               for (uint8_t pp = 0; pp < 4; ++pp) {
+                  uint8_t lpp = vvvv | l << 2 | pp;
+                  add(code, {0xc5, (uint8_t)(0x80 | lpp), (uint8_t)op,
+                             modrm});
+                  for (uint8_t map = 1; map <= 3; ++map)
+                     for (uint8_t w = 0; w < 2; ++w)
+                        add(code, {0xc4, (uint8_t)(0xe0 | map),
+                                   (uint8_t)(w << 7 | lpp), (uint8_t)op,
+                                   modrm});
+               }
+   return fuzz("vex", code);
+}
+
+
+/* every opcode of the one-byte and 0f maps with every ModRM, then under   */
+/* each of 66, 67, F2, F3, F0 and REX.W with a register and three memory    */
+/* ModRMs per ModRM.reg; prefixes, REX, VEX and EVEX escapes are left out   */
+static size_t legacy_fuzz() {
+   vector<uint8_t> code;
+   auto escape = [](unsigned op) {
+      return op == 0x0f || op == 0x26 || op == 0x2e || op == 0x36 ||
+             op == 0x3e || (op >= 0x40 && op <= 0x4f) || op == 0x62 ||
+             op == 0x64 || op == 0x65 || op == 0x66 || op == 0x67 ||
+             op == 0xc4 || op == 0xc5 || op == 0xf0 || op == 0xf2 ||
+             op == 0xf3;
+   };
+   for (int prefix: {-1, 0x66, 0x67, 0xf2, 0xf3, 0xf0, 0x48})
+      for (unsigned map = 0; map < 2; ++map)
+         for (unsigned op = 0; op < 256; ++op) {
+            if (map == 0 && escape(op))
+               continue;
+            for (unsigned modrm = 0; modrm < 256; ++modrm) {
+               if (prefix >= 0 && (modrm & 0xc7) != 0xc1 &&
+               (modrm & 0xc7) != 0x00 && (modrm & 0xc7) != 0x05 &&
+               (modrm & 0xc7) != 0x44)
+                  continue;
+               vector<uint8_t> x;
+               if (prefix >= 0)
+                  x.push_back((uint8_t)prefix);
+               if (map == 1)
+                  x.push_back(0x0f);
+               x.push_back((uint8_t)op);
+               x.push_back((uint8_t)modrm);
+               add(code, x);
+            }
+         }
+   return fuzz("legacy", code);
+}
+
+
+/* number of differing lines of objdump and the decoder on file */
+static size_t check(const string& file) {
+   vector<string> asm1, raw1, asm2, raw2;
+   if (!objdump(file, asm1, raw1) || !decoder(file, asm2, raw2)) {
+      std::cerr << file << ": failed to disassemble\n";
+      return 1;
+   }
+   auto d = compare(file, "asm", asm1, asm2)
+          + compare(file, "raw", raw1, raw2);
+   std::cout << file << ": " << asm1.size() << " insns, " << d
+             << " differing lines\n";
+   return d;
+}
+
+
+int main(int argc, char** argv) {
+   size_t failed = fixed();
+   std::cout << "fixed encodings: " << failed << " differing\n";
+   failed += (vex_fuzz() != 0);
+   failed += (legacy_fuzz() != 0);
+   failed += for_each_binary(argc, argv, check);
+   return failed == 0? 0: 1;
+}
@@ -0,0 +1,146 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* Insn::refresh() classifies transfers in one walk over the RTL; here it is */
+/* checked against the pattern searches with RTL::find() it replaced. Every  */
+/* insn of a sample binary is built with each of the RTL samples and with    */
+/* lifter-style RTL of its own, and call(), jump(), direct(), indirect(),    */
+/* the targets, conditions and the pc-relative operand must all agree.       */
+/* usage: insn_test <dir or binary>...                                       */
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/insn.h"
+#include "../../include/sba/parser.h"
+#include "../../include/sba/rtl.h"
+#include "../../include/sba/expr.h"
+#include "sample.h"
+#include <iostream>
+
+using namespace SBA;
+
+/* transfer of an insn as text, from find() as Insn::refresh() did before */
+static string reference(Statement* stmt, IMM next_offset) {
+   if (stmt == nullptr)
+      return "none";
+
+   Call call_pattern(nullptr);
+   auto vec = stmt->find(RTL::RTL_EQUAL::OPCODE, &call_pattern);
+   if (!vec.empty()) {
+      auto target = ((Mem*)(((Call*)vec.front())->target()))->addr();
+      if (target->expr_type() == Expr::EXPR_TYPE::CONSTANT)
+         return "call direct " + std::to_string(((Const*)target)->to_int());
+      return "call indirect " + target->to_string();
+   }
+
+   Assign jump_pattern(new NoType("pc"), nullptr);
+   vec = stmt->find(RTL::RTL_EQUAL::PARTIAL, &jump_pattern);
+   if (!vec.empty()) {
+      auto target = ((Assign*)(vec.front()))->src();
+      switch (target->expr_type()) {
+         case Expr::EXPR_TYPE::CONSTANT:
+            return "jump direct " +
+                   std::to_string(((Const*)target)->to_int());
+         case Expr::EXPR_TYPE::IFELSE: {
+            auto ifel = (IfElse*)target;
+            auto a = ifel->if_expr();
+            auto b = ifel->else_expr();
+            auto t = (a->to_string().compare("pc") == 0)?
+                     pair<IMM,IMM>{next_offset, ((Const*)b)->to_int()}:
+                     pair<IMM,IMM>{((Const*)a)->to_int(), next_offset};
+            return "jump cond " + std::to_string(t.first) + " " +
+                   std::to_string(t.second);
+         }
+         case Expr::EXPR_TYPE::VAR:
+            return "jump indirect " + target->to_string();
+         default:
+            return "none";
+      }
+   }
+
+   if (stmt->stmt_type() == Statement::STATEMENT_TYPE::EXIT)
+      return ((Exit*)stmt)->exit_type() == Exit::EXIT_TYPE::RET?
+             "ret": "halt";
+   return "none";
+}
+
+
+/* X of the first (plus (reg ip) X), as Program::scan_cptrs() searched it */
+static string reference_pc_rel(Statement* stmt) {
+   if (stmt == nullptr)
+      return "none";
+   Binary pattern(Binary::OP::PLUS, Expr::EXPR_MODE::DI,
+                  new Reg(Expr::EXPR_MODE::DI, SYSTEM::INSN_PTR), nullptr);
+   auto vec = stmt->find(RTL::RTL_EQUAL::PARTIAL, &pattern);
+   return vec.empty()? string("none"):
+                       ((Binary*)(vec.front()))->operand(1)->to_string();
+}
+
+
+/* the same transfer, as the insn reports it */
+static string classified(const Insn& i) {
+   string res;
+   if (i.call() || i.jump()) {
+      res = i.call()? "call": "jump";
+      if (i.indirect())
+         res += " indirect " + i.indirect_target()->to_string();
+      else if (i.direct() && i.cond_jump())
+         res += " cond " + std::to_string(i.direct_target().first) + " " +
+                std::to_string(i.direct_target().second);
+      else if (i.direct())
+         res += " direct " + std::to_string(i.direct_target().first);
+   }
+   else if (i.ret())
+      res = "ret";
+   else if (i.halt())
+      res = "halt";
+   else
+      res = "none";
+   return res + " pc_rel " +
+          (i.pc_rel() == nullptr? string("none"): i.pc_rel()->to_string());
+}
+
+
+/* number of differing insns, the first few are printed */
+static size_t check(const string& file) {
+   /* each insn once with one of the samples, once with RTL of its own */
+   SYSTEM::Object info, info2;
+   vector<tuple<IMM,RTL*,vector<uint8_t>>> offset_rtl_raw, own;
+   vector<IMM> fptr_list;
+   if (!sample(file, info, offset_rtl_raw, fptr_list, true) ||
+   !sample(file, info2, own, fptr_list)) {
+      std::cerr << file << ": failed to load\n";
+      return 1;
+   }
+   offset_rtl_raw.insert(offset_rtl_raw.end(), own.begin(), own.end());
+
+   size_t diff = 0;
+   size_t count = 0;
+   size_t transfers = 0;
+   for (auto const& [offset, rtl, raw]: offset_rtl_raw) {
+      auto s = (rtl == nullptr)? string("<none>"): rtl->to_string();
+      Insn i(offset, rtl, raw);
+      auto x = classified(i);
+      auto y = reference(i.stmt(), i.next_offset()) + " pc_rel " +
+               reference_pc_rel(i.stmt());
+      ++count;
+      transfers += (i.call() || i.jump());
+      if (x != y && ++diff <= 10)
+         std::cerr << file << ": insn " << offset << " " << s
+                   << "\n   classified: [" << x
+                   << "]\n   find():     [" << y << "]\n";
+   }
+   std::cout << file << ": " << count << " insns, " << transfers
+             << " transfers, " << diff << " differing\n";
+   return count == 0? 1: diff;
+}
+
+
+
+int main(int argc, char** argv) {
+   return for_each_binary(argc, argv, check) == 0? 0: 1;
+}
@@ -0,0 +1,100 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* RTLImage save -> load round trip: every insn of a sample binary gets an   */
+/* RTL, or none as an unlifted insn would, and the loaded image must give    */
+/* back the same offsets, raw bytes and RTL text.                            */
+/* usage: rtl_image_test <dir or binary>...                                  */
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/rtl_image.h"
+#include "../../include/sba/arena.h"
+#include "../../include/sba/parser.h"
+#include "../../include/sba/rtl.h"
+#include "sample.h"
+#include <filesystem>
+#include <iostream>
+#include <unistd.h>
+
+using namespace SBA;
+namespace fs = std::filesystem;
+using Image = vector<tuple<IMM,RTL*,vector<uint8_t>>>;
+
+
+/* offset, raw bytes and RTL text of one insn */
+static string text(const tuple<IMM,RTL*,vector<uint8_t>>& x) {
+   static const char* const digits = "0123456789abcdef";
+   auto const& [offset, rtl, raw] = x;
+   auto s = std::to_string(offset);
+   for (auto b: raw) {
+      s += " ";
+      s += digits[b >> 4];
+      s += digits[b & 0xf];
+   }
+   return s + " " + (rtl == nullptr? string("<none>"): rtl->to_string());
+}
+
+
+static void release(Image& image) {
+   for (auto const& [offset, rtl, raw]: image)
+      delete rtl;
+   image.clear();
+}
+
+
+/* number of differing insns, the first few are printed */
+static size_t round_trip(const string& file) {
+   SYSTEM::Object info;
+   Image saved;
+   vector<IMM> fptr_list;
+   if (!sample(file, info, saved, fptr_list, true)) {
+      std::cerr << file << ": failed to load\n";
+      return 1;
+   }
+
+   auto f_image = (fs::temp_directory_path() / ("sba_rtl_image_" +
+                  std::to_string(getpid()))).string();
+   auto key = RTLImage::key(file, 1);
+   size_t diff = 0;
+   Arena arena;
+   Image loaded;
+   if (!RTLImage::save(f_image, key, saved) ||
+   !RTLImage::load(f_image, key, loaded, &arena)) {
+      std::cerr << file << ": failed to save or load " << f_image << "\n";
+      ++diff;
+   }
+   else {
+      for (size_t i = 0; i < std::max(saved.size(), loaded.size()); ++i) {
+         auto a = i < saved.size()? text(saved[i]): string("<none>");
+         auto b = i < loaded.size()? text(loaded[i]): string("<none>");
+         if (a != b && ++diff <= 10)
+            std::cerr << file << ": insn " << i << "\n   saved:  [" << a
+                      << "]\n   loaded: [" << b << "]\n";
+      }
+      /* an image is only loaded with its own key */
+      Image other;
+      if (RTLImage::load(f_image, key + 1, other, &arena)) {
+         std::cerr << file << ": image loaded with another key\n";
+         ++diff;
+      }
+      release(other);
+   }
+   std::error_code ec;
+   fs::remove(f_image, ec);
+   std::cout << file << ": " << saved.size() << " insns, " << diff
+             << " differing\n";
+   release(saved);
+   release(loaded);
+   return diff;
+}
+
+
+
+int main(int argc, char** argv) {
+   return for_each_binary(argc, argv, round_trip) == 0? 0: 1;
+}
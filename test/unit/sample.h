@@ -0,0 +1,158 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* Insns of a sample binary with RTL in the lifter's format, for tests that  */
+/* build a Program without the lifter. By default control transfers follow */
+/* the decoded insns so the cfg is the binary's, other insns get data flow  */
+/* round-robin; with every sample, insns get all of SAMPLES round-robin.    */
+
+#ifndef TEST_SAMPLE_H
+#define TEST_SAMPLE_H
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/parser.h"
+#include "../../include/sba/rtl.h"
+#include <filesystem>
+#include <iostream>
+
+using namespace SBA;
+
+/* RTL texts covering every node the parser builds: the first FLOW_SAMPLES */
+/* are data flow over registers, stack and static memory, the rest are     */
+/* transfers and "", an insn left unlifted                                 */
+static const char* const SAMPLES[] = {
+   "(set (reg :DI ax) (plus :DI (reg :DI bx) (const_int 8)))",
+   "(set (mem :DI (plus :DI (reg :DI sp) (const_int -16))) (reg :DI di))",
+   "(set (reg :DI cx) (mem :DI (plus :DI (reg :DI sp) (const_int -16))))",
+   "(parallel (set (reg :DI sp) (minus :DI (reg :DI sp) (const_int 24))) "
+   "(clobber (reg :CC flags)))",
+   "(set (reg :CCZ flags) (compare :CCZ (reg :SI ax) (const_int 0)))",
+   "(set (reg :DI dx) (if_then_else :DI (ne (reg :CCZ flags) (const_int 0)) "
+   "(reg :DI si) (reg :DI dx)))",
+   "(set (reg :DI ax) (zero_extend :DI (subreg :SI (reg :DI bx) 0)))",
+   "(set (reg :DI si) (sign_extend :DI (mem :SI (plus :DI (reg :DI ax) "
+   "(const_int 4)))))",
+   "(parallel (set (reg :DI ax) (mult :DI (reg :DI ax) (reg :DI di))) "
+   "(clobber (reg :CC flags)))",
+   "(parallel (set (reg :DI bx) (ashift :DI (reg :DI bx) (const_int 3))) "
+   "(clobber (reg :CC flags)))",
+   "(parallel (set (reg :SI cx) (and :SI (reg :SI cx) (const_int 255))) "
+   "(clobber (reg :CC flags)))",
+   "(set (reg :DI ax) (plus :DI (plus :DI (reg :DI bx) (mult :DI (reg :DI cx) "
+   "(const_int 8))) (const_int 4210688)))",
+   "(set (mem :DI (const_int 4210752)) (reg :DI ax))",
+   "(set (reg :DI dx) (mem :DI (const_int 4210752)))",
+   "(set (reg :SI ax) (neg :SI (reg :SI ax)))",
+   "(set (reg :DI di) (plus :DI (reg :DI ip) (const_int 4096)))",
+   "(set (mem :SI (plus :DI (reg :DI sp) (const_int -16))) (reg :SI cx))",
+   "(parallel (set (reg :SI ax) (minus :SI (reg :SI ax) (reg :SI dx))) "
+   "(clobber (reg :CC flags)))",
+   "(set (reg :DF xmm0) (float :DF (reg :SI ax)))",
+   "(set (reg :DF xmm0) (const_double 4607182418800017408))",
+   "(parallel (set (reg :DI ax) (reg :DI bx)) (unspec [(const_int 0)] 7))",
+   "(set (reg :DI ax) (unspec :DI (reg :DI bx) 21))",
+
+   "(set (pc) (if_then_else (ne (reg :CCZ flags) (const_int 0)) "
+   "(const_int 4198400) (pc)))",
+   "(set pc (if_then_else (ltu (reg :CC flags) (const_int 0)) "
+   "(const_int 4198400) pc))",
+   "(set pc (const_int 4198400))",
+   "(set pc (mem :DI (plus :DI (reg :DI ip) (const_int 4096))))",
+   "(call (mem :QI (reg :DI ax)) (const_int 0))",
+   "(set (reg :DI ax) (call (mem :QI (const_int 4198400)) (const_int 0)))",
+   "(set (reg :DI bx) (call (mem :QI (reg :DI bx)) (const_int 0)))",
+   "(set (reg :DI ax) (call (mem :QI (mem :DI (plus :DI (reg :DI ip) "
+   "(const_int 64)))) (const_int 0)))",
+   "simple_return",
+   "",
+   "(trap_if (const_int 1) (const_int 6))",
+};
+static const size_t FLOW_SAMPLES = 22;
+
+
+/* lifter-style RTL of a decoded insn, by its mnemonic and operand */
+static string lift(const string& itc, size_t k) {
+   auto sp = itc.find(' ');
+   auto mnem = itc.substr(0, sp);
+   auto arg = (sp == string::npos)? string(""):
+              itc.substr(itc.find_first_not_of(' ', sp));
+   auto direct = !arg.empty() && std::all_of(arg.begin(), arg.end(),
+                 [](char c) {return std::isdigit(c);});
+   if (mnem == "ret")
+      return "simple_return";
+   if (mnem == "hlt" || mnem == "ud2")
+      return "(trap_if (const_int 1) (const_int 6))";
+   if (mnem == "call")
+      return direct? "(call (mem :QI (const_int " + arg + ")) (const_int 0))":
+                     "(call (mem :QI (reg :DI ax)) (const_int 0))";
+   if (mnem == "jmp")
+      return direct? "(set pc (const_int " + arg + "))":
+                     "(set pc (reg :DI ax))";
+   if (mnem[0] == 'j' && direct)
+      return "(set pc (if_then_else (ne (reg :CCZ flags) (const_int 0)) "
+             "(const_int " + arg + ") pc))";
+   return SAMPLES[k % FLOW_SAMPLES];
+}
+
+
+/* decoded insns of file with their RTL, and its definite fptrs in order */
+static bool sample(const string& file, SYSTEM::Object& info,
+vector<tuple<IMM,RTL*,vector<uint8_t>>>& offset_rtl_raw,
+vector<IMM>& fptr_list, bool every_sample = false) {
+   if (!SYSTEM::load(info, file))
+      return false;
+   SYSTEM::disassemble(info, [&](uint64_t addr, const string& itc,
+   const uint8_t* code, uint8_t len) {
+      auto k = offset_rtl_raw.size();
+      auto s = every_sample? string(SAMPLES[k % (sizeof(SAMPLES)/
+                                            sizeof(char*))]): lift(itc, k);
+      auto rtl = s.empty()? nullptr: Parser::process(s);
+      offset_rtl_raw.push_back({(IMM)addr, rtl,
+                                vector<uint8_t>(code, code + len)});
+   });
+   auto fptrs = SYSTEM::definite_fptrs(info);
+   fptr_list.assign(fptrs.begin(), fptrs.end());
+   std::sort(fptr_list.begin(), fptr_list.end());
+   return true;
+}
+
+
+/* check every binary given, or found in a directory given, in order; the */
+/* number of binaries check() fails on, or 1 if none are given            */
+static size_t for_each_binary(int argc, char** argv,
+const function<size_t(const string&)>& check) {
+   auto elf = [](const std::filesystem::path& p) {
+      char magic[4] = {};
+      fstream f(p, fstream::in | fstream::binary);
+      f.read(magic, 4);
+      return std::filesystem::is_regular_file(p) && f.gcount() == 4 &&
+             magic[0] == 0x7f && magic[1] == 'E' && magic[2] == 'L' &&
+             magic[3] == 'F';
+   };
+   vector<string> files;
+   for (int i = 1; i < argc; ++i) {
+      if (std::filesystem::is_directory(argv[i])) {
+         for (auto const& e: std::filesystem::directory_iterator(argv[i]))
+            if (elf(e.path()))
+               files.push_back(e.path().string());
+      }
+      else
+         files.push_back(argv[i]);
+   }
+   std::sort(files.begin(), files.end());
+   if (files.empty()) {
+      std::cerr << "usage: " << argv[0] << " <dir or binary>...\n";
+      return 1;
+   }
+   size_t failed = 0;
+   for (auto const& file: files)
+      failed += (check(file) != 0);
+   return failed;
+}
+
+#endif
@@ -0,0 +1,340 @@
+/*
+   SBA: Static Binary Analysis Framework
+
+   Copyright (C) 2018 - 2025 by Huan Nguyen in Secure Systems Lab,
+   Stony Brook University, Stony Brook, NY 11794.
+*/
+
+/* Function::tarjan(), rev_postorder() and SCC::dfs() run on explicit      */
+/* stacks; here they are checked against the recursive versions they      */
+/* replaced, kept below on a plain adjacency list of the same cfg. Every   */
+/* function of the sample binaries and a few built cfgs (a deep chain, a   */
+/* deep loop, self-loops, nested loops, random jumps) must give the same   */
+/* SCCs in the same order, the same block order in each SCC, and the same  */
+/* predecessor lists. The recursive versions run on a large stack, the     */
+/* ones under test on the default one.                                     */
+/* usage: scc_test <dir or binary>...                                      */
+
+#include "../../include/sba/system.h"
+#include "../../include/sba/common.h"
+#include "../../include/sba/program.h"
+#include "../../include/sba/function.h"
+#include "../../include/sba/scc.h"
+#include "../../include/sba/block.h"
+#include "../../include/sba/insn.h"
+#include "../../include/sba/parser.h"
+#include "../../include/sba/rtl.h"
+#include "sample.h"
+#include <iostream>
+#include <random>
+#include <pthread.h>
+
+using namespace SBA;
+
+/* ------------------------------- reference -------------------------------- */
+/* Function::tarjan(), Function::rev_postorder() and SCC::dfs() as they were */
+/* before the explicit stacks, on block indices instead of Block*            */
+struct Reference {
+   struct Scc {
+      vector<int> ext_target;
+      vector<int> b_list;
+   };
+   vector<vector<int>> succ;
+   vector<vector<int>> pred;
+   vector<IMM> num;
+   vector<IMM> low;
+   vector<int> parent;
+   vector<bool> visited;
+   vector<int> touched;
+   vector<Scc> sccs;
+   vector<int> s_list;
+
+   void tarjan(int u, IMM& cnt, stack<int>& st) {
+      ++cnt;
+      num[u] = cnt;
+      low[u] = cnt;
+      st.push(u);
+      for (auto v: succ[u]) {
+         if (num[v] == 0) {
+            tarjan(v, cnt, st);
+            low[u] = std::min(low[u], low[v]);
+         }
+         else if (num[v] > 0)
+            low[u] = std::min(low[u], num[v]);
+      }
+      if (num[u] == low[u]) {
+         sccs.push_back({});
+         while (true) {
+            auto v = st.top();
+            st.pop();
+            parent[v] = sccs.size() - 1;
+            num[v] = -1;
+            if (u == v)
+               break;
+         }
+      }
+   }
+
+   void dfs(int scc, int u) {
+      visited[u] = true;
+      touched.push_back(u);
+      for (auto v: succ[u]) {
+         pred[v].push_back(u);
+         if (parent[v] != scc)
+            sccs[scc].ext_target.push_back(v);
+         else if (!visited[v])
+            dfs(scc, v);
+      }
+      sccs[scc].b_list.push_back(u);
+   }
+
+   void build_cfg(int scc, int header) {
+      touched.clear();
+      dfs(scc, header);
+      std::reverse(sccs[scc].b_list.begin(), sccs[scc].b_list.end());
+      for (auto b: touched)
+         visited[b] = false;
+   }
+
+   void rev_postorder(int header) {
+      auto scc = parent[header];
+      build_cfg(scc, header);
+      for (size_t k = 0; k < sccs[scc].ext_target.size(); ++k) {
+         auto u = sccs[scc].ext_target[k];
+         auto nscc = parent[u];
+         if (sccs[nscc].b_list.empty()) {
+            rev_postorder(u);
+            sccs[nscc].ext_target.clear();
+         }
+      }
+      s_list.push_back(scc);
+   }
+
+   /* block indices of each SCC in order, and predecessors of each block */
+   void run(vector<vector<int>>& order) {
+      auto n = succ.size();
+      pred.assign(n, {});
+      num.assign(n, 0);
+      low.assign(n, 0);
+      parent.assign(n, -1);
+      visited.assign(n, false);
+      IMM cnt = 0;
+      stack<int> st;
+      tarjan(0, cnt, st);
+      rev_postorder(0);
+      std::reverse(s_list.begin(), s_list.end());
+      /* pseudo_entry */
+      pred[0].push_back(-1);
+      for (auto scc: s_list)
+         order.push_back(sccs[scc].b_list);
+   }
+};
+
+
+/* run fn on a thread with a stack large enough for the recursion */
+static void deep(const function<void()>& fn) {
+   pthread_attr_t attr;
+   pthread_attr_init(&attr);
+   pthread_attr_setstacksize(&attr, (size_t)1 << 30);
+   pthread_t t;
+   pthread_create(&t, &attr, [](void* p) -> void* {
+      (*(const function<void()>*)p)();
+      return nullptr;
+   }, (void*)&fn);
+   pthread_join(t, nullptr);
+   pthread_attr_destroy(&attr);
+}
+/* -------------------------------------------------------------------------- */
+
+/* number of differences between f and the reference, the first are printed */
+static size_t compare(Function* f, const string& name) {
+   /* blocks of f in the order they are reached, entry first */
+   unordered_map<Block*,int> index;
+   vector<Block*> blocks{f->entry()};
+   index[f->entry()] = 0;
+   Reference ref;
+   for (size_t k = 0; k < blocks.size(); ++k) {
+      ref.succ.push_back({});
+      for (auto const& [v, c]: blocks[k]->succ()) {
+         auto [it, fresh] = index.insert({v, blocks.size()});
+         if (fresh)
+            blocks.push_back(v);
+         ref.succ[k].push_back(it->second);
+      }
+   }
+   vector<vector<int>> expected;
+   deep([&]() {ref.run(expected);});
+
+   vector<vector<int>> order;
+   for (auto scc: f->scc_list()) {
+      order.push_back({});
+      for (auto b: scc->block_list())
+         order.back().push_back(index.contains(b)? index[b]: -2);
+   }
+   size_t diff = 0;
+   auto report = [&](const string& what) {
+      if (++diff <= 10)
+         std::cerr << name << ": function " << f->offset() << ": " << what
+                   << "\n";
+   };
+   if (order.size() != expected.size())
+      report(std::to_string(order.size()) + " SCCs, expected " +
+             std::to_string(expected.size()));
+   for (size_t k = 0; k < std::min(order.size(), expected.size()); ++k)
+      if (order[k] != expected[k])
+         report("SCC " + std::to_string(k) + " differs");
+   for (size_t k = 0; k < blocks.size(); ++k) {
+      vector<int> preds;
+      for (auto u: blocks[k]->pred())
+         preds.push_back(u == f->pseudo_entry()? -1:
+                         index.contains(u)? index[u]: -2);
+      if (preds != ref.pred[k])
+         report("preds of block " + std::to_string(blocks[k]->offset()) +
+                " differ");
+   }
+   return diff;
+}
+
+
+/* number of differing functions of a sample binary */
+static size_t check(const string& file) {
+   SYSTEM::Object info;
+   vector<tuple<IMM,RTL*,vector<uint8_t>>> offset_rtl_raw;
+   vector<IMM> fptr_list;
+   if (!sample(file, info, offset_rtl_raw, fptr_list)) {
+      std::cerr << file << ": failed to load\n";
+      return 1;
+   }
+   Program p(file, std::move(info), offset_rtl_raw, fptr_list, {});
+   size_t diff = 0;
+   size_t funcs = 0;
+   size_t sccs = 0;
+   for (auto fptr: fptr_list) {
+      auto f = p.func(fptr);
+      if (f == nullptr)
+         continue;
+      diff += (compare(f, file) != 0);
+      sccs += f->scc_list().size();
+      ++funcs;
+   }
+   std::cout << file << ": " << funcs << " functions, " << sccs << " SCCs, "
+             << diff << " differing\n";
+   return funcs == 0? 1: diff;
+}
+/* -------------------------------------------------------------------------- */
+
+/* insn k of a built cfg: 'n' data flow, 'r' return, 'j' jump to target, */
+/* 'c' conditional jump to target or fall through                        */
+struct Op {
+   char kind;
+   size_t target;
+};
+
+
+/* one function of 2-byte insns from offset 4096 */
+static size_t check(const string& name, const vector<Op>& ops) {
+   vector<tuple<IMM,RTL*,vector<uint8_t>>> offset_rtl_raw;
+   auto offset = [](size_t k) {return std::to_string(4096 + 2*k);};
+   for (size_t k = 0; k < ops.size(); ++k) {
+      auto const& op = ops[k];
+      auto s = (op.kind == 'n')? string(SAMPLES[0]):
+               (op.kind == 'r')? string("simple_return"):
+               (op.kind == 'j')? "(set pc (const_int " + offset(op.target)
+                                 + "))":
+               "(set pc (if_then_else (ne (reg :CCZ flags) (const_int 0)) "
+               "(const_int " + offset(op.target) + ") pc))";
+      offset_rtl_raw.push_back({4096 + 2*k, Parser::process(s),
+                                vector<uint8_t>{0x90, 0x90}});
+   }
+   Program p(name, SYSTEM::Object(), offset_rtl_raw, {4096}, {});
+   auto f = p.func(4096);
+   if (f == nullptr) {
+      std::cerr << name << ": faulty function\n";
+      return 1;
+   }
+   auto diff = compare(f, name);
+   std::cout << name << ": " << f->scc_list().size() << " SCCs, " << diff
+             << " differing\n";
+   return diff;
+}
+
+
+/* n blocks in a row, the last one returns or jumps back to the first */
+static vector<Op> chain(size_t n, bool loop) {
+   vector<Op> ops;
+   for (size_t k = 0; k + 1 < n; ++k)
+      ops.push_back({'j', k + 1});
+   if (loop)
+      ops.push_back({'c', 0});
+   ops.push_back({'r', 0});
+   return ops;
+}
+
+
+/* blocks that branch back to themselves, every third also to its parent */
+static vector<Op> self_loops(size_t n) {
+   vector<Op> ops;
+   for (size_t k = 0; k < n; ++k) {
+      auto head = ops.size();
+      ops.push_back({'n', 0});
+      ops.push_back({'c', head});
+      if (k % 3 == 2)
+         ops.push_back({'c', head - 2});
+   }
+   ops.push_back({'r', 0});
+   return ops;
+}
+
+
+/* loops nested depth deep, each level has two inner loops and a break */
+static void nested(vector<Op>& ops, size_t depth, vector<size_t>& breaks) {
+   auto head = ops.size();
+   ops.push_back({'n', 0});
+   if (depth > 0) {
+      nested(ops, depth - 1, breaks);
+      breaks.push_back(ops.size());
+      ops.push_back({'c', 0});
+      nested(ops, depth - 1, breaks);
+   }
+   ops.push_back({'c', head});
+}
+
+
+static vector<Op> nested(size_t depth) {
+   vector<Op> ops;
+   vector<size_t> breaks;
+   nested(ops, depth, breaks);
+   for (auto k: breaks)
+      ops[k].target = ops.size();
+   ops.push_back({'r', 0});
+   return ops;
+}
+
+
+/* jumps to random insns, so SCCs of any shape */
+static vector<Op> random(size_t n, unsigned seed) {
+   std::mt19937 gen(seed);
+   vector<Op> ops;
+   for (size_t k = 0; k + 1 < n; ++k) {
+      auto r = gen() % 8;
+      auto target = gen() % n;
+      ops.push_back({r < 3? 'n': r < 4? 'j': r < 7? 'c': 'r', target});
+   }
+   ops.push_back({'r', 0});
+   return ops;
+}
+
+
+
+int main(int argc, char** argv) {
+   size_t failed = for_each_binary(argc, argv,
+                   [](const string& file) {return check(file);});
+   failed += (check("chain", chain(200000, false)) != 0);
+   failed += (check("loop", chain(200000, true)) != 0);
+   failed += (check("self-loops", self_loops(300)) != 0);
+   failed += (check("nested", nested(8)) != 0);
+   for (unsigned seed = 1; seed <= 20; ++seed)
+      failed += (check("random " + std::to_string(seed),
+                       random(2000, seed)) != 0);
+   return failed == 0? 0: 1;
+}